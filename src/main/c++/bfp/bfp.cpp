@@ -1,8 +1,15 @@
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
 #include <pugixml.hpp>
 
 #include "bfp.h"
+#include "bitfileCache.h"
 #include "errorsIrio.h"
 
 namespace irio {
@@ -14,11 +21,8 @@ inline std::string removeSpaces(const std::string &s) {
 	return aux;
 }
 
-std::unordered_map<std::string, bfp::Register> parseRegisters(
-		const pugi::xml_node &node, const std::uint32_t &baseAddress,
-		const bool warnUnsupported) {
-	std::unordered_map<std::string, bfp::Register> mapRet;
-
+void parseRegisters(const pugi::xml_node &node,
+		const std::uint32_t &baseAddress, BitfileTables *tables) {
 	for (const auto &regNode : node.children("Register")) {
 		// Skip if internal register
 		if (regNode.child("Internal").text().as_bool())
@@ -30,14 +34,11 @@ std::unordered_map<std::string, bfp::Register> parseRegisters(
 		if (aux.getElemType() != bfp::ElemTypes::Unsupported) {
 			std::string name = aux.getName();
 			name = removeSpaces(name);
-			mapRet.insert({ name, aux });
-		} else if (warnUnsupported) {
-			std::cerr << "WARNING: Skipping register " << aux.getName()
-					<< ". Unsupported type." << std::endl;
+			tables->regMap.insert({ name, aux });
+		} else {
+			tables->unsupported.push_back(aux.getName());
 		}
 	}
-
-	return mapRet;
 }
 
 std::unordered_map<std::string, bfp::DMA> parseDMA(const pugi::xml_node &node) {
@@ -53,8 +54,7 @@ std::unordered_map<std::string, bfp::DMA> parseDMA(const pugi::xml_node &node) {
 	return mapRet;
 }
 
-BFP::BFP(const std::string &bitfile, const bool warnUnsupported) :
-		m_bitfilePath(bitfile) {
+BitfileTables parseFull(const std::string &bitfile) {
 	pugi::xml_document doc;
 	pugi::xml_parse_result resParse = doc.load_file(bitfile.c_str());
 
@@ -62,22 +62,195 @@ BFP::BFP(const std::string &bitfile, const bool warnUnsupported) :
 		throw errors::BFPParseBitfileError(bitfile, resParse.description());
 	}
 
+	BitfileTables tables;
 	try {
-		m_signature =
+		tables.signature =
 				doc.select_node("/Bitfile/SignatureRegister").node().text().as_string();
-		m_baseAddress =
+		tables.baseAddress =
 				doc.select_node("//NiFpga/BaseAddressOnDevice").node().text().as_uint();
-		m_bitfileVersion =
+		tables.bitfileVersion =
 				doc.select_node("/Bitfile/BitfileVersion").node().text().as_string();
 
-		m_regMap = parseRegisters(
-				doc.select_node("/Bitfile/VI/RegisterList").node(),
-				m_baseAddress, warnUnsupported);
-		m_dmaMap = parseDMA(
+		parseRegisters(doc.select_node("/Bitfile/VI/RegisterList").node(),
+				tables.baseAddress, &tables);
+		tables.dmaMap = parseDMA(
 				doc.select_node("/Bitfile/Project//DmaChannelAllocationList").node());
 	} catch (pugi::xpath_exception &e) {
 		throw errors::BFPParseBitfileError(bitfile, e.what());
 	}
+	return tables;
+}
+
+/**
+ * Reads a bitfile up to the start of its bitstream, the last and by far the
+ * largest element, and closes the root element after it.
+ *
+ * @return False if the bitfile cannot be read or has no bitstream
+ */
+bool readUntilBitstream(const std::string &bitfile, std::string *buffer) {
+	static const std::string BITSTREAM_TAG = "<Bitstream>";
+	static const std::string ROOT_END = "</Bitfile>";
+	const size_t READ_CHUNK = 1 << 16;
+
+	std::ifstream file(bitfile, std::ios::binary);
+	std::vector<char> chunk(READ_CHUNK);
+	buffer->clear();
+	while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+		// The tag may start in the previous chunk
+		const size_t from = buffer->size() < BITSTREAM_TAG.size() ?
+				0 : buffer->size() - BITSTREAM_TAG.size() + 1;
+		buffer->append(chunk.data(), static_cast<size_t>(file.gcount()));
+		const auto pos = buffer->find(BITSTREAM_TAG, from);
+		if (pos != std::string::npos) {
+			buffer->resize(pos);
+			*buffer += ROOT_END;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Returns the first descendant of \p root named \p name in document order,
+ * like the descendant axis of XPath, without building a node set
+ */
+pugi::xml_node findDescendant(const pugi::xml_node &root, const char *name) {
+	pugi::xml_node node = root.first_child();
+	while (node) {
+		if (std::strcmp(node.name(), name) == 0) {
+			return node;
+		}
+		if (node.first_child()) {
+			node = node.first_child();
+			continue;
+		}
+		while (node != root && !node.next_sibling()) {
+			node = node.parent();
+		}
+		if (node == root) {
+			break;
+		}
+		node = node.next_sibling();
+	}
+	return pugi::xml_node();
+}
+
+/**
+ * Parses only the elements preceding the bitstream, which is never loaded
+ * in memory, and finds the nodes walking their parents instead of
+ * evaluating XPath.
+ *
+ * @return False if any of the nodes needed is not before the bitstream, so
+ * the whole bitfile has to be parsed
+ */
+bool parseTargeted(const std::string &bitfile, BitfileTables *tables) {
+	std::string buffer;
+	if (!readUntilBitstream(bitfile, &buffer)) {
+		return false;
+	}
+
+	// Parsed in place, the DOM points to the buffer instead of copying it
+	pugi::xml_document doc;
+	if (doc.load_buffer_inplace(&buffer[0], buffer.size()).status != 0) {
+		return false;
+	}
+
+	const auto root = doc.child("Bitfile");
+	const auto signature = root.child("SignatureRegister");
+	const auto version = root.child("BitfileVersion");
+	const auto registerList = root.child("VI").child("RegisterList");
+	const auto baseAddress =
+			findDescendant(doc, "NiFpga").child("BaseAddressOnDevice");
+	const auto dmaList =
+			findDescendant(root.child("Project"), "DmaChannelAllocationList");
+	if (!signature || !version || !registerList || !baseAddress || !dmaList) {
+		return false;
+	}
+
+	tables->signature = signature.text().as_string();
+	tables->baseAddress = baseAddress.text().as_uint();
+	tables->bitfileVersion = version.text().as_string();
+	parseRegisters(registerList, tables->baseAddress, tables);
+	tables->dmaMap = parseDMA(dmaList);
+	return true;
+}
+
+BitfileTables parseBitfile(const std::string &bitfile, const ParseMode mode) {
+	BitfileTables tables;
+	if (mode == ParseMode::Targeted && parseTargeted(bitfile, &tables)) {
+		return tables;
+	}
+	return parseFull(bitfile);
+}
+
+/**
+ * Indexes the resources named <prefix><n>. A name ending in several digits
+ * is indexed once per split with a number without leading zeros, e.g.
+ * "A12" as ("A", 12) and ("A1", 2), as any of them could be looked up
+ */
+template<typename T>
+void buildEnumIndex(const std::unordered_map<std::string, T> &resources,
+		std::unordered_map<std::string,
+				std::map<std::uint32_t, std::string>> *index) {
+	const size_t MAX_DIGITS = 10;
+	for (const auto &resource : resources) {
+		const std::string &name = resource.first;
+		size_t digits = name.size();
+		while (digits > 0
+				&& std::isdigit(static_cast<unsigned char>(name[digits - 1]))) {
+			--digits;
+		}
+		for (size_t pos = std::max(digits, name.size() - std::min(name.size(),
+				MAX_DIGITS)); pos < name.size(); ++pos) {
+			if (name[pos] == '0' && pos + 1 != name.size()) {
+				continue;
+			}
+			const auto n = std::stoull(name.substr(pos));
+			if (n <= UINT32_MAX) {
+				(*index)[name.substr(0, pos)].emplace(
+						static_cast<std::uint32_t>(n), name);
+			}
+		}
+	}
+}
+
+BFP::BFP(const std::string &bitfile, const bool warnUnsupported) :
+		BFP(bitfile, warnUnsupported, BitfileCache::getDefaultDir()) {
+}
+
+BFP::BFP(const std::string &bitfile, const bool warnUnsupported,
+		const std::string &cacheDir, const ParseMode mode) :
+		m_bitfilePath(bitfile) {
+	const BitfileCache cache(cacheDir);
+	BitfileCache::Key key;
+	// The key is taken before parsing, a bitfile modified meanwhile is
+	// parsed again next time
+	const bool cacheable = cache.isEnabled() && cache.getKey(bitfile, &key);
+
+	BitfileTables tables;
+	m_fromCache = cacheable && cache.load(key, &tables);
+	if (!m_fromCache) {
+		tables = parseBitfile(bitfile, mode);
+		if (cacheable) {
+			cache.store(key, tables);
+		}
+	}
+
+	if (warnUnsupported) {
+		for (const auto &name : tables.unsupported) {
+			std::cerr << "WARNING: Skipping register " << name
+					<< ". Unsupported type." << std::endl;
+		}
+	}
+
+	m_signature = std::move(tables.signature);
+	m_baseAddress = tables.baseAddress;
+	m_bitfileVersion = std::move(tables.bitfileVersion);
+	m_regMap = std::move(tables.regMap);
+	m_dmaMap = std::move(tables.dmaMap);
+
+	buildEnumIndex(m_regMap, &m_regEnumIndex);
+	buildEnumIndex(m_dmaMap, &m_dmaEnumIndex);
 }
 
 std::string BFP::getBitfilePath() const {
@@ -93,11 +266,16 @@ std::unordered_map<std::string, Register> BFP::getRegisters() const {
 }
 
 Register BFP::getRegister(const std::string &registerName) const {
-	try {
-		return m_regMap.at(registerName);
-	} catch (std::out_of_range&) {
+	const auto reg = tryGetRegister(registerName);
+	if (!reg) {
 		throw errors::ResourceNotFoundError(registerName + " not found");
 	}
+	return *reg;
+}
+
+const Register* BFP::tryGetRegister(const std::string &registerName) const {
+	const auto it = m_regMap.find(registerName);
+	return it == m_regMap.end() ? nullptr : &it->second;
 }
 
 std::unordered_map<std::string, DMA> BFP::getDMAs() const {
@@ -105,16 +283,49 @@ std::unordered_map<std::string, DMA> BFP::getDMAs() const {
 }
 
 DMA BFP::getDMA(const std::string &dmaName) const {
-	try {
-		return m_dmaMap.at(dmaName);
-	} catch (std::out_of_range&) {
+	const auto dma = tryGetDMA(dmaName);
+	if (!dma) {
 		throw errors::ResourceNotFoundError(dmaName + " not found");
 	}
+	return *dma;
+}
+
+const DMA* BFP::tryGetDMA(const std::string &dmaName) const {
+	const auto it = m_dmaMap.find(dmaName);
+	return it == m_dmaMap.end() ? nullptr : &it->second;
 }
 
 std::string BFP::getSignature() const {
 	return m_signature;
 }
 
+std::map<std::uint32_t, Register> BFP::enumerateRegisters(
+		const std::string &prefix) const {
+	std::map<std::uint32_t, Register> mapRet;
+	const auto it = m_regEnumIndex.find(prefix);
+	if (it != m_regEnumIndex.end()) {
+		for (const auto &entry : it->second) {
+			mapRet.emplace(entry.first, m_regMap.at(entry.second));
+		}
+	}
+	return mapRet;
+}
+
+std::map<std::uint32_t, DMA> BFP::enumerateDMAs(
+		const std::string &prefix) const {
+	std::map<std::uint32_t, DMA> mapRet;
+	const auto it = m_dmaEnumIndex.find(prefix);
+	if (it != m_dmaEnumIndex.end()) {
+		for (const auto &entry : it->second) {
+			mapRet.emplace(entry.first, m_dmaMap.at(entry.second));
+		}
+	}
+	return mapRet;
+}
+
+bool BFP::isFromCache() const {
+	return m_fromCache;
+}
+
 }  // namespace bfp
 }  // namespace irio
@@ -0,0 +1,461 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <pwd.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+
+#include "bitfileCache.h"
+
+namespace irio {
+namespace bfp {
+
+namespace {
+
+/// Identifies the files of the cache
+const char MAGIC[8] = {'I', 'R', 'I', 'O', 'B', 'F', 'P', 'C'};
+/// Changed whenever the layout of the entries changes
+const std::uint32_t FORMAT_VERSION = 1;
+/// Bytes of the bitfile read at once while looking for its signature
+const size_t SIGNATURE_CHUNK = 4096;
+/// Max length accepted for the SignatureRegister text
+const size_t MAX_SIGNATURE_LENGTH = 256;
+
+/// Text stored in the string table
+struct StringRef {
+	std::uint32_t offset;
+	std::uint32_t length;
+};
+
+/// Beginning of every entry, followed by the registers, the DMAs, the
+/// unsupported register names and the string table
+struct Header {
+	char magic[8];
+	std::uint32_t formatVersion;
+	std::uint32_t nRegisters;
+	std::uint32_t nDMAs;
+	std::uint32_t nUnsupported;
+	std::int64_t mtimeSec;
+	std::int64_t mtimeNsec;
+	std::uint64_t size;
+	std::uint32_t baseAddress;
+	std::uint32_t stringsSize;
+	StringRef path;
+	StringRef signature;
+	StringRef bitfileVersion;
+};
+
+/// A register or DMA
+struct Entry {
+	StringRef key;
+	StringRef name;
+	std::uint32_t address;
+	std::uint32_t numElem;
+	std::uint8_t fpgaType;
+	std::uint8_t elemType;
+	std::uint8_t padding[2];
+};
+
+static_assert(sizeof(Header) == 80 && sizeof(Entry) == 28,
+		"Layout of the bitfile cache changed, update FORMAT_VERSION");
+static_assert(std::is_trivially_copyable<Header>::value
+		&& std::is_trivially_copyable<Entry>::value,
+		"Cache records must be trivially copyable");
+
+/**
+ * Whether a file can only have been written by the current user: owned by
+ * it and not writable by group or others. Otherwise another user could
+ * plant entries with forged addresses
+ */
+bool isPrivate(const struct stat &st) {
+	return st.st_uid == ::geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/// Whether a folder exists and is private
+bool isPrivateDir(const std::string &dir) {
+	const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	const bool ret = ::fstat(fd, &st) == 0 && isPrivate(st);
+	::close(fd);
+	return ret;
+}
+
+/// Read-only mapping of a whole private regular file, see isPrivate
+class MappedFile {
+ public:
+	explicit MappedFile(const std::string &path) {
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+		if (fd < 0) {
+			return;
+		}
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && isPrivate(st)
+				&& st.st_size > 0) {
+			void *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size),
+					PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr != MAP_FAILED) {
+				m_data = static_cast<const char*>(addr);
+				m_size = static_cast<size_t>(st.st_size);
+			}
+		}
+		::close(fd);
+	}
+
+	~MappedFile() {
+		if (m_data) {
+			::munmap(const_cast<char*>(m_data), m_size);
+		}
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* data() const {
+		return m_data;
+	}
+
+	size_t size() const {
+		return m_size;
+	}
+
+ private:
+	const char *m_data = nullptr;
+	size_t m_size = 0;
+};
+
+/// Builds the string table while serializing an entry
+class StringTable {
+ public:
+	StringRef add(const std::string &text) {
+		const StringRef ref = { static_cast<std::uint32_t>(m_data.size()),
+				static_cast<std::uint32_t>(text.size()) };
+		m_data += text;
+		return ref;
+	}
+
+	const std::string& data() const {
+		return m_data;
+	}
+
+ private:
+	std::string m_data;
+};
+
+std::uint64_t fnv1a(const std::string &text) {
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (const char c : text) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool isValid(const StringRef &ref, const std::uint32_t stringsSize) {
+	return static_cast<std::uint64_t>(ref.offset) + ref.length <= stringsSize;
+}
+
+std::string toString(const StringRef &ref, const char *strings) {
+	return std::string(strings + ref.offset, ref.length);
+}
+
+bool isValid(const Entry &entry, const std::uint32_t stringsSize) {
+	return isValid(entry.key, stringsSize) && isValid(entry.name, stringsSize)
+			&& entry.fpgaType
+					<= static_cast<std::uint8_t>(FpgaTypes::FpgaType_DMAHtT)
+			&& entry.elemType
+					< static_cast<std::uint8_t>(ElemTypes::Unsupported);
+}
+
+template<typename T>
+void appendRecord(std::string *buffer, const T &record) {
+	buffer->append(reinterpret_cast<const char*>(&record), sizeof(T));
+}
+
+template<typename T>
+T readRecord(const char *data) {
+	T record;
+	std::memcpy(&record, data, sizeof(T));
+	return record;
+}
+
+Entry makeEntry(const std::string &key, const Resource &resource,
+		StringTable *strings) {
+	Entry entry = {};
+	entry.key = strings->add(key);
+	entry.name = strings->add(resource.getName());
+	entry.address = resource.getAddress();
+	entry.numElem = static_cast<std::uint32_t>(resource.getNumElem());
+	entry.fpgaType = static_cast<std::uint8_t>(resource.getFpgaType());
+	entry.elemType = static_cast<std::uint8_t>(resource.getElemType());
+	return entry;
+}
+
+/**
+ * Reads the text of the first SignatureRegister element of a bitfile. It
+ * is at the beginning of the file, so only the first chunks are read
+ */
+bool readSignature(const std::string &bitfile, std::string *signature) {
+	static const std::string OPEN = "<SignatureRegister>";
+	static const std::string CLOSE = "</SignatureRegister>";
+
+	std::ifstream file(bitfile, std::ios::binary);
+	std::string window;
+	char chunk[SIGNATURE_CHUNK];
+	while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+		window.append(chunk, static_cast<size_t>(file.gcount()));
+		const auto begin = window.find(OPEN);
+		if (begin == std::string::npos) {
+			// Keep the end, it could be the start of the tag
+			if (window.size() > OPEN.size()) {
+				window.erase(0, window.size() - OPEN.size());
+			}
+			continue;
+		}
+		const auto first = begin + OPEN.size();
+		const auto end = window.find(CLOSE, first);
+		if (end != std::string::npos) {
+			*signature = window.substr(first, end - first);
+			return true;
+		}
+		if (window.size() - first > MAX_SIGNATURE_LENGTH) {
+			return false;
+		}
+	}
+	return false;
+}
+
+/// Creates a folder and its parents, only accessible by the current user
+bool makeDirs(const std::string &dir) {
+	for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+		const std::string sub = dir.substr(0, pos);
+		if (::mkdir(sub.c_str(), 0700) != 0 && errno != EEXIST) {
+			return false;
+		}
+		if (pos == std::string::npos) {
+			return true;
+		}
+	}
+}
+
+bool writeAll(const int fd, const std::string &data) {
+	size_t written = 0;
+	while (written < data.size()) {
+		const ssize_t n = ::write(fd, data.data() + written,
+				data.size() - written);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		written += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+}  // namespace
+
+BitfileCache::BitfileCache(const std::string &dir) :
+		m_dir(dir) {
+}
+
+std::string BitfileCache::getDefaultDir() {
+	const char *envVar = std::getenv(BFP_CACHE_PATH_ENV_VAR);
+	if (envVar) {
+		return envVar;
+	}
+
+	const char *xdgCache = std::getenv("XDG_CACHE_HOME");
+	if (xdgCache && xdgCache[0] == '/') {
+		return std::string(xdgCache) + "/" + DEFAULT_BFP_CACHE_SUBDIR;
+	}
+	const char *home = std::getenv("HOME");
+	if (!home || home[0] != '/') {
+		const struct passwd *pw = ::getpwuid(::geteuid());
+		home = pw ? pw->pw_dir : nullptr;
+	}
+	if (!home || home[0] != '/') {
+		return "";
+	}
+	return std::string(home) + "/.cache/" + DEFAULT_BFP_CACHE_SUBDIR;
+}
+
+bool BitfileCache::isEnabled() const {
+	return !m_dir.empty();
+}
+
+bool BitfileCache::getKey(const std::string &bitfile, Key *key) const {
+	char resolved[PATH_MAX];
+	struct stat st;
+	if (!::realpath(bitfile.c_str(), resolved)
+			|| ::stat(resolved, &st) != 0) {
+		return false;
+	}
+	key->path = resolved;
+	key->mtimeSec = st.st_mtim.tv_sec;
+	key->mtimeNsec = st.st_mtim.tv_nsec;
+	key->size = static_cast<std::uint64_t>(st.st_size);
+	return true;
+}
+
+bool BitfileCache::load(const Key &key, BitfileTables *tables) const {
+	if (!isEnabled()) {
+		return false;
+	}
+	if (!isPrivateDir(m_dir)) {
+		return false;
+	}
+	const MappedFile file(getEntryPath(key));
+	if (!file.data() || file.size() < sizeof(Header)) {
+		return false;
+	}
+
+	const auto header = readRecord<Header>(file.data());
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+			|| header.formatVersion != FORMAT_VERSION) {
+		return false;
+	}
+	const std::uint64_t records = sizeof(Header)
+			+ (static_cast<std::uint64_t>(header.nRegisters) + header.nDMAs)
+					* sizeof(Entry)
+			+ static_cast<std::uint64_t>(header.nUnsupported)
+					* sizeof(StringRef);
+	if (records + header.stringsSize != file.size()
+			|| !isValid(header.path, header.stringsSize)
+			|| !isValid(header.signature, header.stringsSize)
+			|| !isValid(header.bitfileVersion, header.stringsSize)) {
+		return false;
+	}
+
+	const char *strings = file.data() + records;
+	if (toString(header.path, strings) != key.path
+			|| header.mtimeSec != key.mtimeSec
+			|| header.mtimeNsec != key.mtimeNsec || header.size != key.size) {
+		return false;
+	}
+	const std::string signature = toString(header.signature, strings);
+	std::string current;
+	if (!readSignature(key.path, &current) || current != signature) {
+		return false;
+	}
+
+	BitfileTables aux;
+	aux.signature = signature;
+	aux.baseAddress = header.baseAddress;
+	aux.bitfileVersion = toString(header.bitfileVersion, strings);
+
+	const char *record = file.data() + sizeof(Header);
+	aux.regMap.reserve(header.nRegisters);
+	for (std::uint32_t i = 0; i < header.nRegisters; ++i) {
+		const auto entry = readRecord<Entry>(record);
+		record += sizeof(Entry);
+		if (!isValid(entry, header.stringsSize)) {
+			return false;
+		}
+		aux.regMap.insert({ toString(entry.key, strings),
+				Register(toString(entry.name, strings),
+						static_cast<FpgaTypes>(entry.fpgaType),
+						static_cast<ElemTypes>(entry.elemType),
+						entry.address, entry.numElem) });
+	}
+	aux.dmaMap.reserve(header.nDMAs);
+	for (std::uint32_t i = 0; i < header.nDMAs; ++i) {
+		const auto entry = readRecord<Entry>(record);
+		record += sizeof(Entry);
+		if (!isValid(entry, header.stringsSize)) {
+			return false;
+		}
+		aux.dmaMap.insert({ toString(entry.key, strings),
+				DMA(toString(entry.name, strings),
+						static_cast<FpgaTypes>(entry.fpgaType),
+						static_cast<ElemTypes>(entry.elemType),
+						entry.address, entry.numElem) });
+	}
+	for (std::uint32_t i = 0; i < header.nUnsupported; ++i) {
+		const auto ref = readRecord<StringRef>(record);
+		record += sizeof(StringRef);
+		if (!isValid(ref, header.stringsSize)) {
+			return false;
+		}
+		aux.unsupported.push_back(toString(ref, strings));
+	}
+
+	*tables = std::move(aux);
+	return true;
+}
+
+bool BitfileCache::store(const Key &key, const BitfileTables &tables) const {
+	if (!isEnabled() || !makeDirs(m_dir) || !isPrivateDir(m_dir)) {
+		return false;
+	}
+
+	StringTable strings;
+	Header header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.formatVersion = FORMAT_VERSION;
+	header.nRegisters = static_cast<std::uint32_t>(tables.regMap.size());
+	header.nDMAs = static_cast<std::uint32_t>(tables.dmaMap.size());
+	header.nUnsupported = static_cast<std::uint32_t>(tables.unsupported.size());
+	header.mtimeSec = key.mtimeSec;
+	header.mtimeNsec = key.mtimeNsec;
+	header.size = key.size;
+	header.baseAddress = tables.baseAddress;
+	header.path = strings.add(key.path);
+	header.signature = strings.add(tables.signature);
+	header.bitfileVersion = strings.add(tables.bitfileVersion);
+
+	std::string records;
+	for (const auto &reg : tables.regMap) {
+		appendRecord(&records, makeEntry(reg.first, reg.second, &strings));
+	}
+	for (const auto &dma : tables.dmaMap) {
+		appendRecord(&records, makeEntry(dma.first, dma.second, &strings));
+	}
+	for (const auto &name : tables.unsupported) {
+		appendRecord(&records, strings.add(name));
+	}
+	header.stringsSize = static_cast<std::uint32_t>(strings.data().size());
+
+	std::string data;
+	appendRecord(&data, header);
+	data += records;
+	data += strings.data();
+
+	// Written aside and renamed, readers see the old entry or the new one
+	const std::string path = getEntryPath(key);
+	const std::string tmpPath = path + ".tmp." + std::to_string(::getpid());
+	const int fd = ::open(tmpPath.c_str(),
+			O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_NOFOLLOW, 0600);
+	if (fd < 0) {
+		return false;
+	}
+	const bool written = writeAll(fd, data);
+	if (::close(fd) != 0 || !written
+			|| ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		::unlink(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+std::string BitfileCache::getEntryPath(const Key &key) const {
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bfpc",
+			static_cast<unsigned long long>(fnv1a(key.path)));
+	return m_dir + "/" + name;
+}
+
+}  // namespace bfp
+}  // namespace irio
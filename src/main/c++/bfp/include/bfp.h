@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -9,12 +11,30 @@
 
 namespace irio {
 namespace bfp {
+
+/**
+ * How BFP reads the XML of a bitfile
+ *
+ * @ingroup BFP
+ */
+enum class ParseMode : std::uint8_t {
+	/// Whole document loaded and queried with XPath
+	Full,
+	/// Only the elements preceding the bitstream are read and parsed, and
+	/// the nodes are found walking the tree. Falls back to Full if any of
+	/// them is missing
+	Targeted
+};
+
 /**
  * BitFile Parser.
  *
  * Manages parsing a bitfile and extracting the Registers and DMAs on it.
  * It also extracts the signature and Bitfile version.
  *
+ * The result is kept in a BitfileCache, so constructing it again for the
+ * same version of a bitfile does not parse its XML.
+ *
  * @ingroup BFP
  */
 class BFP {
@@ -30,6 +50,22 @@ class BFP {
 	 */
 	explicit BFP(const std::string &bitfile, const bool warnUnsupported = true);
 
+	/**
+	 * Parse the specified bitfile, using a specific cache folder and parse mode
+	 *
+	 * @throw irio::errors::BFPParseBitfileError Unable to parse \p bitfile
+	 *
+	 * @param bitfile			Bitfile to parse
+	 * @param warnUnsupported	If true, a message will be printed by std::cerr
+	 * 							informing of the registers found with an unsupported type
+	 * @param cacheDir			Folder of the BitfileCache. Empty to always
+	 * 							parse the XML
+	 * @param mode				How to parse the XML on a cache miss
+	 */
+	BFP(const std::string &bitfile, const bool warnUnsupported,
+			const std::string &cacheDir,
+			const ParseMode mode = ParseMode::Targeted);
+
 	/**
 	 * Return the path of the parsed Bitfile
 	 * @return	Path of the parsed Bitfile
@@ -64,6 +100,16 @@ class BFP {
 	 */
 	Register getRegister(const std::string &registerName) const;
 
+	/**
+	 * Get specific register without throwing if not found. Use it when the
+	 * register is optional, as it is cheaper than catching the exception
+	 *
+	 * @param registerName	Register name to get
+	 * @return	Pointer to the register found, valid while the BFP exists.
+	 * 			nullptr if not found
+	 */
+	const Register* tryGetRegister(const std::string &registerName) const;
+
 	/**
 	 * Get map with all the DMAs parsed, the key if the DMA name (without spaces)
 	 *
@@ -81,7 +127,50 @@ class BFP {
 	 */
 	DMA getDMA(const std::string &dmaName) const;
 
+	/**
+	 * Get specific DMA without throwing if not found. Use it when the DMA is
+	 * optional, as it is cheaper than catching the exception
+	 *
+	 * @param dmaName	DMA name to get
+	 * @return	Pointer to the DMA found, valid while the BFP exists. nullptr
+	 * 			if not found
+	 */
+	const DMA* tryGetDMA(const std::string &dmaName) const;
+
+	/**
+	 * Get the registers following the enumeration naming convention
+	 * <prefix><n>, where n is a number written without leading zeros
+	 * (as std::to_string does). Uses an index built with the tables, so no
+	 * name is composed or looked up for the numbers not present
+	 *
+	 * @param prefix	Name of the registers without their number
+	 * @return	Map with the registers found, the key is their number
+	 */
+	std::map<std::uint32_t, Register> enumerateRegisters(
+			const std::string &prefix) const;
+
+	/**
+	 * Get the DMAs following the enumeration naming convention <prefix><n>,
+	 * where n is a number written without leading zeros
+	 *
+	 * @param prefix	Name of the DMAs without their number
+	 * @return	Map with the DMAs found, the key is their number
+	 */
+	std::map<std::uint32_t, DMA> enumerateDMAs(const std::string &prefix) const;
+
+	/**
+	 * Returns whether the tables were loaded from the cache instead of
+	 * parsing the XML
+	 *
+	 * @return True if loaded from the cache
+	 */
+	bool isFromCache() const;
+
  private:
+	/// For each prefix, number and name of the resources named <prefix><n>
+	using EnumIndex = std::unordered_map<std::string,
+			std::map<std::uint32_t, std::string>>;
+
 	/// Path to the bitfile to be parsed
 	const std::string m_bitfilePath;
 
@@ -96,6 +185,14 @@ class BFP {
 	std::unordered_map<std::string, Register> m_regMap;
 	/// Map storing the data of the DMAs parsed, using their names as keys
 	std::unordered_map<std::string, DMA> m_dmaMap;
+
+	/// Enumerated registers, see enumerateRegisters()
+	EnumIndex m_regEnumIndex;
+	/// Enumerated DMAs, see enumerateDMAs()
+	EnumIndex m_dmaEnumIndex;
+
+	/// Whether the tables were loaded from the cache
+	bool m_fromCache = false;
 };
 }  // namespace bfp
 }  // namespace irio
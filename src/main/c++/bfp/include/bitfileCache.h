@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "register.h"
+#include "dma.h"
+
+namespace irio {
+namespace bfp {
+
+/**
+ * @brief The environment variable name for specifying the bitfile cache path.
+ *
+ * If set, the parsed bitfiles are cached in that folder. If set to an empty
+ * string, the cache is disabled.
+ */
+constexpr char BFP_CACHE_PATH_ENV_VAR[] = "BFP_CACHE_IRIOCORE";
+
+/**
+ * @brief The folder of the bitfile cache inside the cache folder of the
+ * user, i.e. $XDG_CACHE_HOME or ~/.cache
+ */
+constexpr char DEFAULT_BFP_CACHE_SUBDIR[] = "irioCore";
+
+/**
+ * Information extracted from a bitfile
+ *
+ * @ingroup BFP
+ */
+struct BitfileTables {
+	std::string signature;		/**< Bitfile's signature */
+	std::uint32_t baseAddress = 0;	/**< Bitfile's base address */
+	std::string bitfileVersion;	/**< Bitfile's version */
+	/// Registers, using their names without spaces as keys
+	std::unordered_map<std::string, Register> regMap;
+	/// DMAs, using their names without spaces as keys
+	std::unordered_map<std::string, DMA> dmaMap;
+	/// Names of the registers skipped because of their type, in order
+	std::vector<std::string> unsupported;
+};
+
+/**
+ * On-disk cache of parsed bitfiles.
+ *
+ * Each bitfile is stored in its own file, named after its absolute path, in
+ * a compact binary format that is mmap'd on load. An entry is only valid
+ * if the path, size and modification time of the bitfile, and the
+ * SignatureRegister at its beginning, match the ones cached. Entries are
+ * written to a temporary file and renamed, so concurrent processes never
+ * read a partial entry.
+ *
+ * The folder is created only accessible by the current user. Entries are
+ * only loaded if both the folder and the entry are owned by the current
+ * user and not writable by others, so other users cannot plant entries
+ * with forged addresses.
+ *
+ * The cache is an optimization: any error reading or writing it is treated
+ * as a miss.
+ *
+ * @ingroup BFP
+ */
+class BitfileCache {
+ public:
+	/**
+	 * Identifies the version of a bitfile
+	 */
+	struct Key {
+		std::string path;			/**< Absolute path of the bitfile */
+		std::int64_t mtimeSec = 0;	/**< Modification time, seconds */
+		std::int64_t mtimeNsec = 0;	/**< Modification time, nanoseconds */
+		std::uint64_t size = 0;		/**< Size in bytes */
+	};
+
+	/**
+	 * Creates a cache stored in a folder, which is created when storing the
+	 * first entry
+	 *
+	 * @param dir Folder of the cache. Empty to disable the cache
+	 */
+	explicit BitfileCache(const std::string &dir);
+
+	/**
+	 * Returns the folder in #BFP_CACHE_PATH_ENV_VAR or, if not set,
+	 * #DEFAULT_BFP_CACHE_SUBDIR inside $XDG_CACHE_HOME or ~/.cache
+	 *
+	 * @return Default folder of the cache, empty if disabled or the home
+	 * 			folder is unknown
+	 */
+	static std::string getDefaultDir();
+
+	/**
+	 * Returns whether the cache has a folder
+	 *
+	 * @return True if enabled
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * Gets the key of the current version of a bitfile. Must be called
+	 * before parsing it, so a bitfile modified while being parsed is not
+	 * cached as the new version
+	 *
+	 * @param bitfile	Path of the bitfile
+	 * @param key		Key of \p bitfile
+	 * @return False if the bitfile cannot be accessed
+	 */
+	bool getKey(const std::string &bitfile, Key *key) const;
+
+	/**
+	 * Loads the entry of a bitfile
+	 *
+	 * @param key		Key of the bitfile
+	 * @param tables	Tables of the bitfile, only modified on a hit
+	 * @return True on a hit
+	 */
+	bool load(const Key &key, BitfileTables *tables) const;
+
+	/**
+	 * Stores the entry of a bitfile, replacing any previous one
+	 *
+	 * @param key		Key of the bitfile when it was parsed
+	 * @param tables	Tables of the bitfile
+	 * @return True if stored
+	 */
+	bool store(const Key &key, const BitfileTables &tables) const;
+
+	/**
+	 * Returns the path of the entry of a bitfile
+	 *
+	 * @param key Key of the bitfile
+	 * @return Path of the cache file
+	 */
+	std::string getEntryPath(const Key &key) const;
+
+ private:
+	/// Folder of the cache
+	const std::string m_dir;
+};
+
+}  // namespace bfp
+}  // namespace irio
@@ -233,6 +233,23 @@ typedef struct TResourcePort {
 	uint32_t value;     //!< If a resource has been found this register indicates its value
 }TResourcePort;
 
+/**
+ * Type for each of the reads done by irio_getDMAsTtoHostData()
+ *
+ * The caller fills the DMA, the number of blocks and the buffer. The call
+ * fills the blocks read and the status of the read.
+ *
+ * @ingroup IrioCoreCompatible
+ */
+typedef struct TDMARead {
+	int n;				//!< Number of the DMA where data should be read
+	int NBlocks;		//!< Number of data blocks to read
+	uint64_t *data;		//!< Previously allocated buffer where data read will be stored
+	int elementsRead;	//!< Number of blocks read. Can be 0 or NBlocks
+	TIRIOStatusCode code;	//!< Result of the read
+	TErrorDetailCode detailCode;  //!< Detail of the result when it is not a success
+} TDMARead;
+
 #define DEVICESERIALNUMBERLENGTH 20
 #define RIODEVICEMODELLENGTH 20
 #define FPGARIOLENGTH 15
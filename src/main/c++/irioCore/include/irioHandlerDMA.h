@@ -83,15 +83,15 @@ int irio_cleanDMAsTtoHost(irioDrv_t *p_DrvPvt, TStatus *status);
 /**
  * Clean DMA
  *
- * <b>Clean the data from specified (n) DMA</b>. Several read operations will be done over the selected DMA
- * using the given memory buffer. In order to work properly, DMA writing should be disabled
+ * <b>Clean the data from specified (n) DMA</b>. The pending elements are discarded in place, without
+ * copying them, so the given memory buffer is not used. In order to work properly, DMA writing should be disabled
  * calling irio_setDMATtoHostEnable to set DMATtoHostEnable terminal to false.
  * Errors may occur if the port was not found or while reading from the port.
  *
  * @param[in] p_DrvPvt 	Pointer to the driver session structure
  * @param[in] n Number of the DMA to clean
- * @param[in] cleanbuffer buffer to be used for DMA reads.
- * @param[in] buffersize size of the clean buffer.
+ * @param[in] cleanbuffer Unused, kept for compatibility.
+ * @param[in] buffersize Unused, kept for compatibility.
  * @param[out] status	Warning and error messages produced during the execution of this call will be added here.
  * @return \ref TIRIOStatusCode result of the execution of this call.
  *
@@ -235,6 +235,96 @@ int irio_getDMATtoHostData(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
 int irio_getDMATtoHostData_timeout(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
 		uint64_t *data, int *elementsRead, uint32_t timeout, TStatus *status);
 
+/**
+ * Reads data from several DMAs in a single call
+ *
+ * Does the reads of irio_getDMATtoHostData() for all the DMAs in \p reads,
+ * resolving the session and each DMA only once. If there are less blocks
+ * than requested in a DMA nothing is read from it. A failed read does not
+ * stop the others: its result is stored in TDMARead::code and
+ * TDMARead::detailCode, and its message is added to \p status. A failed
+ * NI-RIO call gives an IRIO_error, while timeouts and DMAs not found give
+ * warnings.
+ * Each DMA must appear at most once in \p reads.
+ *
+ * @param[in] p_DrvPvt 	Pointer to the driver session structure
+ * @param[in,out] reads Reads to do. Their elementsRead, code and detailCode are filled by the call
+ * @param[in] count Number of elements in \p reads
+ * @param[out] status Warning and error messages produced during the execution of this call will be added here.
+ * @return \ref TIRIOStatusCode result of the execution of this call. Success only if all the reads succeeded
+ *
+ * @ingroup IrioCoreCompatible
+ */
+int irio_getDMAsTtoHostData(const irioDrv_t *p_DrvPvt, TDMARead *reads,
+		size_t count, TStatus *status);
+
+/**
+ * Reads data from several DMAs in a single call using a timeout parameter
+ *
+ * As irio_getDMAsTtoHostData(), but each read waits until its blocks are
+ * available. The timeout applies to the whole call: the reads share the time
+ * left. A read whose blocks are not available in time reads nothing and
+ * gives a timeout warning.
+ *
+ * @param[in] p_DrvPvt 	Pointer to the driver session structure
+ * @param[in,out] reads Reads to do. Their elementsRead, code and detailCode are filled by the call
+ * @param[in] count Number of elements in \p reads
+ * @param[in] timeout Time in milliseconds to wait for all the reads, 0 to wait indefinitely
+ * @param[out] status Warning and error messages produced during the execution of this call will be added here.
+ * @return \ref TIRIOStatusCode result of the execution of this call. Success only if all the reads succeeded
+ *
+ * @ingroup IrioCoreCompatible
+ */
+int irio_getDMAsTtoHostData_timeout(const irioDrv_t *p_DrvPvt, TDMARead *reads,
+		size_t count, uint32_t timeout, TStatus *status);
+
+/**
+ * Acquires data from the DMA without copying it
+ *
+ * Acquires data blocks from the specified data DMA, waiting until they are available
+ * or the timeout expires. Instead of copying the data into a user buffer, pointers to the
+ * host DMA buffer are returned. If the data wraps around the end of the host buffer it is
+ * returned in two regions: \p data holds the oldest elements and \p dataWrap its
+ * continuation (\p dataWrapSize is 0 otherwise).
+ * The acquired elements must be returned to the FPGA with irio_releaseDMATtoHostData()
+ * once processed. If the timeout expires nothing is acquired and a warning is given.
+ * Errors may occur if one of the needed ports were not found or while reading from the ports.
+ *
+ * @param[in] p_DrvPvt 	Pointer to the driver session structure
+ * @param[in] NBlocks number of data blocks to acquire.
+ * @param[in] n Number of the DMA where data should be acquired
+ * @param[out] data Pointer to the first region of acquired elements
+ * @param[out] dataSize Number of elements in \p data
+ * @param[out] dataWrap Pointer to the second region of acquired elements
+ * @param[out] dataWrapSize Number of elements in \p dataWrap
+ * @param[in] timeout Time in milliseconds to wait for the data, 0 to wait indefinitely
+ * @param[out] status Warning and error messages produced during the execution of this call will be added here.
+ * @return \ref TIRIOStatusCode result of the execution of this call.
+ *
+ * @ingroup IrioCoreCompatible
+ */
+int irio_acquireDMATtoHostData(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
+		const uint64_t **data, size_t *dataSize, const uint64_t **dataWrap,
+		size_t *dataWrapSize, uint32_t timeout, TStatus *status);
+
+/**
+ * Releases data acquired from the DMA
+ *
+ * Returns to the FPGA the elements acquired with irio_acquireDMATtoHostData().
+ * The pointers obtained must not be used after this call.
+ * Errors may occur if one of the needed ports were not found or while writing to the ports.
+ *
+ * @param[in] p_DrvPvt 	Pointer to the driver session structure
+ * @param[in] n Number of the DMA where data was acquired
+ * @param[in] elements Number of elements to release (dataSize + dataWrapSize)
+ * @param[out] status Warning and error messages produced during the execution of this call will be added here.
+ * @return \ref TIRIOStatusCode result of the execution of this call.
+ *
+ * @ingroup IrioCoreCompatible
+ */
+int irio_releaseDMATtoHostData(const irioDrv_t *p_DrvPvt, int n,
+		size_t elements, TStatus *status);
+
 /**
  * Reads image from the DMA
  *
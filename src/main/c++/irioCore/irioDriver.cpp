@@ -6,6 +6,7 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <vector>
 
 #include "errorsIrio.h"
 #include "irioError.h"
@@ -179,31 +180,40 @@ void fillDMATtoHOST(const Irio *irio, irioDrv_t *p_DrvPvt) {
 	it.first->second.chIndex.reset(new std::uint16_t[maxDMA]);
 
 	const auto profile = irio->getProfileID();
+	const bool isIMAQ = profile == PROFILE_ID::FLEXRIO_CPUIMAQ ||
+						profile == PROFILE_ID::FLEXRIO_GPUIMAQ;
+	const auto termDMA = getTerminalsDMA(irio);
+	const auto nCh = termDMA.getAllNCh();
+	const auto frameTypes = termDMA.getAllFrameType();
+	const auto sampleSizes = termDMA.getAllSampleSizes();
+	const auto lengthBlocks = isIMAQ ? std::vector<std::uint16_t>()
+			: irio->getTerminalsDAQ().getAllLengthBlocks();
+
 	std::uint16_t chIndexAccum = 0;
 	for(std::uint16_t i = 0; i < maxDMA; ++i) {
-		try {
-			it.first->second.nch.get()[i] = getTerminalsDMA(irio).getNCh(i);
-			it.first->second.frameType.get()[i] = static_cast<std::uint8_t>(
-				getTerminalsDMA(irio).getFrameType(i));
-			it.first->second.sampleSize.get()[i] =
-				getTerminalsDMA(irio).getSampleSize(i);
-			if (profile == PROFILE_ID::FLEXRIO_CPUIMAQ ||
-				profile == PROFILE_ID::FLEXRIO_GPUIMAQ) {
-				it.first->second.blockNWords.get()[i] = 0;
-				it.first->second.chIndex.get()[i] = i;
-			} else {
-				it.first->second.blockNWords.get()[i] =
-					irio->getTerminalsDAQ().getLengthBlock(i);
-				it.first->second.chIndex.get()[i] = chIndexAccum;
-				chIndexAccum += it.first->second.nch.get()[i];
-			}
-			numCh++;
-		} catch (ResourceNotFoundError &) {
+		if (i >= nCh.size() || i >= frameTypes.size() ||
+				i >= sampleSizes.size() ||
+				(!isIMAQ && i >= lengthBlocks.size())) {
 			it.first->second.nch.get()[i] = 0;
 			it.first->second.frameType.get()[i] = 0;
 			it.first->second.sampleSize.get()[i] = 0;
 			it.first->second.blockNWords.get()[i] = 0;
+			continue;
+		}
+
+		it.first->second.nch.get()[i] = nCh[i];
+		it.first->second.frameType.get()[i] =
+			static_cast<std::uint8_t>(frameTypes[i]);
+		it.first->second.sampleSize.get()[i] = sampleSizes[i];
+		if (isIMAQ) {
+			it.first->second.blockNWords.get()[i] = 0;
+			it.first->second.chIndex.get()[i] = i;
+		} else {
+			it.first->second.blockNWords.get()[i] = lengthBlocks[i];
+			it.first->second.chIndex.get()[i] = chIndexAccum;
+			chIndexAccum += nCh[i];
 		}
+		numCh++;
 	}
 	p_DrvPvt->DMATtoHOSTNo.found = true;
 	p_DrvPvt->DMATtoHOSTNo.value = numCh;
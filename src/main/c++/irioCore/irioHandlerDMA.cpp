@@ -1,5 +1,7 @@
 #include "irioHandlerDMA.h"
 
+#include <vector>
+
 #include "irioError.h"
 #include "irioInstanceManager.h"
 #include "irioUtils.h"
@@ -162,12 +164,21 @@ size_t readData(const std::string &serialNumber, const std::uint32_t &session,
 	size_t elementsToRead = getElementsToRead(
 		term.getFrameType(dmaNum), NBlocks, term.getLengthBlock(dmaNum));
 
+	if (!block) {
+		// All or nothing, reusing the fill level of the previous read so
+		// the usual poll is a single driver call
+		return term.readAvailable(dmaNum, elementsToRead, data,
+								  elementsToRead) /
+			   lengthBlock;
+	}
 	return term.readData(dmaNum, elementsToRead, data, block, timeout) /
 		   lengthBlock;
 }
 
 int irio_getDMATtoHostData(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
 						   uint64_t *data, int *elementsRead, TStatus *status) {
+	// Nothing read unless the read succeeds
+	*elementsRead = 0;
 	const auto f = [n, NBlocks, data, elementsRead, p_DrvPvt] {
 		*elementsRead = static_cast<int>(readData(p_DrvPvt->DeviceSerialNumber,
 								 p_DrvPvt->session, n, NBlocks, data, false));
@@ -179,6 +190,8 @@ int irio_getDMATtoHostData(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
 int irio_getDMATtoHostData_timeout(const irioDrv_t *p_DrvPvt, int NBlocks,
 								   int n, uint64_t *data, int *elementsRead,
 								   uint32_t timeout, TStatus *status) {
+	// Nothing read unless the read succeeds
+	*elementsRead = 0;
 	const auto f = [n, NBlocks, data, timeout, elementsRead, p_DrvPvt] {
 		*elementsRead = static_cast<int>(readData(p_DrvPvt->DeviceSerialNumber,
 												  p_DrvPvt->session, n, NBlocks,
@@ -194,6 +207,146 @@ int irio_getDMATtoHostData_timeout(const irioDrv_t *p_DrvPvt, int NBlocks,
 	}
 }
 
+int readDataMulti(const irioDrv_t *p_DrvPvt, TDMARead *reads,
+				  const size_t count, const bool block,
+				  const std::uint32_t timeout, TStatus *status) {
+	// Reused by the calls of each thread, so reading does not allocate
+	thread_local std::vector<irio::DMAReadRequest> requests;
+	thread_local std::vector<irio::DMAReadResult> results;
+
+	// Block sizes read at irio_initDriver, 0 for DMAs not found
+	const auto lengthBlockOf = [p_DrvPvt](const int n) -> std::uint16_t {
+		return n >= 0 && n < p_DrvPvt->max_dmas
+				   ? p_DrvPvt->DMATtoHOSTBlockNWords[n]
+				   : 0;
+	};
+
+	const auto f = [p_DrvPvt, reads, count, block, timeout, &lengthBlockOf] {
+		const auto term =
+			getTerminalsDAQ(p_DrvPvt->DeviceSerialNumber, p_DrvPvt->session);
+		requests.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			const std::uint16_t lengthBlock = lengthBlockOf(reads[i].n);
+			requests[i].n = static_cast<std::uint32_t>(reads[i].n);
+			requests[i].data = reads[i].data;
+			// Not found DMAs read nothing and are reported by readDataMulti
+			requests[i].elements =
+				lengthBlock == 0
+					? 0
+					: getElementsToRead(
+						  static_cast<irio::FrameType>(
+							  p_DrvPvt->DMATtoHOSTFrameType[reads[i].n]),
+						  reads[i].NBlocks, lengthBlock);
+		}
+		term.readDataMulti(requests, &results, block, timeout);
+	};
+
+	int ret = getOperationGeneric(f, status, p_DrvPvt->verbosity);
+	if (ret != IRIO_success) {
+		return ret;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		TDMARead &read = reads[i];
+		const irio::DMAReadResult &result = results[i];
+		const std::uint16_t lengthBlock = lengthBlockOf(read.n);
+		read.elementsRead = 0;
+		read.code = IRIO_success;
+		read.detailCode = Success;
+		switch (result.status) {
+		case irio::DMAReadStatus::Success:
+			if (lengthBlock != 0) {
+				read.elementsRead =
+					static_cast<int>(result.elementsRead / lengthBlock);
+			}
+			break;
+		case irio::DMAReadStatus::NotEnough:
+			break;
+		case irio::DMAReadStatus::Timeout:
+			read.code = IRIO_warning;
+			read.detailCode = Read_NIRIO_Warning;
+			irio_mergeStatus(status, read.detailCode, p_DrvPvt->verbosity,
+							 "Timeout reading DMA %d", read.n);
+			break;
+		case irio::DMAReadStatus::NotFound:
+			read.code = IRIO_warning;
+			read.detailCode = Read_Resource_Warning;
+			irio_mergeStatus(status, read.detailCode, p_DrvPvt->verbosity,
+							 "%d is not a valid DMA", read.n);
+			break;
+		case irio::DMAReadStatus::Error:
+			read.code = IRIO_error;
+			read.detailCode = NIRIO_API_Error;
+			irio_mergeStatus(status, read.detailCode, p_DrvPvt->verbosity,
+							 "Error reading DMA %d(Code: %d)", read.n,
+							 result.fpgaStatus);
+			break;
+		}
+		if (read.code == IRIO_error ||
+			(read.code == IRIO_warning && ret == IRIO_success)) {
+			ret = read.code;
+		}
+	}
+
+	// A later warning must not hide an earlier error
+	status->code = static_cast<TIRIOStatusCode>(ret);
+	return ret;
+}
+
+int irio_getDMAsTtoHostData(const irioDrv_t *p_DrvPvt, TDMARead *reads,
+							size_t count, TStatus *status) {
+	return readDataMulti(p_DrvPvt, reads, count, false, 0, status);
+}
+
+int irio_getDMAsTtoHostData_timeout(const irioDrv_t *p_DrvPvt, TDMARead *reads,
+									size_t count, uint32_t timeout,
+									TStatus *status) {
+	return readDataMulti(p_DrvPvt, reads, count, true, timeout, status);
+}
+
+int irio_acquireDMATtoHostData(const irioDrv_t *p_DrvPvt, int NBlocks, int n,
+							   const uint64_t **data, size_t *dataSize,
+							   const uint64_t **dataWrap, size_t *dataWrapSize,
+							   uint32_t timeout, TStatus *status) {
+	// Nothing acquired unless the acquisition succeeds
+	*data = nullptr;
+	*dataSize = 0;
+	*dataWrap = nullptr;
+	*dataWrapSize = 0;
+	const auto f = [n, NBlocks, data, dataSize, dataWrap, dataWrapSize,
+					timeout, p_DrvPvt] {
+		const auto term =
+			getTerminalsDAQ(p_DrvPvt->DeviceSerialNumber, p_DrvPvt->session);
+		const size_t elements = getElementsToRead(
+			term.getFrameType(n), NBlocks, term.getLengthBlock(n));
+
+		const auto view = term.acquireData(n, elements, timeout);
+		*data = view.first;
+		*dataSize = view.firstSize;
+		*dataWrap = view.second;
+		*dataWrapSize = view.secondSize;
+	};
+
+	try {
+		return getOperationGeneric(f, status, p_DrvPvt->verbosity);
+	} catch (DMAReadTimeout &e) {
+		irio_mergeStatus(status, Read_NIRIO_Warning, p_DrvPvt->verbosity,
+						 e.what());
+		return IRIO_warning;
+	}
+}
+
+int irio_releaseDMATtoHostData(const irioDrv_t *p_DrvPvt, int n,
+							   size_t elements, TStatus *status) {
+	const auto f = [n, elements, p_DrvPvt] {
+		getTerminalsDMA(p_DrvPvt->DeviceSerialNumber, p_DrvPvt->session)
+			.releaseData(n, elements);
+	};
+
+	return operationGeneric<Read_Resource_Warning, Read_Resource_Warning,
+							ConfigDMA_Warning>(f, status, p_DrvPvt->verbosity);
+}
+
 int irio_getDMATtoHostImage(const irioDrv_t *p_DrvPvt, int imageSize, int n,
 							uint64_t *data, int *elementsRead,
 							TStatus *status) {
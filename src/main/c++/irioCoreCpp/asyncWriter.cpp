@@ -0,0 +1,380 @@
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <linux/version.h>
+
+// IORING_OP_WRITE and the opcode probe appeared in the 5.6 UAPI headers,
+// older headers only get the ThreadPoolWriter
+#if defined(__NR_io_uring_setup) && \
+	LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#define IRIO_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+#include "asyncWriter.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+#ifdef IRIO_IO_URING
+
+/**
+ * Writer on top of the io_uring system calls, without liburing.
+ *
+ * Only the thread using the writer touches the submission queue tail and
+ * the completion queue head, the kernel the other two indexes.
+ */
+class IoUringWriter: public AsyncWriter {
+ public:
+	/**
+	 * Sets up the rings
+	 *
+	 * @param fd	File to write
+	 * @param depth	Max writes in flight
+	 * @return The writer, or null if io_uring or IORING_OP_WRITE are not
+	 * 		   available
+	 */
+	static std::unique_ptr<AsyncWriter> create(const int fd,
+			const unsigned depth) {
+		std::unique_ptr<IoUringWriter> writer(new IoUringWriter(fd));
+		if (!writer->init(depth)) {
+			return nullptr;
+		}
+		return std::unique_ptr<AsyncWriter>(writer.release());
+	}
+
+	~IoUringWriter() {
+		if (m_sqes) {
+			munmap(m_sqes, m_sqesSize);
+		}
+		if (m_cqRing && m_cqRing != m_sqRing) {
+			munmap(m_cqRing, m_cqRingSize);
+		}
+		if (m_sqRing) {
+			munmap(m_sqRing, m_sqRingSize);
+		}
+		if (m_ringFd >= 0) {
+			close(m_ringFd);
+		}
+	}
+
+	void submit(const void *data, const size_t size,
+			const std::uint64_t offset, const std::uint64_t tag) override {
+		const unsigned tail = *m_sqTail;
+		if (tail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE)
+				>= m_sqEntries) {
+			flush();
+		}
+		const unsigned index = tail & *m_sqMask;
+		io_uring_sqe *sqe = &m_sqes[index];
+		std::memset(sqe, 0, sizeof(*sqe));
+		sqe->opcode = IORING_OP_WRITE;
+		sqe->fd = m_fd;
+		sqe->addr = reinterpret_cast<std::uint64_t>(data);
+		sqe->len = static_cast<std::uint32_t>(size);
+		sqe->off = offset;
+		sqe->user_data = tag;
+		m_sqArray[index] = index;
+		__atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+		++m_toSubmit;
+	}
+
+	void flush() override {
+		while (m_toSubmit > 0) {
+			const int ret = enter(m_toSubmit, 0, 0);
+			if (ret < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw errors::DMARecorderError(
+						std::string("Error submitting writes: ")
+								+ std::strerror(errno));
+			}
+			m_toSubmit -= static_cast<unsigned>(ret);
+		}
+	}
+
+	size_t reap(Completion *completions, const size_t max,
+			const size_t min) override {
+		size_t count = 0;
+		while (true) {
+			unsigned head = *m_cqHead;
+			const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+			for (; head != tail && count < max; ++head, ++count) {
+				const io_uring_cqe &cqe = m_cqes[head & *m_cqMask];
+				completions[count].tag = cqe.user_data;
+				completions[count].result = cqe.res;
+			}
+			__atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+			if (count >= min || count == max) {
+				return count;
+			}
+			const int ret = enter(0, static_cast<unsigned>(min - count),
+					IORING_ENTER_GETEVENTS);
+			if (ret < 0 && errno != EINTR) {
+				throw errors::DMARecorderError(
+						std::string("Error waiting for writes: ")
+								+ std::strerror(errno));
+			}
+		}
+	}
+
+	std::string getName() const override {
+		return "io_uring";
+	}
+
+ private:
+	explicit IoUringWriter(const int fd): m_fd(fd) {
+	}
+
+	bool init(const unsigned depth) {
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, depth,
+				&params));
+		if (m_ringFd < 0 || !supportsWrite()) {
+			return false;
+		}
+
+		m_sqRingSize = params.sq_off.array
+				+ params.sq_entries * sizeof(unsigned);
+		m_cqRingSize = params.cq_off.cqes
+				+ params.cq_entries * sizeof(io_uring_cqe);
+		const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (singleMmap) {
+			m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize,
+					m_cqRingSize);
+		}
+
+		m_sqRing = map(m_sqRingSize, IORING_OFF_SQ_RING);
+		if (!m_sqRing) {
+			return false;
+		}
+		m_cqRing = singleMmap ? m_sqRing :
+				map(m_cqRingSize, IORING_OFF_CQ_RING);
+		if (!m_cqRing) {
+			return false;
+		}
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		m_sqes = static_cast<io_uring_sqe*>(map(m_sqesSize,
+				IORING_OFF_SQES));
+		if (!m_sqes) {
+			return false;
+		}
+
+		char *sq = static_cast<char*>(m_sqRing);
+		m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		m_sqEntries = params.sq_entries;
+
+		char *cq = static_cast<char*>(m_cqRing);
+		m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+		return true;
+	}
+
+	bool supportsWrite() const {
+		// Header plus one entry per operation up to IORING_OP_WRITE
+		const size_t ops = IORING_OP_WRITE + 1;
+		std::vector<char> buffer(sizeof(io_uring_probe)
+				+ ops * sizeof(io_uring_probe_op), 0);
+		io_uring_probe *probe = reinterpret_cast<io_uring_probe*>(
+				buffer.data());
+		if (syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PROBE,
+				probe, ops) < 0) {
+			return false;
+		}
+		return probe->ops_len > IORING_OP_WRITE
+				&& (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+	}
+
+	void* map(const size_t size, const std::uint64_t offset) const {
+		void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, m_ringFd,
+				static_cast<off_t>(offset));
+		return ptr == MAP_FAILED ? nullptr : ptr;
+	}
+
+	int enter(const unsigned toSubmit, const unsigned minComplete,
+			const unsigned flags) const {
+		return static_cast<int>(syscall(__NR_io_uring_enter, m_ringFd,
+				toSubmit, minComplete, flags, nullptr, 0));
+	}
+
+	const int m_fd;
+	int m_ringFd = -1;
+
+	void *m_sqRing = nullptr;
+	size_t m_sqRingSize = 0;
+	void *m_cqRing = nullptr;
+	size_t m_cqRingSize = 0;
+	io_uring_sqe *m_sqes = nullptr;
+	size_t m_sqesSize = 0;
+
+	unsigned *m_sqHead = nullptr;
+	unsigned *m_sqTail = nullptr;
+	unsigned *m_sqMask = nullptr;
+	unsigned *m_sqArray = nullptr;
+	unsigned m_sqEntries = 0;
+	unsigned *m_cqHead = nullptr;
+	unsigned *m_cqTail = nullptr;
+	unsigned *m_cqMask = nullptr;
+	io_uring_cqe *m_cqes = nullptr;
+
+	/// Entries queued in the submission ring not handed to the kernel yet
+	unsigned m_toSubmit = 0;
+};
+
+#endif  // IRIO_IO_URING
+
+/**
+ * Writer with a pool of threads calling pwrite()
+ */
+class ThreadPoolWriter: public AsyncWriter {
+ public:
+	ThreadPoolWriter(const int fd, const unsigned depth,
+			const unsigned threads) :
+			m_fd(fd), m_jobs(depth), m_completions(depth) {
+		for (unsigned i = 0; i < threads; ++i) {
+			m_threads.emplace_back(&ThreadPoolWriter::workerLoop, this);
+		}
+	}
+
+	~ThreadPoolWriter() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_jobReady.notify_all();
+		for (auto &thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	void submit(const void *data, const size_t size,
+			const std::uint64_t offset, const std::uint64_t tag) override {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_jobsTail - m_jobsHead >= m_jobs.size()) {
+				throw errors::DMARecorderError(
+						"More writes in flight than the writer depth");
+			}
+			m_jobs[m_jobsTail++ % m_jobs.size()] = {data, size, offset, tag};
+		}
+		m_jobReady.notify_one();
+	}
+
+	void flush() override {
+		// The workers take the writes as soon as they are submitted
+	}
+
+	size_t reap(Completion *completions, const size_t max,
+			const size_t min) override {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_completionReady.wait(lock, [this, min] {
+			return m_completionsTail - m_completionsHead >= min;
+		});
+		size_t count = 0;
+		while (count < max && m_completionsHead != m_completionsTail) {
+			completions[count++] =
+					m_completions[m_completionsHead++ % m_completions.size()];
+		}
+		return count;
+	}
+
+	std::string getName() const override {
+		return "threads";
+	}
+
+ private:
+	struct Job {
+		const void *data;
+		size_t size;
+		std::uint64_t offset;
+		std::uint64_t tag;
+	};
+
+	void workerLoop() {
+		while (true) {
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobReady.wait(lock, [this] {
+					return m_stop || m_jobsHead != m_jobsTail;
+				});
+				if (m_jobsHead == m_jobsTail) {
+					return;
+				}
+				job = m_jobs[m_jobsHead++ % m_jobs.size()];
+			}
+
+			ssize_t ret;
+			do {
+				ret = pwrite(m_fd, job.data, job.size,
+						static_cast<off_t>(job.offset));
+			} while (ret < 0 && errno == EINTR);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_completions[m_completionsTail++ % m_completions.size()] =
+						{job.tag, ret < 0 ? -errno : ret};
+			}
+			m_completionReady.notify_one();
+		}
+	}
+
+	const int m_fd;
+
+	/// Protects the queues and m_stop
+	std::mutex m_mutex;
+	std::condition_variable m_jobReady;
+	std::condition_variable m_completionReady;
+	std::vector<Job> m_jobs;
+	size_t m_jobsHead = 0;
+	size_t m_jobsTail = 0;
+	std::vector<Completion> m_completions;
+	size_t m_completionsHead = 0;
+	size_t m_completionsTail = 0;
+	bool m_stop = false;
+
+	std::vector<std::thread> m_threads;
+};
+
+}  // namespace
+
+std::unique_ptr<AsyncWriter> makeAsyncWriter(const int fd,
+		const unsigned depth, const unsigned threads, const bool useIoUring) {
+	if (depth == 0) {
+		throw errors::DMARecorderError("Writer depth must be at least 1");
+	}
+#ifdef IRIO_IO_URING
+	if (useIoUring) {
+		auto writer = IoUringWriter::create(fd, depth);
+		if (writer) {
+			return writer;
+		}
+	}
+#else
+	static_cast<void>(useIoUring);
+#endif
+	return std::unique_ptr<AsyncWriter>(new ThreadPoolWriter(fd, depth,
+			threads == 0 ? 1 : threads));
+}
+
+}  // namespace irio
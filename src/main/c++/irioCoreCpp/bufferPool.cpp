@@ -0,0 +1,250 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "bufferPool.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+/// Policy of mbind() that prefers a node but falls back to others when it
+/// runs out of memory. Defined here to not depend on libnuma
+const int MPOL_PREFERRED_NODE = 1;
+/// Nodes that fit in the mask passed to mbind()
+const size_t MAX_NUMA_NODES = 1024;
+
+size_t roundUp(const size_t value, const size_t multiple) {
+	return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t getPageSize() {
+	const long size = sysconf(_SC_PAGESIZE);
+	return size > 0 ? static_cast<size_t>(size) : 4096;
+}
+
+/**
+ * Returns the default huge page size of the system, 2 MiB if unknown
+ */
+size_t getHugePageSize() {
+	std::ifstream meminfo("/proc/meminfo");
+	std::string key;
+	size_t kB = 0;
+	while (meminfo >> key) {
+		if (key == "Hugepagesize:" && meminfo >> kB) {
+			return kB * 1024;
+		}
+		meminfo.ignore(256, '\n');
+	}
+	return 2 * 1024 * 1024;
+}
+
+std::string errnoString() {
+	return std::strerror(errno);
+}
+
+/**
+ * Maps \p bytes of anonymous memory starting at a multiple of \p alignment
+ */
+void* mapAligned(const size_t bytes, const size_t alignment) {
+	const size_t padded = bytes + alignment;
+	void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED) {
+		return nullptr;
+	}
+
+	const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+	const std::uintptr_t aligned = roundUp(start, alignment);
+	const size_t head = aligned - start;
+	const size_t tail = padded - head - bytes;
+	if (head > 0) {
+		munmap(raw, head);
+	}
+	if (tail > 0) {
+		munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+	}
+	return reinterpret_cast<void*>(aligned);
+}
+
+}  // namespace
+
+BufferPool::BufferPool(const size_t bufferElements,
+		const BufferPoolConfig &config) :
+		m_bufferElements(bufferElements),
+		m_stride(roundUp(std::max<size_t>(bufferElements, 1)
+				* sizeof(std::uint64_t), getPageSize())),
+		m_buffers(config.buffers) {
+	if (m_bufferElements == 0 || m_buffers == 0) {
+		throw errors::BufferPoolError("Buffer pool without elements");
+	}
+
+	allocate(config);
+
+	m_free.reserve(m_buffers);
+	for (size_t i = m_buffers; i > 0; --i) {
+		m_free.push_back(i - 1);
+	}
+	m_inUse.assign(m_buffers, false);
+}
+
+BufferPool::BufferPool(const TerminalsDMADAQ &daq, const std::uint32_t n,
+		const size_t blocks, const BufferPoolConfig &config) :
+		BufferPool(daq.getElementsPerBlock(n) * blocks, config) {
+}
+
+BufferPool::BufferPool(const TerminalsDMAIMAQ &imaq, const std::uint32_t n,
+		const size_t imagePixelSize, const size_t images,
+		const BufferPoolConfig &config) :
+		BufferPool((imagePixelSize * imaq.getSampleSize(n)
+				+ sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) * images,
+				config) {
+}
+
+BufferPool::~BufferPool() {
+	if (m_locked) {
+		munlock(m_memory, m_mappedBytes);
+	}
+	munmap(m_memory, m_mappedBytes);
+}
+
+void BufferPool::allocate(const BufferPoolConfig &config) {
+	const size_t bytes = m_stride * m_buffers;
+	const size_t hugePageSize = getHugePageSize();
+
+	PageBacking backing = config.pages;
+	if (backing == PageBacking::HugeTLB) {
+		m_mappedBytes = roundUp(bytes, hugePageSize);
+		m_memory = mmap(nullptr, m_mappedBytes, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (m_memory == MAP_FAILED) {
+			m_memory = nullptr;
+			if (!config.fallback) {
+				throw errors::BufferPoolError(
+						"Unable to map " + std::to_string(m_mappedBytes)
+								+ " bytes of huge pages: " + errnoString());
+			}
+			backing = PageBacking::Transparent;
+		}
+	}
+
+	if (backing != PageBacking::HugeTLB) {
+		// Aligned to the huge page size so the kernel can merge the pages
+		const size_t alignment = backing == PageBacking::Transparent ?
+				hugePageSize : getPageSize();
+		m_mappedBytes = roundUp(bytes, alignment);
+		m_memory = mapAligned(m_mappedBytes, alignment);
+		if (!m_memory) {
+			throw errors::BufferPoolError(
+					"Unable to map " + std::to_string(m_mappedBytes)
+							+ " bytes: " + errnoString());
+		}
+		if (backing == PageBacking::Transparent
+				&& madvise(m_memory, m_mappedBytes, MADV_HUGEPAGE) != 0) {
+			backing = PageBacking::Normal;
+		}
+	}
+	m_backing = backing;
+
+	// The policy must be set before the pages are touched
+	if (config.numaNode >= 0
+			&& static_cast<size_t>(config.numaNode) < MAX_NUMA_NODES) {
+		const size_t bitsPerWord = 8 * sizeof(unsigned long);
+		unsigned long mask[MAX_NUMA_NODES / bitsPerWord] = {};
+		mask[config.numaNode / bitsPerWord] |=
+				1UL << (config.numaNode % bitsPerWord);
+		m_numaBound = syscall(SYS_mbind, m_memory, m_mappedBytes,
+				MPOL_PREFERRED_NODE, mask, MAX_NUMA_NODES, 0) == 0;
+	}
+
+	if (config.lockMemory) {
+		m_locked = mlock(m_memory, m_mappedBytes) == 0;
+		if (!m_locked && !config.lockOptional) {
+			const std::string err = errnoString();
+			munmap(m_memory, m_mappedBytes);
+			throw errors::BufferPoolError(
+					"Unable to lock " + std::to_string(m_mappedBytes)
+							+ " bytes in memory: " + err);
+		}
+	}
+
+	// Fault every page in now instead of in the first reads
+	std::memset(m_memory, 0, m_mappedBytes);
+}
+
+std::uint64_t* BufferPool::acquire() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_free.empty()) {
+		return nullptr;
+	}
+	const size_t index = m_free.back();
+	m_free.pop_back();
+	m_inUse[index] = true;
+	return getBuffer(index);
+}
+
+void BufferPool::release(std::uint64_t *buffer) {
+	const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_memory);
+	const std::uintptr_t ptr = reinterpret_cast<std::uintptr_t>(buffer);
+	const size_t offset = static_cast<size_t>(ptr - base);
+	if (ptr < base || offset >= m_stride * m_buffers
+			|| offset % m_stride != 0) {
+		throw errors::BufferPoolError("Buffer does not belong to the pool");
+	}
+
+	const size_t index = offset / m_stride;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_inUse[index]) {
+		throw errors::BufferPoolError(
+				"Buffer " + std::to_string(index) + " is already free");
+	}
+	m_inUse[index] = false;
+	m_free.push_back(index);
+}
+
+std::uint64_t* BufferPool::getBuffer(const size_t index) const {
+	if (index >= m_buffers) {
+		throw errors::BufferPoolError(
+				std::to_string(index) + " is not a valid buffer");
+	}
+	return reinterpret_cast<std::uint64_t*>(
+			static_cast<char*>(m_memory) + index * m_stride);
+}
+
+size_t BufferPool::getBufferElements() const {
+	return m_bufferElements;
+}
+
+size_t BufferPool::getBufferStride() const {
+	return m_stride;
+}
+
+size_t BufferPool::countBuffers() const {
+	return m_buffers;
+}
+
+size_t BufferPool::countFree() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_free.size();
+}
+
+PageBacking BufferPool::getPageBacking() const {
+	return m_backing;
+}
+
+bool BufferPool::isLocked() const {
+	return m_locked;
+}
+
+bool BufferPool::isNumaBound() const {
+	return m_numaBound;
+}
+
+}  // namespace irio
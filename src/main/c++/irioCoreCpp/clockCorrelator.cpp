@@ -0,0 +1,198 @@
+#include <time.h>
+
+#include <cmath>
+#include <string>
+
+#include "clockCorrelator.h"
+#include "daqBlockView.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+// FormatB block: word 0 header, word 1 timestamp, then lengthBlock sample
+// words (see DAQFrameTraits<FrameType::FormatB>)
+const size_t TIMESTAMP_WORD = 1;
+const size_t HEADER_WORDS = DAQFrameTraits<FrameType::FormatB>::headerWords;
+
+std::uint32_t checkFref(const std::uint32_t fref) {
+	if (fref == 0) {
+		throw errors::ClockCorrelationError(
+				"Reference clock of the FPGA timestamps is 0 Hz");
+	}
+	return fref;
+}
+
+/**
+ * Signed ticks from \p ref to \p tick, also across a counter wrap
+ */
+double ticksSince(const std::uint64_t tick, const std::uint64_t ref) {
+	return static_cast<double>(static_cast<std::int64_t>(tick - ref));
+}
+
+}  // namespace
+
+ClockCorrelator::ClockCorrelator(const std::uint32_t fref,
+		const ClockCorrelatorConfig &config) :
+		m_fref(checkFref(fref)), m_config(config),
+		m_nominalNsPerTick(1e9 / fref) {
+	if (m_config.window == 0) {
+		throw errors::ClockCorrelationError("Correlation window without pairs");
+	}
+	m_samples.reserve(m_config.window);
+	m_fit.nsPerTick = m_nominalNsPerTick;
+}
+
+ClockCorrelator::ClockCorrelator(const TerminalsCommon &common,
+		const ClockCorrelatorConfig &config) :
+		ClockCorrelator(common.getFref(), config) {
+}
+
+std::int64_t ClockCorrelator::now(const HostClock clock) {
+	timespec ts;
+	clock_gettime(clock == HostClock::TAI ? CLOCK_TAI : CLOCK_REALTIME, &ts);
+	return static_cast<std::int64_t>(ts.tv_sec) * 1000000000
+			+ ts.tv_nsec;
+}
+
+void ClockCorrelator::addSample(const std::uint64_t tick,
+		const std::int64_t hostNs) {
+	const Sample sample{tick, hostNs - m_config.latencyNs};
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_samples.size() < m_config.window) {
+		m_samples.push_back(sample);
+	} else {
+		m_samples[m_next] = sample;
+		m_next = (m_next + 1) % m_config.window;
+	}
+	fit();
+}
+
+void ClockCorrelator::sample(const std::uint64_t tick) {
+	addSample(tick, now(m_config.clock));
+}
+
+void ClockCorrelator::reset() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_samples.clear();
+	m_next = 0;
+	m_fit = ClockFit();
+	m_fit.nsPerTick = m_nominalNsPerTick;
+}
+
+void ClockCorrelator::fit() {
+	// Relative to the oldest pair, so the sums keep their precision
+	const Sample &ref = m_samples[m_next];
+	const double count = static_cast<double>(m_samples.size());
+
+	double meanX = 0, meanY = 0;
+	for (const auto &s : m_samples) {
+		meanX += ticksSince(s.tick, ref.tick);
+		meanY += static_cast<double>(s.hostNs - ref.hostNs);
+	}
+	meanX /= count;
+	meanY /= count;
+
+	double sxx = 0, sxy = 0;
+	for (const auto &s : m_samples) {
+		const double dx = ticksSince(s.tick, ref.tick) - meanX;
+		const double dy = static_cast<double>(s.hostNs - ref.hostNs) - meanY;
+		sxx += dx * dx;
+		sxy += dx * dy;
+	}
+
+	// A single pair, or pairs of the same tick, only give the offset
+	const double slope = sxx > 0 ? sxy / sxx : m_nominalNsPerTick;
+	const double offset = meanY - slope * meanX;
+
+	double squares = 0;
+	for (const auto &s : m_samples) {
+		const double err = static_cast<double>(s.hostNs - ref.hostNs)
+				- (offset + slope * ticksSince(s.tick, ref.tick));
+		squares += err * err;
+	}
+
+	m_fit.tickRef = ref.tick;
+	m_fit.hostRef = ref.hostNs;
+	m_fit.offsetNs = offset;
+	m_fit.nsPerTick = slope;
+	m_fit.residualNs = std::sqrt(squares / count);
+	m_fit.samples = m_samples.size();
+}
+
+bool ClockCorrelator::isValid() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return !m_samples.empty();
+}
+
+std::int64_t ClockCorrelator::toHostUnlocked(const std::uint64_t tick) const {
+	if (m_samples.empty()) {
+		throw errors::ClockCorrelationError(
+				"No FPGA tick has been paired with the host clock yet");
+	}
+	return m_fit.hostRef + std::llround(m_fit.offsetNs
+			+ m_fit.nsPerTick * ticksSince(tick, m_fit.tickRef));
+}
+
+std::int64_t ClockCorrelator::toHost(const std::uint64_t tick) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return toHostUnlocked(tick);
+}
+
+ClockFit ClockCorrelator::getFit() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_fit;
+}
+
+double ClockCorrelator::getDriftPpm() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_samples.size() < 2) {
+		return 0;
+	}
+	return (m_fit.nsPerTick / m_nominalNsPerTick - 1) * 1e6;
+}
+
+std::uint32_t ClockCorrelator::getFref() const {
+	return m_fref;
+}
+
+size_t ClockCorrelator::stampBlocks(const std::uint64_t *data,
+		const size_t elements, const size_t lengthBlock,
+		std::int64_t *hostNs) const {
+	const size_t words = HEADER_WORDS + lengthBlock;
+	const size_t blocks = elements / words;
+
+	// The same fit for the whole buffer
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t i = 0; i < blocks; ++i) {
+		hostNs[i] = toHostUnlocked(data[i * words + TIMESTAMP_WORD]);
+	}
+	return blocks;
+}
+
+size_t ClockCorrelator::readBlocks(const TerminalsDMADAQ &daq,
+		const std::uint32_t n, const size_t blocks, std::uint64_t *data,
+		std::int64_t *hostNs, const std::uint32_t timeout) {
+	if (daq.getFrameType(n) != FrameType::FormatB) {
+		throw errors::DAQFormatMismatchError(
+				"DMA " + std::to_string(n)
+						+ " blocks do not carry timestamps (not FormatB)");
+	}
+	if (blocks == 0) {
+		return 0;
+	}
+
+	const size_t words = daq.getElementsPerBlock(n);
+	daq.readDataBlocking(n, blocks * words, data, timeout);
+	const std::int64_t completed = now(m_config.clock);
+	// With a backlog the read returns blocks that waited in the FIFO for an
+	// unknown time, so only a drained FIFO gives a usable pair
+	if (daq.getElementsAvailable(n) < words) {
+		addSample(data[(blocks - 1) * words + TIMESTAMP_WORD], completed);
+	}
+
+	return stampBlocks(data, blocks * words, daq.getLengthBlock(n), hostNs);
+}
+
+}  // namespace irio
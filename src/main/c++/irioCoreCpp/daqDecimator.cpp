@@ -0,0 +1,426 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IRIO_DECIMATOR_X86
+#endif
+
+#include <algorithm>
+#include <string>
+
+#include "daqDecimator.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+std::int64_t sumScalar(const std::int32_t *x, const size_t count) {
+	std::int64_t sum = 0;
+	for (size_t i = 0; i < count; ++i) {
+		sum += x[i];
+	}
+	return sum;
+}
+
+float dotScalar(const float *a, const float *b, const size_t count) {
+	float sum = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		sum += a[i] * b[i];
+	}
+	return sum;
+}
+
+#ifdef IRIO_DECIMATOR_X86
+
+///////////////////////////////////////////////////////////////
+///// AVX2 kernels
+///////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+std::int64_t sumAVX2(const std::int32_t *x, const size_t count) {
+	__m256i acc = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i v = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(x + i));
+		acc = _mm256_add_epi64(acc,
+				_mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+		acc = _mm256_add_epi64(acc,
+				_mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+	}
+	alignas(32) std::int64_t lanes[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+			+ sumScalar(x + i, count - i);
+}
+
+__attribute__((target("avx2")))
+float dotAVX2(const float *a, const float *b, const size_t count) {
+	__m256 acc = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i),
+				_mm256_loadu_ps(b + i)));
+	}
+	alignas(32) float lanes[8];
+	_mm256_store_ps(lanes, acc);
+	float sum = 0.0f;
+	for (const float lane : lanes) {
+		sum += lane;
+	}
+	return sum + dotScalar(a + i, b + i, count - i);
+}
+
+///////////////////////////////////////////////////////////////
+///// AVX-512 kernels
+///////////////////////////////////////////////////////////////
+// The unmasked conversions and the reduce intrinsics start from an undefined
+// vector, which GCC reports as uninitialized. Masked forms are used instead
+// and the lanes are reduced through memory, as in the AVX2 kernels
+constexpr __mmask8 ALL_LANES = 0xFF;
+
+__attribute__((target("avx512f")))
+std::int64_t sumAVX512(const std::int32_t *x, const size_t count) {
+	__m512i acc = _mm512_setzero_si512();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		acc = _mm512_add_epi64(acc, _mm512_maskz_cvtepi32_epi64(ALL_LANES,
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i))));
+	}
+	alignas(64) std::int64_t lanes[8];
+	_mm512_store_si512(lanes, acc);
+	std::int64_t total = 0;
+	for (const std::int64_t lane : lanes) {
+		total += lane;
+	}
+	return total + sumScalar(x + i, count - i);
+}
+
+__attribute__((target("avx512f")))
+float dotAVX512(const float *a, const float *b, const size_t count) {
+	__m512 acc = _mm512_setzero_ps();
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		acc = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+				acc);
+	}
+	alignas(64) float lanes[16];
+	_mm512_store_ps(lanes, acc);
+	float sum = 0.0f;
+	for (const float lane : lanes) {
+		sum += lane;
+	}
+	return sum + dotScalar(a + i, b + i, count - i);
+}
+
+#endif  // IRIO_DECIMATOR_X86
+
+std::int64_t sum(const std::int32_t *x, const size_t count,
+		const demux::SimdLevel level) {
+#ifdef IRIO_DECIMATOR_X86
+	if (level == demux::SimdLevel::AVX512) {
+		return sumAVX512(x, count);
+	}
+	if (level == demux::SimdLevel::AVX2) {
+		return sumAVX2(x, count);
+	}
+#else
+	static_cast<void>(level);
+#endif
+	return sumScalar(x, count);
+}
+
+float dot(const float *a, const float *b, const size_t count,
+		const demux::SimdLevel level) {
+#ifdef IRIO_DECIMATOR_X86
+	if (level == demux::SimdLevel::AVX512) {
+		return dotAVX512(a, b, count);
+	}
+	if (level == demux::SimdLevel::AVX2) {
+		return dotAVX2(a, b, count);
+	}
+#else
+	static_cast<void>(level);
+#endif
+	return dotScalar(a, b, count);
+}
+
+/// Bits needed to represent values up to \p value
+unsigned bitsOf(size_t value) {
+	unsigned bits = 0;
+	while (value > 0) {
+		++bits;
+		value >>= 1;
+	}
+	return bits;
+}
+
+demux::DemuxLayout checkLayout(const demux::DemuxLayout &layout) {
+	if (layout.sampleSize != 1 && layout.sampleSize != 2
+			&& layout.sampleSize != 4) {
+		throw errors::DAQFormatMismatchError("Samples of "
+				+ std::to_string(layout.sampleSize)
+				+ " bytes cannot be decimated");
+	}
+	if (layout.nCh == 0) {
+		throw errors::DAQFormatMismatchError("Layout without channels");
+	}
+	return layout;
+}
+
+void checkConfig(const DecimatorOutputConfig &config, const size_t output,
+		const std::uint8_t sampleSize) {
+	const std::string name = "Output " + std::to_string(output);
+	if (config.factor == 0) {
+		throw errors::DecimatorConfigError(name + ": factor must be >= 1");
+	}
+	switch (config.filter) {
+	case DecimationFilter::BoxCar:
+		break;
+	case DecimationFilter::CIC:
+		if (config.cicStages == 0
+				|| config.cicStages > DAQDecimator::MAX_CIC_STAGES) {
+			throw errors::DecimatorConfigError(name + ": CIC stages must be "
+					"between 1 and "
+					+ std::to_string(DAQDecimator::MAX_CIC_STAGES));
+		}
+		// The output of the CIC must fit in its integer state
+		if (8u * sampleSize + config.cicStages * bitsOf(config.factor - 1)
+				> 63) {
+			throw errors::DecimatorConfigError(name + ": CIC of "
+					+ std::to_string(config.cicStages) + " stages and factor "
+					+ std::to_string(config.factor) + " overflows with samples "
+					"of " + std::to_string(sampleSize) + " bytes");
+		}
+		break;
+	case DecimationFilter::FIR:
+		if (config.taps.empty()) {
+			throw errors::DecimatorConfigError(name + ": FIR without taps");
+		}
+		break;
+	default:
+		throw errors::DecimatorConfigError(name + ": unknown filter");
+	}
+}
+
+}  // namespace
+
+DAQDecimator::DAQDecimator(const demux::DemuxLayout &layout,
+		const std::vector<DecimatorOutputConfig> &outputs) :
+		m_layout(checkLayout(layout)) {
+	if (outputs.empty()) {
+		throw errors::DecimatorConfigError("No outputs configured");
+	}
+
+	m_outputs.resize(outputs.size());
+	for (size_t o = 0; o < outputs.size(); ++o) {
+		checkConfig(outputs[o], o, m_layout.sampleSize);
+		Output &out = m_outputs[o];
+		out.config = outputs[o];
+		out.reversedTaps.assign(out.config.taps.rbegin(),
+				out.config.taps.rend());
+		out.channels.resize(m_layout.nCh);
+		out.samples.resize(m_layout.nCh);
+		out.pointers.resize(m_layout.nCh);
+	}
+
+	const size_t perChannel = m_layout.samplesPerChannel();
+	m_scratch.resize(perChannel * m_layout.nCh);
+	for (size_t ch = 0; ch < m_layout.nCh; ++ch) {
+		m_scratchChannels.push_back(m_scratch.data() + ch * perChannel);
+	}
+	reset();
+}
+
+DAQDecimator::DAQDecimator(const TerminalsDMADAQ &daq, const std::uint32_t n,
+		const std::vector<DecimatorOutputConfig> &outputs) :
+		DAQDecimator(demux::getDemuxLayout(daq, n), outputs) {
+}
+
+void DAQDecimator::setCallback(const Callback &callback) {
+	m_callback = callback;
+}
+
+void DAQDecimator::process(const std::uint64_t *data, const size_t nBlocks) {
+	const demux::SimdLevel level = demux::getSimdLevel();
+	const size_t count = m_layout.samplesPerChannel();
+	for (auto &out : m_outputs) {
+		for (auto &samples : out.samples) {
+			samples.clear();
+		}
+	}
+
+	for (size_t b = 0; b < nBlocks; ++b) {
+		demux::demux(m_layout, data + b * m_layout.blockWords(), 1,
+				m_scratchChannels.data());
+		for (auto &out : m_outputs) {
+			for (size_t ch = 0; ch < m_layout.nCh; ++ch) {
+				switch (out.config.filter) {
+				case DecimationFilter::BoxCar:
+					filterBoxCar(&out, ch, m_scratchChannels[ch], count, level);
+					break;
+				case DecimationFilter::CIC:
+					filterCIC(&out, ch, m_scratchChannels[ch], count);
+					break;
+				case DecimationFilter::FIR:
+					filterFIR(&out, ch, m_scratchChannels[ch], count, level);
+					break;
+				}
+			}
+			out.phase = (out.phase + count) % out.config.factor;
+		}
+	}
+
+	for (size_t o = 0; o < m_outputs.size(); ++o) {
+		Output &out = m_outputs[o];
+		out.produced = out.samples[0].size();
+		for (size_t ch = 0; ch < m_layout.nCh; ++ch) {
+			out.pointers[ch] = out.samples[ch].data();
+		}
+		if (m_callback && out.produced > 0) {
+			m_callback(o, out.pointers.data(), out.produced);
+		}
+	}
+}
+
+DMAStreamer::Callback DAQDecimator::attach(const std::uint32_t n,
+		const DMAStreamer::Callback &fullRate) {
+	return [this, n, fullRate](const std::uint32_t dma,
+			const std::uint64_t *data, const size_t elements) {
+		if (dma == n) {
+			process(data, elements / m_layout.blockWords());
+		}
+		if (fullRate) {
+			fullRate(dma, data, elements);
+		}
+	};
+}
+
+size_t DAQDecimator::countOutputs() const {
+	return m_outputs.size();
+}
+
+size_t DAQDecimator::getSamples(const size_t output) const {
+	checkOutput(output);
+	return m_outputs[output].produced;
+}
+
+const float* DAQDecimator::getChannel(const size_t output,
+		const size_t ch) const {
+	checkOutput(output);
+	if (ch >= m_layout.nCh) {
+		throw errors::DecimatorConfigError("Channel " + std::to_string(ch)
+				+ " out of range");
+	}
+	return m_outputs[output].samples[ch].data();
+}
+
+void DAQDecimator::reset() {
+	for (auto &out : m_outputs) {
+		out.phase = 0;
+		out.produced = 0;
+		for (size_t ch = 0; ch < m_layout.nCh; ++ch) {
+			ChannelState &state = out.channels[ch];
+			std::fill(std::begin(state.acc), std::end(state.acc), 0);
+			std::fill(std::begin(state.comb), std::end(state.comb), 0);
+			// Samples before the first one are 0
+			state.history.assign(out.reversedTaps.empty() ?
+					0 : out.reversedTaps.size() - 1, 0.0f);
+			out.samples[ch].clear();
+		}
+	}
+}
+
+void DAQDecimator::checkOutput(const size_t output) const {
+	if (output >= m_outputs.size()) {
+		throw errors::DecimatorConfigError("Output "
+				+ std::to_string(output) + " out of range");
+	}
+}
+
+void DAQDecimator::filterBoxCar(Output *out, const size_t ch,
+		const std::int32_t *x, const size_t count,
+		const demux::SimdLevel level) {
+	ChannelState &state = out->channels[ch];
+	const size_t factor = out->config.factor;
+	const double scale = static_cast<double>(out->config.scale) / factor;
+	std::vector<float> &samples = out->samples[ch];
+
+	size_t phase = out->phase;
+	size_t i = 0;
+	while (i < count) {
+		const size_t take = std::min(factor - phase, count - i);
+		state.acc[0] += static_cast<std::uint64_t>(sum(x + i, take, level));
+		i += take;
+		phase += take;
+		if (phase == factor) {
+			samples.push_back(static_cast<float>(
+					static_cast<std::int64_t>(state.acc[0]) * scale));
+			state.acc[0] = 0;
+			phase = 0;
+		}
+	}
+}
+
+void DAQDecimator::filterCIC(Output *out, const size_t ch,
+		const std::int32_t *x, const size_t count) {
+	// Integrators depend on the previous sample, this filter is scalar
+	ChannelState &state = out->channels[ch];
+	const size_t factor = out->config.factor;
+	const unsigned stages = out->config.cicStages;
+	double gain = 1.0;
+	for (unsigned s = 0; s < stages; ++s) {
+		gain *= static_cast<double>(factor);
+	}
+	const double scale = out->config.scale / gain;
+	std::vector<float> &samples = out->samples[ch];
+
+	size_t phase = out->phase;
+	for (size_t i = 0; i < count; ++i) {
+		// Unsigned arithmetic: the state wraps around without changing the
+		// output, which is known to fit
+		std::uint64_t v = static_cast<std::uint64_t>(
+				static_cast<std::int64_t>(x[i]));
+		for (unsigned s = 0; s < stages; ++s) {
+			state.acc[s] += v;
+			v = state.acc[s];
+		}
+		if (++phase == factor) {
+			for (unsigned s = 0; s < stages; ++s) {
+				const std::uint64_t delayed = state.comb[s];
+				state.comb[s] = v;
+				v -= delayed;
+			}
+			samples.push_back(static_cast<float>(
+					static_cast<std::int64_t>(v) * scale));
+			phase = 0;
+		}
+	}
+}
+
+void DAQDecimator::filterFIR(Output *out, const size_t ch,
+		const std::int32_t *x, const size_t count,
+		const demux::SimdLevel level) {
+	ChannelState &state = out->channels[ch];
+	const size_t factor = out->config.factor;
+	const size_t nTaps = out->reversedTaps.size();
+	const float scale = out->config.scale;
+	std::vector<float> &history = state.history;
+	std::vector<float> &samples = out->samples[ch];
+
+	const size_t kept = nTaps - 1;
+	history.resize(kept + count);
+	for (size_t i = 0; i < count; ++i) {
+		history[kept + i] = static_cast<float>(x[i]);
+	}
+
+	// Only the samples completing a group of factor are computed. The
+	// output of input i uses history[i, i + nTaps)
+	for (size_t i = factor - out->phase - 1; i < count; i += factor) {
+		samples.push_back(dot(out->reversedTaps.data(), history.data() + i,
+				nTaps, level) * scale);
+	}
+
+	std::copy(history.end() - kept, history.end(), history.begin());
+	history.resize(kept);
+}
+
+}  // namespace irio
@@ -0,0 +1,382 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IRIO_DEMUX_X86
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <string>
+
+#include "daqDemux.h"
+#include "daqBlockView.h"
+#include "errorsIrio.h"
+
+namespace irio {
+namespace demux {
+
+namespace {
+
+std::atomic<SimdLevel>& activeLevel() {
+	static std::atomic<SimdLevel> level(detectSimdLevel());
+	return level;
+}
+
+void checkLayout(const DemuxLayout &layout, const size_t maxSampleSize) {
+	if (layout.sampleSize != 1 && layout.sampleSize != 2
+			&& layout.sampleSize != 4 && layout.sampleSize != 8) {
+		throw errors::DAQFormatMismatchError(
+				"Unsupported sample size of "
+						+ std::to_string(layout.sampleSize) + " bytes");
+	}
+	if (layout.sampleSize > maxSampleSize) {
+		throw errors::DAQFormatMismatchError(
+				"Samples of " + std::to_string(layout.sampleSize)
+						+ " bytes do not fit in the output type");
+	}
+	if (layout.nCh == 0) {
+		throw errors::DAQFormatMismatchError("Layout without channels");
+	}
+}
+
+/**
+ * Conversion of a raw sample to the output type. The SIMD kernels do the
+ * same operations (integer widening, int to float, single multiply) so
+ * their results are bit-exact with this one.
+ */
+template<typename T>
+struct Convert {
+	static T apply(const std::int64_t raw, const float) {
+		return static_cast<T>(raw);
+	}
+};
+
+template<>
+struct Convert<float> {
+	static float apply(const std::int64_t raw, const float scale) {
+		return static_cast<float>(raw) * scale;
+	}
+};
+
+/**
+ * Writes samples [first, count) of a channel of one block
+ */
+template<std::uint8_t SampleSize, typename T>
+void demuxChannelScalar(const std::uint64_t *payload, const size_t nCh,
+		const size_t ch, const size_t first, const size_t count, T *out,
+		const float scale) {
+	using Sample = typename DAQSampleTraits<SampleSize>::type;
+	constexpr size_t perWord = sizeof(std::uint64_t) / SampleSize;
+	for (size_t i = first; i < count; ++i) {
+		const size_t s = i * nCh + ch;
+		const auto raw = static_cast<Sample>(
+				payload[s / perWord] >> ((s % perWord) * 8 * SampleSize));
+		out[i] = Convert<T>::apply(raw, scale);
+	}
+}
+
+template<std::uint8_t SampleSize, typename T>
+void demuxBlockScalar(const std::uint64_t *payload, const DemuxLayout &layout,
+		T *const *channels, const size_t offset, const float scale) {
+	const size_t count = layout.samplesPerChannel();
+	for (size_t ch = 0; ch < layout.nCh; ++ch) {
+		demuxChannelScalar<SampleSize>(payload, layout.nCh, ch, 0, count,
+				channels[ch] + offset, scale);
+	}
+}
+
+template<typename T>
+void demuxBlockScalar(const std::uint64_t *payload, const DemuxLayout &layout,
+		T *const *channels, const size_t offset, const float scale) {
+	switch (layout.sampleSize) {
+	case 1:
+		demuxBlockScalar<1>(payload, layout, channels, offset, scale);
+		break;
+	case 2:
+		demuxBlockScalar<2>(payload, layout, channels, offset, scale);
+		break;
+	case 4:
+		demuxBlockScalar<4>(payload, layout, channels, offset, scale);
+		break;
+	default:
+		demuxBlockScalar<8>(payload, layout, channels, offset, scale);
+		break;
+	}
+}
+
+#ifdef IRIO_DEMUX_X86
+
+///////////////////////////////////////////////////////////////
+///// AVX2 kernels (2 bytes samples)
+///////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+void store8(std::int16_t *dst, const __m256i v, const float) {
+	// Values are already in int16 range, saturation does not change them
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+			_mm_packs_epi32(_mm256_castsi256_si128(v),
+					_mm256_extracti128_si256(v, 1)));
+}
+
+__attribute__((target("avx2")))
+void store8(std::int32_t *dst, const __m256i v, const float) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+}
+
+__attribute__((target("avx2")))
+void store8(float *dst, const __m256i v, const float scale) {
+	_mm256_storeu_ps(dst,
+			_mm256_mul_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(scale)));
+}
+
+/**
+ * Stores 4 consecutive samples of 4 channels, packed as one 64 bits lane
+ * per channel
+ */
+__attribute__((target("avx2")))
+void store4x4(std::int16_t *const *channels, const size_t pos,
+		const __m256i v, const float) {
+	alignas(32) std::int16_t tmp[16];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(tmp), v);
+	for (size_t ch = 0; ch < 4; ++ch) {
+		std::memcpy(channels[ch] + pos, tmp + ch * 4, 4 * sizeof(std::int16_t));
+	}
+}
+
+__attribute__((target("avx2")))
+void store4x4(std::int32_t *const *channels, const size_t pos,
+		const __m256i v, const float) {
+	const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+	const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(channels[0] + pos),
+			_mm256_castsi256_si128(lo));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(channels[1] + pos),
+			_mm256_extracti128_si256(lo, 1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(channels[2] + pos),
+			_mm256_castsi256_si128(hi));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(channels[3] + pos),
+			_mm256_extracti128_si256(hi, 1));
+}
+
+__attribute__((target("avx2")))
+void store4x4(float *const *channels, const size_t pos, const __m256i v,
+		const float scale) {
+	const __m256 factor = _mm256_set1_ps(scale);
+	const __m256 lo = _mm256_mul_ps(factor, _mm256_cvtepi32_ps(
+			_mm256_cvtepi16_epi32(_mm256_castsi256_si128(v))));
+	const __m256 hi = _mm256_mul_ps(factor, _mm256_cvtepi32_ps(
+			_mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1))));
+	_mm_storeu_ps(channels[0] + pos, _mm256_castps256_ps128(lo));
+	_mm_storeu_ps(channels[1] + pos, _mm256_extractf128_ps(lo, 1));
+	_mm_storeu_ps(channels[2] + pos, _mm256_castps256_ps128(hi));
+	_mm_storeu_ps(channels[3] + pos, _mm256_extractf128_ps(hi, 1));
+}
+
+/**
+ * Four channels of 2 bytes samples: each word holds one sample of every
+ * channel, so the block is a 4xN transpose done with shuffles
+ */
+template<typename T>
+__attribute__((target("avx2")))
+void demuxBlock4ChAVX2(const std::uint64_t *payload, const size_t count,
+		T *const *channels, const size_t offset, const float scale) {
+	// Within each 128 bits lane group the samples of two words by channel
+	const __m256i shuffle = _mm256_setr_epi8(
+			0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+			0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+	// Join the pairs of both lanes: 64 bits lane k = channel k
+	const __m256i permute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256i v = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(payload + i));
+		v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle),
+				permute);
+		store4x4(channels, offset + i, v, scale);
+	}
+	for (size_t ch = 0; ch < 4; ++ch) {
+		demuxChannelScalar<2>(payload, 4, ch, i, count, channels[ch] + offset,
+				scale);
+	}
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+void demuxBlockAVX2(const std::uint64_t *payload, const DemuxLayout &layout,
+		T *const *channels, const size_t offset, const float scale) {
+	const size_t count = layout.samplesPerChannel();
+	const size_t nCh = layout.nCh;
+	if (nCh == 4) {
+		demuxBlock4ChAVX2(payload, count, channels, offset, scale);
+		return;
+	}
+
+	const size_t total = layout.lengthBlock * 4;
+	const int *base = reinterpret_cast<const int*>(payload);
+	const __m256i stride = _mm256_set1_epi32(static_cast<int>(nCh * 2));
+	const __m256i step = _mm256_mullo_epi32(
+			_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), stride);
+	const __m256i advance = _mm256_set1_epi32(static_cast<int>(8 * nCh * 2));
+
+	for (size_t ch = 0; ch < nCh; ++ch) {
+		T *out = channels[ch] + offset;
+		__m256i idx = _mm256_add_epi32(step,
+				_mm256_set1_epi32(static_cast<int>(ch * 2)));
+		size_t i = 0;
+		// Each gather reads 4 bytes per sample, the last sample of the
+		// payload is left to the scalar tail to not read past it
+		for (; i + 8 <= count && (i + 7) * nCh + ch + 1 < total; i += 8) {
+			__m256i v = _mm256_i32gather_epi32(base, idx, 1);
+			v = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+			store8(out + i, v, scale);
+			idx = _mm256_add_epi32(idx, advance);
+		}
+		demuxChannelScalar<2>(payload, nCh, ch, i, count, out, scale);
+	}
+}
+
+///////////////////////////////////////////////////////////////
+///// AVX-512 kernels (2 bytes samples)
+///////////////////////////////////////////////////////////////
+// The unmasked AVX-512 intrinsics start from an undefined vector, which GCC
+// reports as uninitialized. The masked forms with all lanes set and a zero
+// source do the same work
+constexpr __mmask16 ALL_LANES = 0xFFFF;
+
+__attribute__((target("avx512f")))
+void store16(std::int16_t *dst, const __m512i v, const float) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+			_mm512_maskz_cvtepi32_epi16(ALL_LANES, v));
+}
+
+__attribute__((target("avx512f")))
+void store16(std::int32_t *dst, const __m512i v, const float) {
+	_mm512_storeu_si512(dst, v);
+}
+
+__attribute__((target("avx512f")))
+void store16(float *dst, const __m512i v, const float scale) {
+	_mm512_storeu_ps(dst,
+			_mm512_mul_ps(_mm512_maskz_cvtepi32_ps(ALL_LANES, v), _mm512_set1_ps(scale)));
+}
+
+template<typename T>
+__attribute__((target("avx512f")))
+void demuxBlockAVX512(const std::uint64_t *payload, const DemuxLayout &layout,
+		T *const *channels, const size_t offset, const float scale) {
+	const size_t count = layout.samplesPerChannel();
+	const size_t nCh = layout.nCh;
+	const size_t total = layout.lengthBlock * 4;
+	const __m512i stride = _mm512_set1_epi32(static_cast<int>(nCh * 2));
+	const __m512i step = _mm512_mullo_epi32(
+			_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+					14, 15), stride);
+	const __m512i advance = _mm512_set1_epi32(static_cast<int>(16 * nCh * 2));
+
+	for (size_t ch = 0; ch < nCh; ++ch) {
+		T *out = channels[ch] + offset;
+		__m512i idx = _mm512_add_epi32(step,
+				_mm512_set1_epi32(static_cast<int>(ch * 2)));
+		size_t i = 0;
+		for (; i + 16 <= count && (i + 15) * nCh + ch + 1 < total; i += 16) {
+			__m512i v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(),
+					ALL_LANES, idx, payload, 1);
+			v = _mm512_maskz_srai_epi32(ALL_LANES,
+					_mm512_maskz_slli_epi32(ALL_LANES, v, 16), 16);
+			store16(out + i, v, scale);
+			idx = _mm512_add_epi32(idx, advance);
+		}
+		demuxChannelScalar<2>(payload, nCh, ch, i, count, out, scale);
+	}
+}
+
+#endif  // IRIO_DEMUX_X86
+
+template<typename T>
+size_t demuxImpl(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, T *const *channels, const float scale) {
+	const size_t perChannel = layout.samplesPerChannel();
+	const SimdLevel level = layout.sampleSize == 2 ?
+			getSimdLevel() : SimdLevel::Scalar;
+
+	for (size_t b = 0; b < nBlocks; ++b) {
+		const std::uint64_t *payload = data + b * layout.blockWords()
+				+ layout.headerWords;
+		const size_t offset = b * perChannel;
+#ifdef IRIO_DEMUX_X86
+		// The transpose kernel of 4 channels beats the AVX-512 gathers
+		if (level == SimdLevel::AVX512 && layout.nCh != 4) {
+			demuxBlockAVX512(payload, layout, channels, offset, scale);
+			continue;
+		}
+		if (level != SimdLevel::Scalar) {
+			demuxBlockAVX2(payload, layout, channels, offset, scale);
+			continue;
+		}
+#endif
+		demuxBlockScalar(payload, layout, channels, offset, scale);
+	}
+	return nBlocks * perChannel;
+}
+
+}  // namespace
+
+DemuxLayout getDemuxLayout(const TerminalsDMADAQ &daq, const std::uint32_t n) {
+	DemuxLayout layout;
+	layout.lengthBlock = daq.getLengthBlock(n);
+	layout.headerWords = daq.getElementsPerBlock(n) - layout.lengthBlock;
+	layout.nCh = daq.getNCh(n);
+	layout.sampleSize = daq.getSampleSize(n);
+	checkLayout(layout, sizeof(std::uint64_t));
+	return layout;
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef IRIO_DEMUX_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return SimdLevel::AVX512;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return SimdLevel::AVX2;
+	}
+#endif
+	return SimdLevel::Scalar;
+}
+
+SimdLevel getSimdLevel() {
+	return activeLevel().load(std::memory_order_relaxed);
+}
+
+SimdLevel setSimdLevel(const SimdLevel level) {
+	const SimdLevel best = detectSimdLevel();
+	const SimdLevel selected = level > best ? best : level;
+	activeLevel().store(selected, std::memory_order_relaxed);
+	return selected;
+}
+
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, std::int16_t *const *channels) {
+	checkLayout(layout, sizeof(std::int16_t));
+	return demuxImpl(layout, data, nBlocks, channels, 1.0f);
+}
+
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, std::int32_t *const *channels) {
+	checkLayout(layout, sizeof(std::int32_t));
+	return demuxImpl(layout, data, nBlocks, channels, 1.0f);
+}
+
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, float *const *channels, const float scale) {
+	checkLayout(layout, sizeof(std::uint64_t));
+	return demuxImpl(layout, data, nBlocks, channels, scale);
+}
+
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, float *const *channels, const Module &module) {
+	return demux(layout, data, nBlocks, channels,
+			static_cast<float>(module.getCVADC()));
+}
+
+}  // namespace demux
+}  // namespace irio
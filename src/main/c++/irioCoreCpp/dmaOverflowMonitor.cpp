@@ -0,0 +1,179 @@
+#include <string>
+#include <utility>
+
+#include "dmaOverflowMonitor.h"
+#include "errorsIrio.h"
+#include "terminals/impl/terminalsDMACommonImpl.h"
+
+namespace irio {
+
+namespace {
+/// Bits of the DMATtoHOSTOverflows register, one per DMA number
+constexpr std::uint32_t OVERFLOW_BITS = 16;
+}  // namespace
+
+DMAOverflowMonitor::DMAOverflowMonitor(const TerminalsDMACommon &terminals,
+		const DMAOverflowMonitorConfig &config) :
+		m_terminals(terminals), m_config(config),
+		m_states(OVERFLOW_BITS), m_foundDMAs(0), m_lastValue(0),
+		m_running(false) {
+	// DMA numbers may have gaps, so the bits are those of the DMAs found
+	const auto impl = std::static_pointer_cast<TerminalsDMACommonImpl>(
+			m_terminals.m_impl);
+	for (std::uint32_t n = 0; n < OVERFLOW_BITS; ++n) {
+		if (impl->hasDMAImpl(n)) {
+			m_foundDMAs |= 1u << n;
+		}
+	}
+}
+
+DMAOverflowMonitor::~DMAOverflowMonitor() {
+	stop();
+}
+
+void DMAOverflowMonitor::addCallback(const Callback &callback) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_callbacks.push_back(callback);
+}
+
+void DMAOverflowMonitor::start() {
+	if (m_config.period == 0 || m_running) {
+		return;
+	}
+	m_running = true;
+	m_thread = std::thread(&DMAOverflowMonitor::monitorLoop, this);
+}
+
+void DMAOverflowMonitor::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_wakeUp.notify_all();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+bool DMAOverflowMonitor::isRunning() const {
+	return m_running;
+}
+
+std::uint16_t DMAOverflowMonitor::poll() {
+	std::lock_guard<std::mutex> pollLock(m_pollMutex);
+	const std::uint16_t value = m_terminals.getAllDMAOverflows();
+	const std::uint16_t changed = (value ^ m_lastValue) & m_foundDMAs;
+	m_lastValue = value;
+	if (changed == 0) {
+		return value;
+	}
+
+	const auto now = std::chrono::system_clock::now();
+	for (std::uint32_t n = 0; n < OVERFLOW_BITS; ++n) {
+		if (!(changed & (1u << n))) {
+			continue;
+		}
+		const bool overflow = value & (1u << n);
+		DMAState &state = m_states[n];
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			state.stats.active = overflow;
+			if (overflow) {
+				++state.stats.overflows;
+				if (state.stats.overflows == 1) {
+					state.stats.firstOverflow = now;
+				}
+				state.stats.lastOverflow = now;
+			}
+		}
+
+		if (overflow && m_config.policy == OverflowPolicy::Restart) {
+			restart(n, &state);
+		}
+
+		std::vector<Callback> callbacks;
+		DMAOverflowStats stats;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			callbacks = m_callbacks;
+			stats = state.stats;
+		}
+		for (const auto &callback : callbacks) {
+			callback(n, overflow, stats);
+		}
+	}
+	return value;
+}
+
+DMAOverflowStats DMAOverflowMonitor::getStats(const std::uint32_t n) const {
+	checkDMA(n);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_states[n].stats;
+}
+
+bool DMAOverflowMonitor::popGap(const std::uint32_t n, DMAGap *gap) {
+	checkDMA(n);
+	DMAState &state = m_states[n];
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (state.gaps.empty()) {
+		return false;
+	}
+	*gap = state.gaps.front();
+	state.gaps.pop_front();
+	return true;
+}
+
+std::uint64_t DMAOverflowMonitor::getGapCount(const std::uint32_t n) const {
+	checkDMA(n);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_states[n].gapCount;
+}
+
+void DMAOverflowMonitor::monitorLoop() {
+	const auto period = std::chrono::milliseconds(m_config.period);
+	while (m_running) {
+		try {
+			poll();
+		} catch (std::exception&) {
+			// Keep watching, the register may be readable again later
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wakeUp.wait_for(lock, period, [this] {
+			return !m_running;
+		});
+	}
+}
+
+void DMAOverflowMonitor::restart(const std::uint32_t n, DMAState *state) {
+	const bool wasEnabled = m_terminals.isDMAEnable(n);
+	if (wasEnabled) {
+		m_terminals.disableDMA(n);
+	}
+	m_terminals.stopDMA(n);
+	const size_t discarded = m_terminals.startDMA(n);
+	if (wasEnabled) {
+		m_terminals.enableDMA(n);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++state->stats.restarts;
+	state->stats.elementsDiscarded += discarded;
+
+	DMAGap gap;
+	gap.sequence = ++state->gapCount;
+	gap.time = std::chrono::system_clock::now();
+	gap.elementsDiscarded = discarded;
+	state->gaps.push_back(gap);
+	while (state->gaps.size() > m_config.maxGaps) {
+		state->gaps.pop_front();
+	}
+}
+
+void DMAOverflowMonitor::checkDMA(const std::uint32_t n) const {
+	if (n >= OVERFLOW_BITS || !(m_foundDMAs & (1u << n))) {
+		throw errors::ResourceNotFoundError(n, "monitored DMA");
+	}
+}
+
+}  // namespace irio
@@ -0,0 +1,561 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "dmaRecorder.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+std::uint64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Memory aligned to record::ALIGNMENT, as required by O_DIRECT
+ */
+class AlignedBuffer {
+ public:
+	explicit AlignedBuffer(const size_t size) {
+		if (posix_memalign(&m_data, record::ALIGNMENT, size) != 0) {
+			throw errors::DMARecorderError(
+					"Unable to allocate " + std::to_string(size)
+							+ " bytes for the recorder");
+		}
+		std::memset(m_data, 0, size);
+	}
+
+	~AlignedBuffer() {
+		std::free(m_data);
+	}
+
+	AlignedBuffer(const AlignedBuffer&) = delete;
+	AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+	char* data() const {
+		return static_cast<char*>(m_data);
+	}
+
+ private:
+	void *m_data = nullptr;
+};
+
+/**
+ * Writes the whole buffer synchronously. After a short write, the rest is
+ * written from the previous multiple of \p alignment, as O_DIRECT requires
+ */
+void writeAll(const int fd, const char *data, size_t size, off_t offset,
+		const std::string &what, const size_t alignment) {
+	while (size > 0) {
+		const ssize_t ret = pwrite(fd, data, size, offset);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			throw errors::DMARecorderError("Error writing the " + what + ": "
+					+ std::strerror(ret < 0 ? errno : ENOSPC));
+		}
+		size_t written = static_cast<size_t>(ret);
+		if (written < size) {
+			written -= written % alignment;
+			if (written == 0) {
+				throw errors::DMARecorderError("Error writing the " + what
+						+ ": short write smaller than the alignment");
+			}
+		}
+		data += written;
+		size -= written;
+		offset += static_cast<off_t>(written);
+	}
+}
+
+/**
+ * Queue of buffer indexes with one producer and one consumer. head is only
+ * written by the producer and tail only by the consumer. Both are monotonic
+ * counters kept in different cache lines.
+ */
+class IndexQueue {
+ public:
+	explicit IndexQueue(const size_t size) :
+			m_slots(size) {
+	}
+
+	void reset() {
+		m_head.store(0, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+	}
+
+	void push(const size_t index) {
+		const size_t head = m_head.load(std::memory_order_relaxed);
+		m_slots[head % m_slots.size()] = index;
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	bool front(size_t *index) const {
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (m_head.load(std::memory_order_acquire) == tail) {
+			return false;
+		}
+		*index = m_slots[tail % m_slots.size()];
+		return true;
+	}
+
+	void pop() {
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + 1,
+				std::memory_order_release);
+	}
+
+ private:
+	std::vector<size_t> m_slots;
+	std::atomic<size_t> m_head{0};
+	char m_padHead[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> m_tail{0};
+	char m_padTail[64 - sizeof(std::atomic<size_t>)];
+};
+
+}  // namespace
+
+/**
+ * The chunk buffers and the queues moving them between the threads.
+ *
+ * A buffer is either in the free queue (reader takes it), in the filled
+ * queue (writer takes it) or being written. As there are as many slots as
+ * buffers the queues cannot overflow.
+ */
+class DMARecorder::BufferPool {
+ public:
+	/**
+	 * Write in flight of a buffer
+	 */
+	struct Pending {
+		std::uint64_t offset;
+		size_t written;
+	};
+
+	BufferPool(const size_t numBuffers, const size_t chunkSize,
+			const size_t chunkElements) :
+			buffers(numBuffers), size(chunkSize),
+			memory(numBuffers * chunkSize), discard(chunkElements),
+			free(numBuffers), filled(numBuffers), pending(numBuffers) {
+	}
+
+	void reset() {
+		free.reset();
+		filled.reset();
+		for (size_t i = 0; i < buffers; ++i) {
+			free.push(i);
+		}
+	}
+
+	char* buffer(const size_t index) const {
+		return memory.data() + index * size;
+	}
+
+	record::ChunkHeader* header(const size_t index) const {
+		return reinterpret_cast<record::ChunkHeader*>(buffer(index));
+	}
+
+	std::uint64_t* blocks(const size_t index) const {
+		return reinterpret_cast<std::uint64_t*>(buffer(index)
+				+ record::CHUNK_HEADER_SIZE);
+	}
+
+	const size_t buffers;
+	const size_t size;
+	AlignedBuffer memory;
+	/// Destination of the chunks read while no buffer is free
+	std::vector<std::uint64_t> discard;
+
+	/// Written by the writer, read by the reader
+	IndexQueue free;
+	/// Written by the reader, read by the writer
+	IndexQueue filled;
+	/// Only used by the writer
+	std::vector<Pending> pending;
+};
+
+DMARecorder::DMARecorder(const TerminalsDMADAQ &daq, const std::uint32_t n,
+		const std::string &signature, const std::string &path,
+		const DMARecorderConfig &config) :
+		m_daq(daq), m_n(n), m_path(path), m_config(config),
+		m_blocksPerChunk(config.blocksPerChunk == 0 ?
+				1 : config.blocksPerChunk),
+		m_chunkElements(m_daq.getElementsPerBlock(n) * m_blocksPerChunk),
+		m_chunkSize(record::getChunkSize(m_daq.getElementsPerBlock(n),
+				m_blocksPerChunk)),
+		m_running(false), m_writerStop(false), m_chunksRead(0),
+		m_chunksWritten(0), m_chunksDropped(0), m_bytesWritten(0),
+		m_timeouts(0), m_failed(false) {
+	if (signature.size() >= record::SIGNATURE_LENGTH) {
+		throw errors::DMARecorderError("Bitfile signature too long");
+	}
+
+	std::memset(&m_header, 0, sizeof(m_header));
+	std::memcpy(m_header.magic, record::FILE_MAGIC, sizeof(m_header.magic));
+	m_header.version = record::FORMAT_VERSION;
+	m_header.dma = n;
+	std::memcpy(m_header.signature, signature.c_str(), signature.size());
+	m_header.nCh = m_daq.getNCh(n);
+	m_header.sampleSize = m_daq.getSampleSize(n);
+	m_header.frameType = static_cast<std::uint8_t>(m_daq.getFrameType(n));
+	m_header.lengthBlock = m_daq.getLengthBlock(n);
+	m_header.decimation = m_daq.getSamplingRateDecimation(n);
+	m_header.elementsPerBlock = m_daq.getElementsPerBlock(n);
+	m_header.blocksPerChunk = m_blocksPerChunk;
+	m_header.chunkSize = m_chunkSize;
+
+	m_pool.reset(new BufferPool(config.buffers == 0 ? 1 : config.buffers,
+			m_chunkSize, m_chunkElements));
+}
+
+DMARecorder::~DMARecorder() {
+	try {
+		stop();
+	} catch (errors::DMARecorderError&) {
+		// Nothing else can be done with the file
+	}
+}
+
+void DMARecorder::start() {
+	if (m_fd >= 0) {
+		return;
+	}
+
+	const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+	m_directIO = false;
+	if (m_config.directIO) {
+		m_fd = open(m_path.c_str(), flags | O_DIRECT, 0644);
+		m_directIO = m_fd >= 0;
+	}
+	if (m_fd < 0 && (!m_config.directIO || errno == EINVAL)) {
+		m_fd = open(m_path.c_str(), flags, 0644);
+	}
+	if (m_fd < 0) {
+		throw errors::DMARecorderError("Unable to create " + m_path + ": "
+				+ std::strerror(errno));
+	}
+
+	try {
+		m_writer = makeAsyncWriter(m_fd,
+				static_cast<unsigned>(m_pool->buffers),
+				m_config.writerThreads, m_config.useIoUring);
+
+		m_header.startTime = nowNs();
+		m_header.chunkCount = 0;
+		m_header.indexOffset = 0;
+		m_header.indexEntries = 0;
+		m_header.blocksDropped = 0;
+		AlignedBuffer header(record::ALIGNMENT);
+		std::memcpy(header.data(), &m_header, sizeof(m_header));
+		writeAll(m_fd, header.data(), record::ALIGNMENT, 0, "file header",
+				m_directIO ? record::ALIGNMENT : 1);
+	} catch (...) {
+		m_writer.reset();
+		close(m_fd);
+		m_fd = -1;
+		throw;
+	}
+
+	m_index.clear();
+	m_pool->reset();
+	m_allocated = 0;
+	m_chunksRead = 0;
+	m_chunksWritten = 0;
+	m_chunksDropped = 0;
+	m_bytesWritten = 0;
+	m_timeouts = 0;
+	m_failed = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_lastError.clear();
+		m_backend = m_writer->getName();
+	}
+
+	m_running = true;
+	m_writerStop = false;
+	m_writerThread = std::thread(&DMARecorder::writerLoop, this);
+	m_reader = std::thread(&DMARecorder::readerLoop, this);
+}
+
+void DMARecorder::stop() {
+	if (m_fd < 0) {
+		return;
+	}
+
+	m_running = false;
+	if (m_reader.joinable()) {
+		m_reader.join();
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_writerStop = true;
+	}
+	m_dataReady.notify_all();
+	if (m_writerThread.joinable()) {
+		m_writerThread.join();
+	}
+	m_writer.reset();
+
+	try {
+		finishFile();
+	} catch (...) {
+		close(m_fd);
+		m_fd = -1;
+		throw;
+	}
+	const int ret = close(m_fd);
+	m_fd = -1;
+	if (ret < 0) {
+		throw errors::DMARecorderError("Error closing " + m_path + ": "
+				+ std::strerror(errno));
+	}
+}
+
+bool DMARecorder::isRunning() const {
+	return m_running;
+}
+
+size_t DMARecorder::getChunkSize() const {
+	return m_chunkSize;
+}
+
+DMARecorderStats DMARecorder::getStats() const {
+	DMARecorderStats stats;
+	stats.chunksRead = m_chunksRead;
+	stats.chunksWritten = m_chunksWritten;
+	stats.chunksDropped = m_chunksDropped;
+	stats.bytesWritten = m_bytesWritten;
+	stats.timeouts = m_timeouts;
+	stats.failed = m_failed;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	stats.lastError = m_lastError;
+	stats.directIO = m_directIO;
+	stats.backend = m_backend;
+	return stats;
+}
+
+void DMARecorder::readerLoop() {
+	BufferPool &pool = *m_pool;
+	std::uint64_t sequence = 0;
+	std::uint64_t blocksRead = 0;
+
+	while (m_running) {
+		size_t index = 0;
+		const bool available = pool.free.front(&index);
+		std::uint64_t *dst = available ?
+				pool.blocks(index) : pool.discard.data();
+
+		try {
+			m_daq.readDataBlocking(m_n, m_chunkElements, dst,
+					m_config.readTimeout);
+		} catch (errors::DMAReadTimeout&) {
+			m_timeouts.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		} catch (std::exception &e) {
+			setError(e.what());
+			break;
+		}
+
+		m_chunksRead.fetch_add(1, std::memory_order_relaxed);
+		if (available) {
+			record::ChunkHeader *header = pool.header(index);
+			header->magic = record::CHUNK_MAGIC;
+			header->sequence = sequence++;
+			header->firstBlock = blocksRead;
+			header->timestamp = nowNs();
+			pool.free.pop();
+			pool.filled.push(index);
+			{
+				// Orders the push with the check of the waiting writer
+				std::lock_guard<std::mutex> lock(m_mutex);
+			}
+			m_dataReady.notify_one();
+		} else {
+			m_chunksDropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		blocksRead += m_blocksPerChunk;
+	}
+}
+
+void DMARecorder::writerLoop() {
+	BufferPool &pool = *m_pool;
+	std::vector<AsyncWriter::Completion> completions(pool.buffers);
+	size_t inFlight = 0;
+
+	try {
+		while (true) {
+			size_t index = 0;
+			bool submitted = false;
+			while (pool.filled.front(&index)) {
+				pool.filled.pop();
+				const record::ChunkHeader *header = pool.header(index);
+				const std::uint64_t offset = record::ALIGNMENT
+						+ header->sequence * m_chunkSize;
+				pool.pending[index] = {offset, 0};
+				reserve(offset + m_chunkSize);
+				m_writer->submit(pool.buffer(index), m_chunkSize, offset,
+						index);
+				++inFlight;
+				submitted = true;
+			}
+			if (submitted) {
+				m_writer->flush();
+			}
+
+			if (inFlight == 0) {
+				if (m_writerStop) {
+					break;
+				}
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_dataReady.wait(lock, [this, &pool, &index] {
+					return m_writerStop || pool.filled.front(&index);
+				});
+				continue;
+			}
+
+			// The disk is the bottleneck here, new chunks are submitted
+			// as soon as a write completes
+			const size_t reaped = m_writer->reap(completions.data(),
+					completions.size(), 1);
+			bool resubmitted = false;
+			for (size_t i = 0; i < reaped; ++i) {
+				const size_t done = static_cast<size_t>(completions[i].tag);
+				BufferPool::Pending &pending = pool.pending[done];
+				if (completions[i].result <= 0) {
+					setError("Error writing " + m_path + ": "
+							+ std::strerror(completions[i].result < 0 ?
+									static_cast<int>(-completions[i].result) :
+									ENOSPC));
+				} else {
+					size_t written = pending.written
+							+ static_cast<size_t>(completions[i].result);
+					if (m_directIO) {
+						// O_DIRECT needs aligned offset, length and buffer,
+						// so the rest is written from the previous boundary
+						written -= written % record::ALIGNMENT;
+					}
+					if (written == pending.written) {
+						setError("Error writing " + m_path + ": short write"
+								+ " smaller than the O_DIRECT alignment");
+						--inFlight;
+						pool.free.push(done);
+						continue;
+					}
+					pending.written = written;
+					if (written < m_chunkSize) {
+						// Short write, the rest is submitted again
+						m_writer->submit(pool.buffer(done) + pending.written,
+								m_chunkSize - pending.written,
+								pending.offset + pending.written, done);
+						resubmitted = true;
+						continue;
+					}
+
+					const record::ChunkHeader *header = pool.header(done);
+					if (m_index.size() <= header->sequence) {
+						m_index.resize(header->sequence + 1);
+					}
+					m_index[header->sequence] = {pending.offset,
+							header->firstBlock, header->timestamp, 0};
+					m_chunksWritten.fetch_add(1, std::memory_order_relaxed);
+					m_bytesWritten.fetch_add(m_chunkSize,
+							std::memory_order_relaxed);
+				}
+				--inFlight;
+				pool.free.push(done);
+			}
+			if (resubmitted) {
+				m_writer->flush();
+			}
+		}
+	} catch (std::exception &e) {
+		setError(e.what());
+		// Buffers of the writes in flight cannot be reused safely, so the
+		// writer is only released once they complete
+		if (inFlight > 0) {
+			try {
+				while (inFlight > 0) {
+					inFlight -= m_writer->reap(completions.data(),
+							completions.size(), 1);
+				}
+			} catch (std::exception&) {
+			}
+		}
+	}
+}
+
+void DMARecorder::reserve(const std::uint64_t end) {
+	if (m_config.preallocChunks == 0 || end <= m_allocated) {
+		return;
+	}
+	// Failures are not fatal, the writes will allocate the space themselves
+	// or report the error
+	m_allocated = end + m_config.preallocChunks * m_chunkSize;
+	if (fallocate(m_fd, 0, 0, static_cast<off_t>(m_allocated)) < 0) {
+		m_allocated = std::numeric_limits<std::uint64_t>::max();
+	}
+}
+
+void DMARecorder::finishFile() {
+	// Only the chunks written without a gap before them are indexed
+	size_t chunks = 0;
+	while (chunks < m_index.size() && m_index[chunks].offset != 0) {
+		++chunks;
+	}
+	const std::uint64_t chunksRead = m_chunksRead;
+	const std::uint64_t blocksRead = chunksRead * m_blocksPerChunk;
+
+	m_header.chunkCount = chunks;
+	m_header.indexOffset = record::ALIGNMENT + chunks * m_chunkSize;
+	m_header.indexEntries = chunks;
+	m_header.blocksDropped = blocksRead - chunks * m_blocksPerChunk;
+
+	const size_t indexBytes = chunks * sizeof(record::IndexEntry);
+	if (indexBytes > 0) {
+		const size_t alignedBytes = (indexBytes + record::ALIGNMENT - 1)
+				/ record::ALIGNMENT * record::ALIGNMENT;
+		AlignedBuffer index(alignedBytes);
+		std::memcpy(index.data(), m_index.data(), indexBytes);
+		writeAll(m_fd, index.data(), alignedBytes,
+				static_cast<off_t>(m_header.indexOffset), "block index",
+				m_directIO ? record::ALIGNMENT : 1);
+	}
+
+	AlignedBuffer header(record::ALIGNMENT);
+	std::memcpy(header.data(), &m_header, sizeof(m_header));
+	writeAll(m_fd, header.data(), record::ALIGNMENT, 0, "file header",
+			m_directIO ? record::ALIGNMENT : 1);
+
+	// Drops the padding of the index and any chunk not indexed
+	if (ftruncate(m_fd, static_cast<off_t>(m_header.indexOffset
+			+ indexBytes)) < 0) {
+		throw errors::DMARecorderError("Unable to truncate " + m_path + ": "
+				+ std::strerror(errno));
+	}
+	if (m_config.syncOnClose && fdatasync(m_fd) < 0) {
+		throw errors::DMARecorderError("Unable to sync " + m_path + ": "
+				+ std::strerror(errno));
+	}
+}
+
+void DMARecorder::setError(const std::string &error) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_failed) {
+			m_lastError = error;
+		}
+		m_failed = true;
+	}
+	// The reader stops, the writer finishes the writes in flight
+	m_running = false;
+}
+
+}  // namespace irio
@@ -0,0 +1,644 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "dmaReplay.h"
+#include "errorsIrio.h"
+#include "terminals/impl/terminalsDMADAQImpl.h"
+
+namespace irio {
+
+namespace {
+
+/// Name of the replayed DMAs in the errors
+constexpr char NAME_REPLAY_DMA[] = "ReplayDMA";
+
+using Clock = std::chrono::steady_clock;
+
+}  // namespace
+
+/**
+ * A capture file mapped in memory and the state of its replay
+ */
+class DMAReplay::Capture {
+ public:
+	explicit Capture(const std::string &path) {
+		const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			throw errors::DMAReplayError("Unable to open " + path + ": "
+					+ std::strerror(errno));
+		}
+		struct stat st;
+		if (fstat(fd, &st) < 0) {
+			const int err = errno;
+			close(fd);
+			throw errors::DMAReplayError("Unable to stat " + path + ": "
+					+ std::strerror(err));
+		}
+		m_size = static_cast<size_t>(st.st_size);
+		if (m_size < record::ALIGNMENT) {
+			close(fd);
+			throw errors::DMAReplayError(path + " is not a DMA capture");
+		}
+		m_map = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+		const int err = errno;
+		// The mapping keeps the file open
+		close(fd);
+		if (m_map == MAP_FAILED) {
+			throw errors::DMAReplayError("Unable to map " + path + ": "
+					+ std::strerror(err));
+		}
+		madvise(m_map, m_size, MADV_SEQUENTIAL);
+
+		try {
+			parse(path);
+		} catch (...) {
+			munmap(m_map, m_size);
+			throw;
+		}
+	}
+
+	~Capture() {
+		munmap(m_map, m_size);
+	}
+
+	Capture(const Capture&) = delete;
+	Capture& operator=(const Capture&) = delete;
+
+	std::uint64_t total() const {
+		return data.size() * chunkElements;
+	}
+
+	/**
+	 * Capture time in nanoseconds reached by the replay
+	 */
+	std::uint64_t captureNow(const double speed) const {
+		if (!started) {
+			return captureStart;
+		}
+		const auto elapsed = std::chrono::duration_cast<
+				std::chrono::nanoseconds>(Clock::now() - wallStart).count();
+		return captureStart + static_cast<std::uint64_t>(elapsed * speed);
+	}
+
+	/**
+	 * Words the FPGA would have written so far
+	 */
+	std::uint64_t arrived(const double speed) const {
+		if (!started) {
+			return position;
+		}
+		if (speed == 0) {
+			return total();
+		}
+		const auto last = std::upper_bound(due.begin(), due.end(),
+				captureNow(speed));
+		return std::max<std::uint64_t>(position,
+				static_cast<std::uint64_t>(last - due.begin())
+						* chunkElements);
+	}
+
+	std::uint64_t available(const double speed) const {
+		return arrived(speed) - position;
+	}
+
+	/**
+	 * Copies words from the current position and consumes them
+	 */
+	void copyOut(std::uint64_t *dst, size_t elements) {
+		while (elements > 0) {
+			const size_t offset = position % chunkElements;
+			const size_t count = std::min(elements, chunkElements - offset);
+			std::memcpy(dst, data[position / chunkElements] + offset,
+					count * sizeof(std::uint64_t));
+			dst += count;
+			elements -= count;
+			advance(count);
+		}
+	}
+
+	/**
+	 * Consumes words, raising the overflow when the chunks entered were
+	 * preceded by dropped blocks
+	 */
+	void advance(const std::uint64_t elements) {
+		if (elements == 0) {
+			return;
+		}
+		const std::uint64_t first = (position + chunkElements - 1)
+				/ chunkElements;
+		position += elements;
+		const std::uint64_t last = (position - 1) / chunkElements;
+		for (std::uint64_t i = first; i <= last; ++i) {
+			overflow = overflow || gap[i];
+		}
+	}
+
+	record::FileHeader header;
+	size_t chunkElements = 0;
+	/// Blocks of each chunk in the mapped file
+	std::vector<const std::uint64_t*> data;
+	/// Capture time of each chunk in nanoseconds since the first one
+	std::vector<std::uint64_t> due;
+	/// Whether blocks were dropped right before each chunk
+	std::vector<bool> gap;
+
+	/// Protects the replay state below
+	std::mutex mutex;
+	std::uint64_t position = 0;
+	bool started = false;
+	bool overflow = false;
+	bool enabled = false;
+	std::uint16_t decimation = 0;
+	Clock::time_point wallStart;
+	std::uint64_t captureStart = 0;
+
+	/**
+	 * Elements acquired and not released. Acquisitions spanning more than
+	 * two chunks are served from a copy kept until they are released
+	 */
+	struct Acquisition {
+		size_t elements;
+		std::vector<std::uint64_t> copy;
+	};
+	std::deque<Acquisition> acquisitions;
+
+ private:
+	void parse(const std::string &path) {
+		const char *file = static_cast<const char*>(m_map);
+		std::memcpy(&header, file, sizeof(header));
+		header.signature[record::SIGNATURE_LENGTH - 1] = '\0';
+		if (std::memcmp(header.magic, record::FILE_MAGIC,
+				sizeof(header.magic)) != 0) {
+			throw errors::DMAReplayError(path + " is not a DMA capture");
+		}
+		if (header.version != record::FORMAT_VERSION) {
+			throw errors::DMAReplayError(path + " has format version "
+					+ std::to_string(header.version) + ", expected "
+					+ std::to_string(record::FORMAT_VERSION));
+		}
+		chunkElements = header.elementsPerBlock * header.blocksPerChunk;
+		if (chunkElements == 0 || header.chunkSize == 0
+				|| header.chunkSize % record::ALIGNMENT != 0
+				|| header.chunkSize < record::getChunkSize(
+						header.elementsPerBlock, header.blocksPerChunk)) {
+			throw errors::DMAReplayError(path + " has an invalid chunk size");
+		}
+		decimation = header.decimation;
+
+		// Files not closed properly have no index, their chunks are walked
+		// until one is missing
+		const std::uint64_t fit = (m_size - record::ALIGNMENT)
+				/ header.chunkSize;
+		std::uint64_t chunks = fit;
+		if (header.indexOffset != 0) {
+			if (header.chunkCount > fit) {
+				throw errors::DMAReplayError(path + " is truncated");
+			}
+			chunks = header.chunkCount;
+		}
+
+		std::uint64_t firstTimestamp = 0;
+		std::uint64_t expectedBlock = 0;
+		for (std::uint64_t i = 0; i < chunks; ++i) {
+			const char *chunk = file + record::ALIGNMENT
+					+ i * header.chunkSize;
+			record::ChunkHeader chunkHeader;
+			std::memcpy(&chunkHeader, chunk, sizeof(chunkHeader));
+			if (chunkHeader.magic != record::CHUNK_MAGIC
+					|| chunkHeader.sequence != i) {
+				if (header.indexOffset != 0) {
+					throw errors::DMAReplayError(path + " has chunk "
+							+ std::to_string(i) + " corrupted");
+				}
+				break;
+			}
+
+			if (i == 0) {
+				firstTimestamp = chunkHeader.timestamp;
+			}
+			const std::uint64_t time =
+					chunkHeader.timestamp > firstTimestamp ?
+							chunkHeader.timestamp - firstTimestamp : 0;
+			due.push_back(due.empty() ? time : std::max(due.back(), time));
+			gap.push_back(chunkHeader.firstBlock != expectedBlock);
+			expectedBlock = chunkHeader.firstBlock + header.blocksPerChunk;
+			data.push_back(reinterpret_cast<const std::uint64_t*>(
+					chunk + record::CHUNK_HEADER_SIZE));
+		}
+	}
+
+	void *m_map = nullptr;
+	size_t m_size = 0;
+};
+
+/**
+ * DAQ terminals implementation serving the captures
+ */
+class DMAReplay::Impl: public TerminalsDMADAQImpl {
+ public:
+	Impl(std::vector<std::unique_ptr<Capture>> &&captures,
+			const DMAReplayConfig &config) :
+			TerminalsDMADAQImpl(collect(captures, &record::FileHeader::nCh),
+					frameTypes(captures),
+					collect(captures, &record::FileHeader::sampleSize),
+					collect(captures, &record::FileHeader::lengthBlock),
+					NAME_REPLAY_DMA),
+			m_captures(std::move(captures)),
+			m_speed(config.speed < 0 ? 0 : config.speed) {
+	}
+
+	Capture& capture(const std::uint32_t n) const {
+		if (n >= m_captures.size()) {
+			throw errors::ResourceNotFoundError(n, NAME_REPLAY_DMA);
+		}
+		return *m_captures[n];
+	}
+
+	size_t startDMAImpl(const std::uint32_t n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		if (!c.started) {
+			c.started = true;
+			c.wallStart = Clock::now();
+			c.overflow = false;
+		}
+		return 0;
+	}
+
+	size_t startAllDMAsImpl() const override {
+		for (std::uint32_t n = 0; n < m_captures.size(); ++n) {
+			startDMAImpl(n);
+		}
+		return 0;
+	}
+
+	size_t getEffectiveHostDepthImpl(const std::uint32_t n) const override {
+		capture(n);
+		return getHostDepthImpl(n);
+	}
+
+	void stopDMAImpl(const std::uint32_t n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		if (c.started) {
+			c.captureStart = c.captureNow(m_speed);
+			c.started = false;
+		}
+	}
+
+	void stopAllDMAsImpl() const override {
+		for (std::uint32_t n = 0; n < m_captures.size(); ++n) {
+			stopDMAImpl(n);
+		}
+	}
+
+	size_t cleanDMAImpl(const std::uint32_t n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		if (m_speed == 0) {
+			return 0;
+		}
+		const std::uint64_t available = c.available(m_speed);
+		c.position += available;
+		return available;
+	}
+
+	size_t cleanAllDMAsImpl() const override {
+		size_t discarded = 0;
+		for (std::uint32_t n = 0; n < m_captures.size(); ++n) {
+			discarded += cleanDMAImpl(n);
+		}
+		return discarded;
+	}
+
+	bool isDMAEnableImpl(const std::uint32_t n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		return c.enabled;
+	}
+
+	void enaDisDMAImpl(const std::uint32_t n, bool enaDis) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		c.enabled = enaDis;
+	}
+
+	std::uint16_t getAllDMAOverflowsImpl() const override {
+		std::uint16_t overflows = 0;
+		for (size_t n = 0; n < m_captures.size(); ++n) {
+			std::lock_guard<std::mutex> lock(m_captures[n]->mutex);
+			if (m_captures[n]->overflow) {
+				overflows |= static_cast<std::uint16_t>(1u << n);
+			}
+		}
+		return overflows;
+	}
+
+	using TerminalsDMADAQImpl::readDataImpl;
+
+	// Blocking reads wait for the recorded arrival time, not the FPGA, so
+	// the wait policy does not apply
+	size_t readDataImpl(const std::uint32_t n, size_t elementsToRead,
+			std::uint64_t *data, bool blockRead, std::uint32_t timeout,
+			const WaitPolicy&) const override {
+		const bool stats = isReadStatsEnabledImpl();
+		const auto start = stats ? std::chrono::steady_clock::now() :
+				std::chrono::steady_clock::time_point();
+		Capture &c = capture(n);
+		std::unique_lock<std::mutex> lock(c.mutex);
+		if (blockRead) {
+			try {
+				waitFor(n, &c, &lock, elementsToRead, timeout);
+			} catch (errors::DMAReadTimeout&) {
+				if (stats) {
+					recordReadTimeout(n);
+				}
+				throw;
+			}
+		}
+		const size_t available = c.available(m_speed);
+		const size_t elementsRead =
+				available < elementsToRead ? 0 : elementsToRead;
+		c.copyOut(data, elementsRead);
+		lock.unlock();
+
+		if (stats) {
+			recordRead(n, start, elementsRead, available);
+		}
+		return elementsRead;
+	}
+
+	size_t readDataMultiImpl(const std::vector<DMAReadRequest> &requests,
+			std::vector<DMAReadResult> *results, bool blockRead,
+			std::uint32_t timeout) const override {
+		const auto deadline = Clock::now() + std::chrono::milliseconds(timeout);
+		results->assign(requests.size(), DMAReadResult());
+
+		size_t completed = 0;
+		for (size_t i = 0; i < requests.size(); ++i) {
+			const DMAReadRequest &request = requests[i];
+			DMAReadResult &result = (*results)[i];
+			if (request.n >= m_captures.size()) {
+				result.status = DMAReadStatus::NotFound;
+				continue;
+			}
+
+			// Once the deadline has passed, only what has arrived is read
+			std::uint32_t left = 0;
+			bool block = blockRead;
+			if (blockRead && timeout != 0) {
+				const auto ms = std::chrono::duration_cast<
+						std::chrono::milliseconds>(deadline - Clock::now());
+				left = static_cast<std::uint32_t>(std::max<std::int64_t>(
+						ms.count(), 0));
+				block = left != 0;
+			}
+			try {
+				result.elementsRead = readDataImpl(request.n, request.elements,
+						request.data, block, left);
+			} catch (errors::DMAReadTimeout&) {
+			}
+			if (result.elementsRead == request.elements) {
+				++completed;
+			} else {
+				result.status = blockRead ?
+						DMAReadStatus::Timeout : DMAReadStatus::NotEnough;
+			}
+		}
+		return completed;
+	}
+
+	size_t getElementsAvailableImpl(const std::uint32_t n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		return c.available(m_speed);
+	}
+
+	NiFpga_IrqContext reserveIrqContextImpl() const override {
+		throwNoIrqs();
+	}
+
+	void unreserveIrqContextImpl(NiFpga_IrqContext) const noexcept override {
+	}
+
+	std::uint32_t waitOnIrqsImpl(NiFpga_IrqContext, const std::uint32_t,
+			const std::uint32_t) const override {
+		throwNoIrqs();
+	}
+
+	void acknowledgeIrqsImpl(const std::uint32_t) const override {
+		throwNoIrqs();
+	}
+
+	size_t readAvailableImpl(const std::uint32_t n, size_t maxElements,
+			std::uint64_t *data, size_t minElements,
+			size_t *elementsRemaining) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		if (minElements == 0) {
+			minElements = 1;
+		}
+		const std::uint64_t available = c.available(m_speed);
+		const size_t groups = static_cast<size_t>(std::min<std::uint64_t>(
+				available / minElements, maxElements / minElements));
+		c.copyOut(data, groups * minElements);
+		if (elementsRemaining) {
+			*elementsRemaining = c.available(m_speed);
+		}
+		return groups * minElements;
+	}
+
+	DMADataView acquireDataImpl(const std::uint32_t n, size_t elements,
+			std::uint32_t timeout) const override {
+		Capture &c = capture(n);
+		std::unique_lock<std::mutex> lock(c.mutex);
+		waitFor(n, &c, &lock, elements, timeout);
+
+		DMADataView view;
+		Capture::Acquisition acquisition{elements, {}};
+		const size_t offset = c.position % c.chunkElements;
+		const size_t inChunk = c.chunkElements - offset;
+		if (elements <= inChunk + c.chunkElements) {
+			// Views of the mapped file: the rest of the current chunk and
+			// the start of the next one
+			const std::uint64_t chunk = c.position / c.chunkElements;
+			view.first = c.data[chunk] + offset;
+			view.firstSize = std::min(elements, inChunk);
+			if (elements > inChunk) {
+				view.second = c.data[chunk + 1];
+				view.secondSize = elements - inChunk;
+			}
+			c.advance(elements);
+		} else {
+			acquisition.copy.resize(elements);
+			c.copyOut(acquisition.copy.data(), elements);
+			view.first = acquisition.copy.data();
+			view.firstSize = elements;
+		}
+		c.acquisitions.push_back(std::move(acquisition));
+		return view;
+	}
+
+	void releaseDataImpl(const std::uint32_t n,
+			size_t elements) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		while (elements > 0) {
+			if (c.acquisitions.empty()) {
+				throw errors::DMAReplayError("Releasing more elements of "
+						+ std::string(NAME_REPLAY_DMA) + std::to_string(n)
+						+ " than acquired");
+			}
+			Capture::Acquisition &front = c.acquisitions.front();
+			if (elements < front.elements) {
+				// The copy, if any, is kept until the rest is released
+				front.elements -= elements;
+				break;
+			}
+			elements -= front.elements;
+			c.acquisitions.pop_front();
+		}
+	}
+
+	std::uint16_t getSamplingRateDecimation(
+			const std::uint32_t &n) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		return c.decimation;
+	}
+
+	void setSamplingRateDecimation(const std::uint32_t &n,
+			const std::uint16_t &decimation) const override {
+		Capture &c = capture(n);
+		std::lock_guard<std::mutex> lock(c.mutex);
+		c.decimation = decimation;
+	}
+
+	/**
+	 * Maps the files
+	 */
+	static std::vector<std::unique_ptr<Capture>> mapCaptures(
+			const std::vector<std::string> &paths);
+
+ private:
+	[[noreturn]] static void throwNoIrqs() {
+		throw errors::DMAReplayError(
+				"IRQs are not available when replaying captures");
+	}
+
+	template<typename T>
+	static std::vector<T> collect(
+			const std::vector<std::unique_ptr<Capture>> &captures,
+			T record::FileHeader::*field) {
+		std::vector<T> values;
+		for (const auto &c : captures) {
+			values.push_back(c->header.*field);
+		}
+		return values;
+	}
+
+	static std::vector<FrameType> frameTypes(
+			const std::vector<std::unique_ptr<Capture>> &captures) {
+		std::vector<FrameType> values;
+		for (const auto &c : captures) {
+			values.push_back(static_cast<FrameType>(c->header.frameType));
+		}
+		return values;
+	}
+
+	/**
+	 * Waits until the elements are available, as the FPGA would write them
+	 *
+	 * @throw irio::errors::DMAReadTimeout The elements do not arrive within
+	 * 									   the timeout, or never will
+	 */
+	void waitFor(const std::uint32_t n, Capture *c,
+			std::unique_lock<std::mutex> *lock, const size_t elements,
+			const std::uint32_t timeout) const {
+		const auto deadline = Clock::now() + std::chrono::milliseconds(timeout);
+		while (true) {
+			const std::uint64_t target = c->position + elements;
+			if (!c->started || target > c->total()) {
+				throw errors::DMAReadTimeout(NAME_REPLAY_DMA, n);
+			}
+			if (c->arrived(m_speed) >= target) {
+				return;
+			}
+
+			// Capture time when the chunk completing the request was read
+			const std::uint64_t due = c->due[(target - 1) / c->chunkElements];
+			const auto wake = c->wallStart + std::chrono::nanoseconds(
+					static_cast<std::int64_t>((due - c->captureStart)
+							/ m_speed));
+			if (timeout != 0 && wake > deadline) {
+				lock->unlock();
+				std::this_thread::sleep_until(deadline);
+				lock->lock();
+				if (c->started && c->arrived(m_speed) >= target) {
+					return;
+				}
+				throw errors::DMAReadTimeout(NAME_REPLAY_DMA, n);
+			}
+			lock->unlock();
+			std::this_thread::sleep_until(wake);
+			lock->lock();
+		}
+	}
+
+	std::vector<std::unique_ptr<Capture>> m_captures;
+	const double m_speed;
+};
+
+std::vector<std::unique_ptr<DMAReplay::Capture>>
+DMAReplay::Impl::mapCaptures(const std::vector<std::string> &paths) {
+	if (paths.empty()) {
+		throw errors::DMAReplayError("No capture to replay");
+	}
+	if (paths.size() > 16) {
+		throw errors::DMAReplayError("At most 16 captures can be replayed");
+	}
+	std::vector<std::unique_ptr<Capture>> captures;
+	for (const auto &path : paths) {
+		captures.emplace_back(new Capture(path));
+	}
+	return captures;
+}
+
+DMAReplay::DMAReplay(const std::vector<std::string> &paths,
+		const DMAReplayConfig &config) :
+		m_impl(std::make_shared<Impl>(Impl::mapCaptures(paths), config)) {
+}
+
+TerminalsDMADAQ DMAReplay::getTerminalsDAQ() const {
+	return TerminalsDMADAQ(m_impl);
+}
+
+record::FileHeader DMAReplay::getHeader(const std::uint32_t n) const {
+	return m_impl->capture(n).header;
+}
+
+std::string DMAReplay::getSignature(const std::uint32_t n) const {
+	return m_impl->capture(n).header.signature;
+}
+
+std::uint64_t DMAReplay::getTotalElements(const std::uint32_t n) const {
+	return m_impl->capture(n).total();
+}
+
+bool DMAReplay::isFinished(const std::uint32_t n) const {
+	Capture &c = m_impl->capture(n);
+	std::lock_guard<std::mutex> lock(c.mutex);
+	return c.position == c.total();
+}
+
+}  // namespace irio
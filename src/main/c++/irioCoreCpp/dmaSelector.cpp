@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "dmaSelector.h"
+#include "errorsIrio.h"
+#include "terminals/impl/terminalsDMACommonImpl.h"
+
+namespace irio {
+
+namespace {
+/// Mask selecting every DMA of the set in scans
+constexpr std::uint32_t ALL_DMAS = 0xFFFFFFFF;
+}  // namespace
+
+DMASelector::DMASelector(const TerminalsDMACommon &terminals,
+		const std::vector<std::uint32_t> &dmas,
+		const DMASelectorConfig &config) :
+		m_terminals(terminals), m_dmas(dmas), m_available(dmas.size(), 0),
+		m_allIrqs(0), m_irqContext(nullptr),
+		m_minPollInterval(std::max<std::uint32_t>(1, config.minPollInterval)),
+		m_maxPollInterval(std::max(m_minPollInterval, config.maxPollInterval)),
+		m_pollInterval(m_minPollInterval) {
+	const auto impl = std::static_pointer_cast<TerminalsDMACommonImpl>(
+			m_terminals.m_impl);
+	for (const auto n : m_dmas) {
+		if (!impl->hasDMAImpl(n)) {
+			throw errors::ResourceNotFoundError(n, "DMA");
+		}
+	}
+
+	if (config.dataReadyIrqs.empty()) {
+		return;
+	}
+	if (config.dataReadyIrqs.size() != m_dmas.size()) {
+		throw errors::DMASelectorError(
+				"Expected one data ready IRQ per DMA, got "
+						+ std::to_string(config.dataReadyIrqs.size())
+						+ " for " + std::to_string(m_dmas.size()) + " DMAs");
+	}
+	for (const auto irq : config.dataReadyIrqs) {
+		if (irq >= 32) {
+			throw errors::DMASelectorError(
+					"IRQ " + std::to_string(irq) + " out of range");
+		}
+		m_irqMasks.push_back(1u << irq);
+		m_allIrqs |= m_irqMasks.back();
+	}
+
+	m_irqContext = std::static_pointer_cast<TerminalsDMACommonImpl>(
+			m_terminals.m_impl)->reserveIrqContextImpl();
+}
+
+DMASelector::~DMASelector() {
+	if (m_irqContext) {
+		std::static_pointer_cast<TerminalsDMACommonImpl>(m_terminals.m_impl)
+				->unreserveIrqContextImpl(m_irqContext);
+	}
+}
+
+size_t DMASelector::select(const size_t minElements,
+		const std::uint32_t timeout, std::vector<std::uint32_t> *ready) {
+	ready->clear();
+	if (m_irqContext) {
+		return selectIrqs(minElements, timeout, ready);
+	}
+	return selectPolling(minElements, timeout, ready);
+}
+
+size_t DMASelector::getElementsAvailable(const std::uint32_t n) const {
+	for (size_t i = 0; i < m_dmas.size(); ++i) {
+		if (m_dmas[i] == n) {
+			return m_available[i];
+		}
+	}
+	throw errors::ResourceNotFoundError(n, "selected DMA");
+}
+
+bool DMASelector::usesIrqs() const {
+	return m_irqContext != nullptr;
+}
+
+size_t DMASelector::scan(const size_t minElements, const std::uint32_t irqs,
+		std::vector<std::uint32_t> *ready) {
+	const auto impl = std::static_pointer_cast<TerminalsDMACommonImpl>(
+			m_terminals.m_impl);
+	for (size_t i = 0; i < m_dmas.size(); ++i) {
+		if (irqs != ALL_DMAS && !(m_irqMasks[i] & irqs)) {
+			continue;
+		}
+		m_available[i] = impl->getElementsAvailableImpl(m_dmas[i]);
+		if (m_available[i] >= minElements) {
+			ready->push_back(m_dmas[i]);
+		}
+	}
+	return ready->size();
+}
+
+size_t DMASelector::selectIrqs(const size_t minElements,
+		const std::uint32_t timeout, std::vector<std::uint32_t> *ready) {
+	using std::chrono::steady_clock;
+	const auto impl = std::static_pointer_cast<TerminalsDMACommonImpl>(
+			m_terminals.m_impl);
+	const auto deadline = steady_clock::now()
+			+ std::chrono::milliseconds(timeout);
+
+	// Data may be pending from IRQs acknowledged in previous calls
+	if (scan(minElements, ALL_DMAS, ready) > 0) {
+		return ready->size();
+	}
+
+	while (true) {
+		const auto now = steady_clock::now();
+		if (now >= deadline) {
+			return 0;
+		}
+		const auto left = std::chrono::duration_cast<
+				std::chrono::milliseconds>(deadline - now).count() + 1;
+		const std::uint32_t asserted = impl->waitOnIrqsImpl(m_irqContext,
+				m_allIrqs, static_cast<std::uint32_t>(left));
+		if (asserted == 0) {
+			continue;
+		}
+		// Acknowledge before checking, so data arriving during the scan
+		// asserts the IRQ again
+		impl->acknowledgeIrqsImpl(asserted);
+		if (scan(minElements, asserted, ready) > 0) {
+			return ready->size();
+		}
+	}
+}
+
+size_t DMASelector::selectPolling(const size_t minElements,
+		const std::uint32_t timeout, std::vector<std::uint32_t> *ready) {
+	using std::chrono::steady_clock;
+	const auto deadline = steady_clock::now()
+			+ std::chrono::milliseconds(timeout);
+
+	// Found without sleeping: the DMAs produce faster than the interval
+	if (scan(minElements, ALL_DMAS, ready) > 0) {
+		m_pollInterval = std::max(m_minPollInterval, m_pollInterval / 2);
+		return ready->size();
+	}
+
+	while (true) {
+		const auto now = steady_clock::now();
+		if (now >= deadline) {
+			return 0;
+		}
+		std::this_thread::sleep_for(std::min<steady_clock::duration>(
+				std::chrono::microseconds(m_pollInterval), deadline - now));
+		if (scan(minElements, ALL_DMAS, ready) > 0) {
+			return ready->size();
+		}
+		m_pollInterval = std::min(m_maxPollInterval, m_pollInterval * 2);
+	}
+}
+
+}  // namespace irio
@@ -0,0 +1,292 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#include "dmaStreamer.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+// A zero read timeout would make the readers spin on DMAReadTimeout, or
+// wait forever without seeing stop()
+DMAStreamerConfig checkConfig(DMAStreamerConfig config) {
+	config.blocksPerChunk = std::max<size_t>(1, config.blocksPerChunk);
+	config.ringChunks = std::max<size_t>(1, config.ringChunks);
+	config.readTimeout = std::max<std::uint32_t>(1, config.readTimeout);
+	return config;
+}
+
+}  // namespace
+
+/**
+ * Per DMA state: the SPSC ring and the threads serving it.
+ *
+ * m_head is only written by the reader thread and m_tail only by the
+ * consumer. Both are monotonic counters, the slot is obtained with
+ * the modulo of the number of slots. They are kept in different cache
+ * lines so producer and consumer do not invalidate each other.
+ */
+class DMAStreamer::Channel {
+ public:
+	Channel(const std::uint32_t dma, const size_t elements,
+			const size_t numSlots) :
+			n(dma), chunkElements(elements), slots(numSlots),
+			ring(elements * numSlots), discard(elements) {
+	}
+
+	std::uint64_t* slot(const size_t index) {
+		return ring.data() + (index % slots) * chunkElements;
+	}
+
+	const std::uint32_t n;
+	const size_t chunkElements;
+	const size_t slots;
+
+	std::vector<std::uint64_t> ring;
+	/// Destination of the chunks read while the ring is full
+	std::vector<std::uint64_t> discard;
+
+	std::atomic<size_t> head{0};
+	char padHead[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail{0};
+	char padTail[64 - sizeof(std::atomic<size_t>)];
+
+	std::atomic<std::uint64_t> chunksRead{0};
+	std::atomic<std::uint64_t> chunksDelivered{0};
+	std::atomic<std::uint64_t> chunksDropped{0};
+	std::atomic<std::uint64_t> timeouts{0};
+	std::atomic<bool> failed{false};
+
+	/// Protects lastError and is used to wait for data
+	mutable std::mutex mutex;
+	std::condition_variable dataReady;
+	std::string lastError;
+
+	std::thread reader;
+	std::thread delivery;
+};
+
+DMAStreamer::DMAStreamer(const TerminalsDMADAQ &daq,
+		const std::vector<std::uint32_t> &dmas,
+		const DMAStreamerConfig &config) :
+		m_daq(daq), m_config(checkConfig(config)), m_running(false) {
+	for (const auto n : dmas) {
+		const size_t elements = m_daq.getElementsPerBlock(n)
+				* m_config.blocksPerChunk;
+		m_channels.emplace_back(new Channel(n, elements,
+				m_config.ringChunks));
+	}
+}
+
+DMAStreamer::~DMAStreamer() {
+	stop();
+}
+
+void DMAStreamer::setCallback(const Callback &callback) {
+	if (m_running) {
+		throw errors::DMAStreamerError(
+				"Callback cannot be changed while the streamer is running");
+	}
+	m_callback = callback;
+}
+
+void DMAStreamer::start() {
+	if (m_running) {
+		return;
+	}
+	m_running = true;
+
+	try {
+		for (size_t i = 0; i < m_channels.size(); ++i) {
+			Channel *channel = m_channels[i].get();
+			channel->failed = false;
+			channel->reader = std::thread(&DMAStreamer::readerLoop, this,
+					channel);
+			applyThreadConfig(&channel->reader, i);
+			if (m_callback) {
+				channel->delivery = std::thread(&DMAStreamer::deliveryLoop,
+						this, channel);
+			}
+		}
+	} catch (...) {
+		stop();
+		throw;
+	}
+}
+
+void DMAStreamer::stop() {
+	m_running = false;
+	for (auto &channel : m_channels) {
+		{  // Orders the flag with the check of the waiting threads
+			std::lock_guard<std::mutex> lock(channel->mutex);
+		}
+		channel->dataReady.notify_all();
+		if (channel->reader.joinable()) {
+			channel->reader.join();
+		}
+		if (channel->delivery.joinable()) {
+			channel->delivery.join();
+		}
+	}
+}
+
+bool DMAStreamer::isRunning() const {
+	return m_running;
+}
+
+size_t DMAStreamer::getChunkElements(const std::uint32_t n) const {
+	return getChannel(n).chunkElements;
+}
+
+const std::uint64_t* DMAStreamer::front(const std::uint32_t n,
+		const std::uint32_t timeout) {
+	if (m_callback) {
+		throw errors::DMAStreamerError(
+				"Pull API not available when a callback is registered");
+	}
+
+	Channel &channel = getChannel(n);
+	const size_t tail = channel.tail.load(std::memory_order_relaxed);
+	if (channel.head.load(std::memory_order_acquire) == tail) {
+		if (timeout == 0) {
+			return nullptr;
+		}
+		std::unique_lock<std::mutex> lock(channel.mutex);
+		const bool ready = channel.dataReady.wait_for(lock,
+				std::chrono::milliseconds(timeout), [&channel, tail] {
+					return channel.head.load(std::memory_order_acquire)
+							!= tail;
+				});
+		if (!ready) {
+			return nullptr;
+		}
+	}
+
+	return channel.slot(tail);
+}
+
+void DMAStreamer::pop(const std::uint32_t n) {
+	Channel &channel = getChannel(n);
+	const size_t tail = channel.tail.load(std::memory_order_relaxed);
+	if (channel.head.load(std::memory_order_acquire) == tail) {
+		return;
+	}
+	channel.tail.store(tail + 1, std::memory_order_release);
+	channel.chunksDelivered.fetch_add(1, std::memory_order_relaxed);
+}
+
+DMAStreamerStats DMAStreamer::getStats(const std::uint32_t n) const {
+	const Channel &channel = getChannel(n);
+
+	DMAStreamerStats stats;
+	stats.chunksRead = channel.chunksRead;
+	stats.chunksDelivered = channel.chunksDelivered;
+	stats.chunksDropped = channel.chunksDropped;
+	stats.timeouts = channel.timeouts;
+	stats.failed = channel.failed;
+	std::lock_guard<std::mutex> lock(channel.mutex);
+	stats.lastError = channel.lastError;
+	return stats;
+}
+
+DMAStreamer::Channel& DMAStreamer::getChannel(const std::uint32_t n) const {
+	for (const auto &channel : m_channels) {
+		if (channel->n == n) {
+			return *channel;
+		}
+	}
+	throw errors::ResourceNotFoundError(n, "streamed DMA");
+}
+
+void DMAStreamer::readerLoop(Channel *channel) {
+	while (m_running) {
+		const size_t head = channel->head.load(std::memory_order_relaxed);
+		const size_t tail = channel->tail.load(std::memory_order_acquire);
+		const bool full = head - tail >= channel->slots;
+		std::uint64_t *dst = full ? channel->discard.data() :
+				channel->slot(head);
+
+		try {
+			m_daq.readDataBlocking(channel->n, channel->chunkElements, dst,
+					m_config.readTimeout);
+		} catch (errors::DMAReadTimeout&) {
+			channel->timeouts.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		} catch (std::exception &e) {
+			std::lock_guard<std::mutex> lock(channel->mutex);
+			channel->lastError = e.what();
+			channel->failed = true;
+			break;
+		}
+
+		channel->chunksRead.fetch_add(1, std::memory_order_relaxed);
+		if (full) {
+			channel->chunksDropped.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			channel->head.store(head + 1, std::memory_order_release);
+			{  // Orders the push with the check of the waiting consumer
+				std::lock_guard<std::mutex> lock(channel->mutex);
+			}
+			channel->dataReady.notify_one();
+		}
+	}
+}
+
+void DMAStreamer::deliveryLoop(Channel *channel) {
+	while (true) {
+		const size_t tail = channel->tail.load(std::memory_order_relaxed);
+		if (channel->head.load(std::memory_order_acquire) == tail) {
+			if (!m_running) {
+				break;
+			}
+			std::unique_lock<std::mutex> lock(channel->mutex);
+			channel->dataReady.wait(lock, [this, channel, tail] {
+				return !m_running || channel->head.load(
+						std::memory_order_acquire) != tail;
+			});
+			continue;
+		}
+
+		m_callback(channel->n, channel->slot(tail), channel->chunkElements);
+		channel->tail.store(tail + 1, std::memory_order_release);
+		channel->chunksDelivered.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void DMAStreamer::applyThreadConfig(std::thread *thread,
+		const size_t index) const {
+	if (!m_config.cpuAffinity.empty()) {
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(m_config.cpuAffinity[index % m_config.cpuAffinity.size()],
+				&cpus);
+		const int err = pthread_setaffinity_np(thread->native_handle(),
+				sizeof(cpu_set_t), &cpus);
+		if (err != 0) {
+			throw errors::DMAStreamerError(
+					std::string("Unable to set reader CPU affinity: ")
+							+ std::strerror(err));
+		}
+	}
+
+	if (m_config.rtPriority > 0) {
+		sched_param param;
+		param.sched_priority = m_config.rtPriority;
+		const int err = pthread_setschedparam(thread->native_handle(),
+				SCHED_FIFO, &param);
+		if (err != 0) {
+			throw errors::DMAStreamerError(
+					std::string("Unable to set reader real-time priority: ")
+							+ std::strerror(err));
+		}
+	}
+}
+
+}  // namespace irio
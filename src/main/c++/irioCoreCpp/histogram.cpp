@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "histogram.h"
+
+namespace irio {
+
+double HistogramSnapshot::mean() const {
+	return count == 0 ? 0 : static_cast<double>(sum) / count;
+}
+
+std::uint64_t HistogramSnapshot::percentile(const double percent) const {
+	if (count == 0) {
+		return 0;
+	}
+
+	const double clamped = std::min(std::max(percent, 0.0), 100.0);
+	const auto rank = std::max<std::uint64_t>(1,
+			static_cast<std::uint64_t>(std::ceil(clamped / 100 * count)));
+	std::uint64_t seen = 0;
+	for (size_t i = 0; i < buckets.size(); ++i) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			return std::min(max,
+					std::max(min, Histogram::bucketUpperBound(i)));
+		}
+	}
+	return max;
+}
+
+Histogram::Histogram() {
+	reset();
+}
+
+void Histogram::record(const std::uint64_t value) noexcept {
+	std::uint64_t current = m_min.load(std::memory_order_relaxed);
+	while (value < current && !m_min.compare_exchange_weak(current, value,
+			std::memory_order_relaxed)) {
+	}
+	current = m_max.load(std::memory_order_relaxed);
+	while (value > current && !m_max.compare_exchange_weak(current, value,
+			std::memory_order_relaxed)) {
+	}
+
+	// Counted last, so a snapshot with values has their min and max
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+	m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_release);
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+	HistogramSnapshot snapshot;
+	snapshot.buckets.resize(BUCKETS);
+	for (size_t i = 0; i < BUCKETS; ++i) {
+		snapshot.buckets[i] = m_buckets[i].load(std::memory_order_acquire);
+		snapshot.count += snapshot.buckets[i];
+	}
+	if (snapshot.count != 0) {
+		snapshot.sum = m_sum.load(std::memory_order_relaxed);
+		snapshot.min = m_min.load(std::memory_order_relaxed);
+		snapshot.max = m_max.load(std::memory_order_relaxed);
+	}
+	return snapshot;
+}
+
+void Histogram::reset() noexcept {
+	for (auto &bucket : m_buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	m_sum.store(0, std::memory_order_relaxed);
+	m_min.store(std::numeric_limits<std::uint64_t>::max(),
+			std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+size_t Histogram::bucketOf(const std::uint64_t value) noexcept {
+	if (value < SUB_BUCKETS) {
+		return static_cast<size_t>(value);
+	}
+	// Values in [2^msb, 2^(msb+1)) keep their SUB_BUCKET_BITS bits below
+	// the most significant one
+	const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+	const unsigned shift = msb - SUB_BUCKET_BITS;
+	return (shift + 1) * SUB_BUCKETS
+			+ static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+}
+
+std::uint64_t Histogram::bucketLowerBound(const size_t bucket) noexcept {
+	if (bucket < SUB_BUCKETS) {
+		return bucket;
+	}
+	const size_t shift = bucket / SUB_BUCKETS - 1;
+	return static_cast<std::uint64_t>(bucket % SUB_BUCKETS + SUB_BUCKETS)
+			<< shift;
+}
+
+std::uint64_t Histogram::bucketUpperBound(const size_t bucket) noexcept {
+	return bucket + 1 >= BUCKETS ? std::numeric_limits<std::uint64_t>::max() :
+			bucketLowerBound(bucket + 1) - 1;
+}
+
+}  // namespace irio
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace irio {
+
+/**
+ * Asynchronous positional writer used by DMARecorder.
+ *
+ * Writes are queued with submit(), handed to the kernel with flush() and
+ * their results collected with reap(). Up to the depth given when the
+ * writer was created can be in flight. submit(), flush() and reap() must
+ * be called from the same thread. With O_DIRECT files the data, size and
+ * offset must be multiples of the logical block size of the device.
+ *
+ * @ingroup DMATerminals
+ */
+class AsyncWriter {
+ public:
+	/**
+	 * Result of a write
+	 */
+	struct Completion {
+		std::uint64_t tag;	/**< Tag given to submit() */
+		/// Bytes written or negated errno
+		std::int64_t result;
+	};
+
+	virtual ~AsyncWriter() = default;
+
+	/**
+	 * Queues a write. The data must not be modified until its completion
+	 * has been reaped
+	 *
+	 * @param data		Data to write
+	 * @param size		Bytes to write
+	 * @param offset	Offset in the file
+	 * @param tag		Value returned with the completion
+	 */
+	virtual void submit(const void *data, const size_t size,
+			const std::uint64_t offset, const std::uint64_t tag) = 0;
+
+	/**
+	 * Hands the queued writes to the kernel
+	 */
+	virtual void flush() = 0;
+
+	/**
+	 * Collects the results of finished writes
+	 *
+	 * @param completions	Output buffer
+	 * @param max			Size of \p completions
+	 * @param min			Completions to wait for. Must not be more than
+	 * 						the writes in flight
+	 * @return Number of completions written in \p completions
+	 */
+	virtual size_t reap(Completion *completions, const size_t max,
+			const size_t min) = 0;
+
+	/**
+	 * Returns the name of the implementation
+	 *
+	 * @return "io_uring" or "threads"
+	 */
+	virtual std::string getName() const = 0;
+};
+
+/**
+ * Creates a writer for a file, using io_uring if the kernel allows it or a
+ * pool of threads calling pwrite() otherwise
+ *
+ * @throw irio::errors::DMARecorderError Unable to create the writer
+ *
+ * @param fd			File descriptor open for writing
+ * @param depth			Max writes in flight
+ * @param threads		Threads of the pool, if it is used
+ * @param useIoUring	Whether to try io_uring
+ * @return New writer
+ */
+std::unique_ptr<AsyncWriter> makeAsyncWriter(const int fd,
+		const unsigned depth, const unsigned threads, const bool useIoUring);
+
+}  // namespace irio
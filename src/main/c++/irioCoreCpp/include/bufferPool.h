@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "terminals/terminalsDMADAQ.h"
+#include "terminals/terminalsDMAIMAQ.h"
+
+namespace irio {
+
+/**
+ * Pages backing the memory of a BufferPool
+ *
+ * @ingroup DMATerminals
+ */
+enum class PageBacking : std::uint8_t {
+	Normal,		/**< Regular pages */
+	Transparent,	/**< Regular pages the kernel is advised to merge into
+						 transparent huge pages */
+	HugeTLB		/**< Huge pages reserved in hugetlbfs */
+};
+
+/**
+ * Configuration of a BufferPool
+ *
+ * @ingroup DMATerminals
+ */
+struct BufferPoolConfig {
+	/// Number of buffers in the pool
+	size_t buffers = 8;
+	/// Pages requested for the memory of the pool
+	PageBacking pages = PageBacking::Transparent;
+	/// Use regular pages if the huge pages requested cannot be allocated
+	/// instead of throwing
+	bool fallback = true;
+	/// Lock the memory in RAM, so it is never swapped out
+	bool lockMemory = true;
+	/// Continue without locking if the memory lock limit does not allow
+	/// it instead of throwing
+	bool lockOptional = true;
+	/// NUMA node where the memory is allocated, usually Irio::getNumaNode.
+	/// -1 to use the policy of the calling thread
+	int numaNode = -1;
+};
+
+/**
+ * Preallocated buffers for the data read from the DMAs.
+ *
+ * All the buffers are carved from a single mapping done at construction,
+ * so reading into them never allocates. Each buffer starts at a page
+ * boundary and holds a whole number of DAQ blocks or whole images, as
+ * given by the metadata of the terminals. The mapping can be backed by
+ * huge pages to reduce the TLB misses of the FIFO copies, bound to the
+ * NUMA node of the RIO device and locked in RAM. It is written once at
+ * construction, so the page faults are not paid in the first reads.
+ *
+ * Buffers are taken with acquire() and returned with release(), which can
+ * be called from any thread. Allocation failures are reported at
+ * construction; the optional features that could not be honored are
+ * reported by getPageBacking(), isLocked() and isNumaBound().
+ *
+ * @ingroup DMATerminals
+ */
+class BufferPool {
+ public:
+	/**
+	 * Allocates buffers of an arbitrary number of elements
+	 *
+	 * @throw irio::errors::BufferPoolError Unable to allocate, or to honor
+	 * 										a feature that is not optional
+	 *
+	 * @param bufferElements	Elements of each buffer
+	 * @param config			Pool configuration
+	 */
+	explicit BufferPool(const size_t bufferElements,
+			const BufferPoolConfig &config = BufferPoolConfig());
+
+	/**
+	 * Allocates buffers holding whole blocks of a DAQ DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 * @throw irio::errors::BufferPoolError Unable to allocate, or to honor
+	 * 										a feature that is not optional
+	 *
+	 * @param daq		DAQ terminals with the DMA
+	 * @param n			Number of DMA group
+	 * @param blocks	Blocks of each buffer, see
+	 * 					TerminalsDMADAQ::getElementsPerBlock
+	 * @param config	Pool configuration
+	 */
+	BufferPool(const TerminalsDMADAQ &daq, const std::uint32_t n,
+			const size_t blocks,
+			const BufferPoolConfig &config = BufferPoolConfig());
+
+	/**
+	 * Allocates buffers holding whole images of an IMAQ DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 * @throw irio::errors::BufferPoolError Unable to allocate, or to honor
+	 * 										a feature that is not optional
+	 *
+	 * @param imaq				IMAQ terminals with the DMA
+	 * @param n					Number of DMA group
+	 * @param imagePixelSize	Size of the images in pixels, as passed to
+	 * 							TerminalsDMAIMAQ::readImage
+	 * @param images			Images of each buffer
+	 * @param config			Pool configuration
+	 */
+	BufferPool(const TerminalsDMAIMAQ &imaq, const std::uint32_t n,
+			const size_t imagePixelSize, const size_t images = 1,
+			const BufferPoolConfig &config = BufferPoolConfig());
+
+	/**
+	 * Unmaps the memory. The buffers must not be used afterwards
+	 */
+	~BufferPool();
+
+	BufferPool(const BufferPool&) = delete;
+	BufferPool& operator=(const BufferPool&) = delete;
+
+	/**
+	 * Takes a free buffer from the pool without waiting
+	 *
+	 * @return Buffer of getBufferElements() elements, nullptr if all of
+	 * 		   them are in use
+	 */
+	std::uint64_t* acquire();
+
+	/**
+	 * Returns a buffer to the pool
+	 *
+	 * @throw irio::errors::BufferPoolError The buffer does not belong to the
+	 * 										pool or is already free
+	 *
+	 * @param buffer Buffer obtained with acquire()
+	 */
+	void release(std::uint64_t *buffer);
+
+	/**
+	 * Returns a buffer by its position, whether it is free or not
+	 *
+	 * @throw irio::errors::BufferPoolError Index out of range
+	 *
+	 * @param index Position of the buffer, lower than countBuffers()
+	 * @return Buffer
+	 */
+	std::uint64_t* getBuffer(const size_t index) const;
+
+	/**
+	 * Returns the number of elements of each buffer
+	 *
+	 * @return Elements usable in each buffer
+	 */
+	size_t getBufferElements() const;
+
+	/**
+	 * Returns the bytes between the start of two consecutive buffers
+	 *
+	 * @return Buffer size rounded up to the page size
+	 */
+	size_t getBufferStride() const;
+
+	/**
+	 * Returns the number of buffers in the pool
+	 *
+	 * @return Number of buffers
+	 */
+	size_t countBuffers() const;
+
+	/**
+	 * Returns the number of buffers not acquired
+	 *
+	 * @return Number of free buffers
+	 */
+	size_t countFree() const;
+
+	/**
+	 * Returns the pages that back the pool, which may differ from the ones
+	 * requested if BufferPoolConfig::fallback is set
+	 *
+	 * @return Pages used
+	 */
+	PageBacking getPageBacking() const;
+
+	/**
+	 * Returns whether the memory is locked in RAM
+	 *
+	 * @return True if locked
+	 */
+	bool isLocked() const;
+
+	/**
+	 * Returns whether the memory was bound to BufferPoolConfig::numaNode
+	 *
+	 * @return True if bound
+	 */
+	bool isNumaBound() const;
+
+ private:
+	void allocate(const BufferPoolConfig &config);
+
+	const size_t m_bufferElements;
+	const size_t m_stride;
+	const size_t m_buffers;
+
+	void *m_memory = nullptr;
+	size_t m_mappedBytes = 0;
+	PageBacking m_backing = PageBacking::Normal;
+	bool m_locked = false;
+	bool m_numaBound = false;
+
+	/// Protects m_free and m_inUse
+	mutable std::mutex m_mutex;
+	/// Indexes of the free buffers, used as a stack to reuse warm buffers
+	std::vector<size_t> m_free;
+	std::vector<bool> m_inUse;
+};
+
+}  // namespace irio
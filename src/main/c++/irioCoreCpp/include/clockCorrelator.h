@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "terminals/terminalsCommon.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Host clocks a ClockCorrelator can map the FPGA ticks onto
+ *
+ * @ingroup DMATerminals
+ */
+enum class HostClock : std::uint8_t {
+	Realtime,	/**< CLOCK_REALTIME, UTC as kept by NTP or PTP */
+	TAI			/**< CLOCK_TAI. Equal to Realtime unless the TAI offset
+					 has been set in the kernel, usually by ptp4l/phc2sys */
+};
+
+/**
+ * Configuration of a ClockCorrelator
+ *
+ * @ingroup DMATerminals
+ */
+struct ClockCorrelatorConfig {
+	/// Clock of the host times
+	HostClock clock = HostClock::Realtime;
+	/// Number of most recent tick/host time pairs used in the fit
+	size_t window = 64;
+	/// Nanoseconds between the FPGA taking a timestamp and the host time
+	/// sampled for it, subtracted from every host time added. Covers the
+	/// constant part of the DMA latency when the pairs are sampled on read
+	std::int64_t latencyNs = 0;
+};
+
+/**
+ * Linear relation between FPGA ticks and host time:
+ * host = hostRef + offsetNs + nsPerTick * (tick - tickRef)
+ *
+ * @ingroup DMATerminals
+ */
+struct ClockFit {
+	std::uint64_t tickRef = 0; /**< Tick of the oldest pair in the window */
+	std::int64_t hostRef = 0; /**< Host time of the oldest pair, in ns */
+	double offsetNs = 0; /**< Fitted host time at tickRef, from hostRef */
+	double nsPerTick = 0; /**< Fitted duration of a tick */
+	double residualNs = 0; /**< RMS error of the pairs against the fit */
+	size_t samples = 0; /**< Pairs used in the fit */
+};
+
+/**
+ * Maps FPGA timestamps onto host time.
+ *
+ * Pairs of FPGA tick and host time are fed with addSample() or sample(),
+ * or by reading with readBlocks(), which pairs the timestamp of the last
+ * block read with the time the read completed if the read drained the
+ * FIFO. A least squares line is
+ * fitted to the last ClockCorrelatorConfig::window pairs, giving the
+ * offset between both clocks and the drift of the FPGA oscillator. With
+ * a single pair the nominal tick duration from the reference clock of the
+ * FPGA (TerminalsCommon::getFref) is used.
+ *
+ * The host times sampled on read are late by the DMA latency. Its constant
+ * part can be removed with ClockCorrelatorConfig::latencyNs; the jitter is
+ * averaged out by the fit. Boards correlated against the same host clock,
+ * or against clocks disciplined by PTP, give times that can be merged
+ * directly.
+ *
+ * All methods can be called from several threads.
+ *
+ * @ingroup DMATerminals
+ */
+class ClockCorrelator {
+ public:
+	/**
+	 * Creates a correlator without pairs
+	 *
+	 * @throw irio::errors::ClockCorrelationError Zero reference clock or
+	 * 											  window
+	 *
+	 * @param fref		Frequency in Hz of the FPGA timestamps
+	 * @param config	Correlator configuration
+	 */
+	explicit ClockCorrelator(const std::uint32_t fref,
+			const ClockCorrelatorConfig &config = ClockCorrelatorConfig());
+
+	/**
+	 * Creates a correlator for the timestamps of a RIO device
+	 *
+	 * @throw irio::errors::ClockCorrelationError Zero reference clock or
+	 * 											  window
+	 *
+	 * @param common	Common terminals of the device, see
+	 * 					TerminalsCommon::getFref
+	 * @param config	Correlator configuration
+	 */
+	explicit ClockCorrelator(const TerminalsCommon &common,
+			const ClockCorrelatorConfig &config = ClockCorrelatorConfig());
+
+	/**
+	 * Returns the current time of a host clock
+	 *
+	 * @param clock Host clock to read
+	 * @return Nanoseconds since the epoch of \p clock
+	 */
+	static std::int64_t now(const HostClock clock);
+
+	/**
+	 * Adds a pair and updates the fit
+	 *
+	 * @param tick		FPGA timestamp
+	 * @param hostNs	Host time of \p tick in the configured clock, in ns.
+	 * 					ClockCorrelatorConfig::latencyNs is subtracted
+	 */
+	void addSample(const std::uint64_t tick, const std::int64_t hostNs);
+
+	/**
+	 * Adds a pair with the current host time and updates the fit
+	 *
+	 * @param tick FPGA timestamp that has just been observed
+	 */
+	void sample(const std::uint64_t tick);
+
+	/**
+	 * Discards all the pairs
+	 */
+	void reset();
+
+	/**
+	 * Returns whether there is at least one pair to convert ticks
+	 *
+	 * @return True if toHost() can be used
+	 */
+	bool isValid() const;
+
+	/**
+	 * Converts an FPGA timestamp to host time
+	 *
+	 * @throw irio::errors::ClockCorrelationError No pair added yet
+	 *
+	 * @param tick FPGA timestamp
+	 * @return Host time in ns of the configured clock
+	 */
+	std::int64_t toHost(const std::uint64_t tick) const;
+
+	/**
+	 * Returns the current fit
+	 *
+	 * @return Fit, with ClockFit::samples 0 if there are no pairs
+	 */
+	ClockFit getFit() const;
+
+	/**
+	 * Returns the drift of the FPGA clock against the host clock
+	 *
+	 * @return Parts per million the FPGA ticks are slower than nominal,
+	 * 		   0 with less than two pairs
+	 */
+	double getDriftPpm() const;
+
+	/**
+	 * Returns the nominal frequency of the FPGA timestamps
+	 *
+	 * @return Frequency in Hz
+	 */
+	std::uint32_t getFref() const;
+
+	/**
+	 * Computes the host time of each FormatB block of a buffer
+	 *
+	 * Each block is lengthBlock + 2 words: word 0 is the header, word 1
+	 * the FPGA timestamp that gets converted, then the sample words.
+	 *
+	 * @throw irio::errors::ClockCorrelationError No pair added yet
+	 *
+	 * @param data			Buffer with consecutive FormatB blocks
+	 * @param elements		Number of words in \p data
+	 * @param lengthBlock	Number of sample words of each block, see
+	 * 						TerminalsDMADAQ::getLengthBlock
+	 * @param hostNs		Output with room for a time per whole block
+	 * @return Number of blocks stamped
+	 */
+	size_t stampBlocks(const std::uint64_t *data, const size_t elements,
+			const size_t lengthBlock, std::int64_t *hostNs) const;
+
+	/**
+	 * Reads whole FormatB blocks from a DMA, adds the timestamp of the last
+	 * one paired with the time the read completed, and stamps all of them.
+	 *
+	 * The pair is only added if less than a block remains in the FIFO after
+	 * the read. Otherwise the blocks were queued before the read and the
+	 * time it completed says nothing about when the last one arrived.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 * @throw irio::errors::ClockCorrelationError No pair added yet
+	 * @throw irio::errors::DAQFormatMismatchError The DMA is not FormatB
+	 * @throw irio::errors::DMAReadTimeout The timeout expired
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param daq		DAQ terminals
+	 * @param n			Number of DMA group
+	 * @param blocks	Number of blocks to read
+	 * @param data		Buffer with room for \p blocks blocks, see
+	 * 					TerminalsDMADAQ::getElementsPerBlock
+	 * @param hostNs	Output with room for \p blocks times
+	 * @param timeout	Max time in milliseconds to wait, 0 to wait
+	 * 					indefinitely
+	 * @return Number of blocks read
+	 */
+	size_t readBlocks(const TerminalsDMADAQ &daq, const std::uint32_t n,
+			const size_t blocks, std::uint64_t *data, std::int64_t *hostNs,
+			const std::uint32_t timeout = 0);
+
+ private:
+	/**
+	 * A tick/host time pair
+	 */
+	struct Sample {
+		std::uint64_t tick;
+		std::int64_t hostNs;
+	};
+
+	void fit();
+	std::int64_t toHostUnlocked(const std::uint64_t tick) const;
+
+	const std::uint32_t m_fref;
+	const ClockCorrelatorConfig m_config;
+	const double m_nominalNsPerTick;
+
+	/// Protects the pairs and the fit
+	mutable std::mutex m_mutex;
+	/// Ring with the last pairs, m_next is the oldest once full
+	std::vector<Sample> m_samples;
+	size_t m_next = 0;
+	ClockFit m_fit;
+};
+
+}  // namespace irio
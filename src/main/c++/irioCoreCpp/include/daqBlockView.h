@@ -0,0 +1,404 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+#include "errorsIrio.h"
+#include "frameTypes.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Layout of the words that precede the samples of a DAQ block
+ *
+ * @tparam F Frame type of the DMA
+ *
+ * @ingroup DMATerminals
+ */
+template<FrameType F>
+struct DAQFrameTraits;
+
+/**
+ * FormatA blocks only contain samples
+ *
+ * @ingroup DMATerminals
+ */
+template<>
+struct DAQFrameTraits<FrameType::FormatA> {
+	static constexpr size_t headerWords = 0; /**< Words before the samples */
+};
+
+/**
+ * FormatB blocks start with a header word followed by a timestamp word
+ *
+ * Layout of a block with lengthBlock sample words, in 64-bit words:
+ * | Word               | Content                         |
+ * |--------------------|---------------------------------|
+ * | 0                  | Header                          |
+ * | 1                  | FPGA timestamp, in Fref ticks   |
+ * | 2 .. lengthBlock+1 | Samples                         |
+ *
+ * @ingroup DMATerminals
+ */
+template<>
+struct DAQFrameTraits<FrameType::FormatB> {
+	static constexpr size_t headerWords = 2; /**< Words before the samples */
+};
+
+/**
+ * Integer type of a sample given its size in bytes
+ *
+ * @tparam SampleSize Size in bytes of a sample (1, 2, 4 or 8)
+ *
+ * @ingroup DMATerminals
+ */
+template<std::uint8_t SampleSize>
+struct DAQSampleTraits;
+
+template<>
+struct DAQSampleTraits<1> {
+	using type = std::int8_t;
+};
+
+template<>
+struct DAQSampleTraits<2> {
+	using type = std::int16_t;
+};
+
+template<>
+struct DAQSampleTraits<4> {
+	using type = std::int32_t;
+};
+
+template<>
+struct DAQSampleTraits<8> {
+	using type = std::int64_t;
+};
+
+/**
+ * Read-only view of one DAQ block.
+ *
+ * After the words described by DAQFrameTraits, a block contains
+ * lengthBlock words with the samples packed in little endian order, the
+ * first sample in the least significant bits of the word. Samples are
+ * interleaved by channel: sample 0 of channel 0, sample 0 of channel 1, ...,
+ * sample 1 of channel 0, ...
+ *
+ * Frame type and sample size are template parameters so the accessors
+ * compile to fixed offsets and shifts.
+ *
+ * @tparam F			Frame type of the DMA
+ * @tparam SampleSize	Size in bytes of a sample
+ *
+ * @ingroup DMATerminals
+ */
+template<FrameType F, std::uint8_t SampleSize>
+class DAQBlock {
+ public:
+	using Frame = DAQFrameTraits<F>;
+	using sample_type = typename DAQSampleTraits<SampleSize>::type;
+	/// Number of samples packed in a 64 bits word
+	static constexpr size_t samplesPerWord = sizeof(std::uint64_t) / SampleSize;
+
+	/**
+	 * Creates a view of a block
+	 *
+	 * @param block			Pointer to the first word of the block
+	 * @param lengthBlock	Number of sample words of the block
+	 * @param nCh			Number of channels in the block
+	 */
+	DAQBlock(const std::uint64_t *block, const size_t lengthBlock,
+			const std::uint16_t nCh) :
+			m_block(block), m_lengthBlock(lengthBlock), m_nCh(nCh) {
+	}
+
+	/**
+	 * Returns the number of words of the block, including header words
+	 *
+	 * @return Words of the block
+	 */
+	size_t words() const {
+		return Frame::headerWords + m_lengthBlock;
+	}
+
+	/**
+	 * Returns the first word of the block
+	 *
+	 * @return Pointer to the start of the block
+	 */
+	const std::uint64_t* raw() const {
+		return m_block;
+	}
+
+	/**
+	 * Returns the first word with samples
+	 *
+	 * @return Pointer to the samples of the block
+	 */
+	const std::uint64_t* payload() const {
+		return m_block + Frame::headerWords;
+	}
+
+	/**
+	 * Returns the header word of the block. Only available in frame
+	 * types with header
+	 *
+	 * @return Header word
+	 */
+	std::uint64_t header() const {
+		static_assert(Frame::headerWords >= 1, "Frame type without header");
+		return m_block[0];
+	}
+
+	/**
+	 * Returns the timestamp word of the block. Only available in frame
+	 * types with timestamp
+	 *
+	 * @return Timestamp word
+	 */
+	std::uint64_t timestamp() const {
+		static_assert(Frame::headerWords >= 2, "Frame type without timestamp");
+		return m_block[1];
+	}
+
+	/**
+	 * Returns the number of channels of the block
+	 *
+	 * @return Number of channels
+	 */
+	std::uint16_t getNCh() const {
+		return m_nCh;
+	}
+
+	/**
+	 * Returns the number of samples in the block, all channels included
+	 *
+	 * @return Number of samples
+	 */
+	size_t samples() const {
+		return m_lengthBlock * samplesPerWord;
+	}
+
+	/**
+	 * Returns the number of whole samples of each channel in the block
+	 *
+	 * @return Samples per channel
+	 */
+	size_t samplesPerChannel() const {
+		return samples() / m_nCh;
+	}
+
+	/**
+	 * Returns a sample by its position in the block, regardless of the
+	 * channel
+	 *
+	 * @param i	Position of the sample, lower than samples()
+	 * @return	Sample value
+	 */
+	sample_type rawSample(const size_t i) const {
+		const std::uint64_t word = payload()[i / samplesPerWord];
+		return static_cast<sample_type>(
+				word >> ((i % samplesPerWord) * 8 * SampleSize));
+	}
+
+	/**
+	 * Returns a sample of a channel
+	 *
+	 * @param channel	Channel, lower than getNCh()
+	 * @param index		Sample of the channel, lower than samplesPerChannel()
+	 * @return Sample value
+	 */
+	sample_type sample(const std::uint16_t channel, const size_t index) const {
+		return rawSample(index * m_nCh + channel);
+	}
+
+	/**
+	 * Copies the samples of a channel to an output iterator
+	 *
+	 * @param channel	Channel to copy
+	 * @param out		Destination of samplesPerChannel() samples
+	 * @return	Iterator past the last sample written
+	 */
+	template<typename OutputIt>
+	OutputIt copyChannel(const std::uint16_t channel, OutputIt out) const {
+		const size_t count = samplesPerChannel();
+		for (size_t i = 0; i < count; ++i) {
+			*out++ = sample(channel, i);
+		}
+		return out;
+	}
+
+ private:
+	const std::uint64_t *m_block;
+	size_t m_lengthBlock;
+	std::uint16_t m_nCh;
+};
+
+/**
+ * Read-only view of a buffer with consecutive DAQ blocks, as read from a
+ * DMA with TerminalsDMADAQ. Iterating it yields DAQBlock objects without
+ * copying any data. Trailing words that do not form a whole block are
+ * ignored.
+ *
+ * Use makeDAQBlockView() to build it from the DMA configuration.
+ *
+ * @tparam F			Frame type of the DMA
+ * @tparam SampleSize	Size in bytes of a sample
+ *
+ * @ingroup DMATerminals
+ */
+template<FrameType F, std::uint8_t SampleSize>
+class DAQBlockView {
+ public:
+	using block_type = DAQBlock<F, SampleSize>;
+
+	/**
+	 * Forward iterator over the blocks of the view
+	 */
+	class iterator {
+	 public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = block_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const block_type*;
+		using reference = block_type;
+
+		iterator(const std::uint64_t *pos, const size_t lengthBlock,
+				const std::uint16_t nCh) :
+				m_pos(pos), m_lengthBlock(lengthBlock), m_nCh(nCh) {
+		}
+
+		block_type operator*() const {
+			return block_type(m_pos, m_lengthBlock, m_nCh);
+		}
+
+		iterator& operator++() {
+			m_pos += block_type::Frame::headerWords + m_lengthBlock;
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator prev(*this);
+			++(*this);
+			return prev;
+		}
+
+		bool operator==(const iterator &other) const {
+			return m_pos == other.m_pos;
+		}
+
+		bool operator!=(const iterator &other) const {
+			return m_pos != other.m_pos;
+		}
+
+	 private:
+		const std::uint64_t *m_pos;
+		size_t m_lengthBlock;
+		std::uint16_t m_nCh;
+	};
+
+	/**
+	 * Creates a view of a buffer of blocks. A view of blocks without
+	 * words is empty
+	 *
+	 * @param data			Buffer with the blocks
+	 * @param elements		Number of words in \p data
+	 * @param lengthBlock	Number of sample words of each block
+	 * @param nCh			Number of channels in each block
+	 */
+	DAQBlockView(const std::uint64_t *data, const size_t elements,
+			const size_t lengthBlock, const std::uint16_t nCh) :
+			m_data(data), m_lengthBlock(lengthBlock), m_nCh(nCh),
+			m_blocks(blockWords() == 0 ? 0 : elements / blockWords()) {
+	}
+
+	/**
+	 * Returns the number of whole blocks in the view
+	 *
+	 * @return Number of blocks
+	 */
+	size_t size() const {
+		return m_blocks;
+	}
+
+	/**
+	 * Returns a block of the view
+	 *
+	 * @param i	Index of the block, lower than size()
+	 * @return	View of the block
+	 */
+	block_type operator[](const size_t i) const {
+		return block_type(m_data + i * blockWords(), m_lengthBlock, m_nCh);
+	}
+
+	iterator begin() const {
+		return iterator(m_data, m_lengthBlock, m_nCh);
+	}
+
+	iterator end() const {
+		return iterator(m_data + m_blocks * blockWords(), m_lengthBlock,
+				m_nCh);
+	}
+
+ private:
+	size_t blockWords() const {
+		return block_type::Frame::headerWords + m_lengthBlock;
+	}
+
+	const std::uint64_t *m_data;
+	size_t m_lengthBlock;
+	std::uint16_t m_nCh;
+	size_t m_blocks;
+};
+
+/**
+ * Builds a DAQBlockView for data read from a DMA, checking that the
+ * frame type and sample size of the DMA match the template parameters
+ *
+ * @throw irio::errors::ResourceNotFoundError DMA not found
+ * @throw irio::errors::DAQFormatMismatchError The DMA uses another
+ * 											  frame type or sample size,
+ * 											  or has no channels or
+ * 											  block length
+ *
+ * @tparam F			Expected frame type of the DMA
+ * @tparam SampleSize	Expected size in bytes of a sample
+ * @param daq		DAQ terminals the data has been read from
+ * @param n			Number of DMA group
+ * @param data		Buffer with the blocks
+ * @param elements	Number of words in \p data
+ * @return View of the blocks in \p data
+ */
+template<FrameType F, std::uint8_t SampleSize>
+DAQBlockView<F, SampleSize> makeDAQBlockView(const TerminalsDMADAQ &daq,
+		const std::uint32_t n, const std::uint64_t *data,
+		const size_t elements) {
+	if (daq.getFrameType(n) != F) {
+		throw errors::DAQFormatMismatchError(
+				"Frame type of DMA " + std::to_string(n)
+						+ " does not match the view");
+	}
+	if (daq.getSampleSize(n) != SampleSize) {
+		throw errors::DAQFormatMismatchError(
+				"Sample size of DMA " + std::to_string(n) + " is "
+						+ std::to_string(daq.getSampleSize(n))
+						+ " bytes, view expects "
+						+ std::to_string(SampleSize));
+	}
+	const std::uint16_t nCh = daq.getNCh(n);
+	if (nCh == 0) {
+		throw errors::DAQFormatMismatchError(
+				"DMA " + std::to_string(n) + " has no channels");
+	}
+	const std::uint16_t lengthBlock = daq.getLengthBlock(n);
+	if (lengthBlock == 0) {
+		throw errors::DAQFormatMismatchError(
+				"DMA " + std::to_string(n) + " has blocks without samples");
+	}
+	return DAQBlockView<F, SampleSize>(data, elements, lengthBlock, nCh);
+}
+
+}  // namespace irio
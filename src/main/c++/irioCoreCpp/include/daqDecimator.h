@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "daqDemux.h"
+#include "dmaStreamer.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Filter applied before decimating
+ *
+ * @ingroup DMATerminals
+ */
+enum class DecimationFilter : std::uint8_t {
+	/// Mean of each group of DecimatorOutputConfig::factor samples
+	BoxCar = 0,
+	/// Cascaded integrator-comb of DecimatorOutputConfig::cicStages stages
+	/// and differential delay 1. Computed with exact integer arithmetic and
+	/// normalized by its gain (factor^stages)
+	CIC = 1,
+	/// FIR with DecimatorOutputConfig::taps, evaluated only at the output
+	/// samples
+	FIR = 2
+};
+
+/**
+ * Configuration of a reduced-rate output of a DAQDecimator
+ *
+ * @ingroup DMATerminals
+ */
+struct DecimatorOutputConfig {
+	DecimationFilter filter = DecimationFilter::BoxCar; /**< Filter */
+	/// Input samples per output sample of each channel
+	size_t factor = 1000;
+	/// Stages of the CIC filter, from 1 to MAX_CIC_STAGES
+	unsigned cicStages = 3;
+	/// Coefficients of the FIR filter, taps[0] weights the newest sample
+	std::vector<float> taps;
+	/// Factor applied to the filtered raw samples, e.g. the CVADC of the
+	/// module to get Volts
+	float scale = 1.0f;
+};
+
+/**
+ * Streaming decimation of the channels of a DAQ DMA.
+ *
+ * Consumes the DMA blocks where they are (e.g. a DMAStreamer chunk) and
+ * produces one or more reduced-rate outputs, each with its own filter and
+ * factor, leaving the full-rate data untouched. The filter state of every
+ * channel is kept across calls, so chunks of any number of blocks produce
+ * the same output as a single call with all of them.
+ *
+ * Each block is deinterleaved with the demux kernels into a block-sized
+ * scratch buffer, and the box-car sums and FIR dot products use the SIMD
+ * level selected with demux::setSimdLevel(). Samples of 8 bytes are not
+ * supported.
+ *
+ * Not thread-safe: process() must be called from a single thread, which
+ * is the one running the callback.
+ *
+ * @ingroup DMATerminals
+ */
+class DAQDecimator {
+ public:
+	/// Max stages of a CIC filter. The bits of the samples plus
+	/// stages * log2(factor) must also fit in 63 bits
+	static const unsigned MAX_CIC_STAGES = 6;
+
+	/**
+	 * Function called by process() for every output with new samples
+	 *
+	 * @param output	Index of the output in the configuration
+	 * @param channels	Samples of each channel. Only valid during the call
+	 * @param samples	Number of samples of each channel
+	 */
+	using Callback = std::function<void(const size_t output,
+			const float *const *channels, const size_t samples)>;
+
+	/**
+	 * Creates a decimator for blocks with the given layout
+	 *
+	 * @throw irio::errors::DAQFormatMismatchError	Invalid layout or samples
+	 * 												of 8 bytes
+	 * @throw irio::errors::DecimatorConfigError	No outputs or invalid
+	 * 												output configuration
+	 *
+	 * @param layout	Layout of the blocks
+	 * @param outputs	Configuration of each reduced-rate output
+	 */
+	DAQDecimator(const demux::DemuxLayout &layout,
+			const std::vector<DecimatorOutputConfig> &outputs);
+
+	/**
+	 * Creates a decimator for the blocks of a DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError	DMA not found
+	 * @throw irio::errors::NiFpgaError				Error occurred in an FPGA
+	 * 												operation
+	 * @throw irio::errors::DAQFormatMismatchError	Samples of 8 bytes
+	 * @throw irio::errors::DecimatorConfigError	No outputs or invalid
+	 * 												output configuration
+	 *
+	 * @param daq		DAQ terminals
+	 * @param n			Number of DMA group
+	 * @param outputs	Configuration of each reduced-rate output
+	 */
+	DAQDecimator(const TerminalsDMADAQ &daq, const std::uint32_t n,
+			const std::vector<DecimatorOutputConfig> &outputs);
+
+	/**
+	 * Registers the function receiving the reduced-rate samples
+	 *
+	 * @param callback Function to call on each output with new samples
+	 */
+	void setCallback(const Callback &callback);
+
+	/**
+	 * Filters and decimates consecutive blocks. The samples produced can be
+	 * accessed with getSamples() and getChannel() until the next call
+	 *
+	 * @param data		Buffer with \p nBlocks consecutive blocks
+	 * @param nBlocks	Number of blocks
+	 */
+	void process(const std::uint64_t *data, const size_t nBlocks);
+
+	/**
+	 * Returns a DMAStreamer callback that decimates the chunks of DMA \p n
+	 * and then passes every chunk, unmodified, to \p fullRate
+	 *
+	 * @param n			Number of DMA group decimated
+	 * @param fullRate	Consumer of the full-rate stream, may be empty
+	 * @return Callback to register with DMAStreamer::setCallback
+	 */
+	DMAStreamer::Callback attach(const std::uint32_t n,
+			const DMAStreamer::Callback &fullRate = DMAStreamer::Callback());
+
+	/**
+	 * Returns the number of outputs
+	 *
+	 * @return Outputs configured
+	 */
+	size_t countOutputs() const;
+
+	/**
+	 * Returns the number of samples per channel produced by the last
+	 * process() in an output
+	 *
+	 * @throw irio::errors::DecimatorConfigError Invalid output
+	 *
+	 * @param output Index of the output
+	 * @return Samples of each channel
+	 */
+	size_t getSamples(const size_t output) const;
+
+	/**
+	 * Returns the samples of a channel produced by the last process() in
+	 * an output
+	 *
+	 * @throw irio::errors::DecimatorConfigError Invalid output or channel
+	 *
+	 * @param output	Index of the output
+	 * @param ch		Channel
+	 * @return getSamples() samples
+	 */
+	const float* getChannel(const size_t output, const size_t ch) const;
+
+	/**
+	 * Clears the filter state of all the channels, as if no block had been
+	 * processed
+	 */
+	void reset();
+
+ private:
+	struct ChannelState {
+		/// Box-car sum (acc[0]) or CIC integrators. CIC state wraps
+		/// around, which does not change its output
+		std::uint64_t acc[MAX_CIC_STAGES] = {};
+		/// Delays of the CIC combs
+		std::uint64_t comb[MAX_CIC_STAGES] = {};
+		/// FIR: last taps-1 samples followed by the ones of the block
+		std::vector<float> history;
+	};
+
+	struct Output {
+		DecimatorOutputConfig config;
+		/// Input samples accumulated towards the next output sample
+		size_t phase = 0;
+		/// Taps reversed, so each output is a contiguous dot product
+		std::vector<float> reversedTaps;
+		std::vector<ChannelState> channels;
+		std::vector<std::vector<float>> samples;
+		std::vector<const float*> pointers;
+		size_t produced = 0;
+	};
+
+	void checkOutput(const size_t output) const;
+	void filterBoxCar(Output *out, const size_t ch, const std::int32_t *x,
+			const size_t count, const demux::SimdLevel level);
+	void filterCIC(Output *out, const size_t ch, const std::int32_t *x,
+			const size_t count);
+	void filterFIR(Output *out, const size_t ch, const std::int32_t *x,
+			const size_t count, const demux::SimdLevel level);
+
+	const demux::DemuxLayout m_layout;
+	std::vector<Output> m_outputs;
+	/// One block deinterleaved, reused for every block
+	std::vector<std::int32_t> m_scratch;
+	std::vector<std::int32_t*> m_scratchChannels;
+	Callback m_callback;
+};
+
+}  // namespace irio
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "modules.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+namespace demux {
+
+/**
+ * Instruction sets that can be used by the demux kernels
+ *
+ * @ingroup DMATerminals
+ */
+enum class SimdLevel : std::uint8_t {
+	Scalar = 0, /**< Portable scalar code */
+	AVX2 = 1,	/**< AVX2 kernels */
+	AVX512 = 2	/**< AVX-512F kernels */
+};
+
+/**
+ * Layout of the DAQ blocks of a DMA
+ *
+ * @ingroup DMATerminals
+ */
+struct DemuxLayout {
+	size_t lengthBlock = 0;		/**< Sample words of each block */
+	size_t headerWords = 0;		/**< Words preceding the samples of a block */
+	std::uint16_t nCh = 0;		/**< Number of interleaved channels */
+	std::uint8_t sampleSize = 2;	/**< Size in bytes of each sample */
+
+	/**
+	 * Returns the number of words of each block
+	 *
+	 * @return Words per block
+	 */
+	size_t blockWords() const {
+		return headerWords + lengthBlock;
+	}
+
+	/**
+	 * Returns the number of whole samples of each channel in a block
+	 *
+	 * @return Samples per channel and block
+	 */
+	size_t samplesPerChannel() const {
+		return nCh == 0 ? 0 : lengthBlock * (8 / sampleSize) / nCh;
+	}
+};
+
+/**
+ * Reads the layout of the blocks of a DMA from the FPGA configuration
+ *
+ * @throw irio::errors::ResourceNotFoundError DMA not found
+ * @throw irio::errors::DAQFormatMismatchError Unsupported sample size
+ * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+ *
+ * @param daq	DAQ terminals
+ * @param n		Number of DMA group
+ * @return Layout of the DMA blocks
+ */
+DemuxLayout getDemuxLayout(const TerminalsDMADAQ &daq, const std::uint32_t n);
+
+/**
+ * Returns the best instruction set supported by the CPU
+ *
+ * @return Best SIMD level available
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * Returns the instruction set used by the demux functions
+ *
+ * @return SIMD level in use
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * Selects the instruction set used by the demux functions. By default the
+ * best one detected is used. Levels not supported by the CPU are lowered
+ * to the best one available.
+ *
+ * @param level	Requested SIMD level
+ * @return SIMD level that will be used
+ */
+SimdLevel setSimdLevel(const SimdLevel level);
+
+/**
+ * Deinterleaves DAQ blocks into one contiguous array per channel.
+ *
+ * Samples are taken from each block as described in DAQBlock. Channel
+ * <i>c</i> receives layout.samplesPerChannel() samples per block, so
+ * \p channels[c] must have room for nBlocks * layout.samplesPerChannel()
+ * elements. The SIMD kernels are used for 2 bytes samples, other sizes use
+ * the scalar path.
+ *
+ * @throw irio::errors::DAQFormatMismatchError The samples do not fit in
+ * 											  the output type or the layout
+ * 											  is invalid
+ *
+ * @param layout	Layout of the blocks
+ * @param data		Buffer with \p nBlocks consecutive blocks
+ * @param nBlocks	Number of blocks to demux
+ * @param channels	Destination array of each channel
+ * @return Number of samples written to each channel
+ */
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, std::int16_t *const *channels);
+
+/**
+ * @copydoc demux(const DemuxLayout&, const std::uint64_t*, const size_t, std::int16_t *const *)
+ */
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, std::int32_t *const *channels);
+
+/**
+ * Deinterleaves DAQ blocks into one contiguous array per channel,
+ * converting each sample to float and multiplying it by \p scale
+ *
+ * @throw irio::errors::DAQFormatMismatchError The layout is invalid
+ *
+ * @param layout	Layout of the blocks
+ * @param data		Buffer with \p nBlocks consecutive blocks
+ * @param nBlocks	Number of blocks to demux
+ * @param channels	Destination array of each channel
+ * @param scale		Factor applied to each raw sample
+ * @return Number of samples written to each channel
+ */
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, float *const *channels, const float scale = 1.0f);
+
+/**
+ * Deinterleaves DAQ blocks into one contiguous array per channel,
+ * converting each sample to Volts with the CVADC of \p module
+ *
+ * @throw irio::errors::DAQFormatMismatchError The layout is invalid
+ *
+ * @param layout	Layout of the blocks
+ * @param data		Buffer with \p nBlocks consecutive blocks
+ * @param nBlocks	Number of blocks to demux
+ * @param channels	Destination array of each channel
+ * @param module	Module whose conversion constant is applied
+ * @return Number of samples written to each channel
+ */
+size_t demux(const DemuxLayout &layout, const std::uint64_t *data,
+		const size_t nBlocks, float *const *channels, const Module &module);
+
+}  // namespace demux
+}  // namespace irio
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "terminals/terminalsDMACommon.h"
+
+namespace irio {
+
+/**
+ * Action taken by a DMAOverflowMonitor when a DMA overflows
+ *
+ * @ingroup DMATerminals
+ */
+enum class OverflowPolicy : std::uint8_t {
+	Notify = 0,	/**< Only update the counters and invoke the callbacks */
+	Restart = 1	/**< Also stop, flush and restart the DMA, recording a gap */
+};
+
+/**
+ * Configuration of a DMAOverflowMonitor
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAOverflowMonitorConfig {
+	/// Milliseconds between samples of the overflow register by the
+	/// monitor thread. 0 disables the thread, only poll() samples it
+	std::uint32_t period = 10;
+	/// Action taken when a DMA overflows
+	OverflowPolicy policy = OverflowPolicy::Notify;
+	/// Gap markers kept per DMA until they are popped
+	size_t maxGaps = 64;
+};
+
+/**
+ * Overflow history of a DMA
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAOverflowStats {
+	std::uint64_t overflows = 0; /**< Times the overflow bit has been raised */
+	bool active = false; /**< Value of the overflow bit in the last sample */
+	/// Time the first overflow was observed. Epoch if none
+	std::chrono::system_clock::time_point firstOverflow;
+	/// Time the last overflow was observed. Epoch if none
+	std::chrono::system_clock::time_point lastOverflow;
+	std::uint64_t restarts = 0; /**< Restarts done by the Restart policy */
+	/// Elements discarded by the restarts
+	std::uint64_t elementsDiscarded = 0;
+};
+
+/**
+ * Marks a discontinuity in the data of a DMA caused by an automatic
+ * restart. Data read after the restart does not follow the data read
+ * before it.
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAGap {
+	std::uint64_t sequence = 0; /**< Number of the gap in the DMA, from 1 */
+	/// Time the DMA was restarted
+	std::chrono::system_clock::time_point time;
+	size_t elementsDiscarded = 0; /**< Elements flushed in the restart */
+};
+
+/**
+ * Watchdog for the DMA overflow register.
+ *
+ * Samples the overflow bitfield (TerminalsDMACommon::getAllDMAOverflows)
+ * periodically from its own thread and/or whenever poll() is called, e.g.
+ * after each DMA read. Keeps a per-DMA count of overflows with the times
+ * of the first and last ones, and calls the registered callbacks every
+ * time a bit changes.
+ *
+ * With OverflowPolicy::Restart the overflowed DMA is disabled, stopped,
+ * flushed, restarted and enabled again. As the FPGA stream cannot carry
+ * it, a DMAGap is queued for the DMA so the consumers can learn where the
+ * data is discontinuous (popGap()). Restarting a DMA while another thread
+ * is reading it makes that read fail, so this policy is best combined with
+ * period 0 and calls to poll() from the reading thread.
+ *
+ * @ingroup DMATerminals
+ */
+class DMAOverflowMonitor {
+ public:
+	/**
+	 * Function called when the overflow bit of a DMA changes
+	 *
+	 * @param n			Number of DMA group
+	 * @param overflow	New value of the overflow bit
+	 * @param stats		History of the DMA after the change
+	 */
+	using Callback = std::function<void(const std::uint32_t n,
+			const bool overflow, const DMAOverflowStats &stats)>;
+
+	/**
+	 * Monitors all the DMAs of the terminals
+	 *
+	 * @param terminals	DMA terminals (DAQ or IMAQ)
+	 * @param config	Monitor configuration
+	 */
+	explicit DMAOverflowMonitor(const TerminalsDMACommon &terminals,
+			const DMAOverflowMonitorConfig &config =
+					DMAOverflowMonitorConfig());
+
+	/**
+	 * Stops the monitor thread if it is running
+	 */
+	~DMAOverflowMonitor();
+
+	DMAOverflowMonitor(const DMAOverflowMonitor&) = delete;
+	DMAOverflowMonitor& operator=(const DMAOverflowMonitor&) = delete;
+
+	/**
+	 * Registers a function to call when an overflow bit changes. Callbacks
+	 * are called from the thread sampling the register
+	 *
+	 * @param callback Function to call
+	 */
+	void addCallback(const Callback &callback);
+
+	/**
+	 * Launches the thread sampling the register every period milliseconds.
+	 * Does nothing if the period is 0
+	 */
+	void start();
+
+	/**
+	 * Stops and joins the monitor thread
+	 */
+	void stop();
+
+	/**
+	 * Returns whether the monitor thread is running
+	 *
+	 * @return True if running
+	 */
+	bool isRunning() const;
+
+	/**
+	 * Samples the overflow register now, on the calling thread
+	 *
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @return Value of the overflow register
+	 */
+	std::uint16_t poll();
+
+	/**
+	 * Returns the overflow history of a DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return History of the DMA
+	 */
+	DMAOverflowStats getStats(const std::uint32_t n) const;
+
+	/**
+	 * Takes the oldest gap marker of a DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n		Number of DMA group
+	 * @param gap	Output with the gap marker
+	 * @return True if there was a gap marker pending
+	 */
+	bool popGap(const std::uint32_t n, DMAGap *gap);
+
+	/**
+	 * Returns the number of gaps created in a DMA, including the ones
+	 * already popped. Consumers can compare it between reads to detect
+	 * discontinuities
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return Gaps created since the monitor was constructed
+	 */
+	std::uint64_t getGapCount(const std::uint32_t n) const;
+
+ private:
+	struct DMAState {
+		DMAOverflowStats stats;
+		std::deque<DMAGap> gaps;
+		std::uint64_t gapCount = 0;
+	};
+
+	void monitorLoop();
+	void restart(const std::uint32_t n, DMAState *state);
+	void checkDMA(const std::uint32_t n) const;
+
+	TerminalsDMACommon m_terminals;
+	const DMAOverflowMonitorConfig m_config;
+
+	/// Serializes the samples of the register
+	std::mutex m_pollMutex;
+	/// Protects the DMA states and the callbacks
+	mutable std::mutex m_mutex;
+	/// Indexed by overflow bit, only DMAs found in m_foundDMAs
+	std::vector<DMAState> m_states;
+	std::uint16_t m_foundDMAs;
+	std::vector<Callback> m_callbacks;
+	std::uint16_t m_lastValue;
+
+	std::atomic<bool> m_running;
+	std::condition_variable m_wakeUp;
+	std::thread m_thread;
+};
+
+}  // namespace irio
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asyncWriter.h"
+#include "recordFormat.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Configuration of a DMARecorder
+ *
+ * @ingroup DMATerminals
+ */
+struct DMARecorderConfig {
+	/// Number of DMA blocks in every chunk written to the file
+	size_t blocksPerChunk = 64;
+	/// Number of chunks in the buffer pool. Bounds the writes in flight
+	size_t buffers = 32;
+	/// Max time in milliseconds each FIFO read waits for data before
+	/// checking if the recorder has been stopped
+	std::uint32_t readTimeout = 100;
+	/// Open the file with O_DIRECT. Ignored if the filesystem does not
+	/// support it
+	bool directIO = true;
+	/// Write with io_uring when the kernel supports it
+	bool useIoUring = true;
+	/// Threads calling pwrite() when io_uring is not used
+	unsigned writerThreads = 2;
+	/// Chunks reserved on disk ahead of the ones written, 0 to not reserve.
+	/// Writes that do not extend the file complete without blocking on
+	/// metadata updates, which is what keeps io_uring asynchronous
+	size_t preallocChunks = 256;
+	/// Flush the file to the device when the recording stops
+	bool syncOnClose = true;
+};
+
+/**
+ * Statistics of a recording
+ *
+ * @ingroup DMATerminals
+ */
+struct DMARecorderStats {
+	std::uint64_t chunksRead = 0; /**< Chunks read from the FIFO */
+	std::uint64_t chunksWritten = 0; /**< Chunks stored in the file */
+	/// Chunks read from the FIFO and discarded because no buffer was free
+	std::uint64_t chunksDropped = 0;
+	std::uint64_t bytesWritten = 0; /**< Chunk bytes stored in the file */
+	std::uint64_t timeouts = 0; /**< FIFO reads that expired */
+	bool failed = false; /**< Recording stopped due to an error */
+	std::string lastError; /**< Message of the error that stopped it */
+	bool directIO = false; /**< File opened with O_DIRECT */
+	std::string backend; /**< AsyncWriter::getName of the writer used */
+};
+
+/**
+ * Records a DMA of a DAQ profile to disk.
+ *
+ * A reader thread drains the FIFO in chunks of
+ * DMARecorderConfig::blocksPerChunk whole blocks straight into buffers of a
+ * preallocated pool aligned to record::ALIGNMENT, so the data is not copied
+ * after the FIFO read. A writer thread hands the filled buffers to an
+ * AsyncWriter (io_uring or a pwrite() thread pool) and returns them to the
+ * pool as the writes complete. Both threads exchange buffers through
+ * lock-free single-producer/single-consumer queues. The reader never waits
+ * for the disk: if no buffer is free the chunk is still read from the FIFO
+ * and discarded, and it is counted as dropped.
+ *
+ * The file follows the layout described in recordFormat.h. Its header is
+ * written by start() and completed, together with the block index, by
+ * stop(). The DMA must have been configured and started before calling
+ * start().
+ *
+ * @ingroup DMATerminals
+ */
+class DMARecorder {
+ public:
+	/**
+	 * Preallocates the buffer pool
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::DMARecorderError Signature too long or unable to
+	 * 										 allocate the buffers
+	 *
+	 * @param daq		DAQ terminals used to read the DMA
+	 * @param n			Number of DMA group to record
+	 * @param signature	Signature of the bitfile, see Irio::getSignature
+	 * @param path		File to write. Overwritten on every start()
+	 * @param config	Recorder configuration
+	 */
+	DMARecorder(const TerminalsDMADAQ &daq, const std::uint32_t n,
+			const std::string &signature, const std::string &path,
+			const DMARecorderConfig &config = DMARecorderConfig());
+
+	/**
+	 * Stops the recording if it is running
+	 */
+	~DMARecorder();
+
+	DMARecorder(const DMARecorder&) = delete;
+	DMARecorder& operator=(const DMARecorder&) = delete;
+
+	/**
+	 * Creates the file, writes its header and launches the threads
+	 *
+	 * @throw irio::errors::DMARecorderError Unable to create or write the
+	 * 										 file
+	 */
+	void start();
+
+	/**
+	 * Stops the threads, waits for the pending writes and completes the
+	 * file with the block index
+	 *
+	 * @throw irio::errors::DMARecorderError Unable to complete the file
+	 */
+	void stop();
+
+	/**
+	 * Returns whether the recorder threads are running
+	 *
+	 * @return True if running
+	 */
+	bool isRunning() const;
+
+	/**
+	 * Returns the bytes of every chunk in the file
+	 *
+	 * @return Chunk size, header and padding included
+	 */
+	size_t getChunkSize() const;
+
+	/**
+	 * Returns the statistics of the current or last recording
+	 *
+	 * @return Statistics
+	 */
+	DMARecorderStats getStats() const;
+
+ private:
+	class BufferPool;
+
+	void readerLoop();
+	void writerLoop();
+	void reserve(const std::uint64_t end);
+	void finishFile();
+	void setError(const std::string &error);
+
+	TerminalsDMADAQ m_daq;
+	const std::uint32_t m_n;
+	const std::string m_path;
+	const DMARecorderConfig m_config;
+	const size_t m_blocksPerChunk;
+	const size_t m_chunkElements;
+	const size_t m_chunkSize;
+	std::unique_ptr<BufferPool> m_pool;
+
+	int m_fd = -1;
+	/// Bytes reserved with fallocate(), only used by the writer thread
+	std::uint64_t m_allocated = 0;
+	std::unique_ptr<AsyncWriter> m_writer;
+	/// Header of the file being written, completed by stop()
+	record::FileHeader m_header;
+	/// One entry per chunk sequence, offset 0 until its write completes
+	std::vector<record::IndexEntry> m_index;
+
+	std::thread m_reader;
+	std::thread m_writerThread;
+	std::atomic<bool> m_running;
+	std::atomic<bool> m_writerStop;
+
+	std::atomic<std::uint64_t> m_chunksRead;
+	std::atomic<std::uint64_t> m_chunksWritten;
+	std::atomic<std::uint64_t> m_chunksDropped;
+	std::atomic<std::uint64_t> m_bytesWritten;
+	std::atomic<std::uint64_t> m_timeouts;
+	std::atomic<bool> m_failed;
+	bool m_directIO = false;
+	std::string m_backend;
+
+	/// Protects m_lastError and is used to wake up the writer
+	mutable std::mutex m_mutex;
+	std::condition_variable m_dataReady;
+	std::string m_lastError;
+};
+
+}  // namespace irio
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "recordFormat.h"
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Configuration of a DMAReplay
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAReplayConfig {
+	/**
+	 * Pace of the replay as a factor of the recorded one: 1 delivers each
+	 * chunk when its timestamp says it was read, 2 twice as fast. 0
+	 * delivers the whole capture as fast as it is read.
+	 */
+	double speed = 0;
+};
+
+/**
+ * Replays DMA captures written by DMARecorder through the TerminalsDMADAQ
+ * read API, so the code consuming the DMAs runs offline without hardware.
+ *
+ * Each capture file is mapped in memory and becomes a DMA group of the
+ * terminals: DMA <i>n</i> is the <i>n<sup>th</sup></i> file. The channels,
+ * sample size, frame type, block length and decimation come from the file
+ * header. The DMAs behave as started FIFOs holding the recorded words:
+ * - Nothing is delivered until the DMA is started. Stopping it pauses the
+ *   replay.
+ * - acquireData() returns views of the mapped file when the elements span
+ *   at most two chunks, and a copy otherwise. The views are valid until
+ *   the data is released.
+ * - getDMAOverflow() is raised when the replay crosses blocks that were
+ *   dropped while recording, and cleared when the DMA is started.
+ * - Once the capture is exhausted, reads that cannot be completed throw
+ *   irio::errors::DMAReadTimeout without waiting.
+ * - cleanDMA() only discards data when replaying at the recorded pace.
+ *   At maximum speed there is no stale data to discard.
+ * - The DMA enables, host depths and decimation can be set, but they have
+ *   no effect on the data. IRQs are not available, so DMASelector must
+ *   be used in polling mode.
+ *
+ * As with the hardware, each DMA supports a single consumer.
+ *
+ * @ingroup DMATerminals
+ */
+class DMAReplay {
+ public:
+	/**
+	 * Maps the captures
+	 *
+	 * @throw irio::errors::DMAReplayError Unable to map a file or invalid
+	 * 									   capture
+	 *
+	 * @param paths		Capture files, one per DMA group
+	 * @param config	Replay configuration
+	 */
+	explicit DMAReplay(const std::vector<std::string> &paths,
+			const DMAReplayConfig &config = DMAReplayConfig());
+
+	/**
+	 * Returns the terminals serving the captures. They keep the files
+	 * mapped even after the DMAReplay is destroyed
+	 *
+	 * @return DAQ terminals
+	 */
+	TerminalsDMADAQ getTerminalsDAQ() const;
+
+	/**
+	 * Returns the header of a capture
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return Header of the file, as completed when the recording stopped
+	 */
+	record::FileHeader getHeader(const std::uint32_t n) const;
+
+	/**
+	 * Returns the signature of the bitfile used to record a capture
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return Bitfile signature
+	 */
+	std::string getSignature(const std::uint32_t n) const;
+
+	/**
+	 * Returns the number of words of a capture
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return Words recorded, dropped blocks excluded
+	 */
+	std::uint64_t getTotalElements(const std::uint32_t n) const;
+
+	/**
+	 * Returns whether all the words of a capture have been consumed
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param n Number of DMA group
+	 * @return True if there is nothing left to read
+	 */
+	bool isFinished(const std::uint32_t n) const;
+
+ private:
+	class Capture;
+	class Impl;
+
+	std::shared_ptr<Impl> m_impl;
+};
+
+}  // namespace irio
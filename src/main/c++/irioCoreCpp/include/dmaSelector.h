@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "terminals/terminalsDMACommon.h"
+
+namespace irio {
+
+/**
+ * Configuration of a DMASelector
+ *
+ * @ingroup DMATerminals
+ */
+struct DMASelectorConfig {
+	/**
+	 * IRQ (0-31) asserted by the FPGA when each DMA of the set has data
+	 * ready, in the same order as the DMAs passed to the selector. If
+	 * empty, the fill levels are polled instead.
+	 */
+	std::vector<std::uint8_t> dataReadyIrqs;
+	/// Shortest sleep in microseconds between polls of the fill levels, at
+	/// least 1 so the sleep can back off
+	std::uint32_t minPollInterval = 10;
+	/// Longest sleep in microseconds between polls of the fill levels
+	std::uint32_t maxPollInterval = 1000;
+};
+
+/**
+ * Waits until any DMA of a set has data, so a single thread can serve
+ * every DMA of a board.
+ *
+ * If the FPGA asserts an IRQ when a DMA has data (see
+ * DMASelectorConfig::dataReadyIrqs), the selector sleeps on the IRQs
+ * with NiFpga_WaitOnIrqs and acknowledges them once checked. Otherwise
+ * the fill levels are polled, sleeping between polls for an interval
+ * that grows while the DMAs are idle and shrinks when data is found.
+ *
+ * A selector must be used from a single thread.
+ *
+ * @ingroup DMATerminals
+ */
+class DMASelector {
+ public:
+	/**
+	 * Creates a selector for a set of DMAs. Reserves an IRQ context if
+	 * IRQs are used.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError A DMA is not found
+	 * @throw irio::errors::DMASelectorError Number of IRQs does not match
+	 * 										 the DMAs or IRQ out of range
+	 * @throw irio::errors::NiFpgaError Unable to reserve the IRQ context
+	 *
+	 * @param terminals	DMA terminals (DAQ or IMAQ)
+	 * @param dmas		DMA groups to watch
+	 * @param config	Selector configuration
+	 */
+	DMASelector(const TerminalsDMACommon &terminals,
+			const std::vector<std::uint32_t> &dmas,
+			const DMASelectorConfig &config = DMASelectorConfig());
+
+	/**
+	 * Unreserves the IRQ context, if any
+	 */
+	~DMASelector();
+
+	DMASelector(const DMASelector&) = delete;
+	DMASelector& operator=(const DMASelector&) = delete;
+
+	/**
+	 * Waits until at least one DMA of the set has \p minElements elements
+	 * or the timeout expires
+	 *
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param minElements	Elements needed to consider a DMA ready
+	 * @param timeout		Max time to wait in milliseconds
+	 * @param ready			Output with the DMAs ready. Cleared at the start
+	 * 						of the call, its capacity is reused
+	 * @return	Number of DMAs ready, 0 if the timeout expired
+	 */
+	size_t select(const size_t minElements, const std::uint32_t timeout,
+			std::vector<std::uint32_t> *ready);
+
+	/**
+	 * Returns the fill level of a DMA observed in the last select()
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not in the set
+	 *
+	 * @param n Number of DMA group
+	 * @return Elements that were available in the DMA
+	 */
+	size_t getElementsAvailable(const std::uint32_t n) const;
+
+	/**
+	 * Returns whether the selector waits on IRQs or polls
+	 *
+	 * @return True if IRQs are used
+	 */
+	bool usesIrqs() const;
+
+ private:
+	size_t scan(const size_t minElements, const std::uint32_t irqs,
+			std::vector<std::uint32_t> *ready);
+	size_t selectIrqs(const size_t minElements, const std::uint32_t timeout,
+			std::vector<std::uint32_t> *ready);
+	size_t selectPolling(const size_t minElements,
+			const std::uint32_t timeout, std::vector<std::uint32_t> *ready);
+
+	TerminalsDMACommon m_terminals;
+	std::vector<std::uint32_t> m_dmas;
+	std::vector<std::uint32_t> m_irqMasks;
+	std::vector<size_t> m_available;
+	std::uint32_t m_allIrqs;
+	/// NiFpga_IrqContext reserved for this selector, null when polling
+	void *m_irqContext;
+	const std::uint32_t m_minPollInterval;
+	const std::uint32_t m_maxPollInterval;
+	std::uint32_t m_pollInterval;
+};
+
+}  // namespace irio
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "terminals/terminalsDMADAQ.h"
+
+namespace irio {
+
+/**
+ * Configuration of a DMAStreamer
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAStreamerConfig {
+	/// Number of DMA blocks drained from the FIFO on each read, at least 1
+	size_t blocksPerChunk = 1;
+	/// Number of chunks that fit in the ring buffer of each DMA, at least 1
+	size_t ringChunks = 256;
+	/// Max time in milliseconds each FIFO read waits for data before
+	/// checking if the streamer has been stopped, at least 1
+	std::uint32_t readTimeout = 100;
+	/**
+	 * CPUs where the reader threads are pinned. The reader of the
+	 * <i>i<sup>th</sup></i> streamed DMA is pinned to
+	 * cpuAffinity[i % cpuAffinity.size()]. Empty to not pin the threads.
+	 */
+	std::vector<int> cpuAffinity;
+	/// SCHED_FIFO priority of the reader threads, 0 to keep the default
+	/// scheduling policy
+	int rtPriority = 0;
+};
+
+/**
+ * Statistics of a DMA being streamed
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAStreamerStats {
+	std::uint64_t chunksRead = 0; /**< Chunks read from the FIFO */
+	std::uint64_t chunksDelivered = 0; /**< Chunks consumed */
+	/// Chunks read from the FIFO and discarded because the ring was full
+	std::uint64_t chunksDropped = 0;
+	std::uint64_t timeouts = 0; /**< FIFO reads that expired */
+	bool failed = false; /**< Reader stopped due to an error */
+	std::string lastError; /**< Message of the error that stopped the reader */
+};
+
+/**
+ * Background streaming engine for DMA DAQ data.
+ *
+ * Owns one reader thread per streamed DMA. Each thread drains the DMA FIFO
+ * in chunks of whole blocks (see TerminalsDMADAQ::getElementsPerBlock)
+ * directly into a preallocated lock-free single-producer/single-consumer
+ * ring. The reader never waits for the consumer: if the ring is full the
+ * chunk is still read from the FIFO and discarded, and it is counted as
+ * dropped. This way the FPGA FIFO is kept empty however slow the consumer is.
+ *
+ * Chunks can be consumed with the pull API (front()/pop()) or by
+ * registering a callback, in which case a delivery thread per DMA invokes it.
+ * Only one consumer per DMA is allowed.
+ *
+ * The DMAs must have been configured and started before calling start().
+ *
+ * @ingroup DMATerminals
+ */
+class DMAStreamer {
+ public:
+	/**
+	 * Function called for every chunk delivered
+	 *
+	 * @param n			Number of DMA group
+	 * @param data		Chunk data. Only valid during the call
+	 * @param elements	Number of elements in \p data
+	 */
+	using Callback = std::function<void(const std::uint32_t n,
+			const std::uint64_t *data, const size_t elements)>;
+
+	/**
+	 * Preallocates the rings for the specified DMAs
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param daq		DAQ terminals used to read the DMAs
+	 * @param dmas		DMA groups to stream
+	 * @param config	Streamer configuration
+	 */
+	DMAStreamer(const TerminalsDMADAQ &daq,
+			const std::vector<std::uint32_t> &dmas,
+			const DMAStreamerConfig &config = DMAStreamerConfig());
+
+	/**
+	 * Stops the threads if they are running
+	 */
+	~DMAStreamer();
+
+	DMAStreamer(const DMAStreamer&) = delete;
+	DMAStreamer& operator=(const DMAStreamer&) = delete;
+
+	/**
+	 * Registers the function that will receive the chunks. Must be called
+	 * before start(). Once registered the pull API cannot be used.
+	 *
+	 * @param callback	Function to call for each chunk
+	 */
+	void setCallback(const Callback &callback);
+
+	/**
+	 * Launches the reader threads (and delivery threads if a callback
+	 * has been registered)
+	 *
+	 * @throw irio::errors::DMAStreamerError Unable to apply the CPU affinity
+	 * 										 or real-time priority
+	 */
+	void start();
+
+	/**
+	 * Stops and joins all the threads. Chunks not consumed remain in the
+	 * rings until the next start()
+	 */
+	void stop();
+
+	/**
+	 * Returns whether the streamer threads are running
+	 *
+	 * @return True if running
+	 */
+	bool isRunning() const;
+
+	/**
+	 * Returns the number of elements of each chunk of a DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not streamed
+	 *
+	 * @param n Number of DMA group
+	 * @return Elements per chunk
+	 */
+	size_t getChunkElements(const std::uint32_t n) const;
+
+	/**
+	 * Returns the oldest chunk of a DMA not yet consumed, waiting for it
+	 * if the ring is empty. The chunk is owned by the streamer until pop()
+	 * is called.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not streamed
+	 * @throw irio::errors::DMAStreamerError A callback has been registered
+	 *
+	 * @param n			Number of DMA group
+	 * @param timeout	Max time in milliseconds to wait, 0 to not wait
+	 * @return	Pointer to the chunk (getChunkElements() elements) or
+	 * 			nullptr if none was available
+	 */
+	const std::uint64_t* front(const std::uint32_t n,
+			const std::uint32_t timeout = 0);
+
+	/**
+	 * Releases the chunk returned by front(), making its slot available
+	 * to the reader again
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not streamed
+	 *
+	 * @param n Number of DMA group
+	 */
+	void pop(const std::uint32_t n);
+
+	/**
+	 * Returns the statistics of a streamed DMA
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not streamed
+	 *
+	 * @param n Number of DMA group
+	 * @return Statistics of the DMA
+	 */
+	DMAStreamerStats getStats(const std::uint32_t n) const;
+
+ private:
+	class Channel;
+
+	Channel& getChannel(const std::uint32_t n) const;
+	void readerLoop(Channel *channel);
+	void deliveryLoop(Channel *channel);
+	void applyThreadConfig(std::thread *thread, const size_t index) const;
+
+	TerminalsDMADAQ m_daq;
+	const DMAStreamerConfig m_config;
+	std::vector<std::unique_ptr<Channel>> m_channels;
+	Callback m_callback;
+	std::atomic<bool> m_running;
+};
+
+}  // namespace irio
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "histogram.h"
+
+namespace irio {
+
+/**
+ * Read-only view of elements acquired directly from the host memory
+ * part of a DMA FIFO.
+ *
+ * The host memory buffer is circular, so the acquired elements may be
+ * split in two regions when they wrap around the end of the buffer.
+ * \p first always holds the oldest elements, \p second is only used
+ * in the wrap-around case and holds the continuation of \p first.
+ *
+ * The pointers are only valid until the elements are released with
+ * TerminalsDMACommon::releaseData or the session is closed.
+ *
+ * @ingroup DMATerminals
+ */
+struct DMADataView {
+	const std::uint64_t *first = nullptr; /**< Oldest acquired elements */
+	size_t firstSize = 0; /**< Number of elements in \p first */
+	const std::uint64_t *second = nullptr; /**< Wrap-around continuation */
+	size_t secondSize = 0; /**< Number of elements in \p second */
+
+	/**
+	 * Returns the total number of elements acquired
+	 *
+	 * @return Number of elements in both regions
+	 */
+	size_t size() const {
+		return firstSize + secondSize;
+	}
+
+	/**
+	 * Returns whether the acquired elements are split in two regions
+	 *
+	 * @return True if the view wraps around the end of the host buffer
+	 */
+	bool wraps() const {
+		return secondSize != 0;
+	}
+
+	/**
+	 * Access an element of the view as if it was contiguous
+	 *
+	 * @param i	Index of the element, must be lower than size()
+	 * @return	Element at position \p i
+	 */
+	std::uint64_t operator[](const size_t i) const {
+		return i < firstSize ? first[i] : second[i - firstSize];
+	}
+};
+
+/**
+ * Outcome of each read of TerminalsDMACommon::readDataMulti
+ *
+ * @ingroup DMATerminals
+ */
+enum class DMAReadStatus : std::uint8_t {
+	Success,	/**< All the elements requested were read */
+	NotEnough,	/**< Non-blocking read with less elements available than
+					 requested. Nothing was read */
+	Timeout,	/**< Blocking read whose timeout expired. Nothing was read */
+	NotFound,	/**< The DMA does not exist */
+	Error		/**< The FPGA operation failed, see DMAReadResult::fpgaStatus */
+};
+
+/**
+ * Describes one of the reads of TerminalsDMACommon::readDataMulti. It is an
+ * aggregate, so it can be brace-initialized as {n, elements, data}
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAReadRequest {
+	std::uint32_t n; /**< Number of DMA group */
+	size_t elements; /**< Number of elements to read */
+	/// Buffer with room for \p elements. Allocation and deallocation of data
+	/// is user responsibility
+	std::uint64_t *data;
+};
+
+/**
+ * Result of one of the reads of TerminalsDMACommon::readDataMulti
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAReadResult {
+	size_t elementsRead = 0; /**< 0 or DMAReadRequest::elements */
+	DMAReadStatus status = DMAReadStatus::Success; /**< Outcome of the read */
+	/// NiFpga_Status of the failed operation when \p status is Error
+	std::int32_t fpgaStatus = 0;
+};
+
+/**
+ * Timing of the reads of a DMA, see TerminalsDMACommon::getReadStats.
+ * Reads that time out are only counted
+ *
+ * @ingroup DMATerminals
+ */
+struct DMAReadStats {
+	HistogramSnapshot latencyNs; /**< Duration of each read */
+	HistogramSnapshot elements; /**< Elements returned by each read */
+	/// Elements in the FIFO when each read was done, including the ones
+	/// read
+	HistogramSnapshot fillLevel;
+	/// Time between the ends of consecutive reads that returned data, i.e.
+	/// between the arrival of the blocks when reading blocks as they come
+	HistogramSnapshot interArrivalNs;
+	std::uint64_t timeouts = 0; /**< Reads that timed out */
+};
+
+}  // namespace irio
@@ -264,6 +264,98 @@ class DMAReadTimeout: public IrioError {
 	}
 };
 
+/**
+ * Exception when the DMA streaming engine is misused or its threads
+ * cannot be configured
+ *
+ * @ingroup Errors
+ */
+class DMAStreamerError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when a DMA selector is configured with invalid IRQs
+ *
+ * @ingroup Errors
+ */
+class DMASelectorError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when DMA data is interpreted with a layout (frame type, sample
+ * size) different from the one configured in the FPGA
+ *
+ * @ingroup Errors
+ */
+class DAQFormatMismatchError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when a DMA recording cannot be started or its file written
+ *
+ * @ingroup Errors
+ */
+class DMARecorderError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when the memory of a BufferPool cannot be allocated or locked
+ *
+ * @ingroup Errors
+ */
+class BufferPoolError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when a recorded DMA capture cannot be replayed
+ *
+ * @ingroup Errors
+ */
+class DMAReplayError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when FPGA timestamps cannot be correlated with the host clock
+ *
+ * @ingroup Errors
+ */
+class ClockCorrelationError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when the metrics cannot be exported
+ *
+ * @ingroup Errors
+ */
+class MetricsExportError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when a DAQDecimator is given an invalid configuration
+ *
+ * @ingroup Errors
+ */
+class DecimatorConfigError: public IrioError {
+	using IrioError::IrioError;
+};
+
+/**
+ * Exception when the NiFpga simulator is given an invalid configuration
+ *
+ * @ingroup Errors
+ */
+class SimulatorConfigError: public IrioError {
+	using IrioError::IrioError;
+};
+
 /**
  * Exception when an error occurs while parsing the bitfile
  *
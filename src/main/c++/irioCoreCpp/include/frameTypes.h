@@ -9,7 +9,7 @@ namespace irio {
  */
 enum class FrameType : std::uint8_t {
 	FormatA = 0,/**< Format used for DAQ samples */
-	FormatB = 1 /**< Not yet defined */
+	FormatB = 1 /**< DAQ samples preceded by a header and a timestamp word */
 };
 
 }  // namespace irio
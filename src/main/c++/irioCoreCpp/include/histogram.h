@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace irio {
+
+/**
+ * Copy of the contents of a Histogram at a given time
+ *
+ * @ingroup DMATerminals
+ */
+struct HistogramSnapshot {
+	std::uint64_t count = 0; /**< Values recorded */
+	std::uint64_t sum = 0; /**< Sum of the values recorded */
+	std::uint64_t min = 0; /**< Lowest value recorded, 0 if none */
+	std::uint64_t max = 0; /**< Highest value recorded, 0 if none */
+	/// Values recorded in each of the Histogram::BUCKETS buckets, see
+	/// Histogram::bucketLowerBound()
+	std::vector<std::uint64_t> buckets;
+
+	/**
+	 * Returns the mean of the values recorded
+	 *
+	 * @return Mean, 0 if nothing was recorded
+	 */
+	double mean() const;
+
+	/**
+	 * Returns the value below or at which a percentage of the values
+	 * recorded are. The result is the upper bound of the bucket holding
+	 * it, limited to [min, max], so it may exceed the exact percentile by
+	 * the width of the bucket (6.25% of the value at most)
+	 *
+	 * @param percent	Percentage, from 0 to 100
+	 * @return Percentile, 0 if nothing was recorded
+	 */
+	std::uint64_t percentile(const double percent) const;
+};
+
+/**
+ * Lock-free histogram of unsigned integers with a fixed memory footprint.
+ *
+ * Buckets are log-linear: values under 16 have a bucket each and every
+ * power of two above is split in 16 buckets of equal width, so the
+ * resolution is 1/16 of the value across the whole 64-bit range.
+ *
+ * record() can be called from any number of threads concurrently with
+ * snapshot() and reset(). A snapshot taken while values are being recorded
+ * may miss some of them in some fields, and values recorded during a
+ * reset may be lost.
+ *
+ * @ingroup DMATerminals
+ */
+class Histogram {
+ public:
+	/// Bits of the value that select the bucket inside a power of two
+	static const unsigned SUB_BUCKET_BITS = 4;
+	/// Buckets per power of two
+	static const size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+	/// Number of buckets
+	static const size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	/**
+	 * Creates an empty histogram
+	 */
+	Histogram();
+
+	Histogram(const Histogram&) = delete;
+	Histogram& operator=(const Histogram&) = delete;
+
+	/**
+	 * Adds a value
+	 *
+	 * @param value Value to add
+	 */
+	void record(const std::uint64_t value) noexcept;
+
+	/**
+	 * Copies the contents of the histogram
+	 *
+	 * @return Snapshot
+	 */
+	HistogramSnapshot snapshot() const;
+
+	/**
+	 * Removes all the values
+	 */
+	void reset() noexcept;
+
+	/**
+	 * Returns the bucket where a value is recorded
+	 *
+	 * @param value Value
+	 * @return Index of the bucket
+	 */
+	static size_t bucketOf(const std::uint64_t value) noexcept;
+
+	/**
+	 * Returns the lowest value of a bucket
+	 *
+	 * @param bucket Index of the bucket, lower than BUCKETS
+	 * @return Lowest value recorded in \p bucket
+	 */
+	static std::uint64_t bucketLowerBound(const size_t bucket) noexcept;
+
+	/**
+	 * Returns the highest value of a bucket
+	 *
+	 * @param bucket Index of the bucket, lower than BUCKETS
+	 * @return Highest value recorded in \p bucket
+	 */
+	static std::uint64_t bucketUpperBound(const size_t bucket) noexcept;
+
+ private:
+	std::array<std::atomic<std::uint64_t>, BUCKETS> m_buckets;
+	std::atomic<std::uint64_t> m_sum;
+	std::atomic<std::uint64_t> m_min;
+	std::atomic<std::uint64_t> m_max;
+};
+
+}  // namespace irio
@@ -28,6 +28,14 @@ constexpr char PARSE_LOG_PATH_ENV_VAR[] = "PARSE_LOG_IRIOCORE";
  */
 constexpr char DEFAULT_PARSE_LOG_PATH[] = "/tmp/";
 
+/**
+ * When the terminals of the profile are built
+ */
+enum class TerminalsConstruction {
+	Eager,	/**< All of them by the constructor, checking every resource */
+	Lazy	/**< Each one when first requested, see Irio::validateTerminals */
+};
+
 /**
  * irioCoreCpp main class.
  * 
@@ -60,9 +68,15 @@ class Irio {
 	 * @param RIOSerialNumber	RIO Serial Number of the device to use
 	 * @param FPGAVIversion		Version of the Bitfile. If it does not match the one parsed and exception will be thrown
 	 * @param parseVerbose		Print discovered resources
+	 * @param construction		When to build the terminals. In lazy mode
+	 * 							only the common resources are checked here,
+	 * 							the bitfile is kept parsed and each terminal
+	 * 							finds its resources when first requested
 	 */
   Irio(const std::string &bitfilePath, const std::string &RIOSerialNumber,
-		 const std::string &FPGAVIversion, const bool parseVerbose = false);
+		 const std::string &FPGAVIversion, const bool parseVerbose = false,
+		 const TerminalsConstruction construction =
+				 TerminalsConstruction::Eager);
 
   /**
    * Destructor.
@@ -93,6 +107,31 @@ class Irio {
    */
   void startFPGA(std::uint32_t timeoutMs = 5000) const;
 
+  /**
+   * Builds the terminals not requested yet, checking all the resources of
+   * the bitfile as the constructor does in eager mode. Does nothing in
+   * eager mode
+   *
+   * @throw irio::errors::ResourceNotFoundError	Some of the necessary resources were not found in the bitfile. They are printed and logged as in the constructor
+   * @throw irio::errors::NiFpgaError				Error occurred in an FPGA operation
+   */
+  void validateTerminals() const;
+
+  /**
+   * Returns the signature of the bitfile downloaded to the device
+   *
+   * @return Bitfile signature
+   */
+  std::string getSignature() const;
+
+  /**
+   * Returns the NUMA node the RIO device is attached to. Memory read from
+   * its DMAs is best allocated there, see BufferPoolConfig::numaNode
+   *
+   * @return NUMA node, -1 if unknown or the system is not NUMA
+   */
+  int getNumaNode() const;
+
   /**
    * Returns the platform detected
    *
@@ -331,15 +370,32 @@ class Irio {
 	 */
 	void selectDevProfile(ParserManager *parserManager);
 
+	/**
+	 * Prints the resources not found and writes the parse log, in the folder
+	 * in #PARSE_LOG_PATH_ENV_VAR or #DEFAULT_PARSE_LOG_PATH
+	 *
+	 * @param parserManager Manager that searched the resources
+	 */
+	void reportResourcesNotFound(const ParserManager &parserManager) const;
+
 	/// Platform of the RIO device
 	std::unique_ptr<Platform> m_platform;
 
+	/// Bitfile parsed, kept to build the terminals in lazy mode
+	std::unique_ptr<ParserManager> m_parserManager;
+
 	/// Profile specified in the bitfile
 	std::unique_ptr<ProfileBase> m_profile;
 
+	/// Path of the bitfile downloaded
+	std::string m_bitfilePath;
+
 	/// Name of the RIO device used. Obtained through the serialNumber specified.
 	std::string m_resourceName;
 
+	/// Signature of the bitfile downloaded
+	std::string m_signature;
+
     /// Session obtained when opening a session using the NiFpga library
 	NiFpga_Session m_session = 0;
 
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <NiFpga.h>
+
+namespace irio {
+
+/**
+ * Kind of terminals whose operations are counted
+ *
+ * @ingroup IrioCoreCpp
+ */
+enum class MetricsTerminal : std::uint8_t {
+	Common = 0,
+	Analog = 1,
+	AuxAnalog = 2,
+	Digital = 3,
+	AuxDigital = 4,
+	SignalGeneration = 5,
+	IO = 6,
+	CRIO = 7,
+	FlexRIO = 8,
+	DMA = 9		/**< DAQ and IMAQ terminals */
+};
+
+/**
+ * Operations counted per terminal
+ *
+ * @ingroup IrioCoreCpp
+ */
+enum class MetricsOperation : std::uint8_t {
+	RegisterRead = 0,	/**< Reads of registers */
+	RegisterWrite = 1,	/**< Writes of registers */
+	DMARead = 2,		/**< Reads of DMAs */
+	DMAElementsRead = 3,	/**< Elements returned by the reads of DMAs */
+	Timeout = 4,		/**< Operations whose timeout expired */
+	NiFpgaError = 5		/**< NiFpga operations that returned an error */
+};
+
+/// Number of MetricsTerminal values
+const size_t METRICS_TERMINALS = 10;
+/// Number of MetricsOperation values
+const size_t METRICS_OPERATIONS = 6;
+/// Devices with counters of their own. Operations of later devices are
+/// not counted
+const size_t METRICS_MAX_DEVICES = 32;
+
+/**
+ * Returns the name of a kind of terminals used in the exported metrics
+ *
+ * @param terminal Kind of terminals
+ * @return Name, e.g. "analog"
+ */
+const char* toString(const MetricsTerminal terminal);
+
+/**
+ * Returns the name of the Prometheus counter of an operation
+ *
+ * @param operation Operation
+ * @return Name, e.g. "irio_register_reads_total"
+ */
+const char* toString(const MetricsOperation operation);
+
+/**
+ * Value of a counter of a device
+ *
+ * @ingroup IrioCoreCpp
+ */
+struct MetricsValue {
+	std::string device; /**< Resource name of the device, e.g. "RIO0" */
+	MetricsTerminal terminal; /**< Kind of terminals */
+	MetricsOperation operation; /**< Operation counted */
+	std::uint64_t value; /**< Operations done since the counter was reset */
+};
+
+/**
+ * Values of all the counters at a given time
+ *
+ * @ingroup IrioCoreCpp
+ */
+struct MetricsSnapshot {
+	/// Time the snapshot was taken
+	std::chrono::system_clock::time_point time;
+	/// Counters of the terminals created in each device
+	std::vector<MetricsValue> values;
+	/// NiFpga errors not attributed to a device, e.g. opening a session
+	std::uint64_t unattributedErrors = 0;
+
+	/**
+	 * Returns the value of a counter
+	 *
+	 * @param device	Resource name of the device
+	 * @param terminal	Kind of terminals
+	 * @param operation	Operation
+	 * @return Value of the counter, 0 if not in the snapshot
+	 */
+	std::uint64_t get(const std::string &device,
+			const MetricsTerminal terminal,
+			const MetricsOperation operation) const;
+
+	/**
+	 * Formats the snapshot in the Prometheus text exposition format. Each
+	 * operation is a counter labeled with the device and the terminal
+	 *
+	 * @return Text
+	 */
+	std::string toPrometheus() const;
+};
+
+/**
+ * Handle used by the terminals to update the counters of their device.
+ *
+ * Each thread updates its own copy of the counters, so updating does not
+ * contend with other threads nor needs atomic read-modify-write
+ * instructions. Default-constructed handles discard the updates.
+ *
+ * @ingroup IrioCoreCpp
+ */
+class MetricsCounters {
+ public:
+	MetricsCounters() = default;
+
+	/**
+	 * Adds to a counter
+	 *
+	 * @param operation	Operation to count
+	 * @param count		Value to add
+	 */
+	void add(const MetricsOperation operation,
+			const std::uint64_t count = 1) const;
+
+ private:
+	friend class MetricsRegistry;
+
+	explicit MetricsCounters(const std::uint32_t base);
+
+	/// First slot of the counters, 0 is the slot discarding the updates
+	std::uint32_t m_base = 0;
+};
+
+/**
+ * Library-wide registry of the operation counters.
+ *
+ * Irio binds its session to the resource name of the device, and the
+ * terminals created with that session count their operations in the
+ * counters of the device. Reopening a device continues its counters.
+ *
+ * Counters are sharded per thread. snapshot() sums the shards of all the
+ * threads, including the ones that have finished.
+ *
+ * @ingroup IrioCoreCpp
+ */
+class MetricsRegistry {
+ public:
+	/**
+	 * Returns the registry
+	 *
+	 * @return Registry shared by all the devices
+	 */
+	static MetricsRegistry& instance();
+
+	MetricsRegistry(const MetricsRegistry&) = delete;
+	MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+	/**
+	 * Associates a session with a device. Called by Irio when the session
+	 * is opened. Once METRICS_MAX_DEVICES devices have been bound, new
+	 * devices are not counted
+	 *
+	 * @param session	Session opened
+	 * @param device	Resource name of the device
+	 */
+	void bindSession(const NiFpga_Session session, const std::string &device);
+
+	/**
+	 * Forgets a session. Called by Irio when the session is closed
+	 *
+	 * @param session Session closed
+	 */
+	void unbindSession(const NiFpga_Session session);
+
+	/**
+	 * Returns the counters of a kind of terminals of the device bound to a
+	 * session. The kind of terminals is exported from then on
+	 *
+	 * @param session	Session of the terminals
+	 * @param terminal	Kind of terminals
+	 * @return Counters, discarding the updates if the session is not bound
+	 */
+	MetricsCounters getCounters(const NiFpga_Session session,
+			const MetricsTerminal terminal);
+
+	/**
+	 * Counts a NiFpga error not attributed to any device
+	 */
+	static void countUnattributedError();
+
+	/**
+	 * Returns the value of all the counters
+	 *
+	 * @return Snapshot
+	 */
+	MetricsSnapshot snapshot() const;
+
+	/**
+	 * Sets all the counters to 0. Updates done while resetting may be lost
+	 */
+	void reset();
+
+ private:
+	MetricsRegistry() = default;
+
+	struct Device {
+		std::string name;
+		/// Kinds of terminals created in the device
+		bool terminals[METRICS_TERMINALS] = {};
+	};
+
+	mutable std::mutex m_mutex;
+	std::vector<Device> m_devices;
+	std::unordered_map<NiFpga_Session, size_t> m_sessions;
+};
+
+}  // namespace irio
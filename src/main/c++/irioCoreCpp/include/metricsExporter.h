@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "metrics.h"
+
+namespace irio {
+
+/**
+ * Where a MetricsExporter writes the metrics
+ *
+ * @ingroup IrioCoreCpp
+ */
+enum class MetricsTarget : std::uint8_t {
+	/// Replaces a file, e.g. for the textfile collector of node_exporter.
+	/// The text is written to "<path>.tmp" and renamed, so readers never
+	/// see a partial file
+	File = 0,
+	/// Connects to a Unix stream socket, writes the text and disconnects
+	UnixSocket = 1
+};
+
+/**
+ * Configuration of a MetricsExporter
+ *
+ * @ingroup IrioCoreCpp
+ */
+struct MetricsExporterConfig {
+	std::string path; /**< File or socket to write */
+	MetricsTarget target = MetricsTarget::File; /**< Kind of \p path */
+	/// Milliseconds between exports of the exporter thread. 0 disables the
+	/// thread, only exportNow() writes
+	std::uint32_t period = 10000;
+};
+
+/**
+ * Writes the snapshots of the MetricsRegistry in the Prometheus text
+ * format, periodically from its own thread and/or whenever exportNow() is
+ * called.
+ *
+ * @ingroup IrioCoreCpp
+ */
+class MetricsExporter {
+ public:
+	/**
+	 * Creates an exporter, without starting its thread
+	 *
+	 * @throw irio::errors::MetricsExportError	Empty path
+	 *
+	 * @param config Exporter configuration
+	 */
+	explicit MetricsExporter(const MetricsExporterConfig &config);
+
+	/**
+	 * Stops the exporter thread if it is running
+	 */
+	~MetricsExporter();
+
+	MetricsExporter(const MetricsExporter&) = delete;
+	MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+	/**
+	 * Launches the thread exporting every period milliseconds. Does
+	 * nothing if the period is 0
+	 */
+	void start();
+
+	/**
+	 * Stops and joins the exporter thread
+	 */
+	void stop();
+
+	/**
+	 * Returns whether the exporter thread is running
+	 *
+	 * @return True if running
+	 */
+	bool isRunning() const;
+
+	/**
+	 * Writes a snapshot now, on the calling thread
+	 *
+	 * @throw irio::errors::MetricsExportError	The file or socket cannot be
+	 * 											written
+	 */
+	void exportNow();
+
+	/**
+	 * Returns the number of snapshots written
+	 *
+	 * @return Successful exports
+	 */
+	std::uint64_t getExports() const;
+
+	/**
+	 * Returns the number of exports that failed. The exporter thread keeps
+	 * trying on each period
+	 *
+	 * @return Failed exports
+	 */
+	std::uint64_t getFailures() const;
+
+ private:
+	void exportLoop();
+	void writeFile(const std::string &text) const;
+	void writeSocket(const std::string &text) const;
+
+	const MetricsExporterConfig m_config;
+
+	/// Serializes the exports
+	std::mutex m_exportMutex;
+	std::atomic<std::uint64_t> m_exports;
+	std::atomic<std::uint64_t> m_failures;
+
+	std::mutex m_mutex;
+	std::atomic<bool> m_running;
+	std::condition_variable m_wakeUp;
+	std::thread m_thread;
+};
+
+}  // namespace irio
@@ -211,6 +211,42 @@ class ParserManager {
 						std::unordered_map<std::uint32_t, const std::uint32_t> *mapInsert,
 						const bool optional = false);
 
+	/**
+	 * Finds the addresses of all the registers following the enumeration
+	 * naming convention with a number lower than \p maxResources, in one
+	 * lookup of the enumeration index of the bitfile.
+	 *
+	 * Equivalent to calling findRegisterEnumAddress() as optional for every
+	 * number from 0 to \p maxResources - 1.
+	 *
+	 * @param resourceName The name of the resource without its number.
+	 * @param maxResources Upper bound (excluded) of the numbers to find.
+	 * @param group The group of the resource.
+	 * @param mapInsert Pointer to the enumeration map.
+	 * @return Number of registers found.
+	 */
+	size_t enumerateRegisterAddresses(const std::string &resourceName,
+			const size_t maxResources, const GroupResource &group,
+			std::unordered_map<std::uint32_t, const std::uint32_t> *mapInsert);
+
+	/**
+	 * Finds the DMA numbers of all the DMAs following the enumeration naming
+	 * convention with a number lower than \p maxResources, in one lookup of
+	 * the enumeration index of the bitfile.
+	 *
+	 * Equivalent to calling findDMAEnumNum() as optional for every number
+	 * from 0 to \p maxResources - 1.
+	 *
+	 * @param resourceName The name of the resource without its number.
+	 * @param maxResources Upper bound (excluded) of the numbers to find.
+	 * @param group The group of the resource.
+	 * @param mapInsert Pointer to the enumeration map.
+	 * @return Number of DMAs found.
+	 */
+	size_t enumerateDMANums(const std::string &resourceName,
+			const size_t maxResources, const GroupResource &group,
+			std::unordered_map<std::uint32_t, const std::uint32_t> *mapInsert);
+
 	/**
 	 * Compares two resource maps and logs any differences.
 	 * 
@@ -244,6 +280,13 @@ class ParserManager {
 	 */
 	bool hasErrorOccurred() const;
 
+	/**
+	 * Returns how many resources not found or with errors have been logged.
+	 * Allows to check if a step of the parsing logged new errors
+	 * @return Number of errors logged so far
+	 */
+	size_t getNumErrors() const;
+
 	/**
 	 * Prints resources found, not found and incompatibilities
 	 * @param os 			The output stream to print the information to.
@@ -286,8 +329,8 @@ class ParserManager {
 	bfp::BFP m_bfp;
 	/// Map to divide information of found resources per group
 	std::unordered_map<GroupResource, GroupInfo> m_groupInfo;
-	/// True if some resource was not found
-	bool m_error = false;
+	/// Number of resources not found or with errors logged
+	size_t m_numErrors = 0;
 
 	/// Convert GroupResource to string
 	const std::unordered_map<GroupResource, std::string> m_group2str = {
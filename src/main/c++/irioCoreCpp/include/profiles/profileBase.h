@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <typeindex>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "terminals/terminals.h"
 #include "profilesTypes.h"
@@ -17,6 +21,10 @@ namespace irio {
  * If a terminal group is not in the profile,
  * an \ref irio::errors::TerminalNotImplementedError exception will be thrown.
  *
+ * The profiles only register how to build their terminals. Each terminal is
+ * built, finding its resources in the bitfile, the first time it is
+ * requested or when calling buildAllTerminals().
+ *
  * @ingroup Profiles
  */
 class ProfileBase {
@@ -25,7 +33,8 @@ class ProfileBase {
 	 * Allows the user to access terminals for read/write operations.
 	 * 
 	 * @param parserManager     Pointer to class managing parsing the bitfile
-	 *                          and finding its resources
+	 *                          and finding its resources. Must outlive
+	 *                          the terminals not built yet
 	 * @param session           NiFpga_Session to be used in NiFpga related functions
 	 * @param id				Identification of the profile type
 	 */
@@ -33,9 +42,12 @@ class ProfileBase {
 		const NiFpga_Session &session, const PROFILE_ID &id);
 
 	/**
-	 * Returns the specified terminal if it is present in the current profile
+	 * Returns the specified terminal if it is present in the current profile.
+	 * The terminal is built on the first call
 	 *
 	 * @throw irio::errors::TerminalNotImplementedError	Terminals group not present for the current profile
+	 * @throw irio::errors::ResourceNotFoundError	Some resources of the terminal were not found in the bitfile
+	 * @throw irio::errors::NiFpgaError	Error occurred in an FPGA operation while building the terminal
 	 *
 	 * @tparam T	Terminals to get
 	 * @return		Requested terminals
@@ -43,6 +55,17 @@ class ProfileBase {
 	template<typename T>
 	T getTerminal() const;
 
+	/**
+	 * Builds all the terminals of the profile not built yet. The ones
+	 * whose resources are not found are not kept, but they are all built
+	 * so the ParserManager logs every resource missing
+	 *
+	 * @throw irio::errors::NiFpgaError	Error occurred in an FPGA operation while building a terminal
+	 *
+	 * @return False if some resources were not found in the bitfile
+	 */
+	bool buildAllTerminals() const;
+
 	/**
 	 * Profile type
 	 */
@@ -50,18 +73,62 @@ class ProfileBase {
 
  protected:
 	/**
-	 * @brief Adds a terminal to the profile.
+	 * @brief Adds a terminal to the profile, built when first requested.
 	 *
-	 * @param terminal The terminal to be added.
-	 * @tparam T The type of the terminal.
+	 * @tparam T	Type used to request the terminal
+	 * @tparam Impl	Type of the terminal built. T or a class derived from it
+	 * @param args	Arguments of the constructor of \p Impl following the
+	 * 				ParserManager and the session
 	 */
-	template<typename T>
-	void addTerminal(T terminal);
+	template<typename T, typename Impl = T, typename... Args>
+	void addTerminal(const Args&... args);
 
  private:
+	/// Terminal of the profile and how to build it
+	struct TerminalEntry {
+		/// Builds the terminal. Released once built
+		std::function<TerminalsBase*(ParserManager*, const NiFpga_Session&)>
+			build;
+		/// Terminal, null until built
+		std::unique_ptr<TerminalsBase> terminal;
+		/// Set once terminal can be used without locking
+		std::atomic<bool> built{false};
+	};
+
+	/**
+	 * Builds a terminal if not built yet
+	 *
+	 * @throw irio::errors::ResourceNotFoundError	Some resources of the terminal were not found
+	 *
+	 * @param entry	Terminal to build
+	 */
+	void buildTerminal(TerminalEntry *entry) const;
+
+	/// Used to find the resources of the terminals
+	ParserManager *m_parserManager;
+
+	/// Session used by the terminals
+	const NiFpga_Session m_session;
+
+	/// Serializes building the terminals, as ParserManager is not thread safe
+	mutable std::mutex m_buildMutex;
+
+	/// Terminals in the order they were added, which is the order built
+	std::vector<std::unique_ptr<TerminalEntry>> m_terminals;
+
 	/// Associates a Terminal type to the actual instance of the terminal
-	std::unordered_map<std::type_index,
-			std::unique_ptr<TerminalsBase>> m_mapTerminals;
+	std::unordered_map<std::type_index, TerminalEntry*> m_mapTerminals;
 };
 
+template<typename T, typename Impl, typename... Args>
+void ProfileBase::addTerminal(const Args&... args) {
+	std::unique_ptr<TerminalEntry> entry(new TerminalEntry());
+	entry->build = [args...](ParserManager *parserManager,
+			const NiFpga_Session &session) -> TerminalsBase* {
+		return new Impl(parserManager, session, args...);
+	};
+	m_mapTerminals.emplace(std::type_index(typeid(T)), entry.get());
+	m_terminals.push_back(std::move(entry));
+}
+
 }  // namespace irio
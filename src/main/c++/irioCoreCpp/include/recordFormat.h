@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace irio {
+
+/**
+ * Layout of the files written by DMARecorder.
+ *
+ * A record file holds the data of one DMA. Every part starts at a multiple
+ * of ALIGNMENT so the file can be written with O_DIRECT:
+ *
+ * | Offset                           | Content                           |
+ * |----------------------------------|-----------------------------------|
+ * | 0                                | FileHeader, padded to ALIGNMENT   |
+ * | ALIGNMENT + i * chunkSize        | Chunk i: ChunkHeader + DMA blocks |
+ * | indexOffset                      | indexEntries IndexEntry           |
+ *
+ * Chunks have a fixed size (FileHeader::chunkSize, padding included) and
+ * hold FileHeader::blocksPerChunk whole DMA blocks, each of
+ * FileHeader::elementsPerBlock 64-bit words, right after the ChunkHeader.
+ * The index is written when the recording stops. A file whose indexOffset
+ * is 0 was not closed properly, but its chunks can still be walked with
+ * FileHeader::chunkSize. All fields are little-endian.
+ */
+namespace record {
+
+/// Alignment of the parts of the file, and of the buffers written
+constexpr size_t ALIGNMENT = 4096;
+
+/// FileHeader::magic
+constexpr char FILE_MAGIC[8] = {'I', 'R', 'I', 'O', 'R', 'E', 'C', '\0'};
+
+/// FileHeader::version of the layout described here
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+/// ChunkHeader::magic ("IRIOCHNK")
+constexpr std::uint64_t CHUNK_MAGIC = 0x4B4E48434F495249ull;
+
+/// Max length of FileHeader::signature, NUL included
+constexpr size_t SIGNATURE_LENGTH = 64;
+
+/**
+ * Description of the recorded DMA, at offset 0 of the file
+ */
+struct FileHeader {
+	char magic[8];				/**< FILE_MAGIC */
+	std::uint32_t version;		/**< FORMAT_VERSION */
+	std::uint32_t dma;			/**< Number of the DMA group */
+	/// Signature of the bitfile running while recording, NUL terminated
+	char signature[SIGNATURE_LENGTH];
+	std::uint16_t nCh;			/**< TerminalsDMACommon::getNCh */
+	std::uint8_t sampleSize;	/**< TerminalsDMACommon::getSampleSize */
+	std::uint8_t frameType;		/**< TerminalsDMACommon::getFrameType */
+	std::uint16_t lengthBlock;	/**< TerminalsDMADAQ::getLengthBlock */
+	/// TerminalsDMADAQ::getSamplingRateDecimation
+	std::uint16_t decimation;
+	/// Words per block, TerminalsDMADAQ::getElementsPerBlock
+	std::uint64_t elementsPerBlock;
+	std::uint64_t blocksPerChunk;	/**< Blocks in every chunk */
+	/// Bytes of every chunk in the file, header and padding included
+	std::uint64_t chunkSize;
+	/// Nanoseconds since the epoch when the recording started
+	std::uint64_t startTime;
+	std::uint64_t chunkCount;	/**< Chunks in the file */
+	std::uint64_t indexOffset;	/**< Offset of the index, 0 if not written */
+	std::uint64_t indexEntries;	/**< Entries of the index */
+	std::uint64_t blocksDropped;	/**< Blocks lost while recording */
+};
+
+/**
+ * Header of every chunk
+ */
+struct ChunkHeader {
+	std::uint64_t magic;		/**< CHUNK_MAGIC */
+	std::uint64_t sequence;		/**< Position of the chunk in the file */
+	/// Blocks read from the DMA before the first block of the chunk,
+	/// dropped ones included. A jump between chunks means lost blocks
+	std::uint64_t firstBlock;
+	/// Nanoseconds since the epoch when the chunk was read
+	std::uint64_t timestamp;
+	std::uint64_t reserved[4];
+};
+
+/// Bytes reserved for the ChunkHeader, the blocks start after them
+constexpr size_t CHUNK_HEADER_SIZE = sizeof(ChunkHeader);
+
+/**
+ * Entry of the block index, one per chunk
+ */
+struct IndexEntry {
+	std::uint64_t offset;		/**< Offset of the chunk in the file */
+	std::uint64_t firstBlock;	/**< ChunkHeader::firstBlock */
+	std::uint64_t timestamp;	/**< ChunkHeader::timestamp */
+	std::uint64_t reserved;
+};
+
+static_assert(sizeof(FileHeader) <= ALIGNMENT, "FileHeader too big");
+static_assert(sizeof(ChunkHeader) == 64, "ChunkHeader must be 64 bytes");
+static_assert(sizeof(IndexEntry) == 32, "IndexEntry must be 32 bytes");
+
+/**
+ * Returns the bytes of a chunk in the file
+ *
+ * @param elementsPerBlock	Words per DMA block
+ * @param blocksPerChunk	Blocks per chunk
+ * @return Chunk size, multiple of ALIGNMENT
+ */
+constexpr std::uint64_t getChunkSize(const std::uint64_t elementsPerBlock,
+		const std::uint64_t blocksPerChunk) {
+	return (CHUNK_HEADER_SIZE + elementsPerBlock * blocksPerChunk * 8
+			+ ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+}  // namespace record
+}  // namespace irio
@@ -25,6 +25,17 @@ std::string searchRIODevice(const std::string serialNumber);
  * cases, suggest it please.
  */
 
+/**
+ * @ingroup IrioCoreCpp
+ *
+ * Returns the NUMA node of the PCI device of a RIO device, as reported
+ * by sysfs
+ *
+ * @param resourceName	Name of the RIO device, see searchRIODevice
+ * @return	NUMA node, -1 if unknown or the system is not NUMA
+ */
+int getRIODeviceNumaNode(const std::string &resourceName);
+
 }  // namespace irio
 
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include <NiFpga.h>
 
+#include "metrics.h"
 #include "parserManager.h"
 #include "platforms.h"
 
@@ -18,11 +19,15 @@ class TerminalsBaseImpl {
 	/**
 	 * Base class for terminals
 	 * @param session	NiFpga_Session to be used in NiFpga related functions. Must be a valid one.
+	 * @param terminal	Kind of terminals whose operations are counted in the metrics
 	 */
-	explicit TerminalsBaseImpl(const NiFpga_Session &session);
+	explicit TerminalsBaseImpl(const NiFpga_Session &session,
+			const MetricsTerminal terminal = MetricsTerminal::Common);
 
  protected:
 	const NiFpga_Session m_session;
+	/// Operation counters of these terminals
+	const MetricsCounters m_metrics;
 };
 
 }  // namespace irio
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -7,6 +10,9 @@
 
 #include "terminals/impl/terminalsBaseImpl.h"
 #include "frameTypes.h"
+#include "dmaTypes.h"
+#include "waitPolicy.h"
+#include "histogram.h"
 
 namespace irio {
 /**
@@ -60,11 +66,15 @@ class TerminalsDMACommonImpl: public TerminalsBaseImpl{
 			const std::string &nameTermDMA,
 			const std::string &nameTermDMAEnable);
 
+	virtual ~TerminalsDMACommonImpl() = default;
+
 	std::uint16_t getNChImpl(const std::uint32_t n) const;
 
+	std::vector<std::uint16_t> getAllNChImpl() const;
+
 	bool getDMAOverflowImpl(const std::uint16_t n) const;
 
-	std::uint16_t getAllDMAOverflowsImpl() const;
+	virtual std::uint16_t getAllDMAOverflowsImpl() const;
 
 	FrameType getFrameTypeImpl(const std::uint32_t n) const;
 
@@ -74,25 +84,31 @@ class TerminalsDMACommonImpl: public TerminalsBaseImpl{
 
 	std::vector<std::uint8_t> getAllSampleSizesImpl() const;
 
-	void startDMAImpl(const std::uint32_t n) const;
+	virtual size_t startDMAImpl(const std::uint32_t n) const;
+
+	virtual size_t startAllDMAsImpl() const;
+
+	virtual void setHostDepthImpl(const std::uint32_t n, size_t depth) const;
 
-	void startAllDMAsImpl() const;
+	virtual size_t getHostDepthImpl(const std::uint32_t n) const;
 
-	void stopDMAImpl(const std::uint32_t n) const;
+	virtual size_t getEffectiveHostDepthImpl(const std::uint32_t n) const;
 
-	void stopAllDMAsImpl() const;
+	virtual void stopDMAImpl(const std::uint32_t n) const;
 
-	void cleanDMAImpl(const std::uint32_t n) const;
+	virtual void stopAllDMAsImpl() const;
 
-	void cleanAllDMAsImpl() const;
+	virtual size_t cleanDMAImpl(const std::uint32_t n) const;
 
-	bool isDMAEnableImpl(const std::uint32_t n) const;
+	virtual size_t cleanAllDMAsImpl() const;
+
+	virtual bool isDMAEnableImpl(const std::uint32_t n) const;
 
 	void enableDMAImpl(const std::uint32_t n) const;
 
 	void disableDMAImpl(const std::uint32_t n) const;
 
-	void enaDisDMAImpl(const std::uint32_t n, bool enaDis) const;
+	virtual void enaDisDMAImpl(const std::uint32_t n, bool enaDis) const;
 
 	size_t readDataNonBlockingImpl(const std::uint32_t n,
 			size_t elementsToRead, std::uint64_t *data) const;
@@ -103,6 +119,13 @@ class TerminalsDMACommonImpl: public TerminalsBaseImpl{
 			std::uint64_t *data,
 			std::uint32_t timeout = 0) const;
 
+	size_t readDataBlockingImpl(
+			const std::uint32_t n,
+			size_t elementsToRead,
+			std::uint64_t *data,
+			std::uint32_t timeout,
+			const WaitPolicy &policy) const;
+
 	size_t readDataImpl(
 			const std::uint32_t n,
 			size_t elementsToRead,
@@ -110,9 +133,81 @@ class TerminalsDMACommonImpl: public TerminalsBaseImpl{
 			bool blockRead,
 			std::uint32_t timeout = 0) const;
 
+	virtual size_t readDataImpl(
+			const std::uint32_t n,
+			size_t elementsToRead,
+			std::uint64_t *data,
+			bool blockRead,
+			std::uint32_t timeout,
+			const WaitPolicy &policy) const;
+
+	void setWaitPolicyImpl(const WaitPolicy &policy) const;
+
+	WaitPolicy getWaitPolicyImpl() const;
+
+	void setReadStatsEnabledImpl(const bool enable) const;
+
+	bool isReadStatsEnabledImpl() const;
+
+	DMAReadStats getReadStatsImpl(const std::uint32_t n) const;
+
+	void resetReadStatsImpl(const std::uint32_t n) const;
+
+	void resetAllReadStatsImpl() const;
+
+	virtual size_t readDataMultiImpl(
+			const std::vector<DMAReadRequest> &requests,
+			std::vector<DMAReadResult> *results,
+			bool blockRead,
+			std::uint32_t timeout) const;
+
+	virtual size_t getElementsAvailableImpl(const std::uint32_t n) const;
+
+	virtual NiFpga_IrqContext reserveIrqContextImpl() const;
+
+	virtual void unreserveIrqContextImpl(
+			NiFpga_IrqContext context) const noexcept;
+
+	virtual std::uint32_t waitOnIrqsImpl(NiFpga_IrqContext context,
+			const std::uint32_t irqs, const std::uint32_t timeout) const;
+
+	virtual void acknowledgeIrqsImpl(const std::uint32_t irqs) const;
+
+	virtual size_t readAvailableImpl(
+			const std::uint32_t n,
+			size_t maxElements,
+			std::uint64_t *data,
+			size_t minElements,
+			size_t *elementsRemaining) const;
+
+	virtual DMADataView acquireDataImpl(
+			const std::uint32_t n,
+			size_t elements,
+			std::uint32_t timeout = 0) const;
+
+	virtual void releaseDataImpl(const std::uint32_t n, size_t elements) const;
+
 	size_t countDMAsImpl() const;
 
+	bool hasDMAImpl(const std::uint32_t n) const;
+
  protected:
+	/**
+	 * Constructor for DMAs that are not backed by an FPGA session, such as
+	 * the ones replayed from files. DMA <i>n</i> is described by the
+	 * <i>n<sup>th</sup></i> element of the vectors. Such implementations
+	 * must override the virtual methods that access the FPGA.
+	 *
+	 * @param nCh			Channels of each DMA
+	 * @param frameType		Frame type of each DMA
+	 * @param sampleSize	Sample size of each DMA
+	 * @param nameTermDMA	Name of the DMAs used in the errors
+	 */
+	TerminalsDMACommonImpl(const std::vector<std::uint16_t> &nCh,
+			const std::vector<FrameType> &frameType,
+			const std::vector<std::uint8_t> &sampleSize,
+			const std::string &nameTermDMA);
+
 	template<typename T>
 	bool findArrayRegReadToVector(ParserManager *parserManager,
 			const GroupResource &group, bool optional,
@@ -123,13 +218,64 @@ class TerminalsDMACommonImpl: public TerminalsBaseImpl{
 
 	std::unordered_map<std::uint32_t, const std::uint32_t> getDMAMap() const;
 
+	/**
+	 * Adds a read to the statistics of a DMA. Implementations overriding
+	 * readDataImpl() call it when isReadStatsEnabledImpl() is true
+	 *
+	 * @param n				Number of DMA group
+	 * @param start			Time the read started
+	 * @param elementsRead	Elements returned by the read
+	 * @param fillLevel		Elements in the FIFO when the read was done
+	 */
+	void recordRead(const std::uint32_t n,
+			const std::chrono::steady_clock::time_point &start,
+			const size_t elementsRead, const size_t fillLevel) const;
+
+	/**
+	 * Counts a read of a DMA that timed out in its statistics
+	 *
+	 * @param n Number of DMA group
+	 */
+	void recordReadTimeout(const std::uint32_t n) const;
+
  private:
-	static const size_t SIZE_HOST_DMAS = 2048000;  // TODO: Why this number?
+	/// Default host buffer depth, kept from the old library
+	static const size_t SIZE_HOST_DMAS = 2048000;
 
 	std::unordered_map<std::uint32_t, const std::uint32_t> m_mapDMA;
 
-	void startDMACommon(const std::uint32_t &dma) const;
-	void cleanDMACommon(const std::uint32_t &dma) const;
+	/// Requested host buffer depth per DMA group (0 means default)
+	mutable std::unordered_map<std::uint32_t, size_t> m_hostDepth;
+	/// Host buffer depth granted by the driver per DMA group
+	mutable std::unordered_map<std::uint32_t, size_t> m_effectiveHostDepth;
+	/// Elements remaining reported by the driver in the last readAvailable
+	mutable std::unordered_map<std::uint32_t, size_t> m_lastRemaining;
+	/// Wait used by the blocking operations without a policy of their own
+	mutable WaitPolicy m_waitPolicy;
+
+	/// Timing of the reads of a DMA, updated without locks
+	struct ReadHistograms {
+		Histogram latencyNs;
+		Histogram elements;
+		Histogram fillLevel;
+		Histogram interArrivalNs;
+		std::atomic<std::uint64_t> timeouts{0};
+		/// End of the last read that returned data, 0 if none
+		std::atomic<std::int64_t> lastReadNs{0};
+	};
+	/// Read statistics per DMA group, allocated at construction
+	std::unordered_map<std::uint32_t, std::unique_ptr<ReadHistograms>>
+			m_readStats;
+	mutable std::atomic<bool> m_readStatsEnabled{false};
+
+	size_t readDataFifo(const std::uint32_t n, size_t elementsToRead,
+			std::uint64_t *data, bool blockRead, std::uint32_t timeout,
+			const WaitPolicy &policy, size_t *fillLevel) const;
+
+	void startDMACommon(const std::uint32_t &n,
+						const std::uint32_t &dma) const;
+	size_t cleanDMACommon(const std::uint32_t &n,
+						  const std::uint32_t &dma) const;
 
 	std::uint32_t m_overflowsAddr;
 
@@ -65,11 +65,37 @@ class TerminalsDMADAQImpl: public TerminalsDMACommonImpl{
 
   std::uint16_t getLengthBlock(const std::uint32_t &n) const;
 
-  std::uint16_t getSamplingRateDecimation(const std::uint32_t &n) const;
+  std::vector<std::uint16_t> getAllLengthBlocks() const;
 
-  void setSamplingRateDecimation(const std::uint32_t &n,
+  size_t getElementsPerBlock(const std::uint32_t &n) const;
+
+  virtual std::uint16_t getSamplingRateDecimation(
+		  const std::uint32_t &n) const;
+
+  virtual void setSamplingRateDecimation(const std::uint32_t &n,
 								 const std::uint16_t &decimation) const;
 
+  size_t setHostDepthAuto(const std::uint32_t &n, const std::uint32_t &fref,
+						  const std::uint32_t &bufferingTimeMs) const;
+
+ protected:
+  /**
+   * Constructor for DMAs that are not backed by an FPGA session.
+   * See TerminalsDMACommonImpl for the meaning of the parameters. Such
+   * implementations must override the sampling rate accessors.
+   *
+   * @param nCh				Channels of each DMA
+   * @param frameType		Frame type of each DMA
+   * @param sampleSize		Sample size of each DMA
+   * @param lengthBlocks	Block length of each DMA
+   * @param nameTermDMA		Name of the DMAs used in the errors
+   */
+  TerminalsDMADAQImpl(const std::vector<std::uint16_t> &nCh,
+					  const std::vector<FrameType> &frameType,
+					  const std::vector<std::uint8_t> &sampleSize,
+					  const std::vector<std::uint16_t> &lengthBlocks,
+					  const std::string &nameTermDMA);
+
  private:
 	const std::string m_nameTermSamplingRate;
 
@@ -77,13 +77,16 @@ class TerminalsDMAIMAQImpl : public TerminalsDMACommonImpl {
 						 const std::uint32_t timeout = 0) const;
 
 	void sendUARTMsgImpl(const std::vector<std::uint8_t> &msg,
-						 const std::uint32_t timeout = 0) const;
+						 const std::uint32_t timeout,
+						 const WaitPolicy &policy) const;
 
 	std::vector<std::uint8_t> recvUARTMsgImpl(const size_t bytesToRecv,
-								const std::uint32_t timeout = 0) const;
+								const std::uint32_t timeout,
+								const WaitPolicy &policy) const;
 
 	void setUARTBaudRateImpl(const UARTBaudRates &baudRate,
-							 const std::uint32_t timeout = 0) const;
+							 const std::uint32_t timeout,
+							 const WaitPolicy &policy) const;
 
 	UARTBaudRates getUARTBaudRateImpl() const;
 
@@ -98,7 +101,8 @@ class TerminalsDMAIMAQImpl : public TerminalsDMACommonImpl {
 
 	void findCLConfig(irio::ParserManager *parserManager);
 
-	void waitForSetBaudRateFalse(const uint32_t timeout) const;
+	void waitForSetBaudRateFalse(const uint32_t timeout,
+								 const WaitPolicy &policy) const;
 
 	std::uint32_t m_baudRate_addr;
 	std::uint32_t m_setBaudRate_addr;
@@ -5,6 +5,8 @@
 
 #include "terminals/terminalsBase.h"
 #include "frameTypes.h"
+#include "dmaTypes.h"
+#include "waitPolicy.h"
 
 namespace irio {
 
@@ -39,6 +41,13 @@ class TerminalsDMACommon: public TerminalsBase{
 	 */
 	std::uint16_t getNCh(const std::uint32_t n) const;
 
+	/**
+	 * Returns a vector of the number of channels in each DMA in the FPGA
+	 *
+	 * @return Vector of number of channels, the position corresponds to the number of DMA
+	 */
+	std::vector<std::uint16_t> getAllNCh() const;
+
 	/**
 	 * Returns the FPGA DMA Overflow register of a specific DMA
 	 *
@@ -103,16 +112,128 @@ class TerminalsDMACommon: public TerminalsBase{
 	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
 	 *
 	 * @param n DMA group to configure and start
+	 * @return	Number of stale elements discarded from the DMA
 	 */
-	void startDMA(const std::uint32_t n) const;
+	size_t startDMA(const std::uint32_t n) const;
 
 	/**
 	 * Configures and starts all DMAs in the FPGA
 	 *
 	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
 	 *
+	 * @return	Number of stale elements discarded from all the DMAs
+	 */
+	size_t startAllDMAs() const;
+
+	/**
+	 * Sets the number of elements requested for the host memory part of a
+	 * DMA group FIFO. The value is applied the next time the DMA is started
+	 * (startDMA() or startAllDMAs()).
+	 *
+	 * The driver may grant more elements than requested, use
+	 * getEffectiveHostDepth() after starting the DMA to know the actual depth.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n		Number of DMA group
+	 * @param depth	Number of elements of the host buffer. 0 restores the
+	 * 				default depth
+	 */
+	void setHostDepth(const std::uint32_t n, const size_t depth) const;
+
+	/**
+	 * Returns the number of elements that will be requested for the host
+	 * memory part of a DMA group FIFO when it is started
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n	Number of DMA group
+	 * @return	Requested host buffer depth in elements
+	 */
+	size_t getHostDepth(const std::uint32_t n) const;
+
+	/**
+	 * Sets how the blocking operations of these terminals wait for the
+	 * FPGA: blocking reads (readDataBlocking() and readData()) and, in IMAQ
+	 * terminals, the CameraLink UART operations. Calls that take a
+	 * WaitPolicy use theirs instead.
+	 *
+	 * The policy is shared by the copies of the terminals, and should not
+	 * be changed while another thread is waiting.
+	 *
+	 * @param policy How to wait
+	 */
+	void setWaitPolicy(const WaitPolicy &policy) const;
+
+	/**
+	 * Returns how the blocking operations of these terminals wait
+	 *
+	 * @return Policy set with setWaitPolicy(), the default one if none
+	 */
+	WaitPolicy getWaitPolicy() const;
+
+	/**
+	 * Enables or disables the read statistics of these terminals. While
+	 * enabled, each readData(), readDataBlocking() and
+	 * readDataNonBlocking() call, and each image read of IMAQ terminals,
+	 * records in the histograms of its DMA how long it took, the elements
+	 * returned, the elements in the FIFO and the time since the previous
+	 * read that returned data. Disabled by default. While disabled the
+	 * reads only check the flag.
+	 *
+	 * The recording is compiled out, and this call ignored, when the
+	 * library is built with IRIO_NO_READ_STATS.
+	 *
+	 * The setting is shared by the copies of the terminals.
+	 *
+	 * @param enable True to record the reads
+	 */
+	void setReadStatsEnabled(const bool enable) const;
+
+	/**
+	 * Returns whether the reads are being recorded
+	 *
+	 * @return True if setReadStatsEnabled() enabled them
+	 */
+	bool isReadStatsEnabled() const;
+
+	/**
+	 * Returns a snapshot of the read statistics of a DMA group. It can be
+	 * taken while other threads read
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n	Number of DMA group
+	 * @return	Histograms of the reads recorded since the terminals were
+	 * 			created or the last reset
+	 */
+	DMAReadStats getReadStats(const std::uint32_t n) const;
+
+	/**
+	 * Discards the read statistics of a DMA group
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n Number of DMA group
+	 */
+	void resetReadStats(const std::uint32_t n) const;
+
+	/**
+	 * Discards the read statistics of all the DMA groups
+	 */
+	void resetAllReadStats() const;
+
+	/**
+	 * Returns the number of elements actually granted by the driver for the
+	 * host memory part of a DMA group FIFO the last time it was started
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n	Number of DMA group
+	 * @return	Host buffer depth in elements, 0 if the DMA has not been
+	 * 			started yet
 	 */
-	void startAllDMAs() const;
+	size_t getEffectiveHostDepth(const std::uint32_t n) const;
 
 	/**
 	 * Stops the specified DMA group
@@ -135,27 +256,26 @@ class TerminalsDMACommon: public TerminalsBase{
 	/**
 	 * Cleans the contents of a specified DMA group.
 	 *
-	 * Warning: If the DMA is running, it may lead to a situation
-	 * where more data is read that is possible to clean, which
-	 * may lead to a infinite loop
+	 * The elements are acquired and released in place, so nothing is
+	 * copied nor allocated. Only the elements available when the call
+	 * starts are discarded, data arriving meanwhile is kept.
 	 *
 	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
 	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
 	 *
 	 * @param n	DMA group to clean
+	 * @return	Number of elements discarded
 	 */
-	void cleanDMA(const std::uint32_t n) const;
+	size_t cleanDMA(const std::uint32_t n) const;
 
 	/**
-	 * Cleans the contents of all DMAs in the FPGA
-	 *
-	 * Warning: If the DMA is running, it may lead to a situation
-	 * where more data is read that is possible to clean, which
-	 * may lead to a infinite loop
+	 * Cleans the contents of all DMAs in the FPGA. See cleanDMA()
 	 *
 	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @return	Number of elements discarded from all the DMAs
 	 */
-	void cleanAllDMAs() const;
+	size_t cleanAllDMAs() const;
 
 	/**
 	 * Returns if a DMA group is enabled or not
@@ -248,6 +368,34 @@ class TerminalsDMACommon: public TerminalsBase{
 			std::uint64_t *data,
 			const std::uint32_t timeout = 0) const;
 
+	/**
+	 * Reads an specified number of elements from a DMA group, waiting as
+	 * \p policy says instead of as the policy of the terminals
+	 * (setWaitPolicy()).
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::DMAReadTimeout 	The timeout expires waiting for
+	 * 										enough data to be read
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n					Number of DMA group
+	 * @param elementsToRead	Number of elements to read from the DMA
+	 * @param data				Buffer to write the read data. Allocation and
+	 * 							deallocation of data is user responsibility
+	 * @param timeout			Max time in milliseconds to wait for the
+	 * 							\p elementsToRead to be available,
+	 * 							0 to wait indefinitely.
+	 * @param policy			How to wait for the elements
+	 * @return 	Unless the timeout expires, this function will always
+	 * 			return the specified \p elementsToRead
+	 */
+	size_t readDataBlocking(
+			const std::uint32_t n,
+			const size_t elementsToRead,
+			std::uint64_t *data,
+			const std::uint32_t timeout,
+			const WaitPolicy &policy) const;
+
 	/**
 	 * Reads an specified number of elements from a DMA group.
 	 * 
@@ -278,11 +426,134 @@ class TerminalsDMACommon: public TerminalsBase{
 			const bool blockRead,
 			const std::uint32_t timeout = 0) const;
 
+	/**
+	 * Reads from several DMA groups in a single call.
+	 *
+	 * The requests are serviced in order, resolving each DMA once. A failed
+	 * request does not stop the others: its outcome is reported in its
+	 * result instead of throwing. Each read is all or nothing, as in
+	 * readData(), but a non-blocking read costs a single driver call
+	 * instead of two: the driver is asked to read without waiting, which
+	 * either reads all the elements or nothing.
+	 *
+	 * @param requests	Reads to do. The same DMA must not appear twice
+	 * @param results	Output with one result per request, in the same
+	 * 					order. Resized by the call, its capacity is reused
+	 * @param blockRead	Whether to wait until the elements of each request
+	 * 					are available or not
+	 * @param timeout	If \p blockRead is true, max time in milliseconds to
+	 * 					wait for all the requests, 0 means wait indefinitely.
+	 * 					Ignored otherwise
+	 * @return	Number of requests completed with DMAReadStatus::Success
+	 */
+	size_t readDataMulti(
+			const std::vector<DMAReadRequest> &requests,
+			std::vector<DMAReadResult> *results,
+			const bool blockRead = false,
+			const std::uint32_t timeout = 0) const;
+
+	/**
+	 * Returns the number of elements that can be read from a DMA group
+	 * right now, without reading them
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n Number of DMA group
+	 * @return	Elements available in the DMA
+	 */
+	size_t getElementsAvailable(const std::uint32_t n) const;
+
+	/**
+	 * Reads as many elements as are currently available in a DMA group,
+	 * without waiting, in multiples of \p minElements and up to
+	 * \p maxElements.
+	 *
+	 * The fill level reported by the driver in the previous call is reused
+	 * to decide how much can be read, so a typical poll costs a single
+	 * driver call. If nothing was known to be available, one group of
+	 * \p minElements is tried and the new fill level is obtained with it.
+	 * Each DMA group must be polled from a single thread.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n					Number of DMA group
+	 * @param maxElements		Max number of elements to read. \p data must
+	 * 							have room for them
+	 * @param data				Buffer to write the read data. Allocation and
+	 * 							deallocation of data is user responsibility
+	 * @param minElements		Read granularity, usually the number of elements
+	 * 							of a block. Nothing is read if there are less
+	 * 							elements available
+	 * @param elementsRemaining	If not null, outputs the number of elements
+	 * 							that remain in the DMA after the read, as
+	 * 							reported by the driver in this call, even if
+	 * 							nothing was read
+	 * @return	Number of elements read, a multiple of \p minElements
+	 */
+	size_t readAvailable(
+			const std::uint32_t n,
+			const size_t maxElements,
+			std::uint64_t *data,
+			const size_t minElements = 1,
+			size_t *elementsRemaining = nullptr) const;
+
+	/**
+	 * Acquires elements directly from the host memory part of a DMA group,
+	 * without copying them to a user buffer.
+	 *
+	 * The read operation will block until the requested number of elements
+	 * are available or a timeout expires. The returned view points into the
+	 * host DMA buffer; if the elements wrap around the end of the buffer
+	 * they are returned as two regions (see DMADataView).
+	 * The FPGA cannot write into acquired elements, so they must be released
+	 * with releaseData() as soon as they have been processed.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::DMAReadTimeout 	The timeout expires waiting for
+	 * 										enough data to be acquired
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n			Number of DMA group
+	 * @param elements	Number of elements to acquire from the DMA
+	 * @param timeout	Max time in milliseconds to wait for the
+	 * 					\p elements to be available,
+	 * 					0 to wait indefinitely.
+	 * @return	Read-only view of the acquired elements
+	 */
+	DMADataView acquireData(
+			const std::uint32_t n,
+			const size_t elements,
+			const std::uint32_t timeout = 0) const;
+
+	/**
+	 * Releases elements previously acquired with acquireData(), returning
+	 * them to the FPGA. The pointers of the view that acquired them must not
+	 * be used afterwards.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n			Number of DMA group
+	 * @param elements	Number of elements to release. Usually
+	 * 					DMADataView::size() of the acquired view
+	 */
+	void releaseData(
+			const std::uint32_t n,
+			const size_t elements) const;
+
 	/**
 	 * Returns the number of DMAs found
 	 *
 	 * @return Number of found DMAs
 	 */
 	size_t countDMAs() const;
+
+ private:
+	/// Waits on the IRQs and fill levels of the DMA implementation
+	friend class DMASelector;
+	/// Maps the overflow bits onto the DMAs found
+	friend class DMAOverflowMonitor;
 };
 }  // namespace irio
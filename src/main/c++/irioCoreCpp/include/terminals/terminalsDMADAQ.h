@@ -35,6 +35,30 @@ class TerminalsDMADAQ: public TerminalsDMACommon{
 	 */
 	std::uint16_t getLengthBlock(const std::uint32_t &n) const;
 
+	/**
+	 * Returns a vector of the block lengths used by each DMA group
+	 *
+	 * @return Vector of block lengths, the position corresponds to the number of DMA
+	 */
+	std::vector<std::uint16_t> getAllLengthBlocks() const;
+
+	/**
+	 * Returns the number of DMA elements (64 bits words) that make up a
+	 * block of a specific DMA group, including the extra words added by
+	 * its frame type
+	 *
+	 * FormatA blocks only hold the getLengthBlock(n) sample words. FormatB
+	 * blocks hold a header word (word 0) and a timestamp word (word 1)
+	 * followed by the getLengthBlock(n) sample words, so they have
+	 * getLengthBlock(n) + 2 elements
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 *
+	 * @param n Number of DMA group
+	 * @return	Number of elements of each block of the specified DMA group
+	 */
+	size_t getElementsPerBlock(const std::uint32_t &n) const;
+
 	/**
 	 * Returns the decimation of a specific DMA group
 	 *
@@ -62,6 +86,30 @@ class TerminalsDMADAQ: public TerminalsDMACommon{
 	 */
 	void setSamplingRateDecimation(const std::uint32_t &n,
 			const std::uint16_t &decimation) const;
+
+	/**
+	 * Configures the host buffer depth of a DMA group so that it can hold
+	 * the data acquired during \p bufferingTimeMs milliseconds.
+	 *
+	 * The data rate is calculated with the number of channels, the sample
+	 * size, the frame type and the sampling rate (Fref/decimation) currently
+	 * configured in the DMA group. The depth is rounded up to whole blocks.
+	 * As with TerminalsDMACommon::setHostDepth, the value is applied the next
+	 * time the DMA is started, so the sampling rate must be configured first.
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Resource specified not found
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param n					Number of DMA group
+	 * @param fref				FPGA reference clock in Hz
+	 * 							(see TerminalsCommon::getFref)
+	 * @param bufferingTimeMs	Time in milliseconds the host buffer must be
+	 * 							able to hold without being read
+	 * @return	Host buffer depth requested, in elements
+	 */
+	size_t setHostDepthAuto(const std::uint32_t &n,
+			const std::uint32_t &fref,
+			const std::uint32_t &bufferingTimeMs) const;
 };
 
 }  // namespace irio
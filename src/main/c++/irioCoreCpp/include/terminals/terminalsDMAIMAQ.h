@@ -152,6 +152,24 @@ class TerminalsDMAIMAQ: public TerminalsDMACommon {
 	void sendUARTMsg(const std::vector<std::uint8_t> &msg,
 					 const std::uint32_t timeout = 0) const;
 
+	/**
+	 * Sends an UART message to the CameraLink system, polling
+	 * \p TERMINAL_UARTTXREADY as \p policy says instead of as the policy of
+	 * the terminals (setWaitPolicy())
+	 *
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 * @throw irio::errors::CLUARTTimeout Timeout waiting for
+	 * 										\p TERMINAL_UARTTXREADY to be ready
+	 *
+	 * @param msg 		Message to send
+	 * @param timeout 	Time in ms to wait for line to be ready to send message.
+	 * 					(0 to wait indefinetly)
+	 * @param policy	How to wait for the line
+	 */
+	void sendUARTMsg(const std::vector<std::uint8_t> &msg,
+					 const std::uint32_t timeout,
+					 const WaitPolicy &policy) const;
+
 	/**
 	 * Reads an UART message from the CameraLink system
 	 * 
@@ -168,6 +186,23 @@ class TerminalsDMAIMAQ: public TerminalsDMACommon {
 	std::vector<std::uint8_t> recvUARTMsg(
 		const size_t bytesToRecv = 0, const std::uint32_t timeout = 1000) const;
 
+	/**
+	 * Reads an UART message from the CameraLink system, waiting for each
+	 * byte as \p policy says instead of as the policy of the terminals
+	 * (setWaitPolicy())
+	 *
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 *
+	 * @param bytesToRecv	Number of bytes to read. If it is 0,
+	 * 						reads everything until timeout
+	 * @param timeout		Max time (ms) to wait between bytes. (0 to wait
+	 * 						indefinetly)
+	 * @param policy		How to wait for the bytes
+	 * @return 	Message read
+	 */
+	std::vector<std::uint8_t> recvUARTMsg(const size_t bytesToRecv,
+		const std::uint32_t timeout, const WaitPolicy &policy) const;
+
 	/**
 	 * Sets UART baud rate
 	 * 
@@ -183,6 +218,25 @@ class TerminalsDMAIMAQ: public TerminalsDMACommon {
 	void setUARTBaudRate(const UARTBaudRates &baudRate,
 						 const std::uint32_t timeout = 0) const;
 
+	/**
+	 * Sets UART baud rate, polling \p TERMINAL_UARTSETBAUDRATE as
+	 * \p policy says instead of as the policy of the terminals
+	 * (setWaitPolicy())
+	 *
+	 * @throw irio::errors::NiFpgaError Error occurred in an FPGA operation
+	 * @throw irio::errors::CLUARTTimeout Timeout waiting for
+	 * 										\p TERMINAL_UARTSETBAUDRATE to
+	 * 										be ready
+	 *
+	 * @param baudRate 	Baud rate to configure.
+	 * @param timeout 	Time in ms to wait for the line to be ready
+	 * 					(0 to wait indefinetly)
+	 * @param policy	How to wait for the line
+	 */
+	void setUARTBaudRate(const UARTBaudRates &baudRate,
+						 const std::uint32_t timeout,
+						 const WaitPolicy &policy) const;
+
 	/**
 	 * Read UART baud rate
 	 *
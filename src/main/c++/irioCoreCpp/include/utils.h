@@ -8,13 +8,15 @@
 
 #include "bfp.h"
 #include "errorsIrio.h"
+#include "metrics.h"
 
 namespace irio {
 
 namespace utils {
 /**
  * Throws an exception if the NiFpga_Status is not success.
- * The exception message includes the specified text along with the error code
+ * The exception message includes the specified text along with the error code.
+ * The error is counted in the metrics as not attributed to any device
  *
  * @throw irio::errors::NiFpgaError	Status is not NiFpga_Status_Success
  *
@@ -24,6 +26,20 @@ namespace utils {
 void throwIfNotSuccessNiFpga(const NiFpga_Status &status,
 		const std::string &errMsg = "");
 
+/**
+ * Throws an exception if the NiFpga_Status is not success, counting the
+ * error in the metrics of a terminal.
+ * The exception message includes the specified text along with the error code
+ *
+ * @throw irio::errors::NiFpgaError	Status is not NiFpga_Status_Success
+ *
+ * @param status	Status to check
+ * @param errMsg	Error message to use in the exception if there has been an error
+ * @param metrics	Counters of the terminal doing the operation
+ */
+void throwIfNotSuccessNiFpga(const NiFpga_Status &status,
+		const std::string &errMsg, const MetricsCounters &metrics);
+
 /**
  * Searches a map with identifiers as keys and addresses as values and check if the specified identifier (n) exists.
  *
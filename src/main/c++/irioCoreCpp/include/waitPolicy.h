@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace irio {
+
+/**
+ * How the library waits for the FPGA while a blocking operation polls it.
+ *
+ * A wait starts busy-spinning for \p spinUs, then yields the CPU to other
+ * threads between polls until \p yieldUs more have passed, and from then
+ * on sleeps between polls. The first sleep lasts \p minSleepUs and each
+ * following one doubles, up to \p maxSleepUs.
+ *
+ * Spinning gives the lowest wake-up latency at the cost of a whole core;
+ * sleeping frees the core but adds the sleep granularity of the kernel to
+ * every wait. The default policy keeps the behavior of previous versions:
+ * blocking DMA reads wait in the driver and the CameraLink UART polls
+ * every millisecond.
+ *
+ * @ingroup DMATerminals
+ */
+struct WaitPolicy {
+	/// Let NiFpga wait for the DMA data instead of polling the FIFO. Waits
+	/// that can only poll registers, such as the UART ones, ignore it
+	bool driverWait = true;
+	/// Microseconds polling without releasing the CPU
+	std::uint32_t spinUs = 0;
+	/// Microseconds polling with a yield between polls after spinning
+	std::uint32_t yieldUs = 0;
+	/// First sleep between polls, in microseconds
+	std::uint32_t minSleepUs = 1000;
+	/// Longest sleep between polls, in microseconds
+	std::uint32_t maxSleepUs = 1000;
+
+	/**
+	 * Polls after sleeping a fixed time
+	 *
+	 * @param sleepUs Microseconds between polls
+	 * @return Policy
+	 */
+	static WaitPolicy fixedSleep(const std::uint32_t sleepUs = 1000);
+
+	/**
+	 * Polls continuously until the wait ends. Meant for threads pinned to
+	 * an isolated core
+	 *
+	 * @return Policy
+	 */
+	static WaitPolicy busySpin();
+
+	/**
+	 * Spins, then yields and then sleeps with exponential backoff
+	 *
+	 * @param spinUs		Microseconds spinning
+	 * @param yieldUs		Microseconds yielding after spinning
+	 * @param minSleepUs	First sleep
+	 * @param maxSleepUs	Longest sleep
+	 * @return Policy
+	 */
+	static WaitPolicy hybrid(const std::uint32_t spinUs = 50,
+			const std::uint32_t yieldUs = 200,
+			const std::uint32_t minSleepUs = 10,
+			const std::uint32_t maxSleepUs = 250);
+};
+
+/**
+ * Paces a polling loop according to a WaitPolicy.
+ *
+ * @code
+ * PollWaiter waiter(policy, timeout);
+ * while (!ready()) {
+ *     if (!waiter.wait()) {
+ *         throw timeout error;
+ *     }
+ * }
+ * @endcode
+ *
+ * @ingroup DMATerminals
+ */
+class PollWaiter {
+ public:
+	/**
+	 * Starts a wait
+	 *
+	 * @param policy	How to wait between polls
+	 * @param timeoutMs	Milliseconds until the wait expires, 0 to wait
+	 * 					indefinitely
+	 */
+	PollWaiter(const WaitPolicy &policy, const std::uint32_t timeoutMs);
+
+	/**
+	 * Waits before the next poll, never beyond the timeout
+	 *
+	 * @return False, without waiting, if the timeout has expired
+	 */
+	bool wait();
+
+ private:
+	using Clock = std::chrono::steady_clock;
+
+	const WaitPolicy m_policy;
+	const Clock::time_point m_start;
+	const Clock::time_point m_deadline;
+	const bool m_hasDeadline;
+	std::uint32_t m_sleepUs;
+};
+
+}  // namespace irio
@@ -10,6 +10,7 @@
 #include "profiles/profiles.h"
 #include "rioDiscovery.h"
 #include "errorsIrio.h"
+#include "metrics.h"
 #include "parserManager.h"
 
 namespace irio {
@@ -21,17 +22,23 @@ namespace irio {
 Irio::Irio(const std::string &bitfilePath,
 			   const std::string &RIOSerialNumber,
 			   const std::string &FPGAVIversion,
-			   const bool parseVerbose) {
+			   const bool parseVerbose,
+			   const TerminalsConstruction construction) :
+		m_bitfilePath(bitfilePath) {
 	m_resourceName = searchRIODevice(RIOSerialNumber);
 	bfp::BFP bfp(bitfilePath, false);
+	m_signature = bfp.getSignature();
 
 	initDriver();
 	openSession(bfp.getBitfilePath(), bfp.getSignature());
 
-	ParserManager parserManager(bfp);
+	m_parserManager.reset(new ParserManager(bfp));
 	try {
-		searchPlatform(&parserManager);
-		selectDevProfile(&parserManager);
+		searchPlatform(m_parserManager.get());
+		selectDevProfile(m_parserManager.get());
+		if (construction == TerminalsConstruction::Eager) {
+			m_profile->buildAllTerminals();
+		}
 
 		const auto fpgaVer =
 			m_profile->getTerminal<TerminalsCommon>().getFPGAVIversion();
@@ -41,28 +48,14 @@ Irio::Irio(const std::string &bitfilePath,
 
 		if(parseVerbose) {
 			std::cout << "Resources found: " << std::endl;
-			parserManager.printInfo();
+			m_parserManager->printInfo();
 		}
 
-		if(parserManager.hasErrorOccurred()) {
+		if(m_parserManager->hasErrorOccurred()) {
 			throw errors::ResourceNotFoundError();
 		}
 	} catch(errors::ResourceNotFoundError&) {
-		std::cerr << "[ERROR] Error searching resources in the bitfile "
-				  << bitfilePath << std::endl;
-		std::cerr << "[ERROR] The following resources were not found:"
-				  << std::endl;
-		parserManager.printInfoError();
-
-		std::string baseFilename = utils::getBaseName(bitfilePath);
-		const char *envVar = std::getenv(PARSE_LOG_PATH_ENV_VAR);
-		const std::string logPath = envVar ? envVar : DEFAULT_PARSE_LOG_PATH;
-		const std::string timestamp = utils::getTimestamp();
-
-		std::string logFilePath =
-			logPath + "/irioCore_" + baseFilename + "_parse_log_" + timestamp + ".xml";
-
-		parserManager.printInfoXML(logFilePath);
+		reportResourcesNotFound(*m_parserManager);
 
 		closeSession();
 		finalizeDriver();
@@ -75,6 +68,10 @@ Irio::Irio(const std::string &bitfilePath,
 		finalizeDriver();
 		throw;
 	}
+
+	if (construction == TerminalsConstruction::Eager) {
+		m_parserManager.reset();
+	}
 }
 
 Irio::~Irio() {
@@ -97,7 +94,9 @@ void Irio::startFPGA(std::uint32_t timeoutMs) const {
 		throw errors::NiFpgaFPGAAlreadyRunning(
 				"Bitfile is already running in the FPGA");
 	} else {
-		utils::throwIfNotSuccessNiFpga(status, "Error starting the VI");
+		utils::throwIfNotSuccessNiFpga(status, "Error starting the VI",
+				MetricsRegistry::instance().getCounters(m_session,
+						MetricsTerminal::Common));
 	}
 
 	const auto commonTerm = getTerminalsCommon();
@@ -129,6 +128,25 @@ void Irio::startFPGA(std::uint32_t timeoutMs) const {
 	commonTerm.setDAQStop();
 }
 
+void Irio::validateTerminals() const {
+	if (!m_parserManager) {
+		return;
+	}
+
+	if (!m_profile->buildAllTerminals()) {
+		reportResourcesNotFound(*m_parserManager);
+		throw errors::ResourceNotFoundError();
+	}
+}
+
+std::string Irio::getSignature() const {
+	return m_signature;
+}
+
+int Irio::getNumaNode() const {
+	return getRIODeviceNumaNode(m_resourceName);
+}
+
 Platform Irio::getPlatform() const {
 	return *m_platform.get();
 }
@@ -204,8 +222,10 @@ void Irio::finalizeDriver() const noexcept {
 }
 
 void Irio::closeSession() noexcept {
-	if (m_session != 0)
+	if (m_session != 0) {
+		MetricsRegistry::instance().unbindSession(m_session);
 		NiFpga_Close(m_session, m_closeAttribute);
+	}
 	m_session = 0;
 }
 
@@ -223,12 +243,33 @@ void Irio::openSession(const std::string &bitfilePath,
 			NiFpga_OpenAttribute_NoRun, &m_session);
 
 	if (NiFpga_IsError(status)) {
+		MetricsRegistry::countUnattributedError();
 		const std::string err = "Error downloading bitfile to FPGA. " +
 								std::string("(Code: ") +
 								std::to_string(status) + std::string(")");
 
 		throw irio::errors::NiFpgaErrorDownloadingBitfile(err);
 	}
+	MetricsRegistry::instance().bindSession(m_session, m_resourceName);
+}
+
+void Irio::reportResourcesNotFound(
+		const ParserManager &parserManager) const {
+	std::cerr << "[ERROR] Error searching resources in the bitfile "
+			  << m_bitfilePath << std::endl;
+	std::cerr << "[ERROR] The following resources were not found:"
+			  << std::endl;
+	parserManager.printInfoError();
+
+	std::string baseFilename = utils::getBaseName(m_bitfilePath);
+	const char *envVar = std::getenv(PARSE_LOG_PATH_ENV_VAR);
+	const std::string logPath = envVar ? envVar : DEFAULT_PARSE_LOG_PATH;
+	const std::string timestamp = utils::getTimestamp();
+
+	std::string logFilePath =
+		logPath + "/irioCore_" + baseFilename + "_parse_log_" + timestamp + ".xml";
+
+	parserManager.printInfoXML(logFilePath);
 }
 
 void Irio::searchPlatform(ParserManager *parserManager) {
@@ -241,7 +282,9 @@ void Irio::searchPlatform(ParserManager *parserManager) {
 
 	std::uint8_t platform;
 	const auto status = NiFpga_ReadU8(m_session, platform_addr, &platform);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading Platform");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading Platform",
+			MetricsRegistry::instance().getCounters(m_session,
+					MetricsTerminal::Common));
 
 	switch (platform) {
 	case static_cast<std::uint8_t>(PLATFORM_ID::FlexRIO):
@@ -287,7 +330,9 @@ void Irio::selectDevProfile(ParserManager *parserManager) {
 
 	std::uint8_t profile;
 	const auto status = NiFpga_ReadU8(m_session, profile_addr, &profile);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading DevProfile");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading DevProfile",
+			MetricsRegistry::instance().getCounters(m_session,
+					MetricsTerminal::Common));
 
 	const PLATFORM_ID platform = m_platform->platformID;
 	const auto validValues = validProfileByPlatform.find(platform)->second;
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+#include "metrics.h"
+#include "utils.h"
+
+namespace irio {
+
+namespace {
+
+/// Slots [0, METRICS_OPERATIONS) discard the updates of invalid handles
+const size_t SLOT_UNATTRIBUTED = METRICS_OPERATIONS;
+const size_t SLOT_FIRST_DEVICE = SLOT_UNATTRIBUTED + 1;
+const size_t SLOTS_PER_DEVICE = METRICS_TERMINALS * METRICS_OPERATIONS;
+const size_t SLOTS = SLOT_FIRST_DEVICE
+		+ METRICS_MAX_DEVICES * SLOTS_PER_DEVICE;
+
+/**
+ * Counters updated by a single thread. Padded so they do not share cache
+ * lines with the counters of other threads
+ */
+struct Shard {
+	char padBefore[64];
+	std::atomic<std::uint64_t> values[SLOTS];
+	char padAfter[64];
+
+	Shard() {
+		for (auto &value : values) {
+			value.store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+/**
+ * Shards of the running threads and totals of the finished ones. Never
+ * destroyed, threads may finish after the static objects are
+ */
+struct Shards {
+	std::mutex mutex;
+	std::vector<Shard*> live;
+	std::vector<std::uint64_t> retired = std::vector<std::uint64_t>(SLOTS);
+};
+
+Shards& shards() {
+	static Shards *instance = new Shards();
+	return *instance;
+}
+
+/**
+ * Registers the shard of a thread and adds it to the totals when the
+ * thread finishes
+ */
+struct ShardOwner {
+	Shard *shard;
+
+	ShardOwner() : shard(new Shard()) {
+		Shards &all = shards();
+		std::lock_guard<std::mutex> lock(all.mutex);
+		all.live.push_back(shard);
+	}
+
+	~ShardOwner() {
+		Shards &all = shards();
+		std::lock_guard<std::mutex> lock(all.mutex);
+		for (size_t i = 0; i < SLOTS; ++i) {
+			all.retired[i] += shard->values[i].load(std::memory_order_relaxed);
+		}
+		for (auto it = all.live.begin(); it != all.live.end(); ++it) {
+			if (*it == shard) {
+				all.live.erase(it);
+				break;
+			}
+		}
+		delete shard;
+	}
+};
+
+Shard& localShard() {
+	thread_local ShardOwner owner;
+	return *owner.shard;
+}
+
+inline void addToSlot(const size_t slot, const std::uint64_t count) {
+	// Only this thread writes its shard, a plain load and store suffice
+	auto &value = localShard().values[slot];
+	value.store(value.load(std::memory_order_relaxed) + count,
+			std::memory_order_relaxed);
+}
+
+const char* helpOf(const MetricsOperation operation) {
+	switch (operation) {
+	case MetricsOperation::RegisterRead:
+		return "Registers read by the terminals";
+	case MetricsOperation::RegisterWrite:
+		return "Registers written by the terminals";
+	case MetricsOperation::DMARead:
+		return "Reads of DMAs";
+	case MetricsOperation::DMAElementsRead:
+		return "Elements returned by the reads of DMAs";
+	case MetricsOperation::Timeout:
+		return "Operations whose timeout expired";
+	case MetricsOperation::NiFpgaError:
+		return "NiFpga operations that returned an error";
+	}
+	return "";
+}
+
+std::string escapeLabel(const std::string &value) {
+	std::string escaped;
+	escaped.reserve(value.size());
+	for (const char c : value) {
+		if (c == '\\' || c == '"') {
+			escaped += '\\';
+			escaped += c;
+		} else if (c == '\n') {
+			escaped += "\\n";
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+}  // namespace
+
+const char* toString(const MetricsTerminal terminal) {
+	switch (terminal) {
+	case MetricsTerminal::Common:
+		return "common";
+	case MetricsTerminal::Analog:
+		return "analog";
+	case MetricsTerminal::AuxAnalog:
+		return "auxanalog";
+	case MetricsTerminal::Digital:
+		return "digital";
+	case MetricsTerminal::AuxDigital:
+		return "auxdigital";
+	case MetricsTerminal::SignalGeneration:
+		return "signalgeneration";
+	case MetricsTerminal::IO:
+		return "io";
+	case MetricsTerminal::CRIO:
+		return "crio";
+	case MetricsTerminal::FlexRIO:
+		return "flexrio";
+	case MetricsTerminal::DMA:
+		return "dma";
+	}
+	return "unknown";
+}
+
+const char* toString(const MetricsOperation operation) {
+	switch (operation) {
+	case MetricsOperation::RegisterRead:
+		return "irio_register_reads_total";
+	case MetricsOperation::RegisterWrite:
+		return "irio_register_writes_total";
+	case MetricsOperation::DMARead:
+		return "irio_dma_reads_total";
+	case MetricsOperation::DMAElementsRead:
+		return "irio_dma_elements_read_total";
+	case MetricsOperation::Timeout:
+		return "irio_timeouts_total";
+	case MetricsOperation::NiFpgaError:
+		return "irio_nifpga_errors_total";
+	}
+	return "irio_unknown_total";
+}
+
+std::uint64_t MetricsSnapshot::get(const std::string &device,
+		const MetricsTerminal terminal,
+		const MetricsOperation operation) const {
+	for (const auto &value : values) {
+		if (value.terminal == terminal && value.operation == operation
+				&& value.device == device) {
+			return value.value;
+		}
+	}
+	return 0;
+}
+
+std::string MetricsSnapshot::toPrometheus() const {
+	std::ostringstream text;
+	for (size_t op = 0; op < METRICS_OPERATIONS; ++op) {
+		const auto operation = static_cast<MetricsOperation>(op);
+		const std::string name = toString(operation);
+		text << "# HELP " << name << " " << helpOf(operation) << "\n"
+			 << "# TYPE " << name << " counter\n";
+		for (const auto &value : values) {
+			if (value.operation == operation) {
+				text << name << "{device=\"" << escapeLabel(value.device)
+					 << "\",terminal=\"" << toString(value.terminal)
+					 << "\"} " << value.value << "\n";
+			}
+		}
+		if (operation == MetricsOperation::NiFpgaError) {
+			text << name << " " << unattributedErrors << "\n";
+		}
+	}
+	return text.str();
+}
+
+MetricsCounters::MetricsCounters(const std::uint32_t base) : m_base(base) {
+}
+
+void MetricsCounters::add(const MetricsOperation operation,
+		const std::uint64_t count) const {
+	addToSlot(m_base + utils::enum2underlying(operation), count);
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+	static MetricsRegistry registry;
+	return registry;
+}
+
+void MetricsRegistry::bindSession(const NiFpga_Session session,
+		const std::string &device) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t index = 0;
+	while (index < m_devices.size() && m_devices[index].name != device) {
+		++index;
+	}
+	if (index == m_devices.size()) {
+		if (m_devices.size() == METRICS_MAX_DEVICES) {
+			m_sessions.erase(session);
+			return;
+		}
+		m_devices.push_back(Device());
+		m_devices.back().name = device;
+	}
+	m_sessions[session] = index;
+}
+
+void MetricsRegistry::unbindSession(const NiFpga_Session session) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sessions.erase(session);
+}
+
+MetricsCounters MetricsRegistry::getCounters(const NiFpga_Session session,
+		const MetricsTerminal terminal) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const auto it = m_sessions.find(session);
+	if (it == m_sessions.end()) {
+		return MetricsCounters();
+	}
+
+	const auto t = utils::enum2underlying(terminal);
+	m_devices[it->second].terminals[t] = true;
+	return MetricsCounters(static_cast<std::uint32_t>(SLOT_FIRST_DEVICE
+			+ it->second * SLOTS_PER_DEVICE + t * METRICS_OPERATIONS));
+}
+
+void MetricsRegistry::countUnattributedError() {
+	addToSlot(SLOT_UNATTRIBUTED, 1);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+	MetricsSnapshot snapshot;
+	snapshot.time = std::chrono::system_clock::now();
+
+	std::vector<std::uint64_t> totals;
+	{
+		Shards &all = shards();
+		std::lock_guard<std::mutex> lock(all.mutex);
+		totals = all.retired;
+		for (const Shard *shard : all.live) {
+			for (size_t i = 0; i < SLOTS; ++i) {
+				totals[i] += shard->values[i].load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	snapshot.unattributedErrors = totals[SLOT_UNATTRIBUTED];
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t d = 0; d < m_devices.size(); ++d) {
+		for (size_t t = 0; t < METRICS_TERMINALS; ++t) {
+			if (!m_devices[d].terminals[t]) {
+				continue;
+			}
+			const size_t base = SLOT_FIRST_DEVICE + d * SLOTS_PER_DEVICE
+					+ t * METRICS_OPERATIONS;
+			for (size_t op = 0; op < METRICS_OPERATIONS; ++op) {
+				snapshot.values.push_back({m_devices[d].name,
+						static_cast<MetricsTerminal>(t),
+						static_cast<MetricsOperation>(op), totals[base + op]});
+			}
+		}
+	}
+	return snapshot;
+}
+
+void MetricsRegistry::reset() {
+	Shards &all = shards();
+	std::lock_guard<std::mutex> lock(all.mutex);
+	std::fill(all.retired.begin(), all.retired.end(), 0);
+	for (Shard *shard : all.live) {
+		for (auto &value : shard->values) {
+			value.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+}  // namespace irio
@@ -0,0 +1,172 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "metricsExporter.h"
+#include "errorsIrio.h"
+
+namespace irio {
+
+namespace {
+
+std::string errnoText(const std::string &what, const std::string &path) {
+	return what + " " + path + ": " + std::strerror(errno);
+}
+
+/// Writes all the text, retrying on partial writes and interruptions
+bool writeAll(const int fd, const std::string &text, const int flags) {
+	size_t written = 0;
+	while (written < text.size()) {
+		const ssize_t n = flags < 0 ?
+				::write(fd, text.data() + written, text.size() - written) :
+				::send(fd, text.data() + written, text.size() - written,
+						flags);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		written += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+}  // namespace
+
+MetricsExporter::MetricsExporter(const MetricsExporterConfig &config) :
+		m_config(config), m_exports(0), m_failures(0), m_running(false) {
+	if (m_config.path.empty()) {
+		throw errors::MetricsExportError("No path to export the metrics");
+	}
+}
+
+MetricsExporter::~MetricsExporter() {
+	stop();
+}
+
+void MetricsExporter::start() {
+	if (m_config.period == 0 || m_running) {
+		return;
+	}
+	m_running = true;
+	m_thread = std::thread(&MetricsExporter::exportLoop, this);
+}
+
+void MetricsExporter::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_wakeUp.notify_all();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+bool MetricsExporter::isRunning() const {
+	return m_running;
+}
+
+void MetricsExporter::exportNow() {
+	const std::string text =
+			MetricsRegistry::instance().snapshot().toPrometheus();
+
+	std::lock_guard<std::mutex> lock(m_exportMutex);
+	try {
+		if (m_config.target == MetricsTarget::UnixSocket) {
+			writeSocket(text);
+		} else {
+			writeFile(text);
+		}
+	} catch (errors::MetricsExportError&) {
+		++m_failures;
+		throw;
+	}
+	++m_exports;
+}
+
+std::uint64_t MetricsExporter::getExports() const {
+	return m_exports;
+}
+
+std::uint64_t MetricsExporter::getFailures() const {
+	return m_failures;
+}
+
+void MetricsExporter::exportLoop() {
+	const auto period = std::chrono::milliseconds(m_config.period);
+	while (m_running) {
+		try {
+			exportNow();
+		} catch (errors::MetricsExportError&) {
+			// Counted, the reader may be back on the next period
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wakeUp.wait_for(lock, period, [this] {
+			return !m_running;
+		});
+	}
+}
+
+void MetricsExporter::writeFile(const std::string &text) const {
+	const std::string tmpPath = m_config.path + ".tmp";
+	const int fd = ::open(tmpPath.c_str(),
+			O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		throw errors::MetricsExportError(errnoText("Error opening", tmpPath));
+	}
+
+	const bool written = writeAll(fd, text, -1);
+	const std::string err = errnoText("Error writing", tmpPath);
+	::close(fd);
+	if (!written) {
+		::unlink(tmpPath.c_str());
+		throw errors::MetricsExportError(err);
+	}
+	if (std::rename(tmpPath.c_str(), m_config.path.c_str()) != 0) {
+		const std::string errRename = errnoText("Error renaming", tmpPath);
+		::unlink(tmpPath.c_str());
+		throw errors::MetricsExportError(errRename);
+	}
+}
+
+void MetricsExporter::writeSocket(const std::string &text) const {
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (m_config.path.size() >= sizeof(addr.sun_path)) {
+		throw errors::MetricsExportError("Socket path too long: "
+				+ m_config.path);
+	}
+	std::memcpy(addr.sun_path, m_config.path.c_str(), m_config.path.size());
+
+	const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		throw errors::MetricsExportError(errnoText("Error creating socket for",
+				m_config.path));
+	}
+	if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr),
+			sizeof(addr)) != 0) {
+		const std::string err = errnoText("Error connecting to",
+				m_config.path);
+		::close(fd);
+		throw errors::MetricsExportError(err);
+	}
+
+	// MSG_NOSIGNAL: a reader that went away must not kill the process
+	const bool written = writeAll(fd, text, MSG_NOSIGNAL);
+	const std::string err = errnoText("Error writing to", m_config.path);
+	::close(fd);
+	if (!written) {
+		throw errors::MetricsExportError(err);
+	}
+}
+
+}  // namespace irio
@@ -13,15 +13,15 @@ bool ParserManager::findRegister(const std::string &resourceName,
 								const GroupResource &group,
 								bfp::Register *reg,
 								const bool optional) {
-	try {
-		*reg = m_bfp.getRegister(resourceName);
-		logResourceFound(resourceName, group);
-	} catch (errors::ResourceNotFoundError &) {
+	const auto found = m_bfp.tryGetRegister(resourceName);
+	if (!found) {
 		if(!optional)
 			logResourceNotFound(resourceName, group);
 		return false;
 	}
 
+	*reg = *found;
+	logResourceFound(resourceName, group);
 	return true;
 }
 
@@ -29,15 +29,15 @@ bool ParserManager::findDMA(const std::string &resourceName,
 								const GroupResource &group,
 								bfp::DMA *dma,
 								const bool optional) {
-	try {
-		*dma = m_bfp.getDMA(resourceName);
-		logResourceFound(resourceName, group);
-	} catch (errors::ResourceNotFoundError &) {
+	const auto found = m_bfp.tryGetDMA(resourceName);
+	if (!found) {
 		if(!optional)
 			logResourceNotFound(resourceName, group);
 		return false;
 	}
 
+	*dma = *found;
+	logResourceFound(resourceName, group);
 	return true;
 }
 
@@ -73,7 +73,7 @@ void ParserManager::logResourceNotFound(const std::string &resourceName,
 									   const GroupResource &group) {
 	const auto it = &m_groupInfo.emplace(group, GroupInfo()).first->second;
 	it->notFound.emplace(resourceName);
-	m_error = true;
+	++m_numErrors;
 }
 
 void ParserManager::logResourceError(const std::string &resourceName,
@@ -81,11 +81,15 @@ void ParserManager::logResourceError(const std::string &resourceName,
 		const GroupResource &group) {
 	const auto it = &m_groupInfo.emplace(group, GroupInfo()).first->second;
 	it->error.emplace(resourceName, errMsg);
-	m_error = true;
+	++m_numErrors;
 }
 
 bool ParserManager::hasErrorOccurred() const {
-	return m_error;
+	return m_numErrors != 0;
+}
+
+size_t ParserManager::getNumErrors() const {
+	return m_numErrors;
 }
 
 void ParserManager::printInfo(std::ostream &os, const bool onlyErrors) const {
@@ -223,6 +227,38 @@ bool ParserManager::findDMAEnumNum(const std::string &resourceName,
 	}
 }
 
+size_t ParserManager::enumerateRegisterAddresses(
+		const std::string &resourceName, const size_t maxResources,
+		const GroupResource &group,
+		std::unordered_map<std::uint32_t, const std::uint32_t> *mapInsert) {
+	size_t found = 0;
+	// Sorted by number, stop at the first one out of range
+	for (const auto &reg : m_bfp.enumerateRegisters(resourceName)) {
+		if (reg.first >= maxResources) {
+			break;
+		}
+		logResourceFound(resourceName + std::to_string(reg.first), group);
+		mapInsert->emplace(reg.first, reg.second.getAddress());
+		++found;
+	}
+	return found;
+}
+
+size_t ParserManager::enumerateDMANums(const std::string &resourceName,
+		const size_t maxResources, const GroupResource &group,
+		std::unordered_map<std::uint32_t, const std::uint32_t> *mapInsert) {
+	size_t found = 0;
+	for (const auto &dma : m_bfp.enumerateDMAs(resourceName)) {
+		if (dma.first >= maxResources) {
+			break;
+		}
+		logResourceFound(resourceName + std::to_string(dma.first), group);
+		mapInsert->emplace(dma.first, dma.second.getDMANumber());
+		++found;
+	}
+	return found;
+}
+
 void ParserManager::compareResourcesMap(
 	const std::unordered_map<std::uint32_t, const std::uint32_t> &mapA,
 	const std::string &nameTermA,
@@ -1,13 +1,14 @@
 #include "profiles/profileBase.h"
 #include "errorsIrio.h"
+#include "parserManager.h"
 #include "utils.h"
 
 namespace irio {
 
 ProfileBase::ProfileBase(ParserManager *parserManager,
 		const NiFpga_Session &session, const PROFILE_ID &id) :
-		profileID(id) {
-	addTerminal(TerminalsCommon(parserManager, session));
+		profileID(id), m_parserManager(parserManager), m_session(session) {
+	addTerminal<TerminalsCommon>();
 }
 
 template<typename T>
@@ -19,7 +20,12 @@ T ProfileBase::getTerminal() const {
 			std::to_string(utils::enum2underlying(profileID)) + ")");
 	}
 
-	return *static_cast<T*>(it->second.get());
+	const auto entry = it->second;
+	if (!entry->built.load(std::memory_order_acquire)) {
+		buildTerminal(entry);
+	}
+
+	return *static_cast<T*>(entry->terminal.get());
 }
 
 template TerminalsAnalog ProfileBase::getTerminal() const;
@@ -34,33 +40,36 @@ template TerminalsDMAIMAQ ProfileBase::getTerminal() const;
 template TerminalsCommon ProfileBase::getTerminal() const;
 template TerminalsIO ProfileBase::getTerminal() const;
 
+bool ProfileBase::buildAllTerminals() const {
+	bool found = true;
+	for (const auto &entry : m_terminals) {
+		try {
+			buildTerminal(entry.get());
+		} catch (errors::ResourceNotFoundError &) {
+			found = false;
+		}
+	}
 
-template<typename T>
-void ProfileBase::addTerminal(T terminal) {
-	m_mapTerminals.emplace(std::type_index(typeid(T)),
-			std::unique_ptr<TerminalsBase>(new T(terminal)));
+	return found;
 }
 
-template<>
-void ProfileBase::addTerminal(TerminalsDMADAQCPU terminal) {
-	m_mapTerminals.emplace(std::type_index(typeid(TerminalsDMADAQ)),
-				std::unique_ptr<TerminalsBase>(new TerminalsDMADAQCPU(terminal)));
-}
+void ProfileBase::buildTerminal(TerminalEntry *entry) const {
+	std::lock_guard<std::mutex> lock(m_buildMutex);
+	if (entry->built.load(std::memory_order_relaxed)) {
+		return;
+	}
 
-template <>
-void ProfileBase::addTerminal(TerminalsDMAIMAQCPU terminal) {
-	m_mapTerminals.emplace(std::type_index(typeid(TerminalsDMAIMAQ)),
-				std::unique_ptr<TerminalsBase>(new TerminalsDMAIMAQCPU(terminal)));
-}
+	const auto numErrors = m_parserManager->getNumErrors();
+	std::unique_ptr<TerminalsBase> terminal(
+			entry->build(m_parserManager, m_session));
+	if (m_parserManager->getNumErrors() != numErrors) {
+		throw errors::ResourceNotFoundError(
+			"Resources of the terminal not found in the bitfile");
+	}
 
-template void ProfileBase::addTerminal(TerminalsAnalog terminal);
-template void ProfileBase::addTerminal(TerminalsAuxAnalog terminal);
-template void ProfileBase::addTerminal(TerminalsDigital terminal);
-template void ProfileBase::addTerminal(TerminalsAuxDigital terminal);
-template void ProfileBase::addTerminal(TerminalsFlexRIO terminal);
-template void ProfileBase::addTerminal(TerminalscRIO terminal);
-template void ProfileBase::addTerminal(TerminalsSignalGeneration terminal);
-template void ProfileBase::addTerminal(TerminalsCommon terminal);
-template void ProfileBase::addTerminal(TerminalsIO terminal);
+	entry->terminal = std::move(terminal);
+	entry->build = nullptr;
+	entry->built.store(true, std::memory_order_release);
+}
 
 }  // namespace irio
@@ -7,12 +7,12 @@ ProfileCPUDAQ::ProfileCPUDAQ(ParserManager *parserManager,
 		const NiFpga_Session &session, const Platform &platform,
 		const PROFILE_ID &id) :
 		ProfileBase(parserManager, session, id) {
-	addTerminal(TerminalsAnalog(parserManager, session, platform));
-	addTerminal(TerminalsDigital(parserManager, session, platform));
-	addTerminal(TerminalsAuxAnalog(parserManager, session, platform));
-	addTerminal(TerminalsAuxDigital(parserManager, session, platform));
-	addTerminal(TerminalsSignalGeneration(parserManager, session, platform));
-	addTerminal(TerminalsDMADAQCPU(parserManager, session, platform));
+	addTerminal<TerminalsAnalog>(platform);
+	addTerminal<TerminalsDigital>(platform);
+	addTerminal<TerminalsAuxAnalog>(platform);
+	addTerminal<TerminalsAuxDigital>(platform);
+	addTerminal<TerminalsSignalGeneration>(platform);
+	addTerminal<TerminalsDMADAQ, TerminalsDMADAQCPU>(platform);
 }
 
 }  // namespace irio
@@ -9,6 +9,6 @@ ProfileCPUDAQFlexRIO::ProfileCPUDAQFlexRIO(ParserManager *parserManager,
 										   const Platform &platform)
 	: ProfileCPUDAQ(parserManager, session, platform,
 					PROFILE_ID::FLEXRIO_CPUDAQ) {
-	addTerminal(TerminalsFlexRIO(parserManager, session));
+	addTerminal<TerminalsFlexRIO>();
 }
 }  // namespace irio
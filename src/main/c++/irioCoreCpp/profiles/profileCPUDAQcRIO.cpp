@@ -9,6 +9,6 @@ ProfileCPUDAQcRIO::ProfileCPUDAQcRIO(
 		const Platform &platform) :
 				ProfileCPUDAQ(parserManager, session,
 						platform, PROFILE_ID::FLEXRIO_CPUDAQ) {
-	addTerminal(TerminalscRIO(parserManager, session));
+	addTerminal<TerminalscRIO>();
 }
 }  // namespace irio
@@ -8,10 +8,10 @@ ProfileCPUIMAQ::ProfileCPUIMAQ(ParserManager *parserManager,
 							   const Platform &platform,
                                const PROFILE_ID &id)
 	: ProfileBase(parserManager, session, id) {
-    addTerminal(TerminalsDigital(parserManager, session, platform));
-    addTerminal(TerminalsAuxDigital(parserManager, session, platform));
-    addTerminal(TerminalsAuxAnalog(parserManager, session, platform));
-    addTerminal(TerminalsDMAIMAQCPU(parserManager, session, platform));
+    addTerminal<TerminalsDigital>(platform);
+    addTerminal<TerminalsAuxDigital>(platform);
+    addTerminal<TerminalsAuxAnalog>(platform);
+    addTerminal<TerminalsDMAIMAQ, TerminalsDMAIMAQCPU>(platform);
 }
 
 }  // namespace irio
@@ -7,6 +7,6 @@ ProfileCPUIMAQFlexRIO::ProfileCPUIMAQFlexRIO(ParserManager *parserManager,
 											 const Platform &platform)
 	: ProfileCPUIMAQ(parserManager, session, platform,
 					 PROFILE_ID::FLEXRIO_CPUIMAQ) {
-	addTerminal(TerminalsFlexRIO(parserManager, session));
+	addTerminal<TerminalsFlexRIO>();
 }
 }  // namespace irio
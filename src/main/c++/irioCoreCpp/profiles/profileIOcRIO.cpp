@@ -5,6 +5,6 @@ ProfileIOcRIO::ProfileIOcRIO(ParserManager *parserManager,
 							 const NiFpga_Session &session,
 							 const Platform &platform)
 	: ProfileIO(parserManager, session, platform, PROFILE_ID::CRIO_IO) {
-	addTerminal(TerminalscRIO(parserManager, session));
+	addTerminal<TerminalscRIO>();
 }
 }  // namespace irio
@@ -1,11 +1,14 @@
 #include <dirent.h>
+#include <cctype>
 #include <vector>
 #include <fstream>
 
 #include "rioDiscovery.h"
 #include "errorsIrio.h"
 
-#ifndef CCS_VERSION
+#if defined(NIFPGA_SIM)
+#include "nifpgaSim.h"
+#elif !defined(CCS_VERSION)
 #include <nisyscfg/nisyscfg.h>
 #endif
 
@@ -65,7 +68,7 @@ std::string getRIODeviceCCS(const std::string &serialNumber) {
 
 	return name;
 }
-#else
+#elif !defined(NIFPGA_SIM)
 
 void throwIfNiSysCfgError(const NISysCfgStatus &status,
 		const std::string &errMsg) {
@@ -166,7 +169,10 @@ std::string getRIODevicesNI(const std::string &serialNumber) {
 #endif
 
 std::string getRIODeviceAux(const std::string &serialNumber) {
-#ifdef CCS_VERSION
+#if defined(NIFPGA_SIM)
+	// Every serial number has a simulated device
+	return sim::getResourceName(serialNumber);
+#elif defined(CCS_VERSION)
 	return getRIODeviceCCS(serialNumber);
 #else
 	return getRIODevicesNI(serialNumber);
@@ -182,5 +188,40 @@ std::string searchRIODevice(const std::string serialNumber) {
 	}
 }
 
+int getRIODeviceNumaNode(const std::string &resourceName) {
+	static const std::string interfacePath = "/sys/class/nirio";
+
+	DIR *dir = opendir(interfacePath.c_str());
+	if (!dir || resourceName.empty()) {
+		if (dir) {
+			closedir(dir);
+		}
+		return -1;
+	}
+
+	// Entries are named after the device (e.g. RIO0!board). The character
+	// after the name must not be part of it, so RIO1 does not match RIO10
+	std::string path;
+	const struct dirent *entry = readdir(dir);
+	while (entry && path.empty()) {
+		const std::string name = entry->d_name;
+		if (name.compare(0, resourceName.size(), resourceName) == 0
+				&& (name.size() == resourceName.size()
+						|| !std::isalnum(static_cast<unsigned char>(
+								name[resourceName.size()])))) {
+			path = interfacePath + "/" + name + "/device/numa_node";
+		}
+		entry = readdir(dir);
+	}
+	closedir(dir);
+
+	int node = -1;
+	std::ifstream nodeFile(path);
+	if (path.empty() || !(nodeFile >> node)) {
+		return -1;
+	}
+	return node;
+}
+
 }  // namespace irio
 
@@ -8,20 +8,16 @@ namespace irio {
 
 TerminalsAnalogImpl::TerminalsAnalogImpl(ParserManager *parserManager,
 		const NiFpga_Session &session, const Platform &platform) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::Analog) {
 	// Find AI
-	for(uint32_t i = 0; i < platform.maxAI; ++i) {
-		parserManager->findRegisterEnumAddress(TERMINAL_AI, i,
-				GroupResource::AI, &m_mapAI, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_AI, platform.maxAI,
+			GroupResource::AI, &m_mapAI);
 
 	// Find AO and AOEnable
-	for(uint32_t i = 0; i < platform.maxAO; ++i) {
-		parserManager->findRegisterEnumAddress(
-			TERMINAL_AO, i, GroupResource::AO, &m_mapAO, true);
-		parserManager->findRegisterEnumAddress(
-			TERMINAL_AOENABLE, i, GroupResource::AO, &m_mapAOEnable, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_AO, platform.maxAO,
+			GroupResource::AO, &m_mapAO);
+	parserManager->enumerateRegisterAddresses(TERMINAL_AOENABLE,
+			platform.maxAO, GroupResource::AO, &m_mapAOEnable);
 
 	parserManager->compareResourcesMap(m_mapAO, TERMINAL_AO, m_mapAOEnable,
 									   TERMINAL_AOENABLE, GroupResource::AO);
@@ -32,29 +28,32 @@ TerminalsAnalogImpl::TerminalsAnalogImpl(ParserManager *parserManager,
 	searchModule(platform);
 }
 
-std::int32_t getAnalog(const NiFpga_Session &session, const std::uint32_t n,
+std::int32_t getAnalog(const NiFpga_Session &session,
+		const MetricsCounters &metrics, const std::uint32_t n,
 		const std::unordered_map<std::uint32_t, const std::uint32_t> &mapTerminals,
 		const std::string &terminalName) {
 	auto addr = utils::getAddressEnumResource(mapTerminals, n, terminalName);
 
 	std::int32_t aux;
+	metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI32(session, addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading terminal " + terminalName + std::to_string(n));
+			"Error reading terminal " + terminalName + std::to_string(n),
+			metrics);
 
 	return aux;
 }
 
 std::int32_t TerminalsAnalogImpl::getAIImpl(const std::uint32_t n) const {
-	return getAnalog(m_session, n, m_mapAI, TERMINAL_AI);
+	return getAnalog(m_session, m_metrics, n, m_mapAI, TERMINAL_AI);
 }
 
 std::int32_t TerminalsAnalogImpl::getAOImpl(const std::uint32_t n) const {
-	return getAnalog(m_session, n, m_mapAO, TERMINAL_AO);
+	return getAnalog(m_session, m_metrics, n, m_mapAO, TERMINAL_AO);
 }
 
 std::int32_t TerminalsAnalogImpl::getAOEnableImpl(std::uint32_t n) const {
-	return getAnalog(m_session, n, m_mapAOEnable, TERMINAL_AOENABLE);
+	return getAnalog(m_session, m_metrics, n, m_mapAOEnable, TERMINAL_AOENABLE);
 }
 
 size_t TerminalsAnalogImpl::getNumAIImpl() const {
@@ -65,24 +64,28 @@ size_t TerminalsAnalogImpl::getNumAOImpl() const {
 	return numAO;
 }
 
-void setAnalog(const NiFpga_Session &session, const std::uint32_t n,
+void setAnalog(const NiFpga_Session &session,
+		const MetricsCounters &metrics, const std::uint32_t n,
 		const std::int32_t value,
 		const std::unordered_map<std::uint32_t, const std::uint32_t> &mapTerminals,
 		const std::string &terminalName) {
 	auto addr = utils::getAddressEnumResource(mapTerminals, n, terminalName);
 
+	metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteI32(session, addr, value);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error writing terminal " + terminalName + std::to_string(n));
+			"Error writing terminal " + terminalName + std::to_string(n),
+			metrics);
 }
 
 void TerminalsAnalogImpl::setAOImpl(const std::uint32_t n,
 		const std::int32_t value) const {
-	setAnalog(m_session, n, value, m_mapAO, TERMINAL_AO);
+	setAnalog(m_session, m_metrics, n, value, m_mapAO, TERMINAL_AO);
 }
 
 void TerminalsAnalogImpl::setAOEnableImpl(std::uint32_t n, bool value) const {
-	setAnalog(m_session, n, static_cast<std::uint32_t>(value), m_mapAOEnable,
+	setAnalog(m_session, m_metrics,
+			n, static_cast<std::uint32_t>(value), m_mapAOEnable,
 			TERMINAL_AOENABLE);
 }
 
@@ -6,32 +6,29 @@ namespace irio {
 
 TerminalsAuxAnalogImpl::TerminalsAuxAnalogImpl(ParserManager *parserManager,
 		const NiFpga_Session &session, const Platform &platform) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::AuxAnalog) {
 	// Find AuxAI and Aux64AI
-	for(uint32_t i = 0; i < platform.maxAuxAI; ++i) {
-		parserManager->findRegisterEnumAddress(TERMINAL_AUXAI, i,
-						GroupResource::AuxAI, &m_mapAuxAI, true);
-		parserManager->findRegisterEnumAddress(TERMINAL_AUX64AI, i,
-						GroupResource::AuxAI, &m_mapAuxAI64, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUXAI,
+			platform.maxAuxAI, GroupResource::AuxAI, &m_mapAuxAI);
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUX64AI,
+			platform.maxAuxAI, GroupResource::AuxAI, &m_mapAuxAI64);
 
 	// Find AuxAO and Aux64AO
-	for(uint32_t i = 0; i < platform.maxAuxAO; ++i) {
-		parserManager->findRegisterEnumAddress(TERMINAL_AUXAO, i,
-						GroupResource::AuxAO, &m_mapAuxAO, true);
-		parserManager->findRegisterEnumAddress(TERMINAL_AUX64AO, i,
-						GroupResource::AuxAO, &m_mapAuxAO64, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUXAO,
+			platform.maxAuxAO, GroupResource::AuxAO, &m_mapAuxAO);
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUX64AO,
+			platform.maxAuxAO, GroupResource::AuxAO, &m_mapAuxAO64);
 }
 
 std::int32_t TerminalsAuxAnalogImpl::getAuxAIImpl(const std::uint32_t n) const {
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAI, n,
 			TERMINAL_AUXAI);
 	std::int32_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI32(m_session, add, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUXAI)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 
 	return aux;
 }
@@ -40,10 +37,11 @@ std::int32_t TerminalsAuxAnalogImpl::getAuxAOImpl(const std::uint32_t n) const {
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAO, n,
 			TERMINAL_AUXAO);
 	std::int32_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI32(m_session, add, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUXAO)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 
 	return aux;
 }
@@ -61,10 +59,11 @@ std::int64_t TerminalsAuxAnalogImpl::getAuxAI64Impl(
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAI64, n,
 			TERMINAL_AUX64AO);
 	std::int64_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI64(m_session, add, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUX64AI)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 
 	return aux;
 }
@@ -74,10 +73,11 @@ std::int64_t TerminalsAuxAnalogImpl::getAuxAO64Impl(
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAO64, n,
 			TERMINAL_AUX64AI);
 	std::int64_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI64(m_session, add, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUX64AO)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 
 	return aux;
 }
@@ -94,20 +94,22 @@ void TerminalsAuxAnalogImpl::setAuxAOImpl(const std::uint32_t n,
 		const std::int32_t value) const {
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAO, n,
 			TERMINAL_AUXAO);
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteI32(m_session, add, value);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUXAO)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 }
 
 void TerminalsAuxAnalogImpl::setAuxAO64Impl(const std::uint32_t n,
 		const std::int64_t value) const {
 	const std::uint32_t add = utils::getAddressEnumResource(m_mapAuxAO64, n,
 			TERMINAL_AUX64AO);
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteI64(m_session, add, value);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal " + std::string(TERMINAL_AUX64AO)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 }
 
 }  // namespace irio
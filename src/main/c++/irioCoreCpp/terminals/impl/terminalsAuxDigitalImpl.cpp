@@ -6,36 +6,37 @@ namespace irio {
 
 TerminalsAuxDigitalImpl::TerminalsAuxDigitalImpl(ParserManager *parserManager,
 		const NiFpga_Session &session, const Platform &platform) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::AuxDigital) {
 	// Find AuxDI and AuxDO
-	for(uint32_t i = 0; i < platform.maxAuxDigital; ++i) {
-		parserManager->findRegisterEnumAddress(TERMINAL_AUXDI, i,
-						GroupResource::AuxDI, &m_mapAuxDI, true);
-		parserManager->findRegisterEnumAddress(TERMINAL_AUXDO, i,
-						GroupResource::AuxDO, &m_mapAuxDO, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUXDI,
+			platform.maxAuxDigital, GroupResource::AuxDI, &m_mapAuxDI);
+	parserManager->enumerateRegisterAddresses(TERMINAL_AUXDO,
+			platform.maxAuxDigital, GroupResource::AuxDO, &m_mapAuxDO);
 }
 
-bool getAuxDigital(const NiFpga_Session &session, const std::uint32_t n,
+bool getAuxDigital(const NiFpga_Session &session,
+		const MetricsCounters &metrics, const std::uint32_t n,
 		const std::unordered_map<std::uint32_t, const std::uint32_t> &mapTerminals,
 		const std::string &terminalName) {
 	const auto addr = utils::getAddressEnumResource(mapTerminals, n,
 			terminalName);
 
 	std::uint8_t aux;
+	metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadBool(session, addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading terminal " + terminalName + std::to_string(n));
+			"Error reading terminal " + terminalName + std::to_string(n),
+			metrics);
 
 	return static_cast<bool>(aux);
 }
 
 bool TerminalsAuxDigitalImpl::getAuxDI(const std::uint32_t n) const {
-	return getAuxDigital(m_session, n, m_mapAuxDI, TERMINAL_AUXDI);
+	return getAuxDigital(m_session, m_metrics, n, m_mapAuxDI, TERMINAL_AUXDI);
 }
 
 bool TerminalsAuxDigitalImpl::getAuxDO(const std::uint32_t n) const {
-	return getAuxDigital(m_session, n, m_mapAuxDO, TERMINAL_AUXDO);
+	return getAuxDigital(m_session, m_metrics, n, m_mapAuxDO, TERMINAL_AUXDO);
 }
 
 size_t TerminalsAuxDigitalImpl::getNumAuxDI() const {
@@ -51,10 +52,11 @@ void TerminalsAuxDigitalImpl::setAuxDO(const std::uint32_t n,
 	const auto addr = utils::getAddressEnumResource(m_mapAuxDO, n,
 			TERMINAL_AUXDO);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteBool(m_session, addr,
 			static_cast<NiFpga_Bool>(value));
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error writing terminal " + std::string(TERMINAL_AUXDO)
-					+ std::to_string(n));
+					+ std::to_string(n), m_metrics);
 }
 }  // namespace irio
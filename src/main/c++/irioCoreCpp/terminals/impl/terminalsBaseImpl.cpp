@@ -2,8 +2,10 @@
 
 namespace irio {
 
-TerminalsBaseImpl::TerminalsBaseImpl(const NiFpga_Session &session) :
-		m_session(session) {
+TerminalsBaseImpl::TerminalsBaseImpl(const NiFpga_Session &session,
+		const MetricsTerminal terminal) :
+		m_session(session),
+		m_metrics(MetricsRegistry::instance().getCounters(session, terminal)) {
 }
 
 }
@@ -5,7 +5,7 @@
 namespace irio {
 TerminalscRIOImpl::TerminalscRIOImpl(ParserManager *parserManager,
 		const NiFpga_Session &session) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::CRIO) {
 	parserManager->findRegisterAddress(TERMINAL_CRIOMODULESOK,
 			GroupResource::CRIO, &m_criomodulesok_addr, false);
 
@@ -19,18 +19,21 @@ TerminalscRIOImpl::TerminalscRIOImpl(ParserManager *parserManager,
 
 bool TerminalscRIOImpl::getcRIOModulesOk() const {
 	NiFpga_Bool aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadBool(m_session, m_criomodulesok_addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + std::string(TERMINAL_CRIOMODULESOK));
+			"Error reading " + std::string(TERMINAL_CRIOMODULESOK), m_metrics);
 	return static_cast<bool>(aux);
 }
 
 std::vector<std::uint16_t> TerminalscRIOImpl::getInsertedIOModulesID() const {
 	static std::vector<std::uint16_t> ret(m_numModules);
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadArrayU16(m_session, m_insertediomodulesid_addr,
 			ret.data(), m_numModules);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + std::string(TERMINAL_INSERTEDIOMODULESID));
+			"Error reading " + std::string(TERMINAL_INSERTEDIOMODULESID),
+			m_metrics);
 	return ret;
 }
 }  // namespace irio
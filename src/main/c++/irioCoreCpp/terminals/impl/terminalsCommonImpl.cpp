@@ -16,9 +16,11 @@ TerminalsCommonImpl::TerminalsCommonImpl(ParserManager *parserManager,
 	if (parserManager->findRegisterAddress(TERMINAL_FPGAVIVERSION,
 			GroupResource::Common, &fpgaviversion_addr)) {
 		std::array<std::uint8_t, 2> fpgaviversion;
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadArrayU8(m_session, fpgaviversion_addr,
 				fpgaviversion.data(), 2);
-		utils::throwIfNotSuccessNiFpga(status, "Error reading FPGAVIversion");
+		utils::throwIfNotSuccessNiFpga(status, "Error reading FPGAVIversion",
+				m_metrics);
 		m_fpgaviversion = "V" + std::to_string(fpgaviversion[0])
 				+ "." + std::to_string(fpgaviversion[1]);
 	}
@@ -27,8 +29,9 @@ TerminalsCommonImpl::TerminalsCommonImpl(ParserManager *parserManager,
 	std::uint32_t fref_addr;
 	if (parserManager->findRegisterAddress(TERMINAL_FREF,
 				GroupResource::Common, &fref_addr)) {
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadU32(m_session, fref_addr, &m_fref);
-		utils::throwIfNotSuccessNiFpga(status, "Error reading Fref");
+		utils::throwIfNotSuccessNiFpga(status, "Error reading Fref", m_metrics);
 	}
 
     parserManager->findRegisterAddress(TERMINAL_INITDONE,
@@ -58,36 +61,44 @@ std::uint32_t TerminalsCommonImpl::getFrefImpl() const {
 
 bool TerminalsCommonImpl::getInitDoneImpl() const {
 	std::uint8_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadBool(m_session, m_initdone_addr, &aux);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading InitDone");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading InitDone", m_metrics);
 	return static_cast<bool>(aux);
 }
 
 std::uint8_t TerminalsCommonImpl::getDevQualityStatusImpl() const {
 	std::uint8_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU8(m_session, m_devqualitystatus_addr, &aux);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading DevQualityStatus");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading DevQualityStatus",
+			m_metrics);
 	return aux;
 }
 
 std::int16_t TerminalsCommonImpl::getDevTempImpl() const {
 	std::int16_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadI16(m_session, m_devtemp_addr, &aux);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading DevTemp");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading DevTemp", m_metrics);
 	return aux;
 }
 
 bool TerminalsCommonImpl::getDAQStartStopImpl() const {
 	std::uint8_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU8(m_session, m_daqstartstop_addr, &aux);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading DAQStartStop");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading DAQStartStop",
+			m_metrics);
 	return static_cast<bool>(aux);
 }
 
 bool TerminalsCommonImpl::getDebugModeImpl() const {
 	std::uint8_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU8(m_session, m_debugmode_addr, &aux);
-	utils::throwIfNotSuccessNiFpga(status, "Error reading DebugMode");
+	utils::throwIfNotSuccessNiFpga(status, "Error reading DebugMode",
+			m_metrics);
 	return static_cast<bool>(aux);
 }
 
@@ -100,15 +111,19 @@ void TerminalsCommonImpl::setDAQStopImpl() const {
 }
 
 void TerminalsCommonImpl::setDAQStartStopImpl(const bool &start) const {
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteU8(m_session, m_daqstartstop_addr,
 			static_cast<std::uint8_t>(start));
-	utils::throwIfNotSuccessNiFpga(status, "Error writing DAQStartStop");
+	utils::throwIfNotSuccessNiFpga(status, "Error writing DAQStartStop",
+			m_metrics);
 }
 
 void TerminalsCommonImpl::setDebugModeImpl(const bool &debug) const {
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteU8(m_session, m_debugmode_addr,
 			static_cast<std::uint8_t>(debug));
-	utils::throwIfNotSuccessNiFpga(status, "Error writing DebugMode");
+	utils::throwIfNotSuccessNiFpga(status, "Error writing DebugMode",
+			m_metrics);
 }
 
 double TerminalsCommonImpl::getMinSamplingRateImpl() const {
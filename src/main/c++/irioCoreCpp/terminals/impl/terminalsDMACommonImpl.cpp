@@ -1,6 +1,8 @@
 #include <terminals/impl/terminalsDMACommonImpl.h>
 #include <errorsIrio.h>
 #include <utils.h>
+#include <algorithm>
+#include <chrono>
 #include <memory>
 
 namespace irio {
@@ -16,9 +18,11 @@ bool TerminalsDMACommonImpl::findArrayRegReadToVector(
 	bfp::Register reg;
 	if (parserManager->findRegister(nameReg, group, &reg, optional)) {
 		vec->resize(reg.getNumElem());
+		m_metrics.add(MetricsOperation::RegisterRead);
 		const auto status = readFunc(session, reg.getAddress(), vec->data(),
 				vec->size());
-		utils::throwIfNotSuccessNiFpga(status, "Error reading " + nameReg);
+		utils::throwIfNotSuccessNiFpga(status, "Error reading " + nameReg,
+				m_metrics);
 		return true;
 	} else {
 		return false;
@@ -49,7 +53,8 @@ TerminalsDMACommonImpl::TerminalsDMACommonImpl(ParserManager *parserManager,
 		const std::string &nameTermSampleSize,
 		const std::string &nameTermOverflows, const std::string &nameTermDMA,
 		const std::string &nameTermDMAEnable) :
-		TerminalsBaseImpl(session), m_nameTermOverflows(nameTermOverflows),
+		TerminalsBaseImpl(session, MetricsTerminal::DMA),
+		m_nameTermOverflows(nameTermOverflows),
 		m_nameTermDMA(nameTermDMA), m_nameTermDMAEnable(nameTermDMAEnable) {
 	// Find Overflows (it is one uint16 where each bit is the status)
 	parserManager->findRegisterAddress(nameTermOverflows,
@@ -77,15 +82,39 @@ TerminalsDMACommonImpl::TerminalsDMACommonImpl(ParserManager *parserManager,
 			nameTermSampleSize, &m_sampleSize, &NiFpga_ReadArrayU8);
 
 	// Find DMAs and DMAEnable
-	for(uint32_t i = 0; i < platform.maxDMA; ++i) {
-		parserManager->findDMAEnumNum(nameTermDMA, i, GroupResource::DMA,
-									  &m_mapDMA, true);
-		parserManager->findRegisterEnumAddress(
-			nameTermDMAEnable, i, GroupResource::DMA, &m_mapEnable, true);
-	}
+	parserManager->enumerateDMANums(nameTermDMA, platform.maxDMA,
+			GroupResource::DMA, &m_mapDMA);
+	parserManager->enumerateRegisterAddresses(nameTermDMAEnable,
+			platform.maxDMA, GroupResource::DMA, &m_mapEnable);
 
 	parserManager->compareResourcesMap(m_mapDMA, nameTermDMA, m_mapEnable,
 									   nameTermDMAEnable, GroupResource::DMA);
+
+	for (const auto &values : m_mapDMA) {
+		m_hostDepth.emplace(values.first, 0);
+		m_effectiveHostDepth.emplace(values.first, 0);
+		m_lastRemaining.emplace(values.first, 0);
+		m_readStats.emplace(values.first,
+				std::unique_ptr<ReadHistograms>(new ReadHistograms()));
+	}
+}
+
+TerminalsDMACommonImpl::TerminalsDMACommonImpl(
+		const std::vector<std::uint16_t> &nCh,
+		const std::vector<FrameType> &frameType,
+		const std::vector<std::uint8_t> &sampleSize,
+		const std::string &nameTermDMA) :
+		TerminalsBaseImpl(0), m_overflowsAddr(0), m_nCh(nCh),
+		m_frameType(frameType), m_sampleSize(sampleSize),
+		m_nameTermDMA(nameTermDMA) {
+	for (std::uint32_t i = 0; i < m_nCh.size(); ++i) {
+		m_mapDMA.emplace(i, i);
+		m_hostDepth.emplace(i, 0);
+		m_effectiveHostDepth.emplace(i, 0);
+		m_lastRemaining.emplace(i, 0);
+		m_readStats.emplace(i,
+				std::unique_ptr<ReadHistograms>(new ReadHistograms()));
+	}
 }
 
 std::uint16_t TerminalsDMACommonImpl::getNChImpl(const std::uint32_t n) const {
@@ -97,34 +126,73 @@ std::uint16_t TerminalsDMACommonImpl::getNChImpl(const std::uint32_t n) const {
 	return m_nCh.at(n);
 }
 
-void TerminalsDMACommonImpl::startDMACommon(const std::uint32_t &dma) const {
-	// TODO: For the moment, do the same as in the old lib, reserve a lot of space
-	auto status = NiFpga_ConfigureFifo(m_session, dma, SIZE_HOST_DMAS);
+std::vector<std::uint16_t> TerminalsDMACommonImpl::getAllNChImpl() const {
+	return m_nCh;
+}
+
+void TerminalsDMACommonImpl::startDMACommon(const std::uint32_t &n,
+		const std::uint32_t &dma) const {
+	const size_t requested = m_hostDepth.at(n);
+	const size_t depth = requested == 0 ? SIZE_HOST_DMAS : requested;
+
+	m_lastRemaining.at(n) = 0;
+	auto status = NiFpga_ConfigureFifo2(m_session, dma, depth,
+			&m_effectiveHostDepth.at(n));
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error configuring " + m_nameTermDMA + std::to_string(dma));
+			"Error configuring " + m_nameTermDMA + std::to_string(dma),
+			m_metrics);
 	status = NiFpga_StartFifo(m_session, dma);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error starting " + m_nameTermDMA + std::to_string(dma));
+			"Error starting " + m_nameTermDMA + std::to_string(dma), m_metrics);
 }
 
-void TerminalsDMACommonImpl::startDMAImpl(const std::uint32_t n) const {
+size_t TerminalsDMACommonImpl::startDMAImpl(const std::uint32_t n) const {
 	const auto it = m_mapDMA.find(n);
 	if (it == m_mapDMA.end()) {
 		const std::string err = std::to_string(n) + " is not a valid DMA";
 		throw errors::ResourceNotFoundError(err);
 	}
 
-	startDMACommon(it->second);
+	startDMACommon(n, it->second);
 
-	cleanDMACommon(n);
+	return cleanDMACommon(n, it->second);
 }
 
-void TerminalsDMACommonImpl::startAllDMAsImpl() const {
+size_t TerminalsDMACommonImpl::startAllDMAsImpl() const {
 	for (const auto &values : m_mapDMA) {
-		startDMACommon(values.second);
+		startDMACommon(values.first, values.second);
+	}
+
+	return cleanAllDMAsImpl();
+}
+
+void TerminalsDMACommonImpl::setHostDepthImpl(const std::uint32_t n,
+		size_t depth) const {
+	const auto it = m_hostDepth.find(n);
+	if (it == m_hostDepth.end()) {
+		throw errors::ResourceNotFoundError(n, m_nameTermDMA);
+	}
+
+	it->second = depth;
+}
+
+size_t TerminalsDMACommonImpl::getHostDepthImpl(const std::uint32_t n) const {
+	const auto it = m_hostDepth.find(n);
+	if (it == m_hostDepth.end()) {
+		throw errors::ResourceNotFoundError(n, m_nameTermDMA);
 	}
 
-	cleanAllDMAsImpl();
+	return it->second == 0 ? SIZE_HOST_DMAS : it->second;
+}
+
+size_t TerminalsDMACommonImpl::getEffectiveHostDepthImpl(
+		const std::uint32_t n) const {
+	const auto it = m_effectiveHostDepth.find(n);
+	if (it == m_effectiveHostDepth.end()) {
+		throw errors::ResourceNotFoundError(n, m_nameTermDMA);
+	}
+
+	return it->second;
 }
 
 void TerminalsDMACommonImpl::stopDMAImpl(const std::uint32_t n) const {
@@ -136,7 +204,7 @@ void TerminalsDMACommonImpl::stopDMAImpl(const std::uint32_t n) const {
 
 	const auto status = NiFpga_StopFifo(m_session, it->second);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error stopping " + m_nameTermDMA + std::to_string(n));
+			"Error stopping " + m_nameTermDMA + std::to_string(n), m_metrics);
 }
 
 void TerminalsDMACommonImpl::stopAllDMAsImpl() const {
@@ -144,7 +212,7 @@ void TerminalsDMACommonImpl::stopAllDMAsImpl() const {
 		const auto status = NiFpga_StopFifo(m_session, values.second);
 		utils::throwIfNotSuccessNiFpga(status,
 				"Error stopping " + m_nameTermDMA
-						+ std::to_string(values.first));
+						+ std::to_string(values.first), m_metrics);
 	}
 }
 
@@ -152,42 +220,62 @@ size_t TerminalsDMACommonImpl::countDMAsImpl() const {
 	return m_mapDMA.size();
 }
 
-void TerminalsDMACommonImpl::cleanDMACommon(const std::uint32_t &dma) const {
+bool TerminalsDMACommonImpl::hasDMAImpl(const std::uint32_t n) const {
+	return m_mapDMA.count(n) != 0;
+}
+
+size_t TerminalsDMACommonImpl::cleanDMACommon(const std::uint32_t &n,
+		const std::uint32_t &dma) const {
 	NiFpga_Status status;
 	size_t elementsRemaining;
 	std::uint64_t aux;
 	status = NiFpga_ReadFifoU64(m_session, dma, &aux, 0, 0, &elementsRemaining);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + m_nameTermDMA + std::to_string(dma));
-
-	// TODO: Find better way?
-	static const size_t sizeCleanBuffer = SIZE_HOST_DMAS;
-	std::unique_ptr<std::uint64_t> buffer(new std::uint64_t[sizeCleanBuffer]);
-
-	size_t elementsToRead;
-	while (elementsRemaining > 0) {
-		elementsToRead =
-				elementsRemaining > sizeCleanBuffer ?
-						sizeCleanBuffer : elementsRemaining;
+			"Error reading " + m_nameTermDMA + std::to_string(n), m_metrics);
+
+	// Discard in place: acquiring gives access to the host buffer and
+	// releasing returns it to the FPGA, nothing is copied. Only the
+	// elements pending at the start are discarded, so a running DMA
+	// cannot keep this loop alive
+	size_t discarded = 0;
+	size_t pending = elementsRemaining;
+	while (pending > 0) {
+		std::uint64_t *elements;
+		size_t acquired = 0;
+		status = NiFpga_AcquireFifoReadElementsU64(m_session, dma, &elements,
+				pending, 0, &acquired, &elementsRemaining);
+		utils::throwIfNotSuccessNiFpga(status,
+				"Error reading " + m_nameTermDMA + std::to_string(n),
+				m_metrics);
+		if (acquired == 0) {
+			break;
+		}
 
-		status = NiFpga_ReadFifoU64(m_session, dma, buffer.get(),
-				elementsToRead, 1, &elementsRemaining);
+		status = NiFpga_ReleaseFifoElements(m_session, dma, acquired);
 		utils::throwIfNotSuccessNiFpga(status,
-				"Error reading " + m_nameTermDMA + std::to_string(dma));
+				"Error releasing " + m_nameTermDMA + std::to_string(n),
+				m_metrics);
+		discarded += acquired;
+		pending -= acquired;
 	}
+
+	m_lastRemaining.at(n) = 0;
+	return discarded;
 }
 
-void TerminalsDMACommonImpl::cleanDMAImpl(const std::uint32_t n) const {
+size_t TerminalsDMACommonImpl::cleanDMAImpl(const std::uint32_t n) const {
 	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
 			m_nameTermDMA);
 
-	cleanDMACommon(dmaNum);
+	return cleanDMACommon(n, dmaNum);
 }
 
-void TerminalsDMACommonImpl::cleanAllDMAsImpl() const {
+size_t TerminalsDMACommonImpl::cleanAllDMAsImpl() const {
+	size_t discarded = 0;
 	for (const auto &values : m_mapDMA) {
-		cleanDMACommon(values.second);
+		discarded += cleanDMACommon(values.first, values.second);
 	}
+	return discarded;
 }
 
 bool TerminalsDMACommonImpl::isDMAEnableImpl(const std::uint32_t n) const {
@@ -195,9 +283,11 @@ bool TerminalsDMACommonImpl::isDMAEnableImpl(const std::uint32_t n) const {
 			m_nameTermDMAEnable);
 
 	NiFpga_Bool val;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status = NiFpga_ReadBool(m_session, addr, &val);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + m_nameTermDMAEnable + std::to_string(n));
+			"Error reading " + m_nameTermDMAEnable + std::to_string(n),
+			m_metrics);
 
 	return static_cast<bool>(val);
 }
@@ -215,10 +305,12 @@ void TerminalsDMACommonImpl::enaDisDMAImpl(const std::uint32_t n,
 	const auto addr = utils::getAddressEnumResource(m_mapEnable, n,
 			m_nameTermDMAEnable);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	const auto status = NiFpga_WriteBool(m_session, addr,
 			static_cast<NiFpga_Bool>(enaDis));
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error writing " + m_nameTermDMAEnable + std::to_string(n));
+			"Error writing " + m_nameTermDMAEnable + std::to_string(n),
+			m_metrics);
 }
 
 bool TerminalsDMACommonImpl::getDMAOverflowImpl(const std::uint16_t n) const {
@@ -231,9 +323,10 @@ bool TerminalsDMACommonImpl::getDMAOverflowImpl(const std::uint16_t n) const {
 
 std::uint16_t TerminalsDMACommonImpl::getAllDMAOverflowsImpl() const {
 	std::uint16_t overflows;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status = NiFpga_ReadU16(m_session, m_overflowsAddr, &overflows);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + m_nameTermOverflows);
+			"Error reading " + m_nameTermOverflows, m_metrics);
 
 	return overflows;
 }
@@ -277,37 +370,108 @@ size_t TerminalsDMACommonImpl::readDataBlockingImpl(const std::uint32_t n,
 	return readDataImpl(n, elementsToRead, data, true, timeout);
 }
 
+size_t TerminalsDMACommonImpl::readDataBlockingImpl(const std::uint32_t n,
+		size_t elementsToRead, std::uint64_t *data, std::uint32_t timeout,
+		const WaitPolicy &policy) const {
+	return readDataImpl(n, elementsToRead, data, true, timeout, policy);
+}
+
 size_t TerminalsDMACommonImpl::readDataImpl(const std::uint32_t n,
 		size_t elementsToRead, std::uint64_t *data, bool block,
 		std::uint32_t timeout) const {
+	return readDataImpl(n, elementsToRead, data, block, timeout,
+			m_waitPolicy);
+}
+
+size_t TerminalsDMACommonImpl::readDataImpl(const std::uint32_t n,
+		size_t elementsToRead, std::uint64_t *data, bool block,
+		std::uint32_t timeout, const WaitPolicy &policy) const {
+	m_metrics.add(MetricsOperation::DMARead);
+	size_t elementsRead = 0;
+	try {
+#ifndef IRIO_NO_READ_STATS
+		if (m_readStatsEnabled.load(std::memory_order_relaxed)) {
+			const auto start = std::chrono::steady_clock::now();
+			size_t fillLevel = 0;
+			try {
+				elementsRead = readDataFifo(n, elementsToRead, data, block,
+						timeout, policy, &fillLevel);
+			} catch (errors::DMAReadTimeout&) {
+				recordReadTimeout(n);
+				throw;
+			}
+			recordRead(n, start, elementsRead, fillLevel);
+		} else {
+			elementsRead = readDataFifo(n, elementsToRead, data, block,
+					timeout, policy, nullptr);
+		}
+#else
+		elementsRead = readDataFifo(n, elementsToRead, data, block, timeout,
+				policy, nullptr);
+#endif
+	} catch (errors::DMAReadTimeout&) {
+		m_metrics.add(MetricsOperation::Timeout);
+		throw;
+	}
+	m_metrics.add(MetricsOperation::DMAElementsRead, elementsRead);
+	return elementsRead;
+}
+
+size_t TerminalsDMACommonImpl::readDataFifo(const std::uint32_t n,
+		size_t elementsToRead, std::uint64_t *data, bool block,
+		std::uint32_t timeout, const WaitPolicy &policy,
+		size_t *fillLevel) const {
+	if (block && !policy.driverWait) {
+		// Poll with non-blocking reads, which only read when all the
+		// elements are available
+		PollWaiter waiter(policy, timeout);
+		while (readDataFifo(n, elementsToRead, data, false, 0, policy,
+				fillLevel) != elementsToRead) {
+			if (!waiter.wait()) {
+				throw errors::DMAReadTimeout(m_nameTermDMA, n);
+			}
+		}
+		return elementsToRead;
+	}
+
 	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
 			m_nameTermDMA);
 
 	size_t elementsRead = 0;
 	NiFpga_Status status;
 	if (block) {
+		size_t elementsRemaining = 0;
 		status = NiFpga_ReadFifoU64(m_session, dmaNum, data, elementsToRead,
-				timeout, nullptr);
+				timeout, fillLevel ? &elementsRemaining : nullptr);
 		// Special case when is timeout, inform the user of this specific case
 		if (status == NiFpga_Status_FifoTimeout) {
 			throw errors::DMAReadTimeout(m_nameTermDMA, dmaNum);
 		}
 		utils::throwIfNotSuccessNiFpga(status,
-				"Error reading " + m_nameTermDMA + std::to_string(n));
+				"Error reading " + m_nameTermDMA + std::to_string(n),
+				m_metrics);
 		elementsRead = elementsToRead;
+		if (fillLevel) {
+			*fillLevel = elementsRemaining + elementsRead;
+		}
 	} else {
 		size_t elementsRemaining;
 		// Test how many elements are available right now
 		status = NiFpga_ReadFifoU64(m_session, dmaNum, data, 0, 0,
 				&elementsRemaining);
 		utils::throwIfNotSuccessNiFpga(status,
-				"Error reading " + m_nameTermDMA + std::to_string(n));
+				"Error reading " + m_nameTermDMA + std::to_string(n),
+				m_metrics);
+		if (fillLevel) {
+			*fillLevel = elementsRemaining;
+		}
 		// If not enough, do not read anything and return
 		if (elementsRemaining >= elementsToRead) {
 			status = NiFpga_ReadFifoU64(m_session, dmaNum, data, elementsToRead,
 					1, nullptr);
 			utils::throwIfNotSuccessNiFpga(status,
-					"Error reading " + m_nameTermDMA + std::to_string(n));
+					"Error reading " + m_nameTermDMA + std::to_string(n),
+					m_metrics);
 			elementsRead = elementsToRead;
 		}
 	}
@@ -315,6 +479,307 @@ size_t TerminalsDMACommonImpl::readDataImpl(const std::uint32_t n,
 	return elementsRead;
 }
 
+size_t TerminalsDMACommonImpl::readDataMultiImpl(
+		const std::vector<DMAReadRequest> &requests,
+		std::vector<DMAReadResult> *results, bool blockRead,
+		std::uint32_t timeout) const {
+	const auto deadline = std::chrono::steady_clock::now()
+			+ std::chrono::milliseconds(timeout);
+	results->assign(requests.size(), DMAReadResult());
+
+	size_t completed = 0;
+	for (size_t i = 0; i < requests.size(); ++i) {
+		const DMAReadRequest &request = requests[i];
+		DMAReadResult &result = (*results)[i];
+		const auto it = m_mapDMA.find(request.n);
+		if (it == m_mapDMA.end()) {
+			result.status = DMAReadStatus::NotFound;
+			continue;
+		}
+
+		// With a timeout of 0 the driver reads all the elements or nothing
+		// without waiting. Blocking reads share the time left until the
+		// deadline
+		std::uint32_t timeoutFifo = 0;
+		if (blockRead && timeout == 0) {
+			timeoutFifo = NiFpga_InfiniteTimeout;
+		} else if (blockRead) {
+			const auto left = std::chrono::duration_cast<
+					std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now()).count();
+			timeoutFifo = left > 0 ? static_cast<std::uint32_t>(left) : 0;
+		}
+
+		size_t remaining = 0;
+		m_metrics.add(MetricsOperation::DMARead);
+		const auto status = NiFpga_ReadFifoU64(m_session, it->second,
+				request.data, request.elements, timeoutFifo, &remaining);
+		if (status == NiFpga_Status_FifoTimeout) {
+			result.status = blockRead ?
+					DMAReadStatus::Timeout : DMAReadStatus::NotEnough;
+			if (blockRead) {
+				m_metrics.add(MetricsOperation::Timeout);
+			}
+			remaining = 0;
+		} else if (NiFpga_IsError(status)) {
+			result.status = DMAReadStatus::Error;
+			result.fpgaStatus = status;
+			m_metrics.add(MetricsOperation::NiFpgaError);
+			remaining = 0;
+		} else {
+			result.elementsRead = request.elements;
+			m_metrics.add(MetricsOperation::DMAElementsRead,
+					request.elements);
+			++completed;
+		}
+		m_lastRemaining.at(request.n) = remaining;
+	}
+
+	return completed;
+}
+
+void TerminalsDMACommonImpl::setWaitPolicyImpl(
+		const WaitPolicy &policy) const {
+	m_waitPolicy = policy;
+}
+
+WaitPolicy TerminalsDMACommonImpl::getWaitPolicyImpl() const {
+	return m_waitPolicy;
+}
+
+void TerminalsDMACommonImpl::setReadStatsEnabledImpl(const bool enable) const {
+#ifndef IRIO_NO_READ_STATS
+	m_readStatsEnabled.store(enable, std::memory_order_relaxed);
+#else
+	static_cast<void>(enable);
+#endif
+}
+
+bool TerminalsDMACommonImpl::isReadStatsEnabledImpl() const {
+	return m_readStatsEnabled.load(std::memory_order_relaxed);
+}
+
+DMAReadStats TerminalsDMACommonImpl::getReadStatsImpl(
+		const std::uint32_t n) const {
+	const auto it = m_readStats.find(n);
+	if (it == m_readStats.end()) {
+		throw errors::ResourceNotFoundError(n, m_nameTermDMA);
+	}
+
+	DMAReadStats stats;
+	stats.latencyNs = it->second->latencyNs.snapshot();
+	stats.elements = it->second->elements.snapshot();
+	stats.fillLevel = it->second->fillLevel.snapshot();
+	stats.interArrivalNs = it->second->interArrivalNs.snapshot();
+	stats.timeouts = it->second->timeouts.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void TerminalsDMACommonImpl::resetReadStatsImpl(const std::uint32_t n) const {
+	const auto it = m_readStats.find(n);
+	if (it == m_readStats.end()) {
+		throw errors::ResourceNotFoundError(n, m_nameTermDMA);
+	}
+
+	it->second->latencyNs.reset();
+	it->second->elements.reset();
+	it->second->fillLevel.reset();
+	it->second->interArrivalNs.reset();
+	it->second->timeouts.store(0, std::memory_order_relaxed);
+	it->second->lastReadNs.store(0, std::memory_order_relaxed);
+}
+
+void TerminalsDMACommonImpl::resetAllReadStatsImpl() const {
+	for (const auto &values : m_readStats) {
+		resetReadStatsImpl(values.first);
+	}
+}
+
+void TerminalsDMACommonImpl::recordRead(const std::uint32_t n,
+		const std::chrono::steady_clock::time_point &start,
+		const size_t elementsRead, const size_t fillLevel) const {
+	const auto it = m_readStats.find(n);
+	if (it == m_readStats.end()) {
+		return;
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	ReadHistograms &stats = *it->second;
+	stats.latencyNs.record(static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+					end - start).count()));
+	stats.elements.record(elementsRead);
+	stats.fillLevel.record(fillLevel);
+	if (elementsRead != 0) {
+		const std::int64_t endNs =
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+						end.time_since_epoch()).count();
+		const std::int64_t lastNs = stats.lastReadNs.exchange(endNs,
+				std::memory_order_relaxed);
+		if (lastNs != 0 && endNs > lastNs) {
+			stats.interArrivalNs.record(
+					static_cast<std::uint64_t>(endNs - lastNs));
+		}
+	}
+}
+
+void TerminalsDMACommonImpl::recordReadTimeout(const std::uint32_t n) const {
+	const auto it = m_readStats.find(n);
+	if (it != m_readStats.end()) {
+		it->second->timeouts.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+size_t TerminalsDMACommonImpl::getElementsAvailableImpl(
+		const std::uint32_t n) const {
+	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
+			m_nameTermDMA);
+	std::uint64_t dummy;
+	size_t remaining = 0;
+	const auto status = NiFpga_ReadFifoU64(m_session, dmaNum, &dummy, 0, 0,
+			&remaining);
+	utils::throwIfNotSuccessNiFpga(status,
+			"Error reading " + m_nameTermDMA + std::to_string(n), m_metrics);
+	m_lastRemaining.at(n) = remaining;
+	return remaining;
+}
+
+NiFpga_IrqContext TerminalsDMACommonImpl::reserveIrqContextImpl() const {
+	NiFpga_IrqContext context = nullptr;
+	utils::throwIfNotSuccessNiFpga(
+			NiFpga_ReserveIrqContext(m_session, &context),
+			"Error reserving IRQ context", m_metrics);
+	return context;
+}
+
+void TerminalsDMACommonImpl::unreserveIrqContextImpl(
+		NiFpga_IrqContext context) const noexcept {
+	NiFpga_UnreserveIrqContext(m_session, context);
+}
+
+std::uint32_t TerminalsDMACommonImpl::waitOnIrqsImpl(NiFpga_IrqContext context,
+		const std::uint32_t irqs, const std::uint32_t timeout) const {
+	std::uint32_t asserted = 0;
+	NiFpga_Bool timedOut = NiFpga_False;
+	const auto status = NiFpga_WaitOnIrqs(m_session, context, irqs, timeout,
+			&asserted, &timedOut);
+	if (status == NiFpga_Status_IrqTimeout || timedOut) {
+		return 0;
+	}
+	utils::throwIfNotSuccessNiFpga(status, "Error waiting on IRQs", m_metrics);
+	return asserted;
+}
+
+void TerminalsDMACommonImpl::acknowledgeIrqsImpl(
+		const std::uint32_t irqs) const {
+	utils::throwIfNotSuccessNiFpga(NiFpga_AcknowledgeIrqs(m_session, irqs),
+			"Error acknowledging IRQs", m_metrics);
+}
+
+size_t TerminalsDMACommonImpl::readAvailableImpl(const std::uint32_t n,
+		size_t maxElements, std::uint64_t *data, size_t minElements,
+		size_t *elementsRemaining) const {
+	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
+			m_nameTermDMA);
+	size_t &lastRemaining = m_lastRemaining.at(n);
+	if (minElements == 0) {
+		minElements = 1;
+	}
+	const size_t maxGroups = maxElements / minElements;
+
+	// Elements reported in the previous call are still in the DMA, so they
+	// can be read without asking first. If none, try one group: the read
+	// either succeeds or times out without consuming anything. If not even
+	// one group fits, 0 elements are read to get the fill level
+	size_t groups = std::min(lastRemaining / minElements, maxGroups);
+	if (groups == 0) {
+		groups = std::min<size_t>(1, maxGroups);
+	}
+
+	const size_t elementsToRead = groups * minElements;
+	size_t remaining = 0;
+	m_metrics.add(MetricsOperation::DMARead);
+	const auto status = NiFpga_ReadFifoU64(m_session, dmaNum, data,
+			elementsToRead, 0, &remaining);
+	size_t elementsRead = elementsToRead;
+	if (status == NiFpga_Status_FifoTimeout) {
+		// Less elements than expected (e.g. cleaned meanwhile). The driver
+		// still reports how many there are
+		elementsRead = 0;
+	} else {
+		utils::throwIfNotSuccessNiFpga(status,
+				"Error reading " + m_nameTermDMA + std::to_string(n),
+				m_metrics);
+	}
+
+	m_metrics.add(MetricsOperation::DMAElementsRead, elementsRead);
+	lastRemaining = remaining;
+	if (elementsRemaining) {
+		*elementsRemaining = remaining;
+	}
+	return elementsRead;
+}
+
+DMADataView TerminalsDMACommonImpl::acquireDataImpl(const std::uint32_t n,
+		size_t elements, std::uint32_t timeout) const {
+	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
+			m_nameTermDMA);
+	const std::uint32_t timeoutFifo =
+			timeout == 0 ? NiFpga_InfiniteTimeout : timeout;
+
+	DMADataView view;
+	std::uint64_t *region = nullptr;
+	size_t acquired = 0;
+	m_metrics.add(MetricsOperation::DMARead);
+	NiFpga_Status status = NiFpga_AcquireFifoReadElementsU64(m_session,
+			dmaNum, &region, elements, timeoutFifo, &acquired, nullptr);
+	if (status == NiFpga_Status_FifoTimeout) {
+		m_metrics.add(MetricsOperation::Timeout);
+		throw errors::DMAReadTimeout(m_nameTermDMA, dmaNum);
+	}
+	utils::throwIfNotSuccessNiFpga(status,
+			"Error acquiring " + m_nameTermDMA + std::to_string(n), m_metrics);
+	view.first = region;
+	view.firstSize = acquired;
+
+	// Less elements than requested means the end of the host buffer was
+	// reached. The rest are already available at the start of the buffer
+	if (acquired < elements) {
+		region = nullptr;
+		acquired = 0;
+		status = NiFpga_AcquireFifoReadElementsU64(m_session, dmaNum, &region,
+				elements - view.firstSize, timeoutFifo, &acquired, nullptr);
+		if (NiFpga_IsError(status)) {
+			// Do not leave the first region acquired forever
+			NiFpga_ReleaseFifoElements(m_session, dmaNum, view.firstSize);
+			if (status == NiFpga_Status_FifoTimeout) {
+				m_metrics.add(MetricsOperation::Timeout);
+				throw errors::DMAReadTimeout(m_nameTermDMA, dmaNum);
+			}
+			utils::throwIfNotSuccessNiFpga(status,
+					"Error acquiring " + m_nameTermDMA + std::to_string(n),
+					m_metrics);
+		}
+		view.second = region;
+		view.secondSize = acquired;
+	}
+
+	m_metrics.add(MetricsOperation::DMAElementsRead,
+			view.firstSize + view.secondSize);
+	return view;
+}
+
+void TerminalsDMACommonImpl::releaseDataImpl(const std::uint32_t n,
+		size_t elements) const {
+	const auto dmaNum = utils::getAddressEnumResource(m_mapDMA, n,
+			m_nameTermDMA);
+
+	const auto status = NiFpga_ReleaseFifoElements(m_session, dmaNum,
+			elements);
+	utils::throwIfNotSuccessNiFpga(status,
+			"Error releasing " + m_nameTermDMA + std::to_string(n), m_metrics);
+}
+
 std::unordered_map<std::uint32_t, const std::uint32_t>
 TerminalsDMACommonImpl::getDMAMap() const {
 	return m_mapDMA;
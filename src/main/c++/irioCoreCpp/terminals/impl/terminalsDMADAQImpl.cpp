@@ -1,6 +1,8 @@
 #include <terminals/impl/terminalsDMADAQImpl.h>
 #include <utils.h>
 #include <errorsIrio.h>
+#include <algorithm>
+#include <cmath>
 
 namespace irio {
 
@@ -35,16 +37,24 @@ TerminalsDMADAQImpl::TerminalsDMADAQImpl(ParserManager *parserManager,
 	}
 
 	// Find SamplingRate
-	for(uint32_t i = 0; i < platform.maxDMA; ++i) {
-		parserManager->findRegisterEnumAddress(nameTermSamplingRate, i,
-				GroupResource::DAQ, &m_samplingRate_addr, true);
-	}
+	parserManager->enumerateRegisterAddresses(nameTermSamplingRate,
+			platform.maxDMA, GroupResource::DAQ, &m_samplingRate_addr);
 
 	parserManager->compareResourcesMap(m_samplingRate_addr,
 									   nameTermSamplingRate, getDMAMap(),
 									   nameTermDMA, GroupResource::DAQ);
 }
 
+TerminalsDMADAQImpl::TerminalsDMADAQImpl(
+		const std::vector<std::uint16_t> &nCh,
+		const std::vector<FrameType> &frameType,
+		const std::vector<std::uint8_t> &sampleSize,
+		const std::vector<std::uint16_t> &lengthBlocks,
+		const std::string &nameTermDMA) :
+		TerminalsDMACommonImpl(nCh, frameType, sampleSize, nameTermDMA),
+		m_lengthBlocks(lengthBlocks) {
+}
+
 std::uint16_t TerminalsDMADAQImpl::getLengthBlock(
 		const std::uint32_t &n) const {
 	if (n >= m_lengthBlocks.size()) {
@@ -55,15 +65,28 @@ std::uint16_t TerminalsDMADAQImpl::getLengthBlock(
 	return m_lengthBlocks.at(n);
 }
 
+std::vector<std::uint16_t> TerminalsDMADAQImpl::getAllLengthBlocks() const {
+	return m_lengthBlocks;
+}
+
+size_t TerminalsDMADAQImpl::getElementsPerBlock(const std::uint32_t &n) const {
+	const size_t lengthBlock = getLengthBlock(n);
+	// FormatB blocks: header word, timestamp word, then the samples
+	return getFrameTypeImpl(n) == FrameType::FormatB ?
+			lengthBlock + 2 : lengthBlock;
+}
+
 std::uint16_t TerminalsDMADAQImpl::getSamplingRateDecimation(
 		const std::uint32_t &n) const {
 	const auto addr = utils::getAddressEnumResource(m_samplingRate_addr, n,
 			m_nameTermSamplingRate);
 
 	std::uint16_t value;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status = NiFpga_ReadU16(m_session, addr, &value);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + m_nameTermSamplingRate + std::to_string(n));
+			"Error reading " + m_nameTermSamplingRate + std::to_string(n),
+			m_metrics);
 
 	return value;
 }
@@ -73,8 +96,38 @@ void TerminalsDMADAQImpl::setSamplingRateDecimation(const std::uint32_t &n,
 	const auto addr = utils::getAddressEnumResource(m_samplingRate_addr, n,
 			m_nameTermSamplingRate);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	const auto status = NiFpga_WriteU16(m_session, addr, decimation);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error writing " + m_nameTermSamplingRate + std::to_string(n));
+			"Error writing " + m_nameTermSamplingRate + std::to_string(n),
+			m_metrics);
+}
+
+size_t TerminalsDMADAQImpl::setHostDepthAuto(const std::uint32_t &n,
+		const std::uint32_t &fref, const std::uint32_t &bufferingTimeMs) const {
+	const size_t lengthBlock = getLengthBlock(n);
+	const size_t nCh = getNChImpl(n);
+	const size_t sampleSize = getSampleSizeImpl(n);
+	const size_t wordsBlock = getElementsPerBlock(n);
+	std::uint16_t decimation = getSamplingRateDecimation(n);
+	if (decimation == 0) {
+		decimation = 1;
+	}
+
+	// Payload words produced per second by the DMA group
+	const double samplingRate = static_cast<double>(fref) / decimation;
+	const double wordsPerSecond = samplingRate * nCh * sampleSize
+			/ sizeof(std::uint64_t);
+	const double words = wordsPerSecond * bufferingTimeMs / 1000.0;
+
+	size_t blocks = 1;
+	if (lengthBlock != 0) {
+		blocks = static_cast<size_t>(std::ceil(words / lengthBlock));
+		blocks = std::max<size_t>(blocks, 1);
+	}
+	const size_t depth = blocks * wordsBlock;
+
+	setHostDepthImpl(n, depth);
+	return depth;
 }
 }  // namespace irio
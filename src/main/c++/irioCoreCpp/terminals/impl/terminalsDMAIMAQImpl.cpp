@@ -7,9 +7,6 @@
 
 namespace irio {
 
-static const unsigned int SLEEP_INTERVAL_NS = 1000000;  // 1 ms
-static const timespec sleepTs { 0, SLEEP_INTERVAL_NS };
-
 TerminalsDMAIMAQImpl::TerminalsDMAIMAQImpl(
 	ParserManager* parserManager, const NiFpga_Session& session,
 	const Platform& platform, const std::string& nameTermNCh,
@@ -74,39 +71,55 @@ void TerminalsDMAIMAQImpl::configCameraLinkImpl(
 	const bool controlEnable, const bool linescan,
 	const CLSignalMapping& signalMapping, const CLMode& mode) const {
     NiFpga_Status status;
+    m_metrics.add(MetricsOperation::RegisterWrite);
     status = NiFpga_WriteBool(m_session, m_fvalHigh_addr, fvalHigh);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_FVALHIGH));
+		status, "Error configuring " + std::string(TERMINAL_FVALHIGH),
+		m_metrics);
 
+    m_metrics.add(MetricsOperation::RegisterWrite);
     status = NiFpga_WriteBool(m_session, m_lvalHigh_addr, lvalHigh);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_LVALHIGH));
+		status, "Error configuring " + std::string(TERMINAL_LVALHIGH),
+		m_metrics);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteBool(m_session, m_dvalHigh_addr, dvalHigh);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_DVALHIGH));
+		status, "Error configuring " + std::string(TERMINAL_DVALHIGH),
+		m_metrics);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteBool(m_session, m_spareHigh_addr, spareHigh);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_SPAREHIGH));
+		status, "Error configuring " + std::string(TERMINAL_SPAREHIGH),
+		m_metrics);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteBool(m_session, m_controlEnable_addr, controlEnable);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_CONTROLENABLE));
+		status, "Error configuring " + std::string(TERMINAL_CONTROLENABLE),
+		m_metrics);
 
     const auto signalMappingAux = static_cast<std::uint8_t>(signalMapping);
+    m_metrics.add(MetricsOperation::RegisterWrite);
     status = NiFpga_WriteU8(m_session, m_signalMapping_addr, signalMappingAux);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_SIGNALMAPPING));
+		status, "Error configuring " + std::string(TERMINAL_SIGNALMAPPING),
+		m_metrics);
 
 	const auto modeAux = static_cast<std::uint8_t>(mode);
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteU8(m_session, m_configuration_addr, modeAux);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_CONFIGURATION));
+		status, "Error configuring " + std::string(TERMINAL_CONFIGURATION),
+		m_metrics);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteBool(m_session, m_lineScan_addr, linescan);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error configuring " + std::string(TERMINAL_LINESCAN));
+		status, "Error configuring " + std::string(TERMINAL_LINESCAN),
+		m_metrics);
 }
 
 size_t TerminalsDMAIMAQImpl::readImageNonBlockingImpl(
@@ -134,92 +147,107 @@ size_t TerminalsDMAIMAQImpl::readImageImpl(const std::uint32_t n,
 }
 
 void TerminalsDMAIMAQImpl::sendUARTMsgImpl(const std::vector<std::uint8_t>& msg,
-										   const std::uint32_t timeout) const {
+										   const std::uint32_t timeout,
+										   const WaitPolicy& policy) const {
 	NiFpga_Status status;
 	for (const std::uint8_t& c : msg) {
 		NiFpga_Bool txReady = 0;
-		std::uint32_t countTimeout = 0;
+		PollWaiter waiter(policy, timeout);
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadBool(m_session, m_txReady_addr, &txReady);
 		utils::throwIfNotSuccessNiFpga(
-			status, "Error waiting for " + std::string(TERMINAL_UARTTXREADY));
-		while (!txReady && (timeout == 0 || countTimeout < timeout)) {
-			nanosleep(&sleepTs, nullptr);
-			countTimeout++;
+			status, "Error waiting for " + std::string(TERMINAL_UARTTXREADY),
+			m_metrics);
+		while (!txReady) {
+			if (!waiter.wait()) {
+				m_metrics.add(MetricsOperation::Timeout);
+				throw errors::CLUARTTimeout();
+			}
+			m_metrics.add(MetricsOperation::RegisterRead);
 			status = NiFpga_ReadBool(m_session, m_txReady_addr, &txReady);
 			utils::throwIfNotSuccessNiFpga(
 				status,
-				"Error waiting for " + std::string(TERMINAL_UARTTXREADY));
-		}
-
-		if (timeout != 0 && countTimeout >= timeout) {
-			throw errors::CLUARTTimeout();
+				"Error waiting for " + std::string(TERMINAL_UARTTXREADY),
+				m_metrics);
 		}
 
+		m_metrics.add(MetricsOperation::RegisterWrite);
 		status = NiFpga_WriteU8(m_session, m_txByte_addr, c);
 		utils::throwIfNotSuccessNiFpga(status,
-									   "Error writting CL UART message");
+									   "Error writting CL UART message",
+									   m_metrics);
 
+		m_metrics.add(MetricsOperation::RegisterWrite);
 		status = NiFpga_WriteBool(m_session, m_transmit_addr, 1);
 		utils::throwIfNotSuccessNiFpga(status,
-									   "Error transmitting CL UART message");
+									   "Error transmitting CL UART message",
+									   m_metrics);
 	}
 }
 
 std::vector<std::uint8_t> TerminalsDMAIMAQImpl::recvUARTMsgImpl(
-	const size_t bytesToRecv, const std::uint32_t timeout) const {
+	const size_t bytesToRecv, const std::uint32_t timeout,
+	const WaitPolicy& policy) const {
 	NiFpga_Status status;
 	std::vector<std::uint8_t> recvMsg;
 	NiFpga_Bool rxReady = 1;
-	std::uint32_t countTimeout = 0;
 
 	recvMsg.reserve(bytesToRecv);
 
 	size_t bytesRead = 0;
 	while(rxReady && (bytesToRecv == 0 || bytesRead < bytesToRecv)) {
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadBool(m_session, m_rxReady_addr, &rxReady);
 		utils::throwIfNotSuccessNiFpga(
-			status, "Error waiting for " + std::string(TERMINAL_UARTRXREADY));
+			status, "Error waiting for " + std::string(TERMINAL_UARTRXREADY),
+			m_metrics);
 
-		countTimeout = 0;
-		while (!rxReady && (timeout == 0 || countTimeout < timeout)) {
-			nanosleep(&sleepTs, nullptr);
-			countTimeout++;
+		PollWaiter rxWaiter(policy, timeout);
+		while (!rxReady && rxWaiter.wait()) {
+			m_metrics.add(MetricsOperation::RegisterRead);
 			status = NiFpga_ReadBool(m_session, m_rxReady_addr, &rxReady);
 			utils::throwIfNotSuccessNiFpga(
 				status,
-				"Error waiting for " + std::string(TERMINAL_UARTRXREADY));
+				"Error waiting for " + std::string(TERMINAL_UARTRXREADY),
+				m_metrics);
 		}
 
-		if (timeout != 0 && countTimeout >= timeout) {
+		if (!rxReady) {
 			// This means message has been received, return it
 			continue;
 		}
 
+		m_metrics.add(MetricsOperation::RegisterWrite);
 		status = NiFpga_WriteBool(m_session, m_receive_addr, NiFpga_True);
 		utils::throwIfNotSuccessNiFpga(status,
-									   "Error enabling receiving UART data");
+									   "Error enabling receiving UART data",
+									   m_metrics);
 
 		NiFpga_Bool isDataPending;  // 0 means data is ready
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadBool(m_session, m_receive_addr, &isDataPending);
 		utils::throwIfNotSuccessNiFpga(
-			status, "Error reading " + std::string(TERMINAL_UARTRECEIVE));
-
-		countTimeout = 0;
-		while(isDataPending && (timeout == 0 || countTimeout < timeout)) {
-			nanosleep(&sleepTs, nullptr);
-			countTimeout++;
+			status, "Error reading " + std::string(TERMINAL_UARTRECEIVE),
+			m_metrics);
+
+		PollWaiter dataWaiter(policy, timeout);
+		while (isDataPending) {
+			if (!dataWaiter.wait()) {
+				m_metrics.add(MetricsOperation::Timeout);
+				throw errors::CLUARTTimeout();
+			}
+			m_metrics.add(MetricsOperation::RegisterRead);
 			status = NiFpga_ReadBool(m_session, m_receive_addr, &isDataPending);
 			utils::throwIfNotSuccessNiFpga(
-				status, "Error reading " + std::string(TERMINAL_UARTRECEIVE));
-		}
-
-		if (timeout != 0 && countTimeout >= timeout) {
-			throw errors::CLUARTTimeout();
+				status, "Error reading " + std::string(TERMINAL_UARTRECEIVE),
+				m_metrics);
 		}
 
 		std::uint8_t charAux;
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadU8(m_session, m_rxByte_addr, &charAux);
-		utils::throwIfNotSuccessNiFpga(status, "Error receiving UART data");
+		utils::throwIfNotSuccessNiFpga(status, "Error receiving UART data",
+				m_metrics);
 		recvMsg.push_back(charAux);
 		bytesRead++;
 	}
@@ -228,41 +256,48 @@ std::vector<std::uint8_t> TerminalsDMAIMAQImpl::recvUARTMsgImpl(
 }
 
 void TerminalsDMAIMAQImpl::setUARTBaudRateImpl(
-	const UARTBaudRates& baudRate, const std::uint32_t timeout) const {
+	const UARTBaudRates& baudRate, const std::uint32_t timeout,
+	const WaitPolicy& policy) const {
 	NiFpga_Status status;
 
 	// Wait for SetBaudRate = false
-	waitForSetBaudRateFalse(timeout);
+	waitForSetBaudRateFalse(timeout, policy);
 
 	// Set Baud Rate
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteU8(m_session, m_baudRate_addr,
 							static_cast<std::uint8_t>(baudRate));
-	utils::throwIfNotSuccessNiFpga(status, "Error writing baud rate");
+	utils::throwIfNotSuccessNiFpga(status, "Error writing baud rate",
+			m_metrics);
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	status = NiFpga_WriteBool(m_session, m_setBaudRate_addr, 1);
-	utils::throwIfNotSuccessNiFpga(status, "Error setting baud rate");
+	utils::throwIfNotSuccessNiFpga(status, "Error setting baud rate",
+			m_metrics);
 
 	// Wait for SetBaudRate = false to confirm is configured
-	waitForSetBaudRateFalse(timeout);
+	waitForSetBaudRateFalse(timeout, policy);
 }
 
 void TerminalsDMAIMAQImpl::waitForSetBaudRateFalse(
-	const uint32_t timeout) const {
+	const uint32_t timeout, const WaitPolicy& policy) const {
 	NiFpga_Status status;
 	NiFpga_Bool setBR;
-	std::uint32_t countTimeout = 0;
+	PollWaiter waiter(policy, timeout);
+	m_metrics.add(MetricsOperation::RegisterRead);
 	status = NiFpga_ReadBool(m_session, m_setBaudRate_addr, &setBR);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error reading " + std::string(TERMINAL_UARTSETBAUDRATE));
-	while (setBR && (timeout == 0 || countTimeout < timeout)) {
-		nanosleep(&sleepTs, nullptr);
-		countTimeout++;
+		status, "Error reading " + std::string(TERMINAL_UARTSETBAUDRATE),
+		m_metrics);
+	while (setBR) {
+		if (!waiter.wait()) {
+			m_metrics.add(MetricsOperation::Timeout);
+			throw errors::CLUARTTimeout();
+		}
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadBool(m_session, m_setBaudRate_addr, &setBR);
 		utils::throwIfNotSuccessNiFpga(
-			status, "Error reading " + std::string(TERMINAL_UARTSETBAUDRATE));
-	}
-
-	if (timeout != 0 && countTimeout >= timeout) {
-		throw errors::CLUARTTimeout();
+			status, "Error reading " + std::string(TERMINAL_UARTSETBAUDRATE),
+			m_metrics);
 	}
 }
 
@@ -275,8 +310,10 @@ UARTBaudRates TerminalsDMAIMAQImpl::getUARTBaudRateImpl() const {
 	};
 
 	std::uint8_t brAux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU8(m_session, m_baudRate_addr, &brAux);
-	utils::throwIfNotSuccessNiFpga(status, "Error getting baud rate");
+	utils::throwIfNotSuccessNiFpga(status, "Error getting baud rate",
+			m_metrics);
 
 	const auto it = conversionMap.find(brAux);
 	if(it == conversionMap.end()) {
@@ -288,28 +325,34 @@ UARTBaudRates TerminalsDMAIMAQImpl::getUARTBaudRateImpl() const {
 
 std::uint16_t TerminalsDMAIMAQImpl::getUARTBreakIndicatorImpl() const {
     std::uint16_t breakIndicator;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status =
 		NiFpga_ReadU16(m_session, m_breakIndicator_addr, &breakIndicator);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error reading " + std::string(TERMINAL_UARTBREAKINDICATOR));
+		status, "Error reading " + std::string(TERMINAL_UARTBREAKINDICATOR),
+		m_metrics);
 	return breakIndicator;
 }
 
 std::uint16_t TerminalsDMAIMAQImpl::getUARTFramingErrorImpl() const {
 	std::uint16_t framingError;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status =
 		NiFpga_ReadU16(m_session, m_framingError_addr, &framingError);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error reading " + std::string(TERMINAL_UARTFRAMINGERROR));
+		status, "Error reading " + std::string(TERMINAL_UARTFRAMINGERROR),
+		m_metrics);
 	return framingError;
 }
 
 std::uint16_t TerminalsDMAIMAQImpl::getUARTOverrunErrorImpl() const {
     std::uint16_t overrunError;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	const auto status =
 		NiFpga_ReadU16(m_session, m_overrunError_addr, &overrunError);
 	utils::throwIfNotSuccessNiFpga(
-		status, "Error reading " + std::string(TERMINAL_UARTOVERRUNERROR));
+		status, "Error reading " + std::string(TERMINAL_UARTOVERRUNERROR),
+		m_metrics);
 	return overrunError;
 }
 
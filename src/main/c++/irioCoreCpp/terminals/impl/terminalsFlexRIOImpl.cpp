@@ -5,7 +5,7 @@
 namespace irio {
 TerminalsFlexRIOImpl::TerminalsFlexRIOImpl(ParserManager *parserManager,
 		const NiFpga_Session &session) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::FlexRIO) {
 	parserManager->findRegisterAddress(TERMINAL_RIOADAPTERCORRECT,
 			GroupResource::FlexRIO, &m_rioadaptercorrect_addr, false);
 	parserManager->findRegisterAddress(TERMINAL_INSERTEDIOMODULEID,
@@ -14,17 +14,21 @@ TerminalsFlexRIOImpl::TerminalsFlexRIOImpl(ParserManager *parserManager,
 
 bool TerminalsFlexRIOImpl::getRIOAdapterCorrect() const {
 	NiFpga_Bool aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadBool(m_session, m_rioadaptercorrect_addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + std::string(TERMINAL_RIOADAPTERCORRECT));
+			"Error reading " + std::string(TERMINAL_RIOADAPTERCORRECT),
+			m_metrics);
 	return static_cast<bool>(aux);
 }
 
 std::uint32_t TerminalsFlexRIOImpl::getInsertedIOModuleID() const {
 	std::uint32_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU32(m_session, m_insertediomoduleid_addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + std::string(TERMINAL_INSERTEDIOMODULEID));
+			"Error reading " + std::string(TERMINAL_INSERTEDIOMODULEID),
+			m_metrics);
 	return aux;
 }
 }  // namespace irio
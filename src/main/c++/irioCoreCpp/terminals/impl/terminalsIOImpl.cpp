@@ -7,23 +7,22 @@ namespace irio {
 TerminalsIOImpl::TerminalsIOImpl(ParserManager* parserManager,
 								 const NiFpga_Session& session,
 								 const Platform& platform)
-	: TerminalsBaseImpl(session) {
+	: TerminalsBaseImpl(session, MetricsTerminal::IO) {
 	// Find IO Sampling Rate
-	for (uint32_t i = 0; i < platform.maxModules; ++i) {
-		parserManager->findRegisterEnumAddress(TERMINAL_SAMPLINGRATE, i,
-											   GroupResource::IO,
-											   &m_mapSamplingRate, true);
-	}
+	parserManager->enumerateRegisterAddresses(TERMINAL_SAMPLINGRATE,
+			platform.maxModules, GroupResource::IO, &m_mapSamplingRate);
 }
 
 void TerminalsIOImpl::setSamplingRateDecimationImpl(
 	const std::uint32_t& n, const std::uint16_t dec) const {
 	auto addr = utils::getAddressEnumResource(m_mapSamplingRate, n,
 											  TERMINAL_SAMPLINGRATE);
+    m_metrics.add(MetricsOperation::RegisterWrite);
     auto status = NiFpga_WriteU16(m_session, addr, dec);
 	utils::throwIfNotSuccessNiFpga(
 		status, "Error writing terminal " +
-					std::string(TERMINAL_SAMPLINGRATE) + std::to_string(n));
+					std::string(TERMINAL_SAMPLINGRATE) + std::to_string(n),
+					m_metrics);
 }
 
 std::uint16_t TerminalsIOImpl::getSamplingRateDecimationImpl(
@@ -31,10 +30,12 @@ std::uint16_t TerminalsIOImpl::getSamplingRateDecimationImpl(
 	auto addr = utils::getAddressEnumResource(m_mapSamplingRate, n,
 											  TERMINAL_SAMPLINGRATE);
     std::uint16_t dec;
+    m_metrics.add(MetricsOperation::RegisterRead);
     auto status = NiFpga_ReadU16(m_session, addr, &dec);
     utils::throwIfNotSuccessNiFpga(
 		status, "Error reading terminal " +
-					std::string(TERMINAL_SAMPLINGRATE) + std::to_string(n));
+					std::string(TERMINAL_SAMPLINGRATE) + std::to_string(n),
+					m_metrics);
     return dec;
 }
 
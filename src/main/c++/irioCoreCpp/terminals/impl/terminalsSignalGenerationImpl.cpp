@@ -9,7 +9,7 @@ TerminalsSignalGenerationImpl::TerminalsSignalGenerationImpl(
 		ParserManager *parserManager,
 		const NiFpga_Session &session,
 		const Platform &platform) :
-		TerminalsBaseImpl(session) {
+		TerminalsBaseImpl(session, MetricsTerminal::SignalGeneration) {
 	NiFpga_Status status;
 
 	std::uint32_t addrSGNO;
@@ -18,9 +18,10 @@ TerminalsSignalGenerationImpl::TerminalsSignalGenerationImpl(
 		// There are no signal generators, go back
 		return;
 	}
+	m_metrics.add(MetricsOperation::RegisterRead);
 	status = NiFpga_ReadU8(m_session, addrSGNO, &m_numSG);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading " + std::string(TERMINAL_SGNO));
+			"Error reading " + std::string(TERMINAL_SGNO), m_metrics);
 
 	std::unordered_map<std::uint32_t, const std::uint32_t> mapFrefAux;
 	std::unordered_map<std::string,
@@ -60,10 +61,11 @@ TerminalsSignalGenerationImpl::TerminalsSignalGenerationImpl(
 
 	for (const auto pair : mapFrefAux) {
 		std::uint32_t aux;
+		m_metrics.add(MetricsOperation::RegisterRead);
 		status = NiFpga_ReadU32(m_session, pair.second, &aux);
 		utils::throwIfNotSuccessNiFpga(status,
 				"Error reading " + std::string(TERMINAL_SGFREF)
-				+ std::to_string(pair.first));
+				+ std::to_string(pair.first), m_metrics);
 
 		m_mapFref.insert({pair.first, aux});
 	}
@@ -98,47 +100,53 @@ std::uint8_t TerminalsSignalGenerationImpl::getSGSignalTypeImpl(
 			n, TERMINAL_SGSIGNALTYPE);
 
 	std::uint8_t aux;
+	m_metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU8(m_session, addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal "
-			+ std::string(TERMINAL_SGSIGNALTYPE) + std::to_string(n));
+			+ std::string(TERMINAL_SGSIGNALTYPE) + std::to_string(n),
+			m_metrics);
 
 	return aux;
 }
 
 std::uint32_t getValue(
 		const NiFpga_Session &session,
+		const MetricsCounters &metrics,
 		const std::uint32_t n,
 		const std::unordered_map<std::uint32_t, const std::uint32_t> &mapTerminals,
 		const std::string &terminalName) {
 	auto addr = utils::getAddressEnumResource(mapTerminals, n, terminalName);
 
 	std::uint32_t aux;
+	metrics.add(MetricsOperation::RegisterRead);
 	auto status = NiFpga_ReadU32(session, addr, &aux);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading terminal " + terminalName + std::to_string(n));
+			"Error reading terminal " + terminalName + std::to_string(n),
+			metrics);
 
 	return aux;
 }
 
 std::uint32_t TerminalsSignalGenerationImpl::getSGAmpImpl(
 		const std::uint32_t n) const {
-	return getValue(m_session, n, m_mapAmp_addr, TERMINAL_SGAMP);
+	return getValue(m_session, m_metrics, n, m_mapAmp_addr, TERMINAL_SGAMP);
 }
 
 std::uint32_t TerminalsSignalGenerationImpl::getSGFreqImpl(
 		const std::uint32_t n) const {
-	return getValue(m_session, n, m_mapFreq_addr, TERMINAL_SGFREQ);
+	return getValue(m_session, m_metrics, n, m_mapFreq_addr, TERMINAL_SGFREQ);
 }
 
 std::uint32_t TerminalsSignalGenerationImpl::getSGPhaseImpl(
 		const std::uint32_t n) const {
-	return getValue(m_session, n, m_mapPhase_addr, TERMINAL_SGPHASE);
+	return getValue(m_session, m_metrics, n, m_mapPhase_addr, TERMINAL_SGPHASE);
 }
 
 std::uint32_t TerminalsSignalGenerationImpl::getSGUpdateRateImpl(
 		const std::uint32_t n) const {
-	return getValue(m_session, n, m_mapUpdateRate_addr, TERMINAL_SGUPDATERATE);
+	return getValue(m_session, m_metrics,
+			n, m_mapUpdateRate_addr, TERMINAL_SGUPDATERATE);
 }
 
 void TerminalsSignalGenerationImpl::setSGSignalTypeImpl(
@@ -147,43 +155,49 @@ void TerminalsSignalGenerationImpl::setSGSignalTypeImpl(
 	const auto addr = utils::getAddressEnumResource(
 			m_mapSignalType_addr, n, TERMINAL_SGSIGNALTYPE);
 
+	m_metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteU8(m_session, addr, value);
 	utils::throwIfNotSuccessNiFpga(status,
 			"Error reading terminal "
-			+ std::string(TERMINAL_SGSIGNALTYPE) + std::to_string(n));
+			+ std::string(TERMINAL_SGSIGNALTYPE) + std::to_string(n),
+			m_metrics);
 }
 
 void setValue(
 		const NiFpga_Session &session,
+		const MetricsCounters &metrics,
 		const std::uint32_t n,
 		const std::uint32_t value,
 		const std::unordered_map<std::uint32_t, const std::uint32_t> &mapTerminals,
 		const std::string &terminalName) {
 	const auto addr = utils::getAddressEnumResource(mapTerminals, n, terminalName);
 
+	metrics.add(MetricsOperation::RegisterWrite);
 	auto status = NiFpga_WriteU32(session, addr, value);
 	utils::throwIfNotSuccessNiFpga(status,
-			"Error reading terminal " + terminalName + std::to_string(n));
+			"Error reading terminal " + terminalName + std::to_string(n),
+			metrics);
 }
 
 void TerminalsSignalGenerationImpl::setSGAmpImpl(
 		const std::uint32_t n, const std::uint32_t value) const {
-	setValue(m_session, n, value, m_mapAmp_addr, TERMINAL_SGAMP);
+	setValue(m_session, m_metrics, n, value, m_mapAmp_addr, TERMINAL_SGAMP);
 }
 
 void TerminalsSignalGenerationImpl::setSGFreqDecimationImpl(
 		const std::uint32_t n, const std::uint32_t value) const {
-	setValue(m_session, n, value, m_mapFreq_addr, TERMINAL_SGFREQ);
+	setValue(m_session, m_metrics, n, value, m_mapFreq_addr, TERMINAL_SGFREQ);
 }
 
 void TerminalsSignalGenerationImpl::setSGPhaseImpl(
 		const std::uint32_t n, const std::uint32_t value) const {
-	setValue(m_session, n, value, m_mapPhase_addr, TERMINAL_SGPHASE);
+	setValue(m_session, m_metrics, n, value, m_mapPhase_addr, TERMINAL_SGPHASE);
 }
 
 void TerminalsSignalGenerationImpl::setSGUpdateRateDecimationImpl(
 		const std::uint32_t n,
 		const std::uint32_t value) const {
-	setValue(m_session, n, value, m_mapUpdateRate_addr, TERMINAL_SGUPDATERATE);
+	setValue(m_session, m_metrics,
+			n, value, m_mapUpdateRate_addr, TERMINAL_SGUPDATERATE);
 }
 }  // namespace irio
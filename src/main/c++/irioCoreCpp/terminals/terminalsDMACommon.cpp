@@ -16,12 +16,68 @@ std::uint16_t TerminalsDMACommon::getNCh(const std::uint32_t n) const {
 			->getNChImpl(n);
 }
 
-void TerminalsDMACommon::startDMA(const std::uint32_t n) const {
-	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->startDMAImpl(n);
+std::vector<std::uint16_t> TerminalsDMACommon::getAllNCh() const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getAllNChImpl();
+}
+
+size_t TerminalsDMACommon::startDMA(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->startDMAImpl(n);
+}
+
+size_t TerminalsDMACommon::startAllDMAs() const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->startAllDMAsImpl();
+}
+
+void TerminalsDMACommon::setHostDepth(const std::uint32_t n,
+									  const size_t depth) const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->setHostDepthImpl(n, depth);
+}
+
+size_t TerminalsDMACommon::getHostDepth(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getHostDepthImpl(n);
+}
+
+void TerminalsDMACommon::setWaitPolicy(const WaitPolicy &policy) const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->setWaitPolicyImpl(policy);
 }
 
-void TerminalsDMACommon::startAllDMAs() const {
-	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->startAllDMAsImpl();
+WaitPolicy TerminalsDMACommon::getWaitPolicy() const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getWaitPolicyImpl();
+}
+
+void TerminalsDMACommon::setReadStatsEnabled(const bool enable) const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->setReadStatsEnabledImpl(enable);
+}
+
+bool TerminalsDMACommon::isReadStatsEnabled() const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->isReadStatsEnabledImpl();
+}
+
+DMAReadStats TerminalsDMACommon::getReadStats(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getReadStatsImpl(n);
+}
+
+void TerminalsDMACommon::resetReadStats(const std::uint32_t n) const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->resetReadStatsImpl(n);
+}
+
+void TerminalsDMACommon::resetAllReadStats() const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->resetAllReadStatsImpl();
+}
+
+size_t TerminalsDMACommon::getEffectiveHostDepth(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getEffectiveHostDepthImpl(n);
 }
 
 void TerminalsDMACommon::stopDMA(const std::uint32_t n) const {
@@ -37,12 +93,12 @@ size_t TerminalsDMACommon::countDMAs() const {
 			->countDMAsImpl();
 }
 
-void TerminalsDMACommon::cleanDMA(const std::uint32_t n) const {
-	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->cleanDMAImpl(n);
+size_t TerminalsDMACommon::cleanDMA(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->cleanDMAImpl(n);
 }
 
-void TerminalsDMACommon::cleanAllDMAs() const {
-	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->cleanAllDMAsImpl();
+size_t TerminalsDMACommon::cleanAllDMAs() const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)->cleanAllDMAsImpl();
 }
 
 bool TerminalsDMACommon::isDMAEnable(const std::uint32_t n) const {
@@ -108,6 +164,15 @@ size_t TerminalsDMACommon::readDataBlocking(const std::uint32_t n,
 			->readDataBlockingImpl(n, elementsToRead, data, timeout);
 }
 
+size_t TerminalsDMACommon::readDataBlocking(const std::uint32_t n,
+											const size_t elementsToRead,
+											std::uint64_t *data,
+											const std::uint32_t timeout,
+											const WaitPolicy &policy) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->readDataBlockingImpl(n, elementsToRead, data, timeout, policy);
+}
+
 size_t TerminalsDMACommon::readData(const std::uint32_t n,
 									const size_t elementsToRead,
 									std::uint64_t *data, const bool blockRead,
@@ -116,4 +181,40 @@ size_t TerminalsDMACommon::readData(const std::uint32_t n,
 			->readDataImpl(n, elementsToRead, data, blockRead, timeout);
 }
 
+size_t TerminalsDMACommon::readDataMulti(
+		const std::vector<DMAReadRequest> &requests,
+		std::vector<DMAReadResult> *results, const bool blockRead,
+		const std::uint32_t timeout) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->readDataMultiImpl(requests, results, blockRead, timeout);
+}
+
+size_t TerminalsDMACommon::getElementsAvailable(const std::uint32_t n) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->getElementsAvailableImpl(n);
+}
+
+size_t TerminalsDMACommon::readAvailable(const std::uint32_t n,
+										 const size_t maxElements,
+										 std::uint64_t *data,
+										 const size_t minElements,
+										 size_t *elementsRemaining) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->readAvailableImpl(n, maxElements, data, minElements,
+								elementsRemaining);
+}
+
+DMADataView TerminalsDMACommon::acquireData(const std::uint32_t n,
+											const size_t elements,
+											const std::uint32_t timeout) const {
+	return std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->acquireDataImpl(n, elements, timeout);
+}
+
+void TerminalsDMACommon::releaseData(const std::uint32_t n,
+									 const size_t elements) const {
+	std::static_pointer_cast<TerminalsDMACommonImpl>(m_impl)
+			->releaseDataImpl(n, elements);
+}
+
 }  // namespace irio
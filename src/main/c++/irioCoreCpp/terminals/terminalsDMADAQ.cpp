@@ -14,6 +14,16 @@ std::uint16_t TerminalsDMADAQ::getLengthBlock(const std::uint32_t &n) const {
 			->getLengthBlock(n);
 }
 
+std::vector<std::uint16_t> TerminalsDMADAQ::getAllLengthBlocks() const {
+	return std::static_pointer_cast<TerminalsDMADAQImpl>(m_impl)
+			->getAllLengthBlocks();
+}
+
+size_t TerminalsDMADAQ::getElementsPerBlock(const std::uint32_t &n) const {
+	return std::static_pointer_cast<TerminalsDMADAQImpl>(m_impl)
+			->getElementsPerBlock(n);
+}
+
 std::uint16_t TerminalsDMADAQ::getSamplingRateDecimation(
 		const std::uint32_t &n) const {
 	return std::static_pointer_cast<TerminalsDMADAQImpl>(m_impl)
@@ -26,4 +36,12 @@ void TerminalsDMADAQ::setSamplingRateDecimation(
 	std::static_pointer_cast<TerminalsDMADAQImpl>(m_impl)
 			->setSamplingRateDecimation(n, decimation);
 }
+
+size_t TerminalsDMADAQ::setHostDepthAuto(
+		const std::uint32_t &n,
+		const std::uint32_t &fref,
+		const std::uint32_t &bufferingTimeMs) const {
+	return std::static_pointer_cast<TerminalsDMADAQImpl>(m_impl)
+			->setHostDepthAuto(n, fref, bufferingTimeMs);
+}
 }  // namespace irio
@@ -43,20 +43,38 @@ size_t TerminalsDMAIMAQ::readImage(const std::uint32_t n,
 
 void TerminalsDMAIMAQ::sendUARTMsg(const std::vector<std::uint8_t> &msg,
 								   const std::uint32_t timeout) const {
+	sendUARTMsg(msg, timeout, getWaitPolicy());
+}
+
+void TerminalsDMAIMAQ::sendUARTMsg(const std::vector<std::uint8_t> &msg,
+								   const std::uint32_t timeout,
+								   const WaitPolicy &policy) const {
 	std::static_pointer_cast<TerminalsDMAIMAQImpl>(m_impl)->sendUARTMsgImpl(
-		msg, timeout);
+		msg, timeout, policy);
 }
 
 std::vector<std::uint8_t> TerminalsDMAIMAQ::recvUARTMsg(
 	const size_t bytesToRecv, const std::uint32_t timeout) const {
+	return recvUARTMsg(bytesToRecv, timeout, getWaitPolicy());
+}
+
+std::vector<std::uint8_t> TerminalsDMAIMAQ::recvUARTMsg(
+	const size_t bytesToRecv, const std::uint32_t timeout,
+	const WaitPolicy &policy) const {
 	return std::static_pointer_cast<TerminalsDMAIMAQImpl>(m_impl)
-		->recvUARTMsgImpl(bytesToRecv, timeout);
+		->recvUARTMsgImpl(bytesToRecv, timeout, policy);
 }
 
 void TerminalsDMAIMAQ::setUARTBaudRate(const UARTBaudRates &baudRate,
 									   const std::uint32_t timeout) const {
+	setUARTBaudRate(baudRate, timeout, getWaitPolicy());
+}
+
+void TerminalsDMAIMAQ::setUARTBaudRate(const UARTBaudRates &baudRate,
+									   const std::uint32_t timeout,
+									   const WaitPolicy &policy) const {
 	std::static_pointer_cast<TerminalsDMAIMAQImpl>(m_impl)->setUARTBaudRateImpl(
-		baudRate, timeout);
+		baudRate, timeout, policy);
 }
 
 UARTBaudRates TerminalsDMAIMAQ::getUARTBaudRate() const {
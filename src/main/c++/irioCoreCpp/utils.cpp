@@ -12,6 +12,17 @@ namespace utils {
 void throwIfNotSuccessNiFpga(const NiFpga_Status &status,
 		const std::string &errMsg) {
 	if (NiFpga_IsError(status)) {
+		MetricsRegistry::countUnattributedError();
+		const std::string err = errMsg + std::string("(Code: ")
+				+ std::to_string(status) + std::string(")");
+		throw irio::errors::NiFpgaError(err);
+	}
+}
+
+void throwIfNotSuccessNiFpga(const NiFpga_Status &status,
+		const std::string &errMsg, const MetricsCounters &metrics) {
+	if (NiFpga_IsError(status)) {
+		metrics.add(MetricsOperation::NiFpgaError);
 		const std::string err = errMsg + std::string("(Code: ")
 				+ std::to_string(status) + std::string(")");
 		throw irio::errors::NiFpgaError(err);
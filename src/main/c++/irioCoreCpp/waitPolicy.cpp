@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "waitPolicy.h"
+
+namespace irio {
+
+namespace {
+
+/**
+ * Hints the CPU that this is a spin loop, so it saves power and does not
+ * starve its sibling hyperthread
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+}  // namespace
+
+WaitPolicy WaitPolicy::fixedSleep(const std::uint32_t sleepUs) {
+	WaitPolicy policy;
+	policy.driverWait = false;
+	policy.minSleepUs = sleepUs;
+	policy.maxSleepUs = sleepUs;
+	return policy;
+}
+
+WaitPolicy WaitPolicy::busySpin() {
+	WaitPolicy policy;
+	policy.driverWait = false;
+	policy.spinUs = std::numeric_limits<std::uint32_t>::max();
+	return policy;
+}
+
+WaitPolicy WaitPolicy::hybrid(const std::uint32_t spinUs,
+		const std::uint32_t yieldUs, const std::uint32_t minSleepUs,
+		const std::uint32_t maxSleepUs) {
+	WaitPolicy policy;
+	policy.driverWait = false;
+	policy.spinUs = spinUs;
+	policy.yieldUs = yieldUs;
+	policy.minSleepUs = minSleepUs;
+	policy.maxSleepUs = maxSleepUs;
+	return policy;
+}
+
+PollWaiter::PollWaiter(const WaitPolicy &policy,
+		const std::uint32_t timeoutMs) :
+		m_policy(policy), m_start(Clock::now()),
+		m_deadline(m_start + std::chrono::milliseconds(timeoutMs)),
+		m_hasDeadline(timeoutMs != 0),
+		m_sleepUs(std::min(policy.minSleepUs, policy.maxSleepUs)) {
+}
+
+bool PollWaiter::wait() {
+	const auto now = Clock::now();
+	if (m_hasDeadline && now >= m_deadline) {
+		return false;
+	}
+
+	const std::uint64_t elapsedUs = static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+					now - m_start).count());
+	if (elapsedUs < m_policy.spinUs) {
+		cpuRelax();
+		return true;
+	}
+	if (elapsedUs < static_cast<std::uint64_t>(m_policy.spinUs)
+			+ m_policy.yieldUs) {
+		std::this_thread::yield();
+		return true;
+	}
+
+	Clock::duration sleep = std::chrono::microseconds(m_sleepUs);
+	if (m_hasDeadline) {
+		sleep = std::min<Clock::duration>(sleep, m_deadline - now);
+	}
+	std::this_thread::sleep_for(sleep);
+
+	m_sleepUs = m_sleepUs > m_policy.maxSleepUs / 2 ? m_policy.maxSleepUs :
+			std::min(m_policy.maxSleepUs,
+					std::max<std::uint32_t>(m_sleepUs * 2, 1));
+	return true;
+}
+
+}  // namespace irio
@@ -0,0 +1,35 @@
+#pragma once
+
+/*
+ * Subset of the NI FlexRIO API implemented by the NiFpga simulator. It
+ * replaces the header of the NI driver when irioCoreCpp is built with
+ * NIFPGA_SIM=true.
+ */
+
+#include <stdint.h>
+
+#include <NiFpga.h>
+
+#define NIFLEXRIO_Attr_InsertedFamID 1
+#define NIFLEXRIO_ValueType_U32 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reads an attribute of the FlexRIO device. The simulator only implements
+ * NIFLEXRIO_Attr_InsertedFamID as NIFLEXRIO_ValueType_U32
+ *
+ * @param session	Handle to a currently open session
+ * @param attribute	Attribute to read
+ * @param valueType	Type of the attribute
+ * @param value		Output with the value
+ * @return Result of the call
+ */
+NiFpga_Status NiFlexRio_GetAttribute(NiFpga_Session session,
+		int32_t attribute, int32_t valueType, void *value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "simDevice.h"
+
+namespace irio {
+
+/**
+ * Software implementation of the NiFpga (and NiFlexRio) C functions used by
+ * irioCoreCpp, so the library runs without RIO hardware or NI drivers.
+ * Build irioCoreCpp with NIFPGA_SIM=true to link it against the simulator.
+ *
+ * Configure the simulated devices before creating the Irio objects:
+ * @code
+ * irio::sim::DeviceConfig config;
+ * config.fifos["DMATtoHOST0"].producer.type = irio::sim::ProducerType::Sine;
+ * config.fifos["DMATtoHOST0"].rate = 50e6;
+ * irio::sim::setDeviceConfig("0", config);
+ * irio::Irio irio(bitfile, "0", "V1.0");
+ * @endcode
+ */
+namespace sim {
+
+/**
+ * Sets the configuration used by the devices opened from now on with the
+ * resource of a serial number. Serial numbers without configuration use
+ * the default one.
+ *
+ * @ingroup NiFpgaSim
+ *
+ * @param serialNumber	Serial number of the simulated device
+ * @param config		Device configuration
+ */
+void setDeviceConfig(const std::string &serialNumber,
+		const DeviceConfig &config);
+
+/**
+ * Removes the configuration of every serial number
+ *
+ * @ingroup NiFpgaSim
+ */
+void resetDeviceConfigs();
+
+/**
+ * Returns the resource name of the simulated device with a serial number.
+ * Every serial number has a device.
+ *
+ * @ingroup NiFpgaSim
+ *
+ * @param serialNumber	Serial number of the simulated device
+ * @return Resource name to pass to NiFpga_Open
+ */
+std::string getResourceName(const std::string &serialNumber);
+
+/**
+ * Returns the device of an open session, to act as the FPGA on it
+ *
+ * @ingroup NiFpgaSim
+ *
+ * @param session Session returned by NiFpga_Open
+ * @return Device of the session, null if the session is not open
+ */
+std::shared_ptr<Device> getDevice(const NiFpga_Session session);
+
+}  // namespace sim
+}  // namespace irio
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <NiFpga.h>
+
+#include "bfp.h"
+#include "platforms.h"
+#include "profilesTypes.h"
+#include "simProducers.h"
+
+namespace irio {
+namespace sim {
+
+/**
+ * Configuration of a simulated target to host FIFO
+ *
+ * @ingroup NiFpgaSim
+ */
+struct FifoConfig {
+	/// Data written by the FPGA
+	ProducerConfig producer;
+	/// Words per second written by the FPGA. 0 keeps the FIFO full
+	double rate = 1e6;
+	/// Derive the rate from Fref and DMATtoHOSTSamplingRate<n> when the
+	/// bitfile has it and it is not 0, as the DAQ profiles do
+	bool followSamplingRate = false;
+	/// IRQ (0-31) asserted while the FIFO has irqThreshold words. -1: none
+	std::int32_t irq = -1;
+	/// Words needed to assert the IRQ
+	size_t irqThreshold = 1;
+};
+
+/**
+ * Configuration of a simulated RIO device.
+ *
+ * Registers start at 0 except the common terminals, which take the values
+ * below, and the DMA description arrays (DMATtoHOSTNCh, SampleSize,
+ * FrameType and BlockNWords), which are derived from the producers.
+ * InitDone rises when the VI runs.
+ *
+ * @ingroup NiFpgaSim
+ */
+struct DeviceConfig {
+	/// Value of Platform
+	PLATFORM_ID platform = PLATFORM_ID::FlexRIO;
+	/// Value of DevProfile
+	std::uint8_t profile = PROFILE_VALUE_DAQ;
+	/// Value of FPGAVIversion, as {major, minor}
+	std::uint8_t fpgaVIversion[2] = {1, 0};
+	/// Value of Fref in Hz
+	std::uint32_t fref = 100000000;
+	/// Module ID reported by NiFlexRio_GetAttribute
+	std::uint32_t moduleID = 0;
+	/// Configuration of the FIFOs by DMA name, e.g. "DMATtoHOST0". FIFOs not
+	/// listed use the default configuration
+	std::unordered_map<std::string, FifoConfig> fifos;
+	/// Initial values by register name, applied last
+	std::unordered_map<std::string, std::vector<std::uint64_t>> registers;
+};
+
+/**
+ * Counters of a simulated FIFO
+ *
+ * @ingroup NiFpgaSim
+ */
+struct FifoStats {
+	std::uint64_t produced = 0;	/**< Words written into the host buffer */
+	std::uint64_t dropped = 0;	/**< Words lost because the buffer was full */
+	std::uint64_t released = 0;	/**< Words read or released by the host */
+	size_t fillLevel = 0;		/**< Words available to the host */
+	bool started = false;		/**< Whether the FIFO is started */
+};
+
+/**
+ * Simulated RIO device running a bitfile.
+ *
+ * The register file is built from the registers of the bitfile, keeping
+ * their addresses and sizes. Each target to host DMA gets a host buffer
+ * that its producer fills lazily: every FIFO operation computes the words
+ * the FPGA would have written since the last one at the configured rate,
+ * generates them into the buffer and drops the ones that do not fit,
+ * raising the DMA bit of DMATtoHOSTOverflows. The FPGA only writes while
+ * the FIFO is started and, if the bitfile has them, DAQStartStop and
+ * DMATtoHOSTEnable<n> are true. No thread is used, the data is generated
+ * by the thread that reads it.
+ *
+ * The NiFpga_* functions of the simulator forward to the methods taking
+ * addresses and FIFO numbers, the methods taking names are meant for
+ * tests and benchmarks acting as the FPGA.
+ *
+ * @ingroup NiFpgaSim
+ */
+class Device {
+ public:
+	/// Host buffer depth of the FIFOs until they are configured
+	static const size_t DEFAULT_DEPTH = 65536;
+
+	/**
+	 * Builds the device for a bitfile
+	 *
+	 * @throw irio::errors::SimulatorConfigError Invalid producer or register
+	 * 											 configuration
+	 *
+	 * @param bfp		Parsed bitfile
+	 * @param config	Device configuration
+	 */
+	Device(const bfp::BFP &bfp, const DeviceConfig &config);
+
+	~Device();
+
+	Device(const Device&) = delete;
+	Device& operator=(const Device&) = delete;
+
+	/**
+	 * Wakes up the threads waiting on the FIFOs and makes any further FIFO
+	 * operation fail
+	 */
+	void close();
+
+	/**
+	 * Starts the VI, raising InitDone
+	 *
+	 * @return NiFpga_Status_FpgaAlreadyRunning if it was running
+	 */
+	NiFpga_Status run();
+
+	/**
+	 * Reads elements of a register as raw 64-bit values
+	 *
+	 * @param address	Register address
+	 * @param values	Output buffer
+	 * @param size		Elements to read
+	 * @return Result of the operation
+	 */
+	NiFpga_Status read(const std::uint32_t address, std::uint64_t *values,
+			const size_t size) const;
+
+	/**
+	 * Writes elements of a control as raw 64-bit values
+	 *
+	 * @param address	Register address
+	 * @param values	Values to write
+	 * @param size		Elements to write
+	 * @return Result of the operation
+	 */
+	NiFpga_Status write(const std::uint32_t address,
+			const std::uint64_t *values, const size_t size);
+
+	NiFpga_Status configureFifo(const std::uint32_t fifo, const size_t depth,
+			size_t *actualDepth);
+
+	NiFpga_Status startFifo(const std::uint32_t fifo);
+
+	NiFpga_Status stopFifo(const std::uint32_t fifo);
+
+	NiFpga_Status readFifo(const std::uint32_t fifo, std::uint64_t *data,
+			const size_t n, const std::uint32_t timeout,
+			size_t *elementsRemaining);
+
+	NiFpga_Status acquireFifo(const std::uint32_t fifo,
+			std::uint64_t **elements, const size_t n,
+			const std::uint32_t timeout, size_t *elementsAcquired,
+			size_t *elementsRemaining);
+
+	NiFpga_Status releaseFifo(const std::uint32_t fifo, const size_t n);
+
+	NiFpga_Status waitOnIrqs(const std::uint32_t irqs,
+			const std::uint32_t timeout, std::uint32_t *irqsAsserted,
+			NiFpga_Bool *timedOut);
+
+	/**
+	 * Returns the module ID reported by NiFlexRio_GetAttribute
+	 *
+	 * @return Module ID
+	 */
+	std::uint32_t getModuleID() const;
+
+	/**
+	 * Sets an element of a register, indicators included, as the FPGA would
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Register or index not found
+	 *
+	 * @param name	Register name
+	 * @param value	Raw value
+	 * @param index	Element of the register
+	 */
+	void setRegister(const std::string &name, const std::uint64_t value,
+			const size_t index = 0);
+
+	/**
+	 * Returns an element of a register as a raw value
+	 *
+	 * @throw irio::errors::ResourceNotFoundError Register or index not found
+	 *
+	 * @param name	Register name
+	 * @param index	Element of the register
+	 * @return Raw value
+	 */
+	std::uint64_t getRegister(const std::string &name,
+			const size_t index = 0) const;
+
+	/**
+	 * Brings a FIFO up to date and returns its counters
+	 *
+	 * @throw irio::errors::ResourceNotFoundError DMA not found
+	 *
+	 * @param dmaName DMA name in the bitfile, e.g. "DMATtoHOST0"
+	 * @return Counters of the FIFO
+	 */
+	FifoStats getFifoStats(const std::string &dmaName);
+
+ private:
+	struct Slot {
+		bfp::ElemTypes type;
+		std::vector<std::uint64_t> values;
+		/// FIFOs whose rate or gates depend on the register
+		std::vector<size_t> fifos;
+	};
+	struct Fifo;
+
+	void initRegisters(const bfp::BFP &bfp, const DeviceConfig &config);
+	void initFifos(const bfp::BFP &bfp, const DeviceConfig &config);
+	void setIfExists(const std::string &name, const std::uint64_t value,
+			const size_t index = 0);
+	Slot *findSlot(const std::string &name, const size_t index);
+	const Slot *findSlot(const std::string &name, const size_t index) const;
+	Fifo *findFifo(const std::uint32_t fifo) const;
+	std::uint64_t readRaw(const std::uint32_t address) const;
+	void updateFifo(Fifo *fifo);
+	double getRate(const Fifo &fifo) const;
+	bool isGateOpen(const Fifo &fifo) const;
+	NiFpga_Status waitElements(Fifo *fifo, std::unique_lock<std::mutex> *lock,
+			const size_t n, const std::uint32_t timeout,
+			const std::chrono::steady_clock::time_point &start);
+	void startLocked(Fifo *fifo);
+	void setOverflow(const Fifo &fifo, const bool overflow);
+
+	const std::uint32_t m_fref;
+	const std::uint32_t m_moduleID;
+	std::atomic<bool> m_running;
+	std::atomic<bool> m_closed;
+
+	/// Protects the register values
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::uint32_t, Slot> m_registers;
+	std::unordered_map<std::string, std::uint32_t> m_addresses;
+	std::uint32_t m_initDoneAddr;
+	bool m_hasInitDone;
+	std::uint32_t m_overflowsAddr;
+	bool m_hasOverflows;
+
+	std::vector<std::unique_ptr<Fifo>> m_fifos;
+	std::unordered_map<std::uint32_t, size_t> m_fifoIndex;
+	std::unordered_map<std::string, size_t> m_fifoNames;
+};
+
+}  // namespace sim
+}  // namespace irio
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace irio {
+namespace sim {
+
+/**
+ * Kind of data generated by a simulated target to host FIFO
+ *
+ * @ingroup NiFpgaSim
+ */
+enum class ProducerType : std::uint8_t {
+	Ramp = 0,	/**< Each channel counts up by step from offset + channel */
+	Sine = 1,	/**< Sine wave, channels shifted by 2*pi/nCh */
+	Noise = 2,	/**< Gaussian noise with amplitude as standard deviation */
+	Frames = 3	/**< Header, timestamp and blockWords words of ramp data */
+};
+
+/**
+ * Configuration of the data generated for a FIFO.
+ *
+ * Samples are channel-interleaved and packed little-endian in the 64-bit
+ * words of the FIFO, as the DAQ profiles do.
+ *
+ * @ingroup NiFpgaSim
+ */
+struct ProducerConfig {
+	/// Kind of data
+	ProducerType type = ProducerType::Ramp;
+	/// Channels interleaved in the stream
+	std::uint16_t nCh = 1;
+	/// Bytes per sample: 1, 2, 4 or 8
+	std::uint8_t sampleSize = 2;
+	/// Words of data per block (DAQ BlockNWords). Frames add two header
+	/// words to each block. 0 means 1 for Frames
+	std::uint16_t blockWords = 0;
+	/// Peak of Sine, standard deviation of Noise
+	double amplitude = 1000;
+	/// Value added to every sample
+	double offset = 0;
+	/// Cycles per sample of Sine
+	double frequency = 0.001;
+	/// Increment per sample of Ramp and Frames
+	std::int64_t step = 1;
+	/// Seed of Noise
+	std::uint64_t seed = 1;
+};
+
+/**
+ * Generator of the words written by the FPGA into a FIFO
+ *
+ * @ingroup NiFpgaSim
+ */
+class Producer {
+ public:
+	virtual ~Producer() = default;
+
+	/**
+	 * Writes the next words of the stream
+	 *
+	 * @param words	Output buffer
+	 * @param n		Number of words to write
+	 */
+	virtual void generate(std::uint64_t *words, size_t n) = 0;
+
+	/**
+	 * Advances the stream without writing it, as happens to the data
+	 * dropped by an overflow
+	 *
+	 * @param n Number of words to skip
+	 */
+	virtual void skip(std::uint64_t n) = 0;
+};
+
+/**
+ * Base of the producers that pack one sample per channel in turns
+ *
+ * @ingroup NiFpgaSim
+ */
+class SampleProducer: public Producer {
+ public:
+	explicit SampleProducer(const ProducerConfig &config);
+
+	void generate(std::uint64_t *words, size_t n) override;
+
+	void skip(std::uint64_t n) override;
+
+ protected:
+	/**
+	 * Value of a sample before truncating it to the sample size
+	 *
+	 * @param ch	Channel of the sample
+	 * @param i		Index of the sample in the channel
+	 * @return Value of the sample
+	 */
+	virtual std::int64_t sample(const std::uint16_t ch,
+			const std::uint64_t i) = 0;
+
+	const ProducerConfig m_config;
+
+ private:
+	const std::uint32_t m_samplesPerWord;
+	const std::uint64_t m_mask;
+	std::uint64_t m_index = 0;
+};
+
+/**
+ * Ramp per channel
+ *
+ * @ingroup NiFpgaSim
+ */
+class RampProducer: public SampleProducer {
+ public:
+	explicit RampProducer(const ProducerConfig &config);
+
+ protected:
+	std::int64_t sample(const std::uint16_t ch, const std::uint64_t i) override;
+};
+
+/**
+ * Sine per channel
+ *
+ * @ingroup NiFpgaSim
+ */
+class SineProducer: public SampleProducer {
+ public:
+	explicit SineProducer(const ProducerConfig &config);
+
+ protected:
+	std::int64_t sample(const std::uint16_t ch, const std::uint64_t i) override;
+};
+
+/**
+ * Gaussian noise
+ *
+ * @ingroup NiFpgaSim
+ */
+class NoiseProducer: public SampleProducer {
+ public:
+	explicit NoiseProducer(const ProducerConfig &config);
+
+ protected:
+	std::int64_t sample(const std::uint16_t ch, const std::uint64_t i) override;
+
+ private:
+	std::mt19937_64 m_engine;
+	std::normal_distribution<double> m_distribution;
+};
+
+/**
+ * Blocks with the FormatB layout: a header word with the block counter,
+ * a timestamp word with the index of the first sample of the block and
+ * blockWords words of ramp samples
+ *
+ * @ingroup NiFpgaSim
+ */
+class FramesProducer: public Producer {
+ public:
+	/// Upper 16 bits of every header word
+	static constexpr std::uint64_t HEADER_MARK = 0xF7A3ull << 48;
+
+	explicit FramesProducer(const ProducerConfig &config);
+
+	void generate(std::uint64_t *words, size_t n) override;
+
+	void skip(std::uint64_t n) override;
+
+ private:
+	std::uint64_t payloadBefore(const std::uint64_t word) const;
+
+	RampProducer m_payload;
+	const std::uint64_t m_blockWords;
+	const std::uint64_t m_samplesPerBlock;
+	std::uint64_t m_word = 0;
+};
+
+/**
+ * Creates the producer described by a configuration
+ *
+ * @throw irio::errors::SimulatorConfigError Invalid sample size or channels
+ *
+ * @param config Producer configuration
+ * @return New producer
+ */
+std::unique_ptr<Producer> makeProducer(const ProducerConfig &config);
+
+}  // namespace sim
+}  // namespace irio
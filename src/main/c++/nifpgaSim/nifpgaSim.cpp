@@ -0,0 +1,342 @@
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <NiFpga.h>
+#include <niflexrio.h>
+
+#include "nifpgaSim.h"
+#include "errorsIrio.h"
+
+namespace irio {
+namespace sim {
+
+namespace {
+
+const char RESOURCE_PREFIX[] = "RIOSIM";
+
+/**
+ * Sessions and configurations shared by the NiFpga functions
+ */
+class Registry {
+ public:
+	static Registry &instance() {
+		static Registry registry;
+		return registry;
+	}
+
+	void setConfig(const std::string &serialNumber,
+			const DeviceConfig &config) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_configs[serialNumber] = config;
+	}
+
+	void resetConfigs() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_configs.clear();
+	}
+
+	DeviceConfig getConfig(const std::string &serialNumber) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_configs.find(serialNumber);
+		return it == m_configs.end() ? DeviceConfig() : it->second;
+	}
+
+	NiFpga_Session open(const std::shared_ptr<Device> &device) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const NiFpga_Session session = m_nextSession++;
+		m_sessions[session] = device;
+		return session;
+	}
+
+	std::shared_ptr<Device> close(const NiFpga_Session session) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_sessions.find(session);
+		if (it == m_sessions.end()) {
+			return nullptr;
+		}
+		const auto device = it->second;
+		m_sessions.erase(it);
+		return device;
+	}
+
+	std::shared_ptr<Device> get(const NiFpga_Session session) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_sessions.find(session);
+		return it == m_sessions.end() ? nullptr : it->second;
+	}
+
+ private:
+	Registry() = default;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, DeviceConfig> m_configs;
+	std::unordered_map<NiFpga_Session, std::shared_ptr<Device>> m_sessions;
+	NiFpga_Session m_nextSession = 1;
+};
+
+template<typename T>
+NiFpga_Status readArray(const NiFpga_Session session,
+		const std::uint32_t indicator, T *array, const size_t size) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!array && size > 0) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	std::vector<std::uint64_t> raw(size);
+	const auto status = device->read(indicator, raw.data(), size);
+	if (status == NiFpga_Status_Success) {
+		for (size_t i = 0; i < size; ++i) {
+			array[i] = static_cast<T>(raw[i]);
+		}
+	}
+	return status;
+}
+
+template<typename T>
+NiFpga_Status writeArray(const NiFpga_Session session,
+		const std::uint32_t control, const T *array, const size_t size) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!array && size > 0) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	std::vector<std::uint64_t> raw(size);
+	for (size_t i = 0; i < size; ++i) {
+		// Signed values are sign extended, as the reads truncate them back
+		raw[i] = static_cast<std::uint64_t>(array[i]);
+	}
+	return device->write(control, raw.data(), size);
+}
+
+}  // namespace
+
+void setDeviceConfig(const std::string &serialNumber,
+		const DeviceConfig &config) {
+	Registry::instance().setConfig(serialNumber, config);
+}
+
+void resetDeviceConfigs() {
+	Registry::instance().resetConfigs();
+}
+
+std::string getResourceName(const std::string &serialNumber) {
+	return RESOURCE_PREFIX + serialNumber;
+}
+
+std::shared_ptr<Device> getDevice(const NiFpga_Session session) {
+	return Registry::instance().get(session);
+}
+
+}  // namespace sim
+}  // namespace irio
+
+using irio::sim::Registry;
+
+#define SIM_SCALAR_FUNCTIONS(Type, type) \
+	NiFpga_Status NiFpga_Read##Type(NiFpga_Session session, \
+			uint32_t indicator, type *value) { \
+		return irio::sim::readArray(session, indicator, value, 1); \
+	} \
+	NiFpga_Status NiFpga_Write##Type(NiFpga_Session session, \
+			uint32_t control, type value) { \
+		return irio::sim::writeArray(session, control, &value, 1); \
+	} \
+	NiFpga_Status NiFpga_ReadArray##Type(NiFpga_Session session, \
+			uint32_t indicator, type *array, size_t size) { \
+		return irio::sim::readArray(session, indicator, array, size); \
+	} \
+	NiFpga_Status NiFpga_WriteArray##Type(NiFpga_Session session, \
+			uint32_t control, const type *array, size_t size) { \
+		return irio::sim::writeArray(session, control, array, size); \
+	}
+
+extern "C" {
+
+NiFpga_Status NiFpga_Initialize(void) {
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_Finalize(void) {
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_Open(const char *bitfile, const char *signature,
+		const char *resource, uint32_t attribute, NiFpga_Session *session) {
+	if (!bitfile || !resource || !session) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	const std::string resourceName = resource;
+	const std::string prefix = irio::sim::RESOURCE_PREFIX;
+	if (resourceName.compare(0, prefix.size(), prefix)) {
+		return NiFpga_Status_InvalidResourceName;
+	}
+
+	std::shared_ptr<irio::sim::Device> device;
+	try {
+		const irio::bfp::BFP bfp(bitfile, false);
+		if (signature && bfp.getSignature() != signature) {
+			return NiFpga_Status_SignatureMismatch;
+		}
+		device = std::make_shared<irio::sim::Device>(bfp,
+				Registry::instance().getConfig(
+						resourceName.substr(prefix.size())));
+	} catch (irio::errors::BFPParseBitfileError&) {
+		return NiFpga_Status_BitfileReadError;
+	} catch (irio::errors::IrioError&) {
+		return NiFpga_Status_InvalidParameter;
+	}
+
+	if (!(attribute & NiFpga_OpenAttribute_NoRun)) {
+		device->run();
+	}
+	*session = Registry::instance().open(device);
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_Close(NiFpga_Session session, uint32_t) {
+	const auto device = Registry::instance().close(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	device->close();
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_Run(NiFpga_Session session, uint32_t) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->run() : NiFpga_Status_InvalidSession;
+}
+
+SIM_SCALAR_FUNCTIONS(Bool, NiFpga_Bool)
+SIM_SCALAR_FUNCTIONS(I8, int8_t)
+SIM_SCALAR_FUNCTIONS(U8, uint8_t)
+SIM_SCALAR_FUNCTIONS(I16, int16_t)
+SIM_SCALAR_FUNCTIONS(U16, uint16_t)
+SIM_SCALAR_FUNCTIONS(I32, int32_t)
+SIM_SCALAR_FUNCTIONS(U32, uint32_t)
+SIM_SCALAR_FUNCTIONS(I64, int64_t)
+SIM_SCALAR_FUNCTIONS(U64, uint64_t)
+
+NiFpga_Status NiFpga_ConfigureFifo(NiFpga_Session session, uint32_t fifo,
+		size_t depth) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->configureFifo(fifo, depth, nullptr) :
+			NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFpga_ConfigureFifo2(NiFpga_Session session, uint32_t fifo,
+		size_t requestedDepth, size_t *actualDepth) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->configureFifo(fifo, requestedDepth, actualDepth) :
+			NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFpga_StartFifo(NiFpga_Session session, uint32_t fifo) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->startFifo(fifo) : NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFpga_StopFifo(NiFpga_Session session, uint32_t fifo) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->stopFifo(fifo) : NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFpga_ReadFifoU64(NiFpga_Session session, uint32_t fifo,
+		uint64_t *data, size_t numberOfElements, uint32_t timeout,
+		size_t *elementsRemaining) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!data && numberOfElements > 0) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	return device->readFifo(fifo, data, numberOfElements, timeout,
+			elementsRemaining);
+}
+
+NiFpga_Status NiFpga_AcquireFifoReadElementsU64(NiFpga_Session session,
+		uint32_t fifo, uint64_t **elements, size_t elementsRequested,
+		uint32_t timeout, size_t *elementsAcquired,
+		size_t *elementsRemaining) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!elements) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	return device->acquireFifo(fifo, elements, elementsRequested, timeout,
+			elementsAcquired, elementsRemaining);
+}
+
+NiFpga_Status NiFpga_ReleaseFifoElements(NiFpga_Session session,
+		uint32_t fifo, size_t elements) {
+	const auto device = Registry::instance().get(session);
+	return device ? device->releaseFifo(fifo, elements) :
+			NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFpga_ReserveIrqContext(NiFpga_Session session,
+		NiFpga_IrqContext *context) {
+	if (!Registry::instance().get(session)) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!context) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	// The simulator keeps no state per context
+	*context = new std::uint8_t(0);
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_UnreserveIrqContext(NiFpga_Session session,
+		NiFpga_IrqContext context) {
+	if (!Registry::instance().get(session)) {
+		return NiFpga_Status_InvalidSession;
+	}
+	delete static_cast<std::uint8_t*>(context);
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status NiFpga_WaitOnIrqs(NiFpga_Session session,
+		NiFpga_IrqContext context, uint32_t irqs, uint32_t timeout,
+		uint32_t *irqsAsserted, NiFpga_Bool *timedOut) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!context) {
+		return NiFpga_Status_ResourceNotInitialized;
+	}
+	return device->waitOnIrqs(irqs, timeout, irqsAsserted, timedOut);
+}
+
+NiFpga_Status NiFpga_AcknowledgeIrqs(NiFpga_Session session, uint32_t) {
+	// The IRQs follow the fill levels, there is no latch to clear
+	return Registry::instance().get(session) ?
+			NiFpga_Status_Success : NiFpga_Status_InvalidSession;
+}
+
+NiFpga_Status NiFlexRio_GetAttribute(NiFpga_Session session,
+		int32_t attribute, int32_t valueType, void *value) {
+	const auto device = Registry::instance().get(session);
+	if (!device) {
+		return NiFpga_Status_InvalidSession;
+	}
+	if (!value || attribute != NIFLEXRIO_Attr_InsertedFamID
+			|| valueType != NIFLEXRIO_ValueType_U32) {
+		return NiFpga_Status_FeatureNotSupported;
+	}
+	const std::uint32_t moduleID = device->getModuleID();
+	std::memcpy(value, &moduleID, sizeof(moduleID));
+	return NiFpga_Status_Success;
+}
+
+}  // extern "C"
@@ -0,0 +1,624 @@
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <thread>
+
+#include "simDevice.h"
+#include "errorsIrio.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+#include "terminals/names/namesTerminalsFlexRIO.h"
+
+namespace irio {
+namespace sim {
+
+const size_t Device::DEFAULT_DEPTH;
+
+struct Device::Fifo {
+	std::string name;
+	FifoConfig config;
+	std::unique_ptr<Producer> producer;
+	/// Bool registers that must be true for the FPGA to write
+	std::vector<std::uint32_t> gates;
+	bool hasSamplingRate = false;
+	std::uint32_t samplingRateAddr = 0;
+	/// Number n of DMATtoHOST<n>, -1 if the name does not follow it
+	std::int32_t group = -1;
+
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::vector<std::uint64_t> buffer;
+	size_t depth = DEFAULT_DEPTH;
+	bool started = false;
+	std::chrono::steady_clock::time_point last;
+	/// Fraction of word owed by the producer between updates
+	double owed = 0;
+	std::uint64_t written = 0;
+	std::uint64_t acquired = 0;
+	std::uint64_t released = 0;
+	std::uint64_t dropped = 0;
+};
+
+namespace {
+
+std::int32_t parseGroup(const std::string &name) {
+	const std::string prefix = TERMINAL_DMATTOHOST;
+	if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix)) {
+		return -1;
+	}
+	const std::string number = name.substr(prefix.size());
+	if (number.find_first_not_of("0123456789") != std::string::npos) {
+		return -1;
+	}
+	return std::stoi(number);
+}
+
+std::uint64_t normalize(const bfp::ElemTypes type, const std::uint64_t value) {
+	return type == bfp::ElemTypes::Bool ? (value != 0) : value;
+}
+
+}  // namespace
+
+Device::Device(const bfp::BFP &bfp, const DeviceConfig &config) :
+		m_fref(config.fref), m_moduleID(config.moduleID), m_running(false),
+		m_closed(false), m_initDoneAddr(0), m_hasInitDone(false),
+		m_overflowsAddr(0), m_hasOverflows(false) {
+	initRegisters(bfp, config);
+	initFifos(bfp, config);
+
+	for (const auto &reg : config.registers) {
+		for (size_t i = 0; i < reg.second.size(); ++i) {
+			Slot *slot = findSlot(reg.first, i);
+			if (!slot) {
+				throw errors::SimulatorConfigError("Register " + reg.first +
+						" not found or too short in the bitfile");
+			}
+			slot->values[i] = normalize(slot->type, reg.second[i]);
+		}
+	}
+}
+
+Device::~Device() {
+	close();
+}
+
+void Device::close() {
+	m_closed = true;
+	for (auto &fifo : m_fifos) {
+		std::lock_guard<std::mutex> lock(fifo->mutex);
+		fifo->cond.notify_all();
+	}
+}
+
+NiFpga_Status Device::run() {
+	if (m_running.exchange(true)) {
+		return NiFpga_Status_FpgaAlreadyRunning;
+	}
+	if (m_hasInitDone) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_registers.at(m_initDoneAddr).values[0] = 1;
+	}
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::read(const std::uint32_t address,
+		std::uint64_t *values, const size_t size) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const auto it = m_registers.find(address);
+	if (it == m_registers.end()) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	if (size > it->second.values.size()) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	std::copy(it->second.values.begin(), it->second.values.begin() + size,
+			values);
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::write(const std::uint32_t address,
+		const std::uint64_t *values, const size_t size) {
+	std::vector<size_t> dependents;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_registers.find(address);
+		if (it == m_registers.end()) {
+			return NiFpga_Status_ResourceNotFound;
+		}
+		if (size > it->second.values.size()) {
+			return NiFpga_Status_InvalidParameter;
+		}
+		dependents = it->second.fifos;
+	}
+
+	// Account the words written with the old rate and gates first
+	for (const auto n : dependents) {
+		std::lock_guard<std::mutex> lock(m_fifos[n]->mutex);
+		updateFifo(m_fifos[n].get());
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Slot &slot = m_registers.at(address);
+		for (size_t i = 0; i < size; ++i) {
+			slot.values[i] = normalize(slot.type, values[i]);
+		}
+	}
+
+	for (const auto n : dependents) {
+		std::lock_guard<std::mutex> lock(m_fifos[n]->mutex);
+		m_fifos[n]->cond.notify_all();
+	}
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::configureFifo(const std::uint32_t fifo,
+		const size_t depth, size_t *actualDepth) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	if (depth == 0) {
+		return NiFpga_Status_BadDepth;
+	}
+
+	std::lock_guard<std::mutex> lock(f->mutex);
+	if (f->started && depth != f->depth) {
+		// The host buffer cannot be resized while the FIFO runs
+		return NiFpga_Status_InvalidParameter;
+	}
+	f->depth = depth;
+	if (actualDepth) {
+		*actualDepth = depth;
+	}
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::startFifo(const std::uint32_t fifo) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	std::lock_guard<std::mutex> lock(f->mutex);
+	startLocked(f);
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::stopFifo(const std::uint32_t fifo) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	std::lock_guard<std::mutex> lock(f->mutex);
+	updateFifo(f);
+	f->started = false;
+	f->cond.notify_all();
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::readFifo(const std::uint32_t fifo, std::uint64_t *data,
+		const size_t n, const std::uint32_t timeout,
+		size_t *elementsRemaining) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	std::unique_lock<std::mutex> lock(f->mutex);
+	if (f->acquired != f->released) {
+		// Reading would release the acquired elements out of order
+		return NiFpga_Status_FifoElementsCurrentlyAcquired;
+	}
+	startLocked(f);
+
+	// Reads longer than the host buffer are served as the data arrives
+	NiFpga_Status status = NiFpga_Status_Success;
+	size_t done = 0;
+	do {
+		const size_t chunk = std::min(n - done, f->depth);
+		status = waitElements(f, &lock, chunk, timeout, start);
+		if (NiFpga_IsError(status)) {
+			break;
+		}
+		const size_t index = f->acquired % f->depth;
+		const size_t first = std::min(chunk, f->depth - index);
+		const auto buffer = f->buffer.begin();
+		std::copy(buffer + index, buffer + index + first, data + done);
+		std::copy(buffer, buffer + (chunk - first), data + done + first);
+		f->acquired += chunk;
+		f->released = f->acquired;
+		done += chunk;
+	} while (done < n);
+
+	if (elementsRemaining) {
+		*elementsRemaining = f->written - f->acquired;
+	}
+	return status;
+}
+
+NiFpga_Status Device::acquireFifo(const std::uint32_t fifo,
+		std::uint64_t **elements, const size_t n, const std::uint32_t timeout,
+		size_t *elementsAcquired, size_t *elementsRemaining) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	std::unique_lock<std::mutex> lock(f->mutex);
+	startLocked(f);
+	if (n > f->depth - (f->acquired - f->released)) {
+		return NiFpga_Status_BadReadWriteCount;
+	}
+
+	const auto status = waitElements(f, &lock, n, timeout, start);
+	size_t count = 0;
+	if (!NiFpga_IsError(status)) {
+		// As with the real host buffer, a region never wraps around: less
+		// elements than requested are acquired at the end of the buffer
+		const size_t index = f->acquired % f->depth;
+		count = std::min(n, f->depth - index);
+		*elements = f->buffer.data() + index;
+		f->acquired += count;
+	}
+	if (elementsAcquired) {
+		*elementsAcquired = count;
+	}
+	if (elementsRemaining) {
+		*elementsRemaining = f->written - f->acquired;
+	}
+	return status;
+}
+
+NiFpga_Status Device::releaseFifo(const std::uint32_t fifo, const size_t n) {
+	Fifo *f = findFifo(fifo);
+	if (!f) {
+		return NiFpga_Status_ResourceNotFound;
+	}
+	std::lock_guard<std::mutex> lock(f->mutex);
+	if (n > f->acquired - f->released) {
+		return NiFpga_Status_InvalidParameter;
+	}
+	// The FPGA could not use the space until now
+	updateFifo(f);
+	f->released += n;
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status Device::waitOnIrqs(const std::uint32_t irqs,
+		const std::uint32_t timeout, std::uint32_t *irqsAsserted,
+		NiFpga_Bool *timedOut) {
+	const auto start = std::chrono::steady_clock::now();
+	const auto interval = std::chrono::microseconds(100);
+	while (!m_closed) {
+		std::uint32_t asserted = 0;
+		for (auto &fifo : m_fifos) {
+			const auto irq = fifo->config.irq;
+			if (irq < 0 || irq > 31 || !(irqs & (1u << irq))) {
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(fifo->mutex);
+			updateFifo(fifo.get());
+			if (fifo->written - fifo->acquired >= fifo->config.irqThreshold) {
+				asserted |= 1u << irq;
+			}
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		const bool expired = timeout != NiFpga_InfiniteTimeout &&
+				elapsed >= std::chrono::milliseconds(timeout);
+		if (asserted || expired) {
+			if (irqsAsserted) {
+				*irqsAsserted = asserted;
+			}
+			if (timedOut) {
+				*timedOut = asserted ? NiFpga_False : NiFpga_True;
+			}
+			return NiFpga_Status_Success;
+		}
+		std::this_thread::sleep_for(interval);
+	}
+	return NiFpga_Status_InvalidSession;
+}
+
+std::uint32_t Device::getModuleID() const {
+	return m_moduleID;
+}
+
+void Device::setRegister(const std::string &name, const std::uint64_t value,
+		const size_t index) {
+	std::uint32_t address;
+	std::vector<std::uint64_t> values;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const Slot *slot = findSlot(name, index);
+		if (!slot) {
+			throw errors::ResourceNotFoundError(name + "[" +
+					std::to_string(index) + "] not found in the simulator");
+		}
+		address = m_addresses.at(name);
+		values.assign(slot->values.begin(), slot->values.begin() + index + 1);
+	}
+	values[index] = value;
+	write(address, values.data(), values.size());
+}
+
+std::uint64_t Device::getRegister(const std::string &name,
+		const size_t index) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const Slot *slot = findSlot(name, index);
+	if (!slot) {
+		throw errors::ResourceNotFoundError(name + "[" +
+				std::to_string(index) + "] not found in the simulator");
+	}
+	return slot->values[index];
+}
+
+FifoStats Device::getFifoStats(const std::string &dmaName) {
+	const auto it = m_fifoNames.find(dmaName);
+	if (it == m_fifoNames.end()) {
+		throw errors::ResourceNotFoundError(dmaName +
+				" not found in the simulator");
+	}
+	Fifo *f = m_fifos[it->second].get();
+	std::lock_guard<std::mutex> lock(f->mutex);
+	updateFifo(f);
+
+	FifoStats stats;
+	stats.produced = f->written;
+	stats.dropped = f->dropped;
+	stats.released = f->released;
+	stats.fillLevel = f->written - f->acquired;
+	stats.started = f->started;
+	return stats;
+}
+
+void Device::initRegisters(const bfp::BFP &bfp, const DeviceConfig &config) {
+	for (const auto &pair : bfp.getRegisters()) {
+		const bfp::Register &reg = pair.second;
+		Slot slot;
+		slot.type = reg.getElemType();
+		slot.values.assign(std::max<size_t>(reg.getNumElem(), 1), 0);
+		m_registers[reg.getAddress()] = slot;
+		m_addresses[pair.first] = reg.getAddress();
+	}
+
+	setIfExists(TERMINAL_PLATFORM, static_cast<std::uint8_t>(config.platform));
+	setIfExists(TERMINAL_DEVPROFILE, config.profile);
+	setIfExists(TERMINAL_FPGAVIVERSION, config.fpgaVIversion[0], 0);
+	setIfExists(TERMINAL_FPGAVIVERSION, config.fpgaVIversion[1], 1);
+	setIfExists(TERMINAL_FREF, config.fref);
+	setIfExists(TERMINAL_RIOADAPTERCORRECT, 1);
+	setIfExists(TERMINAL_INSERTEDIOMODULEID, config.moduleID);
+
+	const auto initDone = m_addresses.find(TERMINAL_INITDONE);
+	if (initDone != m_addresses.end()) {
+		m_hasInitDone = true;
+		m_initDoneAddr = initDone->second;
+	}
+	const auto overflows = m_addresses.find(TERMINAL_DMATTOHOSTOVERFLOWS);
+	if (overflows != m_addresses.end()) {
+		m_hasOverflows = true;
+		m_overflowsAddr = overflows->second;
+	}
+}
+
+void Device::initFifos(const bfp::BFP &bfp, const DeviceConfig &config) {
+	const auto startStop = m_addresses.find(TERMINAL_DAQSTARTSTOP);
+
+	for (const auto &pair : bfp.getDMAs()) {
+		const bfp::DMA &dma = pair.second;
+		if (!dma.isTargetToHost()) {
+			continue;
+		}
+
+		std::unique_ptr<Fifo> fifo(new Fifo());
+		fifo->name = pair.first;
+		const auto it = config.fifos.find(pair.first);
+		if (it != config.fifos.end()) {
+			fifo->config = it->second;
+		}
+		fifo->producer = makeProducer(fifo->config.producer);
+		fifo->group = parseGroup(pair.first);
+
+		const size_t index = m_fifos.size();
+		if (startStop != m_addresses.end()) {
+			fifo->gates.push_back(startStop->second);
+		}
+		if (fifo->group >= 0) {
+			const std::string n = std::to_string(fifo->group);
+			const auto enable = m_addresses.find(TERMINAL_DMATTOHOSTENABLE + n);
+			if (enable != m_addresses.end()) {
+				fifo->gates.push_back(enable->second);
+			}
+			const auto rate = m_addresses.find(
+					TERMINAL_DMATTOHOSTSAMPLINGRATE + n);
+			if (rate != m_addresses.end()) {
+				fifo->hasSamplingRate = true;
+				fifo->samplingRateAddr = rate->second;
+				m_registers.at(rate->second).fifos.push_back(index);
+			}
+
+			const auto &producer = fifo->config.producer;
+			const bool frames = producer.type == ProducerType::Frames;
+			const size_t group = static_cast<size_t>(fifo->group);
+			setIfExists(TERMINAL_DMATTOHOSTNCH, producer.nCh, group);
+			setIfExists(TERMINAL_DMATTOHOSTSAMPLESIZE, producer.sampleSize,
+					group);
+			setIfExists(TERMINAL_DMATTOHOSTFRAMETYPE, frames ? 1 : 0, group);
+			setIfExists(TERMINAL_DMATTOHOSTBLOCKNWORDS,
+					frames && producer.blockWords == 0 ?
+							1 : producer.blockWords, group);
+		}
+		for (const auto gate : fifo->gates) {
+			m_registers.at(gate).fifos.push_back(index);
+		}
+
+		m_fifoIndex[dma.getDMANumber()] = index;
+		m_fifoNames[pair.first] = index;
+		m_fifos.push_back(std::move(fifo));
+	}
+}
+
+void Device::setIfExists(const std::string &name, const std::uint64_t value,
+		const size_t index) {
+	Slot *slot = findSlot(name, index);
+	if (slot) {
+		slot->values[index] = normalize(slot->type, value);
+	}
+}
+
+Device::Slot *Device::findSlot(const std::string &name, const size_t index) {
+	const auto it = m_addresses.find(name);
+	if (it == m_addresses.end()) {
+		return nullptr;
+	}
+	Slot &slot = m_registers.at(it->second);
+	return index < slot.values.size() ? &slot : nullptr;
+}
+
+const Device::Slot *Device::findSlot(const std::string &name,
+		const size_t index) const {
+	const auto it = m_addresses.find(name);
+	if (it == m_addresses.end()) {
+		return nullptr;
+	}
+	const Slot &slot = m_registers.at(it->second);
+	return index < slot.values.size() ? &slot : nullptr;
+}
+
+Device::Fifo *Device::findFifo(const std::uint32_t fifo) const {
+	const auto it = m_fifoIndex.find(fifo);
+	return it == m_fifoIndex.end() ? nullptr : m_fifos[it->second].get();
+}
+
+std::uint64_t Device::readRaw(const std::uint32_t address) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_registers.at(address).values[0];
+}
+
+void Device::updateFifo(Fifo *fifo) {
+	const auto now = std::chrono::steady_clock::now();
+	const auto elapsed = std::chrono::duration<double>(now - fifo->last);
+	fifo->last = now;
+	if (!fifo->started || !isGateOpen(*fifo)) {
+		return;
+	}
+
+	const std::uint64_t space = fifo->depth - (fifo->written - fifo->released);
+	const double rate = getRate(*fifo);
+	std::uint64_t words = space;
+	if (rate > 0) {
+		fifo->owed += rate * elapsed.count();
+		const double whole = std::floor(fifo->owed);
+		fifo->owed -= whole;
+		words = static_cast<std::uint64_t>(whole);
+	}
+
+	const std::uint64_t fit = std::min(words, space);
+	const size_t index = fifo->written % fifo->depth;
+	const size_t first = std::min<std::uint64_t>(fit, fifo->depth - index);
+	fifo->producer->generate(fifo->buffer.data() + index, first);
+	fifo->producer->generate(fifo->buffer.data(), fit - first);
+	fifo->written += fit;
+
+	if (words > fit) {
+		fifo->producer->skip(words - fit);
+		fifo->dropped += words - fit;
+		setOverflow(*fifo, true);
+	}
+}
+
+double Device::getRate(const Fifo &fifo) const {
+	if (fifo.config.followSamplingRate && fifo.hasSamplingRate) {
+		const auto decimation = readRaw(fifo.samplingRateAddr);
+		if (decimation != 0) {
+			const auto &producer = fifo.config.producer;
+			double words = static_cast<double>(m_fref) / decimation
+					* producer.nCh * producer.sampleSize / 8;
+			if (producer.type == ProducerType::Frames) {
+				const double block = producer.blockWords == 0 ?
+						1 : producer.blockWords;
+				words *= (block + 2) / block;
+			}
+			return words;
+		}
+	}
+	return fifo.config.rate;
+}
+
+bool Device::isGateOpen(const Fifo &fifo) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const auto gate : fifo.gates) {
+		if (m_registers.at(gate).values[0] == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+NiFpga_Status Device::waitElements(Fifo *fifo,
+		std::unique_lock<std::mutex> *lock, const size_t n,
+		const std::uint32_t timeout,
+		const std::chrono::steady_clock::time_point &start) {
+	using std::chrono::steady_clock;
+	const auto minWait = std::chrono::microseconds(10);
+	const auto maxWait = std::chrono::milliseconds(100);
+	while (!m_closed) {
+		updateFifo(fifo);
+		const std::uint64_t available = fifo->written - fifo->acquired;
+		if (available >= n) {
+			return NiFpga_Status_Success;
+		}
+
+		steady_clock::duration wait = maxWait;
+		if (timeout != NiFpga_InfiniteTimeout) {
+			const auto left = start + std::chrono::milliseconds(timeout)
+					- steady_clock::now();
+			if (left <= steady_clock::duration::zero()) {
+				return NiFpga_Status_FifoTimeout;
+			}
+			wait = std::min(wait, left);
+		}
+		const double rate = getRate(*fifo);
+		if (fifo->started && rate > 0) {
+			const double missing = static_cast<double>(n - available)
+					- fifo->owed;
+			const auto needed = std::chrono::duration_cast<
+					steady_clock::duration>(
+							std::chrono::duration<double>(missing / rate));
+			wait = std::max<steady_clock::duration>(minWait,
+					std::min(wait, needed));
+		}
+		fifo->cond.wait_for(*lock, wait);
+	}
+	return NiFpga_Status_InvalidSession;
+}
+
+void Device::startLocked(Fifo *fifo) {
+	if (fifo->started) {
+		return;
+	}
+	fifo->buffer.resize(fifo->depth);
+	fifo->written = 0;
+	fifo->acquired = 0;
+	fifo->released = 0;
+	fifo->owed = 0;
+	fifo->last = std::chrono::steady_clock::now();
+	fifo->started = true;
+	setOverflow(*fifo, false);
+	fifo->cond.notify_all();
+}
+
+void Device::setOverflow(const Fifo &fifo, const bool overflow) {
+	if (!m_hasOverflows || fifo.group < 0 || fifo.group > 63) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto &value = m_registers.at(m_overflowsAddr).values[0];
+	const std::uint64_t bit = 1ull << fifo.group;
+	value = overflow ? (value | bit) : (value & ~bit);
+}
+
+}  // namespace sim
+}  // namespace irio
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "simProducers.h"
+#include "errorsIrio.h"
+
+namespace irio {
+namespace sim {
+
+namespace {
+
+const ProducerConfig &checkConfig(const ProducerConfig &config) {
+	const auto size = config.sampleSize;
+	if (size != 1 && size != 2 && size != 4 && size != 8) {
+		throw errors::SimulatorConfigError("Invalid sample size " +
+				std::to_string(size));
+	}
+	if (config.nCh == 0) {
+		throw errors::SimulatorConfigError("A producer needs one channel");
+	}
+	return config;
+}
+
+}  // namespace
+
+constexpr std::uint64_t FramesProducer::HEADER_MARK;
+
+SampleProducer::SampleProducer(const ProducerConfig &config) :
+		m_config(checkConfig(config)),
+		m_samplesPerWord(8 / config.sampleSize),
+		m_mask(config.sampleSize == 8 ?
+				~0ull : (1ull << (8 * config.sampleSize)) - 1) {
+}
+
+void SampleProducer::generate(std::uint64_t *words, size_t n) {
+	const std::uint32_t bits = 8 * m_config.sampleSize;
+	for (size_t w = 0; w < n; ++w) {
+		std::uint64_t word = 0;
+		for (std::uint32_t s = 0; s < m_samplesPerWord; ++s, ++m_index) {
+			const auto ch = static_cast<std::uint16_t>(m_index % m_config.nCh);
+			const std::uint64_t value = static_cast<std::uint64_t>(
+					sample(ch, m_index / m_config.nCh));
+			word |= (value & m_mask) << (bits * s);
+		}
+		words[w] = word;
+	}
+}
+
+void SampleProducer::skip(std::uint64_t n) {
+	m_index += n * m_samplesPerWord;
+}
+
+RampProducer::RampProducer(const ProducerConfig &config) :
+		SampleProducer(config) {
+}
+
+std::int64_t RampProducer::sample(const std::uint16_t ch,
+		const std::uint64_t i) {
+	return std::llround(m_config.offset) + ch +
+			m_config.step * static_cast<std::int64_t>(i);
+}
+
+SineProducer::SineProducer(const ProducerConfig &config) :
+		SampleProducer(config) {
+}
+
+std::int64_t SineProducer::sample(const std::uint16_t ch,
+		const std::uint64_t i) {
+	static const double TWO_PI = 2 * std::acos(-1.0);
+	const double phase = m_config.frequency * static_cast<double>(i)
+			+ static_cast<double>(ch) / m_config.nCh;
+	return std::llround(m_config.offset
+			+ m_config.amplitude * std::sin(TWO_PI * phase));
+}
+
+NoiseProducer::NoiseProducer(const ProducerConfig &config) :
+		SampleProducer(config), m_engine(config.seed),
+		m_distribution(config.offset, config.amplitude) {
+}
+
+std::int64_t NoiseProducer::sample(const std::uint16_t, const std::uint64_t) {
+	return std::llround(m_distribution(m_engine));
+}
+
+FramesProducer::FramesProducer(const ProducerConfig &config) :
+		m_payload(config),
+		m_blockWords(config.blockWords == 0 ? 1 : config.blockWords),
+		m_samplesPerBlock(m_blockWords * (8 / config.sampleSize)
+				/ config.nCh) {
+}
+
+void FramesProducer::generate(std::uint64_t *words, size_t n) {
+	const std::uint64_t frameWords = m_blockWords + 2;
+	size_t w = 0;
+	while (w < n) {
+		const std::uint64_t frame = m_word / frameWords;
+		const std::uint64_t offset = m_word % frameWords;
+		if (offset == 0) {
+			words[w++] = HEADER_MARK | (frame & 0xFFFFFFFFFFFFull);
+			++m_word;
+		} else if (offset == 1) {
+			words[w++] = frame * m_samplesPerBlock;
+			++m_word;
+		} else {
+			const size_t count = std::min<std::uint64_t>(n - w,
+					frameWords - offset);
+			m_payload.generate(words + w, count);
+			w += count;
+			m_word += count;
+		}
+	}
+}
+
+void FramesProducer::skip(std::uint64_t n) {
+	m_payload.skip(payloadBefore(m_word + n) - payloadBefore(m_word));
+	m_word += n;
+}
+
+std::uint64_t FramesProducer::payloadBefore(const std::uint64_t word) const {
+	const std::uint64_t frameWords = m_blockWords + 2;
+	const std::uint64_t offset = word % frameWords;
+	return (word / frameWords) * m_blockWords + (offset > 2 ? offset - 2 : 0);
+}
+
+std::unique_ptr<Producer> makeProducer(const ProducerConfig &config) {
+	switch (config.type) {
+	case ProducerType::Ramp:
+		return std::unique_ptr<Producer>(new RampProducer(config));
+	case ProducerType::Sine:
+		return std::unique_ptr<Producer>(new SineProducer(config));
+	case ProducerType::Noise:
+		return std::unique_ptr<Producer>(new NoiseProducer(config));
+	case ProducerType::Frames:
+		return std::unique_ptr<Producer>(new FramesProducer(config));
+	}
+	throw errors::SimulatorConfigError("Unknown producer type " +
+			std::to_string(static_cast<int>(config.type)));
+}
+
+}  // namespace sim
+}  // namespace irio
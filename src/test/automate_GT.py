@@ -17,6 +17,7 @@ binaryPaths = {
     "irioCoreCpp Unitary": "c++/unittests/irioCoreCpp/test_ut_irioCoreCpp",
     "irioCoreCpp Functional": "c++/irioCoreCpp/test_irioCoreCpp",
     "BFP": "c++/bfp/test_bfp",
+    "nifpgaSim Unitary": "c++/unittests/nifpgaSim/test_ut_nifpgaSim",
 }
 
 def runCommand(binary, filterText, RIODevice, RIOSerial, Verbose, Coupling, MaxCounter, Summary=False, suiteName=None, shuffle=False, iterations='1', verboseTest=False, verboseInit=False):
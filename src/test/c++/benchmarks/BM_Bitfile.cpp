@@ -0,0 +1,208 @@
+#include <malloc.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchUtils.h"
+#include "bfp.h"
+#include "bitfileCache.h"
+#include "errorsIrio.h"
+
+using namespace irio;
+
+namespace {
+
+/// Source of the tables of the bitfile
+enum CacheMode: std::int64_t {
+	Disabled = 0,	/**< XML parsed every time, no cache */
+	Miss = 1,		/**< XML parsed and stored in the cache */
+	Hit = 2			/**< Tables loaded from the cache */
+};
+
+const std::string BENCH_CACHE_DIR = "/tmp/irioCore_bfp_cache_bench";
+
+const std::string& getBitfile(const std::int64_t bitfile) {
+	return bitfile == 0 ? BITFILE_DAQ : BITFILE_IMAQ;
+}
+
+/**
+ * Reads a field in kB of /proc/self/status
+ *
+ * @return Value of the field, -1 if not found
+ */
+long readStatusKB(const std::string &field) {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, field.size() + 1, field + ":") == 0) {
+			return std::stol(line.substr(field.size() + 1));
+		}
+	}
+	return -1;
+}
+
+/**
+ * Returns how much the resident set grew while parsing a bitfile once, i.e.
+ * its peak memory. The freed heap is returned to the system and the peak
+ * reset before parsing
+ *
+ * @return Growth in kB, -1 if the peak cannot be reset
+ */
+long measureParseKB(const std::string &bitfile, const bfp::ParseMode mode) {
+	malloc_trim(0);
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (!(clearRefs << "5" << std::flush)) {
+		return -1;
+	}
+	const long before = readStatusKB("VmRSS");
+	{
+		bfp::BFP parsed(bitfile, false, "", mode);
+	}
+	return readStatusKB("VmHWM") - before;
+}
+
+/// How a missing resource is reported by the lookup
+enum LookupMode: std::int64_t {
+	Throwing = 0,	/**< BFP::getRegister, catching ResourceNotFoundError */
+	Try = 1			/**< BFP::tryGetRegister, returning nullptr */
+};
+
+/**
+ * Names probed when looking for the resources of the terminals: every
+ * enumerated prefix up to a platform maximum. Most of them are not in the
+ * bitfile
+ */
+std::vector<std::string> getCandidateNames() {
+	const std::string prefixes[] = { "AI", "AO", "AOEnable", "auxAI",
+			"aux64AI", "auxAO", "aux64AO", "DI", "DO", "auxDI", "auxDO",
+			"DMATtoHOSTEnable", "DMATtoHOSTSamplingRate", "SGSignalType" };
+	std::vector<std::string> names;
+	for (const auto &prefix : prefixes) {
+		for (int i = 0; i < 64; ++i) {
+			names.push_back(prefix + std::to_string(i));
+		}
+	}
+	return names;
+}
+
+/// Removes the cache entry of a bitfile
+void removeEntry(const bfp::BitfileCache &cache, const std::string &bitfile) {
+	bfp::BitfileCache::Key key;
+	if (cache.getKey(bitfile, &key)) {
+		std::remove(cache.getEntryPath(key).c_str());
+	}
+}
+
+/**
+ * Construction of BFP, i.e. the parse done by every Irio constructor, with
+ * the bitfile cache disabled (cold), missing the entry or hitting it (warm)
+ *
+ * Args: bitfile (0 DAQ, 1 IMAQ), CacheMode
+ */
+void BM_BitfileParse(benchmark::State &state) {
+	const auto &bitfile = getBitfile(state.range(0));
+	const auto mode = static_cast<CacheMode>(state.range(1));
+	const std::string dir = mode == CacheMode::Disabled ? "" : BENCH_CACHE_DIR;
+	const bfp::BitfileCache cache(dir);
+
+	removeEntry(cache, bitfile);
+	if (mode == CacheMode::Hit) {
+		bfp::BFP warmUp(bitfile, false, dir);
+	}
+
+	size_t registers = 0;
+	for (auto _ : state) {
+		if (mode == CacheMode::Miss) {
+			state.PauseTiming();
+			removeEntry(cache, bitfile);
+			state.ResumeTiming();
+		}
+		bfp::BFP parsed(bitfile, false, dir);
+		if (parsed.isFromCache() != (mode == CacheMode::Hit)) {
+			state.SkipWithError("Unexpected cache result");
+			break;
+		}
+		registers = parsed.getRegisters().size();
+		benchmark::DoNotOptimize(registers);
+	}
+	state.counters["registers"] = static_cast<double>(registers);
+	removeEntry(cache, bitfile);
+}
+
+/**
+ * XML parse of a bitfile (no cache) loading the whole document and using
+ * XPath, or only the elements before the bitstream. Also reports the peak
+ * memory of one parse (peak_rss_kB)
+ *
+ * Args: bitfile (0 DAQ, 1 IMAQ), ParseMode
+ */
+void BM_BitfileParseMode(benchmark::State &state) {
+	const auto &bitfile = getBitfile(state.range(0));
+	const auto mode = static_cast<bfp::ParseMode>(state.range(1));
+
+	size_t registers = 0;
+	for (auto _ : state) {
+		bfp::BFP parsed(bitfile, false, "", mode);
+		registers = parsed.getRegisters().size();
+		benchmark::DoNotOptimize(registers);
+	}
+	state.counters["registers"] = static_cast<double>(registers);
+	state.counters["peak_rss_kB"] =
+			static_cast<double>(measureParseKB(bitfile, mode));
+}
+
+/**
+ * Lookup of the candidate names of the terminals, most of them missing as
+ * in a bitfile with sparse resources, reporting them with an exception or
+ * a nullptr
+ *
+ * Args: bitfile (0 DAQ, 1 IMAQ), LookupMode
+ */
+void BM_BitfileLookup(benchmark::State &state) {
+	const bfp::BFP parsed(getBitfile(state.range(0)), false, "");
+	const auto mode = static_cast<LookupMode>(state.range(1));
+	const auto names = getCandidateNames();
+
+	size_t found = 0;
+	for (auto _ : state) {
+		found = 0;
+		for (const auto &name : names) {
+			if (mode == LookupMode::Try) {
+				found += parsed.tryGetRegister(name) != nullptr;
+			} else {
+				try {
+					parsed.getRegister(name);
+					++found;
+				} catch (errors::ResourceNotFoundError &) {
+				}
+			}
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.counters["found"] = static_cast<double>(found);
+	state.counters["missing"] = static_cast<double>(names.size() - found);
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() *
+			names.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_BitfileLookup)
+	->ArgNames({"bitfile", "mode"})
+	->ArgsProduct({{0, 1}, {LookupMode::Throwing, LookupMode::Try}})
+	->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_BitfileParseMode)
+	->ArgNames({"bitfile", "mode"})
+	->ArgsProduct({{0, 1},
+		{static_cast<std::int64_t>(bfp::ParseMode::Full),
+		static_cast<std::int64_t>(bfp::ParseMode::Targeted)}})
+	->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_BitfileParse)
+	->ArgNames({"bitfile", "mode"})
+	->ArgsProduct({{0, 1},
+		{CacheMode::Disabled, CacheMode::Miss, CacheMode::Hit}})
+	->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchUtils.h"
+#include "irioCoreCpp.h"
+
+using namespace irio;
+
+namespace {
+
+/// Read function driven by the benchmark
+enum ReadMode: std::int64_t {
+	NonBlocking = 0,	/**< readDataNonBlocking */
+	Blocking = 1,		/**< readDataBlocking */
+	Available = 2		/**< readAvailable */
+};
+
+/// Shared by the threads of a benchmark run
+std::unique_ptr<Irio> irioDAQ;
+
+void setupDAQ(const benchmark::State &state) {
+	sim::ProducerConfig producer;
+	producer.blockWords = static_cast<std::uint16_t>(state.range(0));
+	producer.nCh = static_cast<std::uint16_t>(state.range(2));
+	producer.sampleSize = static_cast<std::uint8_t>(state.range(3));
+	setBenchDevice(PLATFORM_ID::RSeries, PROFILE_VALUE_DAQ, producer);
+
+	try {
+		irioDAQ.reset(new Irio(BITFILE_DAQ, BENCH_SERIAL,
+				BENCH_FPGAVI_VERSION));
+		irioDAQ->startFPGA();
+		const auto daq = irioDAQ->getTerminalsDAQ();
+		for (std::uint32_t n = 0; n < daq.countDMAs(); ++n) {
+			daq.enableDMA(n);
+		}
+		irioDAQ->getTerminalsCommon().setDAQStartStop(true);
+		daq.startAllDMAs();
+	} catch (errors::IrioError &e) {
+		std::cerr << e.what() << std::endl;
+		irioDAQ.reset();
+	}
+}
+
+void teardownDAQ(const benchmark::State&) {
+	irioDAQ.reset();
+	sim::resetDeviceConfigs();
+}
+
+/**
+ * Reads blocks from a DMA per call. Each thread reads its own DMA while
+ * there are enough of them
+ *
+ * Args: block words, blocks per call, channels, sample size, ReadMode
+ */
+void BM_DAQReadData(benchmark::State &state) {
+	if (!irioDAQ) {
+		state.SkipWithError("Simulated device not opened");
+		return;
+	}
+	const auto daq = irioDAQ->getTerminalsDAQ();
+	const std::uint32_t n = static_cast<std::uint32_t>(
+			state.thread_index() % daq.countDMAs());
+	const size_t elements = daq.getElementsPerBlock(n) *
+			static_cast<size_t>(state.range(1));
+	const auto mode = static_cast<ReadMode>(state.range(4));
+	std::vector<std::uint64_t> data(elements);
+
+	std::uint64_t bytes = 0;
+	CallMeter meter;
+	for (auto _ : state) {
+		size_t read = 0;
+		meter.begin();
+		switch (mode) {
+		case ReadMode::NonBlocking:
+			read = daq.readDataNonBlocking(n, elements, data.data());
+			break;
+		case ReadMode::Blocking:
+			read = daq.readDataBlocking(n, elements, data.data(), 1000);
+			break;
+		case ReadMode::Available:
+			read = daq.readAvailable(n, elements, data.data(), elements);
+			break;
+		}
+		meter.end();
+		benchmark::DoNotOptimize(data.data());
+		bytes += read * sizeof(std::uint64_t);
+	}
+	meter.report(state, bytes);
+}
+
+/**
+ * Non-blocking reads of one block with the read statistics disabled or
+ * enabled, to measure the cost of recording them
+ *
+ * Args: block words, blocks per call, channels, sample size, stats enabled
+ */
+void BM_DAQReadStats(benchmark::State &state) {
+	if (!irioDAQ) {
+		state.SkipWithError("Simulated device not opened");
+		return;
+	}
+	const auto daq = irioDAQ->getTerminalsDAQ();
+	const size_t elements = daq.getElementsPerBlock(0) *
+			static_cast<size_t>(state.range(1));
+	std::vector<std::uint64_t> data(elements);
+	daq.setReadStatsEnabled(state.range(4) != 0);
+
+	std::uint64_t bytes = 0;
+	CallMeter meter;
+	for (auto _ : state) {
+		meter.begin();
+		const size_t read = daq.readDataNonBlocking(0, elements, data.data());
+		meter.end();
+		benchmark::DoNotOptimize(data.data());
+		bytes += read * sizeof(std::uint64_t);
+	}
+	meter.report(state, bytes);
+}
+
+/**
+ * Construction of Irio followed by the first use of the DAQ terminals, as
+ * done by an application that only reads DMAs. In lazy mode the other
+ * terminals are never built
+ *
+ * Args: TerminalsConstruction
+ */
+void BM_IrioStartup(benchmark::State &state) {
+	const auto construction =
+			static_cast<TerminalsConstruction>(state.range(0));
+	setBenchDevice(PLATFORM_ID::RSeries, PROFILE_VALUE_DAQ,
+			sim::ProducerConfig());
+
+	std::uint64_t allocations = 0;
+	for (auto _ : state) {
+		const auto before = getThreadAllocations();
+		try {
+			Irio irio(BITFILE_DAQ, BENCH_SERIAL, BENCH_FPGAVI_VERSION, false,
+					construction);
+			benchmark::DoNotOptimize(irio.getTerminalsDAQ().countDMAs());
+		} catch (errors::IrioError &e) {
+			state.SkipWithError(e.what());
+			break;
+		}
+		allocations += getThreadAllocations() - before;
+	}
+	state.counters["allocs/call"] = benchmark::Counter(
+			static_cast<double>(allocations),
+			benchmark::Counter::kAvgIterations);
+	sim::resetDeviceConfigs();
+}
+
+}  // namespace
+
+BENCHMARK(BM_IrioStartup)
+	->ArgNames({"construction"})
+	->Arg(static_cast<std::int64_t>(TerminalsConstruction::Eager))
+	->Arg(static_cast<std::int64_t>(TerminalsConstruction::Lazy))
+	->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_DAQReadData)
+	->Setup(setupDAQ)
+	->Teardown(teardownDAQ)
+	->ArgNames({"blockWords", "blocks", "nCh", "sampleSize", "mode"})
+	->ArgsProduct({
+		{256, 4096},
+		{1, 16},
+		{1, 8},
+		{2, 8},
+		{ReadMode::NonBlocking, ReadMode::Blocking, ReadMode::Available}})
+	->Threads(1)
+	->Threads(2)
+	->UseRealTime();
+
+BENCHMARK(BM_DAQReadStats)
+	->Setup(setupDAQ)
+	->Teardown(teardownDAQ)
+	->ArgNames({"blockWords", "blocks", "nCh", "sampleSize", "stats"})
+	->ArgsProduct({{256}, {1}, {1}, {8}, {0, 1}})
+	->UseRealTime();
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchUtils.h"
+#include "irioCoreCpp.h"
+
+using namespace irio;
+
+namespace {
+
+/// Shared by the threads of a benchmark run
+std::unique_ptr<Irio> irioIMAQ;
+
+void setupIMAQ(const benchmark::State &state) {
+	sim::ProducerConfig producer;
+	producer.sampleSize = static_cast<std::uint8_t>(state.range(1));
+	setBenchDevice(PLATFORM_ID::FlexRIO, PROFILE_VALUE_IMAQ, producer);
+
+	try {
+		irioIMAQ.reset(new Irio(BITFILE_IMAQ, BENCH_SERIAL,
+				BENCH_FPGAVI_VERSION));
+		irioIMAQ->startFPGA();
+		const auto imaq = irioIMAQ->getTerminalsIMAQ();
+		const size_t words = static_cast<size_t>(state.range(0)) *
+				producer.sampleSize / 8;
+		for (std::uint32_t n = 0; n < imaq.countDMAs(); ++n) {
+			// Room for two images, big ones do not fit the default depth
+			imaq.setHostDepth(n, std::max(words * 2,
+					sim::Device::DEFAULT_DEPTH));
+			imaq.enableDMA(n);
+		}
+		irioIMAQ->getTerminalsCommon().setDAQStartStop(true);
+		imaq.startAllDMAs();
+	} catch (errors::IrioError &e) {
+		std::cerr << e.what() << std::endl;
+		irioIMAQ.reset();
+	}
+}
+
+void teardownIMAQ(const benchmark::State&) {
+	irioIMAQ.reset();
+	sim::resetDeviceConfigs();
+}
+
+/**
+ * Reads an image per call. Each thread reads its own DMA while there are
+ * enough of them
+ *
+ * Args: pixels per image, bytes per pixel, blocking
+ */
+void BM_IMAQReadImage(benchmark::State &state) {
+	if (!irioIMAQ) {
+		state.SkipWithError("Simulated device not opened");
+		return;
+	}
+	const auto imaq = irioIMAQ->getTerminalsIMAQ();
+	const std::uint32_t n = static_cast<std::uint32_t>(
+			state.thread_index() % imaq.countDMAs());
+	const size_t pixels = static_cast<size_t>(state.range(0));
+	const size_t words = pixels * imaq.getSampleSize(n) / 8;
+	const bool blocking = state.range(2);
+	std::vector<std::uint64_t> image(words);
+
+	std::uint64_t bytes = 0;
+	CallMeter meter;
+	for (auto _ : state) {
+		meter.begin();
+		const size_t read = blocking ?
+				imaq.readImageBlocking(n, pixels, image.data(), 1000) :
+				imaq.readImageNonBlocking(n, pixels, image.data());
+		meter.end();
+		benchmark::DoNotOptimize(image.data());
+		if (read) {
+			bytes += words * sizeof(std::uint64_t);
+		}
+	}
+	meter.report(state, bytes);
+}
+
+}  // namespace
+
+BENCHMARK(BM_IMAQReadImage)
+	->Setup(setupIMAQ)
+	->Teardown(teardownIMAQ)
+	->ArgNames({"pixels", "pixelSize", "blocking"})
+	->ArgsProduct({
+		{640 * 480, 1024 * 1024},
+		{1, 2},
+		{0, 1}})
+	->Threads(1)
+	->Threads(2)
+	->UseRealTime();
@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <vector>
+
+#include "benchUtils.h"
+#include "irioDriver.h"
+#include "irioError.h"
+#include "irioHandlerDMA.h"
+
+namespace {
+
+/// Shared by the threads of a benchmark run
+irioDrv_t drvLegacy;
+
+void setupLegacy(const benchmark::State &state) {
+	irio::sim::ProducerConfig producer;
+	producer.blockWords = static_cast<std::uint16_t>(state.range(0));
+	setBenchDevice(irio::PLATFORM_ID::RSeries, irio::PROFILE_VALUE_DAQ,
+			producer);
+
+	TStatus status;
+	irio_initStatus(&status);
+	irio_initDriver("BM_Legacy", BENCH_SERIAL.c_str(), "7854",
+			"Rseries_CPUDAQ_7854", BENCH_FPGAVI_VERSION.c_str(), 0,
+			"../../resources/7854", "../../resources/7854", &drvLegacy,
+			&status);
+	irio_setFPGAStart(&drvLegacy, 1, &status);
+	irio_setUpDMAsTtoHost(&drvLegacy, &status);
+	for (std::uint32_t n = 0; n < drvLegacy.DMATtoHOSTNo.value; ++n) {
+		irio_setDMATtoHostEnable(&drvLegacy, static_cast<int>(n), 1, &status);
+	}
+	irio_setDAQStartStop(&drvLegacy, 1, &status);
+	if (status.code == IRIO_error) {
+		std::fprintf(stderr, "%s\n", status.msg ? status.msg : "IRIO error");
+		drvLegacy.DMATtoHOSTNo.value = 0;
+	}
+	irio_resetStatus(&status);
+}
+
+void teardownLegacy(const benchmark::State&) {
+	TStatus status;
+	irio_initStatus(&status);
+	irio_closeDriver(&drvLegacy, 0, &status);
+	irio_resetStatus(&status);
+	irio::sim::resetDeviceConfigs();
+}
+
+/**
+ * Reads blocks per call with the C API. Each thread reads its own DMA
+ * while there are enough of them
+ *
+ * Args: block words, blocks per call, blocking
+ */
+void BM_LegacyGetDMATtoHostData(benchmark::State &state) {
+	if (!drvLegacy.DMATtoHOSTNo.value) {
+		state.SkipWithError("Simulated device not opened");
+		return;
+	}
+	const int n = static_cast<int>(static_cast<std::uint32_t>(
+			state.thread_index()) % drvLegacy.DMATtoHOSTNo.value);
+	const int blocks = static_cast<int>(state.range(1));
+	const bool blocking = state.range(2);
+	std::vector<std::uint64_t> data(
+			static_cast<size_t>(blocks * state.range(0)));
+
+	TStatus status;
+	irio_initStatus(&status);
+	std::uint64_t bytes = 0;
+	CallMeter meter;
+	for (auto _ : state) {
+		int blocksRead = 0;
+		meter.begin();
+		if (blocking) {
+			irio_getDMATtoHostData_timeout(&drvLegacy, blocks, n, data.data(),
+					&blocksRead, 1000, &status);
+		} else {
+			irio_getDMATtoHostData(&drvLegacy, blocks, n, data.data(),
+					&blocksRead, &status);
+		}
+		meter.end();
+		benchmark::DoNotOptimize(data.data());
+		bytes += static_cast<std::uint64_t>(blocksRead) *
+				static_cast<std::uint64_t>(state.range(0)) *
+				sizeof(std::uint64_t);
+	}
+	if (status.code == IRIO_error) {
+		state.SkipWithError(status.msg ? status.msg : "IRIO error");
+	}
+	irio_resetStatus(&status);
+	meter.report(state, bytes);
+}
+
+}  // namespace
+
+BENCHMARK(BM_LegacyGetDMATtoHostData)
+	->Setup(setupLegacy)
+	->Teardown(teardownLegacy)
+	->ArgNames({"blockWords", "blocks", "blocking"})
+	->ArgsProduct({
+		{256, 4096},
+		{1, 16},
+		{0, 1}})
+	->Threads(1)
+	->Threads(2)
+	->UseRealTime();
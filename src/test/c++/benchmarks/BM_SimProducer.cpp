@@ -0,0 +1,39 @@
+#include <vector>
+
+#include "benchUtils.h"
+
+namespace {
+
+/**
+ * Generation of the words by the simulated FPGA alone. The read benchmarks
+ * include this cost, as the simulator generates the words in the thread
+ * that reads them, so it is the baseline to subtract from them.
+ *
+ * Args: words per call, channels, sample size
+ */
+void BM_SimProducer(benchmark::State &state) {
+	irio::sim::ProducerConfig config;
+	config.nCh = static_cast<std::uint16_t>(state.range(1));
+	config.sampleSize = static_cast<std::uint8_t>(state.range(2));
+	const auto producer = irio::sim::makeProducer(config);
+	std::vector<std::uint64_t> words(static_cast<size_t>(state.range(0)));
+
+	CallMeter meter;
+	for (auto _ : state) {
+		meter.begin();
+		producer->generate(words.data(), words.size());
+		meter.end();
+		benchmark::DoNotOptimize(words.data());
+	}
+	meter.report(state, state.iterations() * words.size() *
+			sizeof(std::uint64_t));
+}
+
+}  // namespace
+
+BENCHMARK(BM_SimProducer)
+	->ArgNames({"words", "nCh", "sampleSize"})
+	->ArgsProduct({
+		{256, 4096, 65536},
+		{1, 8},
+		{2, 8}});
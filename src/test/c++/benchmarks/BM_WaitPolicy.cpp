@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchUtils.h"
+#include "irioCoreCpp.h"
+
+using namespace irio;
+using std::chrono::steady_clock;
+
+namespace {
+
+/// WaitPolicy used by the reads
+enum Policy: std::int64_t {
+	Driver = 0,		/**< WaitPolicy(), the wait of the driver */
+	FixedSleep = 1,	/**< WaitPolicy::fixedSleep(), 1 ms between polls */
+	Hybrid = 2,		/**< WaitPolicy::hybrid() */
+	BusySpin = 3	/**< WaitPolicy::busySpin() */
+};
+
+/// Words per second written by the simulated FPGA
+const double WORDS_PER_SECOND = 1e6;
+
+std::unique_ptr<Irio> irioDAQ;
+
+WaitPolicy makePolicy(const Policy policy) {
+	switch (policy) {
+	case Policy::FixedSleep:
+		return WaitPolicy::fixedSleep();
+	case Policy::Hybrid:
+		return WaitPolicy::hybrid();
+	case Policy::BusySpin:
+		return WaitPolicy::busySpin();
+	default:
+		return WaitPolicy();
+	}
+}
+
+void setupPaced(const benchmark::State &state) {
+	sim::DeviceConfig config;
+	config.platform = PLATFORM_ID::RSeries;
+	config.profile = PROFILE_VALUE_DAQ;
+	auto &fifo = config.fifos["DMATtoHOST0"];
+	fifo.producer.blockWords = static_cast<std::uint16_t>(state.range(0));
+	fifo.rate = WORDS_PER_SECOND;
+	sim::setDeviceConfig(BENCH_SERIAL, config);
+
+	try {
+		irioDAQ.reset(new Irio(BITFILE_DAQ, BENCH_SERIAL,
+				BENCH_FPGAVI_VERSION));
+		irioDAQ->startFPGA();
+		irioDAQ->getTerminalsDAQ().enableDMA(0);
+		irioDAQ->getTerminalsCommon().setDAQStartStop(true);
+	} catch (errors::IrioError &e) {
+		std::cerr << e.what() << std::endl;
+		irioDAQ.reset();
+	}
+}
+
+void teardownPaced(const benchmark::State&) {
+	irioDAQ.reset();
+	sim::resetDeviceConfigs();
+}
+
+/**
+ * Blocking reads of one block from a DMA written at a fixed rate. The
+ * latency percentiles are the delay between the arrival of the last word
+ * of the block and the return of the read, i.e. the wake-up latency of the
+ * policy. The CPU time shows what the policy costs while waiting.
+ *
+ * Args: block words, Policy
+ */
+void BM_WaitPolicyRead(benchmark::State &state) {
+	if (!irioDAQ) {
+		state.SkipWithError("Simulated device not opened");
+		return;
+	}
+	const auto daq = irioDAQ->getTerminalsDAQ();
+	const size_t elements = daq.getElementsPerBlock(0);
+	const auto policy = makePolicy(static_cast<Policy>(state.range(1)));
+	const auto period = std::chrono::duration_cast<steady_clock::duration>(
+			std::chrono::duration<double>(elements / WORDS_PER_SECOND));
+	std::vector<std::uint64_t> data(elements);
+
+	// Restart the FIFO, so the arrival of each block is known
+	daq.stopDMA(0);
+	daq.startDMA(0);
+	const auto start = steady_clock::now();
+
+	std::uint64_t bytes = 0;
+	std::uint64_t blocks = 0;
+	CallMeter meter;
+	for (auto _ : state) {
+		daq.readDataBlocking(0, elements, data.data(), 1000, policy);
+		const auto arrival = start + period * static_cast<int>(++blocks);
+		meter.record(std::max<steady_clock::duration>(
+				steady_clock::now() - arrival, steady_clock::duration::zero()));
+		benchmark::DoNotOptimize(data.data());
+		bytes += elements * sizeof(std::uint64_t);
+	}
+	meter.report(state, bytes);
+}
+
+}  // namespace
+
+BENCHMARK(BM_WaitPolicyRead)
+	->Setup(setupPaced)
+	->Teardown(teardownPaced)
+	->ArgNames({"blockWords", "policy"})
+	->ArgsProduct({
+		{256, 4096},
+		{Policy::Driver, Policy::FixedSleep, Policy::Hybrid,
+				Policy::BusySpin}})
+	->UseRealTime();
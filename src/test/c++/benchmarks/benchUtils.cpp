@@ -0,0 +1,90 @@
+#include "benchUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local std::uint64_t threadAllocations = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+	++threadAllocations;
+	void *ptr = std::malloc(size ? size : 1);
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+std::uint64_t getThreadAllocations() {
+	return threadAllocations;
+}
+
+void setBenchDevice(const irio::PLATFORM_ID platform, const std::uint8_t profile,
+		const irio::sim::ProducerConfig &producer) {
+	irio::sim::DeviceConfig config;
+	config.platform = platform;
+	config.profile = profile;
+	// Names of DMAs not in the bitfile are ignored
+	for (int n = 0; n < 16; ++n) {
+		auto &fifo = config.fifos["DMATtoHOST" + std::to_string(n)];
+		fifo.producer = producer;
+		fifo.rate = 0;
+	}
+	irio::sim::setDeviceConfig(BENCH_SERIAL, config);
+}
+
+CallMeter::CallMeter(const size_t capacity):
+		m_samples(capacity), m_allocations(getThreadAllocations()) {
+}
+
+void CallMeter::report(benchmark::State &state, const std::uint64_t bytes) {
+	const auto allocations = getThreadAllocations() - m_allocations;
+	const auto iterations = state.iterations();
+	state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+	state.counters["allocs/call"] = benchmark::Counter(
+			iterations ? static_cast<double>(allocations) / iterations : 0,
+			benchmark::Counter::kAvgThreads);
+
+	std::vector<std::uint64_t> sorted(m_samples.begin(),
+			m_samples.begin() + std::min(m_count, m_samples.size()));
+	if (sorted.empty()) {
+		return;
+	}
+	std::sort(sorted.begin(), sorted.end());
+	const auto percentile = [&sorted](const double p) {
+		const size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+		return static_cast<double>(sorted[index]);
+	};
+	state.counters["p50_ns"] = benchmark::Counter(percentile(0.5),
+			benchmark::Counter::kAvgThreads);
+	state.counters["p90_ns"] = benchmark::Counter(percentile(0.9),
+			benchmark::Counter::kAvgThreads);
+	state.counters["p99_ns"] = benchmark::Counter(percentile(0.99),
+			benchmark::Counter::kAvgThreads);
+	state.counters["p999_ns"] = benchmark::Counter(percentile(0.999),
+			benchmark::Counter::kAvgThreads);
+	state.counters["max_ns"] = benchmark::Counter(percentile(1),
+			benchmark::Counter::kAvgThreads);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nifpgaSim.h"
+
+/**
+ * Bitfiles of the test resources, relative to the benchmarks folder
+ */
+const std::string BITFILE_DAQ =
+		"../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx";
+const std::string BITFILE_IMAQ =
+		"../../resources/7966/NiFpga_FlexRIO_CPUIMAQ_7966.lvbitx";
+
+/**
+ * Serial number of the simulated device used by the benchmarks
+ */
+const std::string BENCH_SERIAL = "0";
+
+/**
+ * FPGA VI version of the simulated devices
+ */
+const std::string BENCH_FPGAVI_VERSION = "V1.0";
+
+/**
+ * Returns the heap allocations made by the calling thread since it started
+ *
+ * @return Number of calls to operator new
+ */
+std::uint64_t getThreadAllocations();
+
+/**
+ * Configures the simulated device used by the benchmarks. Every target to
+ * host FIFO keeps full, so the benchmarks measure the host side of the read
+ * path (plus the generation of the words, see BM_SimProducer).
+ *
+ * @param platform		Value of Platform
+ * @param profile		Value of DevProfile
+ * @param producer		Data written into every FIFO
+ */
+void setBenchDevice(const irio::PLATFORM_ID platform, const std::uint8_t profile,
+		const irio::sim::ProducerConfig &producer);
+
+/**
+ * Measures the calls of a benchmark loop and reports MB/s, per call
+ * latency percentiles and heap allocations per call as counters.
+ *
+ * Only the last samples are kept, so the loop never allocates.
+ */
+class CallMeter {
+ public:
+	/**
+	 * @param capacity Latencies kept to compute the percentiles
+	 */
+	explicit CallMeter(const size_t capacity = 1 << 16);
+
+	void begin() {
+		m_start = std::chrono::steady_clock::now();
+	}
+
+	void end() {
+		record(std::chrono::steady_clock::now() - m_start);
+	}
+
+	/**
+	 * Adds a latency measured by the caller instead of by begin() and end()
+	 *
+	 * @param elapsed Latency of a call
+	 */
+	void record(const std::chrono::steady_clock::duration &elapsed) {
+		m_samples[m_count++ % m_samples.size()] = static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+						elapsed).count());
+	}
+
+	/**
+	 * Sets the counters of the benchmark. Percentiles and allocations are
+	 * averaged between threads, throughput is added
+	 *
+	 * @param state	Benchmark state
+	 * @param bytes	Bytes read by all the calls of the thread
+	 */
+	void report(benchmark::State &state, const std::uint64_t bytes);
+
+ private:
+	std::vector<std::uint64_t> m_samples;
+	size_t m_count = 0;
+	std::uint64_t m_allocations;
+	std::chrono::steady_clock::time_point m_start;
+};
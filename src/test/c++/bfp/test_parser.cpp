@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include "bfp.h"
+#include "bitfileCache.h"
 #include "errorsIrio.h"
 
 using namespace irio::bfp;
@@ -109,3 +115,235 @@ TEST(BFP, InvalidDMA){
 		irio::errors::ResourceNotFoundError);
 }
 
+TEST(BFP, TryGetRegister){
+	std::string bitfile = "../../resources/7966/NiFpga_FlexRIO_OnlyResources_7966.lvbitx";
+	BFP parsedBitfile(bitfile, false);
+
+	const Register *reg = parsedBitfile.tryGetRegister("AOEnable0");
+	ASSERT_NE(reg, nullptr);
+	EXPECT_EQ(reg->getName(), "AOEnable0");
+	EXPECT_EQ(reg->getAddress(), 2);
+	EXPECT_EQ(reg, parsedBitfile.tryGetRegister("AOEnable0"));
+
+	EXPECT_EQ(parsedBitfile.tryGetRegister("NOTEXIST"), nullptr);
+}
+
+TEST(BFP, TryGetDMA){
+	std::string bitfile = "../../resources/7966/NiFpga_FlexRIO_OnlyResources_7966.lvbitx";
+	BFP parsedBitfile(bitfile, false);
+
+	const DMA *dma = parsedBitfile.tryGetDMA("DMATtoHOST0");
+	ASSERT_NE(dma, nullptr);
+	EXPECT_EQ(dma->getName(), "DMATtoHOST0");
+	EXPECT_EQ(dma->getDMANumber(), 0);
+
+	EXPECT_EQ(parsedBitfile.tryGetDMA("NOTEXIST"), nullptr);
+}
+
+
+namespace {
+
+const std::string CACHE_BITFILE =
+		"../../resources/7966/NiFpga_FlexRIO_OnlyResources_7966.lvbitx";
+const std::string CACHE_DIR = "/tmp/irioCore_bfp_cache_test";
+
+/// Removes the cache entry of a bitfile
+void removeEntry(const std::string &bitfile) {
+	const BitfileCache cache(CACHE_DIR);
+	BitfileCache::Key key;
+	ASSERT_TRUE(cache.getKey(bitfile, &key));
+	std::remove(cache.getEntryPath(key).c_str());
+}
+
+void copyFile(const std::string &from, const std::string &to) {
+	std::ifstream src(from, std::ios::binary);
+	std::ofstream dst(to, std::ios::binary);
+	dst << src.rdbuf();
+}
+
+void expectSameResource(const Resource &a, const Resource &b) {
+	EXPECT_EQ(a.getName(), b.getName());
+	EXPECT_EQ(a.getAddress(), b.getAddress()) << a.getName();
+	EXPECT_EQ(a.getElemType(), b.getElemType()) << a.getName();
+	EXPECT_EQ(a.getFpgaType(), b.getFpgaType()) << a.getName();
+	EXPECT_EQ(a.getNumElem(), b.getNumElem()) << a.getName();
+}
+
+void expectSameTables(const BFP &result, const BFP &expected) {
+	EXPECT_EQ(result.getSignature(), expected.getSignature());
+	EXPECT_EQ(result.getBitfileVersion(), expected.getBitfileVersion());
+
+	const auto registers = expected.getRegisters();
+	ASSERT_EQ(result.getRegisters().size(), registers.size());
+	for (const auto &reg : registers) {
+		const auto other = result.getRegister(reg.first);
+		expectSameResource(other, reg.second);
+		EXPECT_EQ(other.isArray(), reg.second.isArray());
+		EXPECT_EQ(other.isControl(), reg.second.isControl());
+	}
+	const auto dmas = expected.getDMAs();
+	ASSERT_EQ(result.getDMAs().size(), dmas.size());
+	for (const auto &dma : dmas) {
+		const auto other = result.getDMA(dma.first);
+		expectSameResource(other, dma.second);
+		EXPECT_EQ(other.isTargetToHost(), dma.second.isTargetToHost());
+	}
+}
+
+}  // namespace
+
+TEST(BFPCache, Hit) {
+	removeEntry(CACHE_BITFILE);
+	BFP cold(CACHE_BITFILE, false, CACHE_DIR);
+	EXPECT_FALSE(cold.isFromCache());
+
+	BFP warm(CACHE_BITFILE, false, CACHE_DIR);
+	EXPECT_TRUE(warm.isFromCache());
+	EXPECT_EQ(warm.getBitfilePath(), CACHE_BITFILE);
+	EXPECT_EQ(warm.getBitfileVersion(), "4.0");
+	EXPECT_EQ(warm.getSignature(), "F8D0486B2C90CB55C8A88E01FF18F295");
+}
+
+TEST(BFPCache, SameTablesAsXML) {
+	BFP xml(CACHE_BITFILE, false, "");
+	BFP(CACHE_BITFILE, false, CACHE_DIR);
+	BFP cached(CACHE_BITFILE, false, CACHE_DIR);
+	ASSERT_TRUE(cached.isFromCache());
+	EXPECT_FALSE(xml.isFromCache());
+
+	expectSameTables(cached, xml);
+}
+
+TEST(BFPCache, ModifiedBitfile) {
+	const std::string bitfile = "/tmp/irioCore_bfp_cache_test.lvbitx";
+	copyFile(CACHE_BITFILE, bitfile);
+	BFP(bitfile, false, CACHE_DIR);
+	EXPECT_TRUE(BFP(bitfile, false, CACHE_DIR).isFromCache());
+
+	// Same contents, different modification time
+	const timespec times[2] = { { 0, UTIME_NOW }, { 1, 0 } };
+	ASSERT_EQ(utimensat(AT_FDCWD, bitfile.c_str(), times, 0), 0);
+	EXPECT_FALSE(BFP(bitfile, false, CACHE_DIR).isFromCache());
+	EXPECT_TRUE(BFP(bitfile, false, CACHE_DIR).isFromCache());
+	std::remove(bitfile.c_str());
+}
+
+TEST(BFPCache, CorruptEntry) {
+	BFP(CACHE_BITFILE, false, CACHE_DIR);
+	const BitfileCache cache(CACHE_DIR);
+	BitfileCache::Key key;
+	ASSERT_TRUE(cache.getKey(CACHE_BITFILE, &key));
+	{
+		std::ofstream entry(cache.getEntryPath(key), std::ios::binary);
+		entry << std::string(100, '\xff');
+	}
+
+	BFP parsed(CACHE_BITFILE, false, CACHE_DIR);
+	EXPECT_FALSE(parsed.isFromCache());
+	EXPECT_EQ(parsed.getRegisters().size(), 241);
+	EXPECT_TRUE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+}
+
+TEST(BFPCache, ForeignWritableEntry) {
+	BFP(CACHE_BITFILE, false, CACHE_DIR);
+	const BitfileCache cache(CACHE_DIR);
+	BitfileCache::Key key;
+	ASSERT_TRUE(cache.getKey(CACHE_BITFILE, &key));
+	ASSERT_EQ(chmod(cache.getEntryPath(key).c_str(), 0666), 0);
+	EXPECT_FALSE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+	EXPECT_TRUE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+}
+
+TEST(BFPCache, SharedFolder) {
+	BFP(CACHE_BITFILE, false, CACHE_DIR);
+	ASSERT_EQ(chmod(CACHE_DIR.c_str(), 0777), 0);
+	EXPECT_FALSE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+	EXPECT_FALSE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+	ASSERT_EQ(chmod(CACHE_DIR.c_str(), 0700), 0);
+	EXPECT_TRUE(BFP(CACHE_BITFILE, false, CACHE_DIR).isFromCache());
+}
+
+TEST(BFPCache, Disabled) {
+	BFP(CACHE_BITFILE, false, "");
+	EXPECT_FALSE(BFP(CACHE_BITFILE, false, "").isFromCache());
+}
+
+TEST(BFPCache, InvalidBitfile) {
+	EXPECT_THROW(BFP("DOESNOTEXIST.lvbitx", false, CACHE_DIR), // @suppress("Goto statement used")
+		irio::errors::BFPParseBitfileError);
+}
+
+TEST(BFPParseMode, TargetedSameAsFull) {
+	const std::string bitfiles[] = {
+			"../../resources/allRegisterTypes.lvbitx",
+			"../../resources/7966/NiFpga_FlexRIO_OnlyResources_7966.lvbitx",
+			"../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx" };
+	for (const auto &bitfile : bitfiles) {
+		SCOPED_TRACE(bitfile);
+		BFP full(bitfile, false, "", ParseMode::Full);
+		BFP targeted(bitfile, false, "", ParseMode::Targeted);
+		expectSameTables(targeted, full);
+	}
+}
+
+TEST(BFPParseMode, BitstreamNotRead) {
+	// Bitfile cut in the middle of the bitstream, not well-formed
+	std::ifstream src(CACHE_BITFILE, std::ios::binary);
+	const std::string text((std::istreambuf_iterator<char>(src)),
+			std::istreambuf_iterator<char>());
+	const auto bitstream = text.find("<Bitstream>");
+	ASSERT_NE(bitstream, std::string::npos);
+	const std::string bitfile = "/tmp/irioCore_bfp_truncated.lvbitx";
+	{
+		std::ofstream dst(bitfile, std::ios::binary);
+		dst << text.substr(0, bitstream) << "<Bitstream>AAAA";
+	}
+
+	EXPECT_THROW(BFP(bitfile, false, "", ParseMode::Full), // @suppress("Goto statement used")
+		irio::errors::BFPParseBitfileError);
+	BFP targeted(bitfile, false, "", ParseMode::Targeted);
+	expectSameTables(targeted, BFP(CACHE_BITFILE, false, "", ParseMode::Full));
+	std::remove(bitfile.c_str());
+}
+
+TEST(BFPParseMode, InvalidBitfile) {
+	EXPECT_THROW(BFP("DOESNOTEXIST.lvbitx", false, "", ParseMode::Targeted), // @suppress("Goto statement used")
+		irio::errors::BFPParseBitfileError);
+}
+
+TEST(BFPEnumerate, SameAsLookups) {
+	const std::string bitfiles[] = {
+			"../../resources/7966/NiFpga_FlexRIO_OnlyResources_7966.lvbitx",
+			"../../resources/9159/NiFpga_cRIO_CPUDAQ_9159.lvbitx" };
+	const std::string prefixes[] = { "AI", "AO", "AOEnable", "auxAI",
+			"aux64AI", "auxAO", "DI", "DO", "auxDI", "auxDO", "DMATtoHOSTEnable",
+			"DMATtoHOSTSamplingRate", "SamplingRate", "NOTEXIST" };
+	for (const auto &bitfile : bitfiles) {
+		BFP parsed(bitfile, false, "");
+		for (const auto &prefix : prefixes) {
+			SCOPED_TRACE(bitfile + ": " + prefix);
+			const auto registers = parsed.getRegisters();
+			std::map<std::uint32_t, std::string> expected;
+			for (std::uint32_t i = 0; i < 1000; ++i) {
+				const auto name = prefix + std::to_string(i);
+				if (registers.count(name)) {
+					expected.emplace(i, name);
+				}
+			}
+
+			const auto result = parsed.enumerateRegisters(prefix);
+			ASSERT_EQ(result.size(), expected.size());
+			for (const auto &reg : result) {
+				EXPECT_EQ(reg.second.getName(), expected.at(reg.first));
+			}
+		}
+	}
+}
+
+TEST(BFPEnumerate, DMAs) {
+	BFP parsed(CACHE_BITFILE, false, "");
+	const auto dmas = parsed.enumerateDMAs("DMATtoHOST");
+	ASSERT_EQ(dmas.size(), 1);
+	EXPECT_EQ(dmas.at(0).getName(), "DMATtoHOST0");
+	EXPECT_TRUE(parsed.enumerateDMAs("NOTEXIST").empty());
+}
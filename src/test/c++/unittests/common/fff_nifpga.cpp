@@ -45,8 +45,15 @@ DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ReadArrayU8, NiFpga_Session, uint32_t, uint8_t*,
 DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ReadArrayU16, NiFpga_Session, uint32_t, uint16_t*, size_t);
 
 DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ReadFifoU64, NiFpga_Session, uint32_t, uint64_t*, size_t, uint32_t, size_t*);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_AcquireFifoReadElementsU64, NiFpga_Session, uint32_t, uint64_t**, size_t, uint32_t, size_t*, size_t*);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ReleaseFifoElements, NiFpga_Session, uint32_t, size_t);
 
-DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ConfigureFifo, NiFpga_Session, uint32_t, size_t);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ConfigureFifo2, NiFpga_Session, uint32_t, size_t, size_t*);
+
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_ReserveIrqContext, NiFpga_Session, NiFpga_IrqContext*);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_UnreserveIrqContext, NiFpga_Session, NiFpga_IrqContext);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_WaitOnIrqs, NiFpga_Session, NiFpga_IrqContext, uint32_t, uint32_t, uint32_t*, NiFpga_Bool*);
+DEFINE_FAKE_NIFPGA_FUNC(NiFpga_AcknowledgeIrqs, NiFpga_Session, uint32_t);
 
 DEFINE_FAKE_NIFPGA_FUNC(NiFpga_Run, NiFpga_Session, uint32_t);
 
@@ -184,7 +191,44 @@ void init_ok_fff_nifpga(){
 		return NiFpga_Status_Success;
 	};
 
-	NiFpga_ConfigureFifo_fake.return_val = NiFpga_Status_Success;
+	NiFpga_AcquireFifoReadElementsU64_fake.custom_fake = [](NiFpga_Session,
+			uint32_t, uint64_t** elements, size_t elementsRequested, uint32_t,
+			size_t* elementsAcquired, size_t* elementsRemaining) {
+		static uint64_t hostBuffer[4096] = {};
+		*elements = hostBuffer;
+		*elementsAcquired = elementsRequested;
+		if(elementsRemaining)
+			*elementsRemaining = 0;
+
+		return NiFpga_Status_Success;
+	};
+	NiFpga_ReleaseFifoElements_fake.return_val = NiFpga_Status_Success;
+
+	NiFpga_ConfigureFifo2_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			size_t requestedDepth, size_t* actualDepth) {
+		if(actualDepth)
+			*actualDepth = requestedDepth;
+
+		return NiFpga_Status_Success;
+	};
+	NiFpga_ReserveIrqContext_fake.custom_fake = [](NiFpga_Session,
+			NiFpga_IrqContext* context) {
+		static int irqContext;
+		*context = &irqContext;
+		return NiFpga_Status_Success;
+	};
+	NiFpga_UnreserveIrqContext_fake.return_val = NiFpga_Status_Success;
+	NiFpga_WaitOnIrqs_fake.custom_fake = [](NiFpga_Session, NiFpga_IrqContext,
+			uint32_t irqs, uint32_t, uint32_t* irqsAsserted,
+			NiFpga_Bool* timedOut) {
+		if(irqsAsserted)
+			*irqsAsserted = irqs;
+		if(timedOut)
+			*timedOut = NiFpga_False;
+
+		return NiFpga_Status_Success;
+	};
+	NiFpga_AcknowledgeIrqs_fake.return_val = NiFpga_Status_Success;
 	NiFpga_StartFifo_fake.return_val = NiFpga_Status_Success;
 	NiFpga_StopFifo_fake.return_val = NiFpga_Status_Success;
 }
@@ -211,7 +255,13 @@ void reset_fff_nifpga(){
 	RESET_FAKE(NiFpga_ReadArrayU8);
 	RESET_FAKE(NiFpga_ReadArrayU16);
 	RESET_FAKE(NiFpga_ReadFifoU64);
-	RESET_FAKE(NiFpga_ConfigureFifo);
+	RESET_FAKE(NiFpga_AcquireFifoReadElementsU64);
+	RESET_FAKE(NiFpga_ReleaseFifoElements);
+	RESET_FAKE(NiFpga_ConfigureFifo2);
+	RESET_FAKE(NiFpga_ReserveIrqContext);
+	RESET_FAKE(NiFpga_UnreserveIrqContext);
+	RESET_FAKE(NiFpga_WaitOnIrqs);
+	RESET_FAKE(NiFpga_AcknowledgeIrqs);
 	RESET_FAKE(NiFpga_Run);
 	RESET_FAKE(NiFpga_StartFifo);
 	RESET_FAKE(NiFpga_StopFifo);
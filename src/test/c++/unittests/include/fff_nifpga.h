@@ -55,8 +55,15 @@ DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ReadArrayU8, NiFpga_Session, uint32_t, uint8_t*,
 DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ReadArrayU16, NiFpga_Session, uint32_t, uint16_t*, size_t);
 
 DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ReadFifoU64, NiFpga_Session, uint32_t, uint64_t*, size_t, uint32_t, size_t*);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_AcquireFifoReadElementsU64, NiFpga_Session, uint32_t, uint64_t**, size_t, uint32_t, size_t*, size_t*);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ReleaseFifoElements, NiFpga_Session, uint32_t, size_t);
 
-DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ConfigureFifo, NiFpga_Session, uint32_t, size_t);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ConfigureFifo2, NiFpga_Session, uint32_t, size_t, size_t*);
+
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_ReserveIrqContext, NiFpga_Session, NiFpga_IrqContext*);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_UnreserveIrqContext, NiFpga_Session, NiFpga_IrqContext);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_WaitOnIrqs, NiFpga_Session, NiFpga_IrqContext, uint32_t, uint32_t, uint32_t*, NiFpga_Bool*);
+DECLARE_FAKE_NIFPGA_FUNC(NiFpga_AcknowledgeIrqs, NiFpga_Session, uint32_t);
 
 DECLARE_FAKE_NIFPGA_FUNC(NiFpga_Run, NiFpga_Session, uint32_t);
 
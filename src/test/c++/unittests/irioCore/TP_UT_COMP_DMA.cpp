@@ -199,6 +199,46 @@ TEST_F(DMATestsAdapter, getDMATtoHostData_timeout) {
 	EXPECT_EQ(ret, IRIO_success);
 }
 
+TEST_F(DMATestsAdapter, getDMAsTtoHostData) {
+	uint64_t data[4096];
+	TDMARead reads[1] = {{0, 1, data, -1, IRIO_error, Generic_Error}};
+	const auto ret = irio_getDMAsTtoHostData(&p_DrvPvt, reads, 1, &status);
+
+	EXPECT_EQ(status.code, IRIO_success) << status.msg;
+	EXPECT_EQ(ret, IRIO_success);
+	EXPECT_EQ(reads[0].code, IRIO_success);
+	EXPECT_EQ(reads[0].detailCode, Success);
+	EXPECT_EQ(reads[0].elementsRead, 1);
+}
+
+TEST_F(DMATestsAdapter, getDMAsTtoHostData_timeout) {
+	uint64_t data[4096];
+	TDMARead reads[1] = {{0, 1, data, -1, IRIO_error, Generic_Error}};
+	const auto ret = irio_getDMAsTtoHostData_timeout(&p_DrvPvt, reads, 1,
+			1000, &status);
+
+	EXPECT_EQ(status.code, IRIO_success) << status.msg;
+	EXPECT_EQ(ret, IRIO_success);
+	EXPECT_EQ(reads[0].code, IRIO_success);
+	EXPECT_EQ(reads[0].elementsRead, 1);
+}
+
+TEST_F(DMATestsAdapter, acquireReleaseDMATtoHostData) {
+	const uint64_t *data, *dataWrap;
+	size_t dataSize, dataWrapSize;
+	auto ret = irio_acquireDMATtoHostData(&p_DrvPvt, 1, 0, &data, &dataSize,
+			&dataWrap, &dataWrapSize, 1000, &status);
+
+	EXPECT_EQ(status.code, IRIO_success) << status.msg;
+	EXPECT_EQ(ret, IRIO_success);
+	EXPECT_EQ(dataWrapSize, 0);
+
+	ret = irio_releaseDMATtoHostData(&p_DrvPvt, 0, dataSize + dataWrapSize,
+			&status);
+	EXPECT_EQ(status.code, IRIO_success) << status.msg;
+	EXPECT_EQ(ret, IRIO_success);
+}
+
 /////////////////////////////////////////////////////////////////
 /////// Error DMA Tests
 /////////////////////////////////////////////////////////////////
@@ -256,13 +296,64 @@ TEST_F(ErrorDMATestsAdapter, NiFpgaErrorCleanDMA) {
 	EXPECT_EQ(ret, IRIO_warning);
 }
 
+TEST_F(ErrorDMATestsAdapter, getDMAsTtoHostDataInvalidDMA) {
+	uint64_t data0[256], data1[256];
+	TDMARead reads[2] = {{10, 1, data0, 0, IRIO_success, Success},
+						 {0, 1, data1, 0, IRIO_success, Success}};
+	const auto ret = irio_getDMAsTtoHostData(&p_DrvPvt, reads, 2, &status);
+
+	EXPECT_EQ(ret, IRIO_warning);
+	EXPECT_EQ(status.code, IRIO_warning);
+	EXPECT_EQ(reads[0].code, IRIO_warning);
+	EXPECT_EQ(reads[0].detailCode, Read_Resource_Warning);
+	EXPECT_EQ(reads[0].elementsRead, 0);
+	// The valid DMA is still read
+	EXPECT_EQ(reads[1].code, IRIO_success);
+	EXPECT_EQ(reads[1].elementsRead, 1);
+}
+
+TEST_F(ErrorDMATestsAdapter, ErrorTimeoutGetDMAsTtoHostData_timeout) {
+	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			uint64_t*, size_t, uint32_t, size_t*) {
+		return NiFpga_Status_FifoTimeout;
+	};
+
+	uint64_t data[256];
+	TDMARead reads[1] = {{0, 1, data, 0, IRIO_success, Success}};
+	const auto ret = irio_getDMAsTtoHostData_timeout(&p_DrvPvt, reads, 1,
+			1000, &status);
+
+	EXPECT_EQ(ret, IRIO_warning);
+	EXPECT_EQ(status.detailCode, Read_NIRIO_Warning);
+	EXPECT_EQ(reads[0].code, IRIO_warning);
+	EXPECT_EQ(reads[0].detailCode, Read_NIRIO_Warning);
+}
+
+TEST_F(ErrorDMATestsAdapter, ErrorFPGAGetDMAsTtoHostData) {
+	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			uint64_t*, size_t, uint32_t, size_t*) {
+		return NiFpga_Status_InternalError;
+	};
+
+	uint64_t data[256];
+	TDMARead reads[2] = {{0, 1, data, 0, IRIO_success, Success},
+						 {10, 1, data, 0, IRIO_success, Success}};
+	const auto ret = irio_getDMAsTtoHostData(&p_DrvPvt, reads, 2, &status);
+
+	EXPECT_EQ(ret, IRIO_error);
+	EXPECT_EQ(status.code, IRIO_error);
+	EXPECT_EQ(reads[0].code, IRIO_error);
+	EXPECT_EQ(reads[0].detailCode, NIRIO_API_Error);
+	EXPECT_EQ(reads[1].code, IRIO_warning);
+}
+
 TEST_F(ErrorDMATestsAdapter, ErrorTimeoutGetDMATtoHostData_timeout) {
 	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
 			uint64_t*, size_t, uint32_t, size_t*) {
 		return NiFpga_Status_FifoTimeout;
 	};
 
-	int32_t elementsRead;
+	int32_t elementsRead = -1;
 	uint64_t data[256];
 	const auto ret = irio_getDMATtoHostData_timeout(&p_DrvPvt, 1, 0, data,
 			&elementsRead, 1000, &status);
@@ -270,5 +361,26 @@ TEST_F(ErrorDMATestsAdapter, ErrorTimeoutGetDMATtoHostData_timeout) {
 	EXPECT_EQ(status.code, IRIO_warning);
 	EXPECT_EQ(status.detailCode, Read_NIRIO_Warning);
 	EXPECT_EQ(ret, IRIO_warning);
+	EXPECT_EQ(elementsRead, 0);
+}
+
+TEST_F(ErrorDMATestsAdapter, ErrorTimeoutAcquireDMATtoHostData) {
+	NiFpga_AcquireFifoReadElementsU64_fake.custom_fake = [](NiFpga_Session,
+			uint32_t, uint64_t**, size_t, uint32_t, size_t*, size_t*) {
+		return NiFpga_Status_FifoTimeout;
+	};
+
+	uint64_t dummy = 0;
+	const uint64_t *data = &dummy, *dataWrap = &dummy;
+	size_t dataSize = 1, dataWrapSize = 1;
+	const auto ret = irio_acquireDMATtoHostData(&p_DrvPvt, 1, 0, &data,
+			&dataSize, &dataWrap, &dataWrapSize, 1000, &status);
+
+	EXPECT_EQ(ret, IRIO_warning);
+	EXPECT_EQ(status.detailCode, Read_NIRIO_Warning);
+	EXPECT_EQ(data, nullptr);
+	EXPECT_EQ(dataSize, 0);
+	EXPECT_EQ(dataWrap, nullptr);
+	EXPECT_EQ(dataWrapSize, 0);
 }
 
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "bufferPool.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class BufferPoolTests: public BaseTests {
+public:
+	BufferPoolTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+	}
+
+	const std::uint16_t lengthBlockFake[2] = {42,24};
+};
+
+class ErrorBufferPoolTests: public BufferPoolTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// Buffer Pool Tests
+///////////////////////////////////////////////////////////////
+TEST_F(BufferPoolTests, acquireRelease) {
+	BufferPoolConfig config;
+	config.buffers = 3;
+	BufferPool pool(1000, config);
+
+	EXPECT_EQ(pool.countBuffers(), 3);
+	EXPECT_EQ(pool.getBufferElements(), 1000);
+	EXPECT_EQ(pool.getBufferStride() % 4096, 0);
+	EXPECT_GE(pool.getBufferStride(), 1000 * sizeof(std::uint64_t));
+
+	std::vector<std::uint64_t*> buffers;
+	while (auto buffer = pool.acquire()) {
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 4096, 0);
+		buffer[999] = buffers.size();
+		buffers.push_back(buffer);
+	}
+	EXPECT_EQ(buffers.size(), 3);
+	EXPECT_EQ(pool.countFree(), 0);
+
+	pool.release(buffers[1]);
+	EXPECT_EQ(pool.countFree(), 1);
+	EXPECT_EQ(pool.acquire(), buffers[1]);
+	EXPECT_EQ(pool.getBuffer(2), buffers[2]);
+}
+
+TEST_F(BufferPoolTests, daqBlocks) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	BufferPool pool(irio.getTerminalsDAQ(), 1, 10);
+
+	EXPECT_EQ(pool.getBufferElements(), lengthBlockFake[1] * 10);
+	std::uint64_t *buffer = pool.acquire();
+	ASSERT_NE(buffer, nullptr);
+	EXPECT_NO_THROW(irio.getTerminalsDAQ().readDataBlocking(1,
+			pool.getBufferElements(), buffer));
+	pool.release(buffer);
+}
+
+TEST_F(BufferPoolTests, pageBackings) {
+	for (const auto pages : {PageBacking::Normal, PageBacking::Transparent,
+			PageBacking::HugeTLB}) {
+		BufferPoolConfig config;
+		config.pages = pages;
+		config.buffers = 2;
+		BufferPool pool(100, config);
+		// Huge pages may not be reserved in the system
+		if (pages != PageBacking::HugeTLB) {
+			EXPECT_NE(pool.getPageBacking(), PageBacking::HugeTLB);
+		}
+		pool.acquire()[99] = 1;
+	}
+}
+
+TEST_F(BufferPoolTests, numaNode) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	BufferPoolConfig config;
+	config.numaNode = irio.getNumaNode();
+	EXPECT_GE(config.numaNode, -1);
+
+	BufferPool pool(100, config);
+	if (config.numaNode == -1) {
+		EXPECT_FALSE(pool.isNumaBound());
+	}
+}
+
+///////////////////////////////////////////////////////////////
+///// Error Buffer Pool Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorBufferPoolTests, noElements) {
+	EXPECT_THROW(BufferPool(0);, errors::BufferPoolError);
+	BufferPoolConfig config;
+	config.buffers = 0;
+	EXPECT_THROW(BufferPool(10, config);, errors::BufferPoolError);
+}
+
+TEST_F(ErrorBufferPoolTests, invalidDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(BufferPool(irio.getTerminalsDAQ(), 10, 1);,
+			errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorBufferPoolTests, releaseTwice) {
+	BufferPool pool(10);
+	std::uint64_t *buffer = pool.acquire();
+	pool.release(buffer);
+	EXPECT_THROW(pool.release(buffer), errors::BufferPoolError);
+}
+
+TEST_F(ErrorBufferPoolTests, releaseForeignBuffer) {
+	BufferPool pool(10);
+	std::uint64_t other[10];
+	EXPECT_THROW(pool.release(other), errors::BufferPoolError);
+	EXPECT_THROW(pool.release(pool.getBuffer(0) + 1), errors::BufferPoolError);
+	EXPECT_THROW(pool.getBuffer(pool.countBuffers()), errors::BufferPoolError);
+}
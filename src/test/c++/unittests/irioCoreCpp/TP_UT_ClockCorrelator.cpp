@@ -0,0 +1,208 @@
+#include <cstdint>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "clockCorrelator.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class ClockCorrelatorTests: public BaseTests {
+public:
+	ClockCorrelatorTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTFRAMETYPE).getAddress(),
+						frameTypeFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+	}
+
+	const std::uint8_t frameTypeFake[2] = {0, 1};
+	const std::uint16_t lengthBlockFake[2] = {2, 2};
+
+	// 1 MHz FPGA clock running 50 ppm slow, started at host time 5 s
+	const std::uint32_t fref = 1000000;
+	const double nsPerTick = 1000 * (1 + 50e-6);
+	const std::int64_t host0 = 5000000000;
+
+	std::int64_t hostOf(const std::uint64_t tick) const {
+		return host0 + static_cast<std::int64_t>(tick * nsPerTick);
+	}
+};
+
+class ErrorClockCorrelatorTests: public ClockCorrelatorTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// Clock Correlator Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ClockCorrelatorTests, offsetAndDrift) {
+	ClockCorrelator correlator(fref);
+	EXPECT_FALSE(correlator.isValid());
+
+	for (std::uint64_t tick = 0; tick < 100000000; tick += 1000000) {
+		correlator.addSample(tick, hostOf(tick));
+	}
+
+	EXPECT_TRUE(correlator.isValid());
+	EXPECT_NEAR(correlator.getDriftPpm(), 50, 0.01);
+	EXPECT_NEAR(correlator.toHost(123456789), hostOf(123456789), 2);
+	EXPECT_EQ(correlator.getFit().samples, 64);
+	EXPECT_LT(correlator.getFit().residualNs, 1);
+}
+
+TEST_F(ClockCorrelatorTests, nominalRateWithOneSample) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	ClockCorrelator correlator(irio.getTerminalsCommon());
+	EXPECT_EQ(correlator.getFref(), frefFake);
+
+	correlator.addSample(1000, host0);
+	EXPECT_EQ(correlator.toHost(1000 + frefFake), host0 + 1000000000);
+	EXPECT_EQ(correlator.toHost(1000), host0);
+	EXPECT_EQ(correlator.getDriftPpm(), 0);
+}
+
+TEST_F(ClockCorrelatorTests, windowFollowsRateChange) {
+	ClockCorrelatorConfig config;
+	config.window = 4;
+	ClockCorrelator correlator(fref, config);
+
+	for (std::uint64_t tick = 0; tick < 4000; tick += 1000) {
+		correlator.addSample(tick, host0 + tick * 1000);
+	}
+	EXPECT_NEAR(correlator.getDriftPpm(), 0, 1e-6);
+
+	for (std::uint64_t tick = 4000; tick < 8000; tick += 1000) {
+		correlator.addSample(tick, hostOf(tick));
+	}
+	EXPECT_NEAR(correlator.getDriftPpm(), 50, 0.01);
+	EXPECT_EQ(correlator.getFit().tickRef, 4000);
+	EXPECT_EQ(correlator.getFit().samples, 4);
+
+	correlator.reset();
+	EXPECT_FALSE(correlator.isValid());
+}
+
+TEST_F(ClockCorrelatorTests, latencySubtracted) {
+	ClockCorrelatorConfig config;
+	config.latencyNs = 500;
+	ClockCorrelator correlator(fref, config);
+	correlator.addSample(0, host0);
+	EXPECT_EQ(correlator.toHost(0), host0 - 500);
+}
+
+TEST_F(ClockCorrelatorTests, sampleHostClock) {
+	for (const auto clock : {HostClock::Realtime, HostClock::TAI}) {
+		ClockCorrelatorConfig config;
+		config.clock = clock;
+		ClockCorrelator correlator(fref, config);
+
+		const auto before = ClockCorrelator::now(clock);
+		correlator.sample(42);
+		const auto after = ClockCorrelator::now(clock);
+		EXPECT_GE(correlator.toHost(42), before);
+		EXPECT_LE(correlator.toHost(42), after);
+	}
+}
+
+TEST_F(ClockCorrelatorTests, stampBlocks) {
+	ClockCorrelator correlator(fref);
+	correlator.addSample(0, host0);
+	correlator.addSample(1000000, hostOf(1000000));
+
+	// Three FormatB blocks of two sample words plus an incomplete one
+	const std::uint64_t data[] = {0, 100, 1, 2,
+								  0, 200, 3, 4,
+								  0, 300, 5, 6,
+								  0, 400};
+	std::int64_t hostNs[3];
+	EXPECT_EQ(correlator.stampBlocks(data, 14, 2, hostNs), 3);
+	EXPECT_NEAR(hostNs[0], hostOf(100), 1);
+	EXPECT_NEAR(hostNs[1], hostOf(200), 1);
+	EXPECT_NEAR(hostNs[2], hostOf(300), 1);
+}
+
+TEST_F(ClockCorrelatorTests, readBlocks) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	ClockCorrelator correlator(irio.getTerminalsCommon());
+
+	// The fake FIFO leaves the buffer untouched
+	std::uint64_t data[] = {0, 1000, 1, 2,
+							0, 2000, 3, 4};
+	std::int64_t hostNs[2];
+	const auto before = ClockCorrelator::now(HostClock::Realtime);
+	EXPECT_EQ(correlator.readBlocks(irio.getTerminalsDAQ(), 1, 2, data, hostNs),
+			2);
+	const auto after = ClockCorrelator::now(HostClock::Realtime);
+
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_val, 8);
+	EXPECT_GE(hostNs[1], before);
+	EXPECT_LE(hostNs[1], after);
+	EXPECT_NEAR(hostNs[1] - hostNs[0], 1e12 / frefFake, 1);
+}
+
+TEST_F(ClockCorrelatorTests, readBlocksBacklog) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	ClockCorrelator correlator(fref);
+	correlator.addSample(0, host0);
+
+	// Two more blocks remain queued after the read
+	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			uint64_t*, size_t, uint32_t, size_t *elementsRemaining) {
+		if (elementsRemaining) {
+			*elementsRemaining = 8;
+		}
+		return NiFpga_Status_Success;
+	};
+	std::uint64_t data[] = {0, 1000, 1, 2,
+							0, 2000, 3, 4};
+	std::int64_t hostNs[2];
+	EXPECT_EQ(correlator.readBlocks(irio.getTerminalsDAQ(), 1, 2, data, hostNs),
+			2);
+
+	EXPECT_EQ(correlator.getFit().samples, 1);
+	EXPECT_NEAR(hostNs[1], host0 + 2000 * 1000, 1);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error Clock Correlator Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorClockCorrelatorTests, invalidConfig) {
+	EXPECT_THROW(ClockCorrelator(0);, errors::ClockCorrelationError);
+	ClockCorrelatorConfig config;
+	config.window = 0;
+	EXPECT_THROW(ClockCorrelator(fref, config);,
+			errors::ClockCorrelationError);
+}
+
+TEST_F(ErrorClockCorrelatorTests, noSamples) {
+	ClockCorrelator correlator(fref);
+	const std::uint64_t data[] = {0, 100, 1, 2};
+	std::int64_t hostNs[1];
+	EXPECT_THROW(correlator.toHost(0), errors::ClockCorrelationError);
+	EXPECT_THROW(correlator.stampBlocks(data, 4, 2, hostNs),
+			errors::ClockCorrelationError);
+}
+
+TEST_F(ErrorClockCorrelatorTests, notFormatB) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	ClockCorrelator correlator(fref);
+	std::uint64_t data[2];
+	std::int64_t hostNs[1];
+	EXPECT_THROW(correlator.readBlocks(irio.getTerminalsDAQ(), 0, 1, data,
+			hostNs), errors::DAQFormatMismatchError);
+	EXPECT_THROW(correlator.readBlocks(irio.getTerminalsDAQ(), 10, 1, data,
+			hostNs), errors::ResourceNotFoundError);
+}
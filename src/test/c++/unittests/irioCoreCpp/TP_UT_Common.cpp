@@ -119,6 +119,19 @@ TEST_F(CommonTests, closeAttribute) {
 	);
 }
 
+TEST_F(CommonTests, LazyConstruction) {
+	Irio irio(bitfilePath, "0", "V9.9", false, TerminalsConstruction::Lazy);
+	EXPECT_EQ(irio.getTerminalsCommon().getFref(), frefFake);
+	EXPECT_NO_THROW(irio.getTerminalsAnalog(););
+	EXPECT_NO_THROW(irio.validateTerminals(););
+	EXPECT_NO_THROW(irio.getTerminalsDAQ(););
+}
+
+TEST_F(CommonTests, ValidateTerminalsEager) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_NO_THROW(irio.validateTerminals(););
+}
+
 ///////////////////////////////////////////////////////////////
 ///// Error Common Tests
 ///////////////////////////////////////////////////////////////
@@ -0,0 +1,152 @@
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "daqBlockView.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class DAQBlockViewTests: public BaseTests {
+public:
+	DAQBlockViewTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTFRAMETYPE).getAddress(),
+						frameTypeFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTSAMPLESIZE).getAddress(),
+						sampleSizeFake, 2);
+	}
+
+	const std::uint16_t nchFake[2] = {2,2};
+	const std::uint8_t frameTypeFake[2] = {0, 1};
+	const std::uint16_t lengthBlockFake[2] = {2,2};
+	const std::uint8_t sampleSizeFake[2] = {2,2};
+
+	// Two channels of int16 samples: ch0 = 1,2,3,4 ch1 = -1,-2,-3,-4
+	const std::uint64_t wordA = 0xFFFE0002FFFF0001;
+	const std::uint64_t wordB = 0xFFFC0004FFFD0003;
+};
+
+class ErrorDAQBlockViewTests: public DAQBlockViewTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// DAQ Block View Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DAQBlockViewTests, blockFormatA) {
+	const std::uint64_t data[] = {wordA, wordB};
+	const DAQBlock<FrameType::FormatA, 2> block(data, 2, 2);
+
+	EXPECT_EQ(block.words(), 2);
+	EXPECT_EQ(block.samples(), 8);
+	EXPECT_EQ(block.samplesPerChannel(), 4);
+	for (size_t i = 0; i < 4; ++i) {
+		EXPECT_EQ(block.sample(0, i), static_cast<std::int16_t>(i + 1));
+		EXPECT_EQ(block.sample(1, i), -static_cast<std::int16_t>(i + 1));
+	}
+}
+
+TEST_F(DAQBlockViewTests, blockFormatB) {
+	const std::uint64_t data[] = {0xAA, 123456789, wordA, wordB};
+	const DAQBlock<FrameType::FormatB, 2> block(data, 2, 2);
+
+	EXPECT_EQ(block.words(), 4);
+	EXPECT_EQ(block.header(), 0xAA);
+	EXPECT_EQ(block.timestamp(), 123456789);
+	EXPECT_EQ(block.payload(), data + 2);
+	EXPECT_EQ(block.sample(1, 3), -4);
+}
+
+TEST_F(DAQBlockViewTests, copyChannel) {
+	const std::uint64_t data[] = {wordA, wordB};
+	const DAQBlock<FrameType::FormatA, 2> block(data, 2, 2);
+
+	std::vector<std::int32_t> channel;
+	block.copyChannel(1, std::back_inserter(channel));
+	EXPECT_EQ(channel, std::vector<std::int32_t>({-1, -2, -3, -4}));
+}
+
+TEST_F(DAQBlockViewTests, iterateBlocks) {
+	// Three FormatB blocks plus an incomplete one
+	const std::uint64_t data[] = {0, 10, wordA, wordB,
+								  1, 20, wordA, wordB,
+								  2, 30, wordA, wordB,
+								  3, 40};
+	const DAQBlockView<FrameType::FormatB, 2> view(data, 14, 2, 2);
+
+	EXPECT_EQ(view.size(), 3);
+	std::uint64_t expectedHeader = 0;
+	for (const auto block : view) {
+		EXPECT_EQ(block.header(), expectedHeader);
+		EXPECT_EQ(block.timestamp(), (expectedHeader + 1) * 10);
+		++expectedHeader;
+	}
+	EXPECT_EQ(expectedHeader, 3);
+	EXPECT_EQ(view[2].raw(), data + 8);
+}
+
+TEST_F(DAQBlockViewTests, emptyBlocks) {
+	const std::uint64_t data[] = {wordA, wordB};
+	const DAQBlockView<FrameType::FormatA, 2> view(data, 2, 0, 2);
+
+	EXPECT_EQ(view.size(), 0);
+	EXPECT_TRUE(view.begin() == view.end());
+}
+
+TEST_F(DAQBlockViewTests, makeDAQBlockView) {
+	const std::uint64_t data[] = {0, 10, wordA, wordB};
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto view = makeDAQBlockView<FrameType::FormatB, 2>(
+			irio.getTerminalsDAQ(), 1, data, 4);
+	EXPECT_EQ(view.size(), 1);
+	EXPECT_EQ(view[0].sample(0, 1), 2);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DAQ Block View Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDAQBlockViewTests, frameTypeMismatch) {
+	const std::uint64_t data[] = {wordA, wordB};
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW((makeDAQBlockView<FrameType::FormatB, 2>(
+			irio.getTerminalsDAQ(), 0, data, 2));,
+			errors::DAQFormatMismatchError);
+}
+
+TEST_F(ErrorDAQBlockViewTests, sampleSizeMismatch) {
+	const std::uint64_t data[] = {wordA, wordB};
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW((makeDAQBlockView<FrameType::FormatA, 4>(
+			irio.getTerminalsDAQ(), 0, data, 2));,
+			errors::DAQFormatMismatchError);
+}
+
+TEST_F(ErrorDAQBlockViewTests, noLengthBlock) {
+	const std::uint16_t noLengthBlock[2] = {0, 2};
+	setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+					bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+					noLengthBlock, 2);
+	const std::uint64_t data[] = {wordA, wordB};
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW((makeDAQBlockView<FrameType::FormatA, 2>(
+			irio.getTerminalsDAQ(), 0, data, 2));,
+			errors::DAQFormatMismatchError);
+}
@@ -0,0 +1,396 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "daqDecimator.h"
+#include "errorsIrio.h"
+
+
+using namespace irio;
+
+namespace {
+
+/// Reduced-rate samples of every output, concatenated across calls
+using Collected = std::vector<std::vector<std::vector<float>>>;
+
+demux::DemuxLayout makeLayout(const std::uint16_t nCh,
+		const size_t lengthBlock, const size_t headerWords = 2) {
+	demux::DemuxLayout layout;
+	layout.nCh = nCh;
+	layout.lengthBlock = lengthBlock;
+	layout.headerWords = headerWords;
+	layout.sampleSize = 2;
+	return layout;
+}
+
+/**
+ * Interleaves the channels in blocks of 16-bit samples. Each channel must
+ * have nBlocks * samplesPerChannel() samples
+ */
+std::vector<std::uint64_t> makeBlocks(const demux::DemuxLayout &layout,
+		const std::vector<std::vector<std::int16_t>> &channels,
+		const size_t nBlocks) {
+	const size_t perChannel = layout.samplesPerChannel();
+	std::vector<std::uint64_t> data(layout.blockWords() * nBlocks, 0);
+	for (size_t b = 0; b < nBlocks; ++b) {
+		std::vector<std::int16_t> samples(layout.lengthBlock * 4, 0);
+		for (size_t i = 0; i < perChannel; ++i) {
+			for (size_t ch = 0; ch < layout.nCh; ++ch) {
+				samples[i * layout.nCh + ch] = channels[ch][b * perChannel + i];
+			}
+		}
+		std::memcpy(&data[b * layout.blockWords() + layout.headerWords],
+				samples.data(), layout.lengthBlock * sizeof(std::uint64_t));
+	}
+	return data;
+}
+
+/// Registers a callback appending the samples of every output to \p out
+void collect(DAQDecimator *decimator, const demux::DemuxLayout &layout,
+		Collected *out) {
+	out->assign(decimator->countOutputs(),
+			std::vector<std::vector<float>>(layout.nCh));
+	decimator->setCallback([out](const size_t output,
+			const float *const *channels, const size_t samples) {
+		for (size_t ch = 0; ch < (*out)[output].size(); ++ch) {
+			(*out)[output][ch].insert((*out)[output][ch].end(), channels[ch],
+					channels[ch] + samples);
+		}
+	});
+}
+
+std::vector<std::vector<std::int16_t>> randomChannels(const size_t nCh,
+		const size_t samples) {
+	std::mt19937 rng(static_cast<unsigned>(nCh * 1000 + samples));
+	std::uniform_int_distribution<int> dist(-32768, 32767);
+	std::vector<std::vector<std::int16_t>> channels(nCh,
+			std::vector<std::int16_t>(samples));
+	for (auto &channel : channels) {
+		for (auto &sample : channel) {
+			sample = static_cast<std::int16_t>(dist(rng));
+		}
+	}
+	return channels;
+}
+
+DecimatorOutputConfig makeOutput(const DecimationFilter filter,
+		const size_t factor) {
+	DecimatorOutputConfig config;
+	config.filter = filter;
+	config.factor = factor;
+	if (filter == DecimationFilter::FIR) {
+		config.taps = {0.1f, -0.25f, 0.5f, 1.0f, 0.5f, -0.25f, 0.1f, 0.05f,
+				0.02f};
+	}
+	return config;
+}
+
+void expectNear(const std::vector<float> &result,
+		const std::vector<float> &expected) {
+	ASSERT_EQ(result.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		EXPECT_NEAR(result[i], expected[i],
+				1e-5 * std::max(1.0f, std::fabs(expected[i])))
+				<< "sample " << i;
+	}
+}
+
+/// Restores the SIMD level detected when leaving the scope
+struct SimdLevelGuard {
+	~SimdLevelGuard() {
+		demux::setSimdLevel(demux::detectSimdLevel());
+	}
+};
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////
+///// DAQ Decimator Tests
+///////////////////////////////////////////////////////////////
+TEST(DAQDecimatorTests, boxCarMean) {
+	// 16 samples per channel and block
+	const auto layout = makeLayout(2, 8);
+	std::vector<std::vector<std::int16_t>> channels(2);
+	for (int i = 0; i < 32; ++i) {
+		channels[0].push_back(static_cast<std::int16_t>(i));
+		channels[1].push_back(static_cast<std::int16_t>(-2 * i));
+	}
+	const auto data = makeBlocks(layout, channels, 2);
+
+	auto config = makeOutput(DecimationFilter::BoxCar, 4);
+	config.scale = 0.5f;
+	DAQDecimator decimator(layout, {config});
+	decimator.process(data.data(), 2);
+
+	ASSERT_EQ(decimator.getSamples(0), 8);
+	for (size_t k = 0; k < 8; ++k) {
+		const float mean = 4.0f * k + 1.5f;
+		EXPECT_FLOAT_EQ(decimator.getChannel(0, 0)[k], mean * 0.5f);
+		EXPECT_FLOAT_EQ(decimator.getChannel(0, 1)[k], -mean);
+	}
+}
+
+TEST(DAQDecimatorTests, boxCarAcrossBlocks) {
+	// Factor 5 does not divide the 16 samples of a block
+	const auto layout = makeLayout(1, 4);
+	std::vector<std::vector<std::int16_t>> channels(1,
+			std::vector<std::int16_t>(48, 3));
+	const auto data = makeBlocks(layout, channels, 3);
+
+	DAQDecimator decimator(layout,
+			{makeOutput(DecimationFilter::BoxCar, 5)});
+	std::vector<size_t> produced;
+	for (size_t b = 0; b < 3; ++b) {
+		decimator.process(&data[b * layout.blockWords()], 1);
+		produced.push_back(decimator.getSamples(0));
+		for (size_t i = 0; i < decimator.getSamples(0); ++i) {
+			EXPECT_FLOAT_EQ(decimator.getChannel(0, 0)[i], 3.0f);
+		}
+	}
+	EXPECT_EQ(produced, std::vector<size_t>({3, 3, 3}));
+}
+
+TEST(DAQDecimatorTests, cicConstant) {
+	const auto layout = makeLayout(3, 16);
+	const size_t samples = 4 * layout.samplesPerChannel();
+	std::vector<std::vector<std::int16_t>> channels = {
+			std::vector<std::int16_t>(samples, 100),
+			std::vector<std::int16_t>(samples, -32768),
+			std::vector<std::int16_t>(samples, 32767)};
+	const auto data = makeBlocks(layout, channels, 4);
+
+	auto config = makeOutput(DecimationFilter::CIC, 8);
+	config.cicStages = 4;
+	DAQDecimator decimator(layout, {config});
+	decimator.process(data.data(), 4);
+
+	ASSERT_EQ(decimator.getSamples(0), samples / 8);
+	// After the transient of one output per stage, the gain is 1
+	for (size_t k = config.cicStages; k < samples / 8; ++k) {
+		EXPECT_FLOAT_EQ(decimator.getChannel(0, 0)[k], 100.0f);
+		EXPECT_FLOAT_EQ(decimator.getChannel(0, 1)[k], -32768.0f);
+		EXPECT_FLOAT_EQ(decimator.getChannel(0, 2)[k], 32767.0f);
+	}
+}
+
+TEST(DAQDecimatorTests, cicMatchesReference) {
+	const auto layout = makeLayout(1, 16);
+	const size_t samples = 5 * layout.samplesPerChannel();
+	const auto channels = randomChannels(1, samples);
+	const auto data = makeBlocks(layout, channels, 5);
+	const size_t factor = 7;
+	const unsigned stages = 3;
+
+	// Integrators, decimation and combs with exact integer arithmetic
+	std::int64_t acc[stages] = {}, comb[stages] = {};
+	std::vector<float> expected;
+	for (size_t i = 0; i < samples; ++i) {
+		std::int64_t v = channels[0][i];
+		for (unsigned s = 0; s < stages; ++s) {
+			v = acc[s] += v;
+		}
+		if ((i + 1) % factor == 0) {
+			for (unsigned s = 0; s < stages; ++s) {
+				const std::int64_t delayed = comb[s];
+				comb[s] = v;
+				v -= delayed;
+			}
+			expected.push_back(static_cast<float>(v / 343.0));
+		}
+	}
+
+	auto config = makeOutput(DecimationFilter::CIC, factor);
+	config.cicStages = stages;
+	DAQDecimator decimator(layout, {config});
+	decimator.process(data.data(), 5);
+	expectNear(std::vector<float>(decimator.getChannel(0, 0),
+			decimator.getChannel(0, 0) + decimator.getSamples(0)), expected);
+}
+
+TEST(DAQDecimatorTests, firMatchesReference) {
+	const auto layout = makeLayout(3, 20);
+	const size_t samples = 4 * layout.samplesPerChannel();
+	const auto channels = randomChannels(3, samples);
+	const auto data = makeBlocks(layout, channels, 4);
+	const auto config = makeOutput(DecimationFilter::FIR, 3);
+
+	DAQDecimator decimator(layout, {config});
+	decimator.process(data.data(), 4);
+
+	for (size_t ch = 0; ch < 3; ++ch) {
+		std::vector<float> expected;
+		for (size_t n = 2; n < samples; n += 3) {
+			double y = 0.0;
+			for (size_t k = 0; k < config.taps.size() && k <= n; ++k) {
+				y += config.taps[k] * channels[ch][n - k];
+			}
+			expected.push_back(static_cast<float>(y));
+		}
+		expectNear(std::vector<float>(decimator.getChannel(0, ch),
+				decimator.getChannel(0, ch) + decimator.getSamples(0)),
+				expected);
+	}
+}
+
+TEST(DAQDecimatorTests, chunkedEqualsOneShot) {
+	const auto layout = makeLayout(4, 30);
+	const size_t nBlocks = 7;
+	const auto channels = randomChannels(4,
+			nBlocks * layout.samplesPerChannel());
+	const auto data = makeBlocks(layout, channels, nBlocks);
+	const std::vector<DecimatorOutputConfig> outputs = {
+			makeOutput(DecimationFilter::BoxCar, 11),
+			makeOutput(DecimationFilter::CIC, 6),
+			makeOutput(DecimationFilter::FIR, 4)};
+
+	DAQDecimator oneShot(layout, outputs);
+	Collected expected;
+	collect(&oneShot, layout, &expected);
+	oneShot.process(data.data(), nBlocks);
+
+	DAQDecimator chunked(layout, outputs);
+	Collected result;
+	collect(&chunked, layout, &result);
+	const size_t chunks[] = {1, 3, 2, 1};
+	size_t block = 0;
+	for (const size_t n : chunks) {
+		chunked.process(&data[block * layout.blockWords()], n);
+		block += n;
+	}
+
+	EXPECT_EQ(result, expected);
+}
+
+TEST(DAQDecimatorTests, simdLevelsAgree) {
+	const SimdLevelGuard guard;
+	const auto layout = makeLayout(5, 64);
+	const size_t nBlocks = 3;
+	const auto channels = randomChannels(5,
+			nBlocks * layout.samplesPerChannel());
+	const auto data = makeBlocks(layout, channels, nBlocks);
+	const std::vector<DecimatorOutputConfig> outputs = {
+			makeOutput(DecimationFilter::BoxCar, 13),
+			makeOutput(DecimationFilter::FIR, 2)};
+
+	demux::setSimdLevel(demux::SimdLevel::Scalar);
+	DAQDecimator scalar(layout, outputs);
+	Collected expected;
+	collect(&scalar, layout, &expected);
+	scalar.process(data.data(), nBlocks);
+
+	const auto best = demux::detectSimdLevel();
+	for (auto level = demux::SimdLevel::AVX2; level <= best;
+			level = static_cast<demux::SimdLevel>(
+					static_cast<int>(level) + 1)) {
+		EXPECT_EQ(demux::setSimdLevel(level), level);
+		DAQDecimator decimator(layout, outputs);
+		Collected result;
+		collect(&decimator, layout, &result);
+		decimator.process(data.data(), nBlocks);
+
+		// Integer sums are exact, dot products may be reordered
+		EXPECT_EQ(result[0], expected[0]);
+		for (size_t ch = 0; ch < layout.nCh; ++ch) {
+			expectNear(result[1][ch], expected[1][ch]);
+		}
+	}
+}
+
+TEST(DAQDecimatorTests, attachForwardsFullRate) {
+	const auto layout = makeLayout(2, 8);
+	const auto data = makeBlocks(layout,
+			std::vector<std::vector<std::int16_t>>(2,
+					std::vector<std::int16_t>(32, 1)), 2);
+	DAQDecimator decimator(layout,
+			{makeOutput(DecimationFilter::BoxCar, 16)});
+	size_t calls = 0;
+	decimator.setCallback([&calls](const size_t, const float *const *,
+			const size_t samples) {
+		EXPECT_EQ(samples, 2);
+		++calls;
+	});
+
+	std::vector<std::uint32_t> forwarded;
+	const auto callback = decimator.attach(1, [&forwarded, &data](
+			const std::uint32_t n, const std::uint64_t *chunk,
+			const size_t elements) {
+		EXPECT_EQ(chunk, data.data());
+		EXPECT_EQ(elements, data.size());
+		forwarded.push_back(n);
+	});
+	callback(0, data.data(), data.size());
+	EXPECT_EQ(calls, 0);
+	callback(1, data.data(), data.size());
+	EXPECT_EQ(calls, 1);
+	EXPECT_EQ(forwarded, std::vector<std::uint32_t>({0, 1}));
+
+	// Without consumer of the full-rate stream
+	decimator.attach(1)(1, data.data(), data.size());
+	EXPECT_EQ(calls, 2);
+}
+
+TEST(DAQDecimatorTests, reset) {
+	const auto layout = makeLayout(1, 4);
+	const auto channels = randomChannels(1, 32);
+	const auto data = makeBlocks(layout, channels, 2);
+	const std::vector<DecimatorOutputConfig> outputs = {
+			makeOutput(DecimationFilter::CIC, 5),
+			makeOutput(DecimationFilter::FIR, 5)};
+
+	DAQDecimator decimator(layout, outputs);
+	Collected first, second;
+	collect(&decimator, layout, &first);
+	decimator.process(data.data(), 2);
+	collect(&decimator, layout, &second);
+	decimator.reset();
+	decimator.process(data.data(), 2);
+
+	EXPECT_EQ(second, first);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DAQ Decimator Tests
+///////////////////////////////////////////////////////////////
+TEST(ErrorDAQDecimatorTests, invalidLayout) {
+	auto layout = makeLayout(2, 8);
+	layout.sampleSize = 8;
+	EXPECT_THROW(DAQDecimator(layout, {DecimatorOutputConfig()}),
+			errors::DAQFormatMismatchError);
+	EXPECT_THROW(DAQDecimator(makeLayout(0, 8), {DecimatorOutputConfig()}),
+			errors::DAQFormatMismatchError);
+}
+
+TEST(ErrorDAQDecimatorTests, invalidConfig) {
+	const auto layout = makeLayout(2, 8);
+	EXPECT_THROW(DAQDecimator(layout, {}), errors::DecimatorConfigError);
+
+	EXPECT_THROW(DAQDecimator(layout, {makeOutput(DecimationFilter::BoxCar,
+			0)}), errors::DecimatorConfigError);
+
+	auto fir = makeOutput(DecimationFilter::FIR, 4);
+	fir.taps.clear();
+	EXPECT_THROW(DAQDecimator(layout, {fir}), errors::DecimatorConfigError);
+
+	auto cic = makeOutput(DecimationFilter::CIC, 4);
+	cic.cicStages = 0;
+	EXPECT_THROW(DAQDecimator(layout, {cic}), errors::DecimatorConfigError);
+	cic.cicStages = DAQDecimator::MAX_CIC_STAGES + 1;
+	EXPECT_THROW(DAQDecimator(layout, {cic}), errors::DecimatorConfigError);
+
+	// 16 bits + 6 stages * 10 bits do not fit
+	cic.cicStages = 6;
+	cic.factor = 1000;
+	EXPECT_THROW(DAQDecimator(layout, {cic}), errors::DecimatorConfigError);
+	cic.factor = 128;
+	EXPECT_NO_THROW(DAQDecimator(layout, {cic}));
+}
+
+TEST(ErrorDAQDecimatorTests, invalidOutput) {
+	DAQDecimator decimator(makeLayout(2, 8), {DecimatorOutputConfig()});
+	EXPECT_THROW(decimator.getSamples(1), errors::DecimatorConfigError);
+	EXPECT_THROW(decimator.getChannel(1, 0), errors::DecimatorConfigError);
+	EXPECT_THROW(decimator.getChannel(0, 2), errors::DecimatorConfigError);
+}
@@ -0,0 +1,220 @@
+#include <random>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "daqDemux.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class DAQDemuxTests: public BaseTests {
+public:
+	DAQDemuxTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTFRAMETYPE).getAddress(),
+						frameTypeFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTSAMPLESIZE).getAddress(),
+						sampleSizeFake, 2);
+	}
+
+	~DAQDemuxTests() {
+		demux::setSimdLevel(demux::detectSimdLevel());
+	}
+
+	/**
+	 * Demuxes random blocks with every SIMD level available and checks
+	 * they produce exactly the same output as the scalar path
+	 */
+	template<typename T>
+	void checkBitExact(const demux::DemuxLayout &layout, const size_t nBlocks,
+			const float scale = 1.0f) {
+		std::mt19937_64 rng(layout.nCh * 1000 + layout.lengthBlock);
+		std::vector<std::uint64_t> data(layout.blockWords() * nBlocks);
+		for (auto &word : data) {
+			word = rng();
+		}
+
+		const size_t samples = nBlocks * layout.samplesPerChannel();
+		std::vector<std::vector<T>> expected(layout.nCh,
+				std::vector<T>(samples));
+		demux::setSimdLevel(demux::SimdLevel::Scalar);
+		EXPECT_EQ(runDemux(layout, data, nBlocks, &expected, scale), samples);
+
+		const auto best = demux::detectSimdLevel();
+		for (auto level = demux::SimdLevel::AVX2; level <= best;
+				level = static_cast<demux::SimdLevel>(
+						static_cast<int>(level) + 1)) {
+			std::vector<std::vector<T>> result(layout.nCh,
+					std::vector<T>(samples));
+			EXPECT_EQ(demux::setSimdLevel(level), level);
+			EXPECT_EQ(runDemux(layout, data, nBlocks, &result, scale),
+					samples);
+			EXPECT_EQ(result, expected) << "nCh " << layout.nCh
+					<< ", level " << static_cast<int>(level);
+		}
+	}
+
+	template<typename T>
+	size_t runDemux(const demux::DemuxLayout &layout,
+			const std::vector<std::uint64_t> &data, const size_t nBlocks,
+			std::vector<std::vector<T>> *out, const float) {
+		std::vector<T*> channels;
+		for (auto &channel : *out) {
+			channels.push_back(channel.data());
+		}
+		return demux::demux(layout, data.data(), nBlocks, channels.data());
+	}
+
+	size_t runDemux(const demux::DemuxLayout &layout,
+			const std::vector<std::uint64_t> &data, const size_t nBlocks,
+			std::vector<std::vector<float>> *out, const float scale) {
+		std::vector<float*> channels;
+		for (auto &channel : *out) {
+			channels.push_back(channel.data());
+		}
+		return demux::demux(layout, data.data(), nBlocks, channels.data(),
+				scale);
+	}
+
+	static demux::DemuxLayout makeLayout(const std::uint16_t nCh,
+			const size_t lengthBlock, const size_t headerWords,
+			const std::uint8_t sampleSize = 2) {
+		demux::DemuxLayout layout;
+		layout.nCh = nCh;
+		layout.lengthBlock = lengthBlock;
+		layout.headerWords = headerWords;
+		layout.sampleSize = sampleSize;
+		return layout;
+	}
+
+	const std::uint16_t nchFake[2] = {4,3};
+	const std::uint8_t frameTypeFake[2] = {0, 1};
+	const std::uint16_t lengthBlockFake[2] = {64,48};
+	const std::uint8_t sampleSizeFake[2] = {2,2};
+
+	const std::vector<std::uint16_t> channelsToTest = {1, 2, 3, 4, 5, 8, 16};
+};
+
+class ErrorDAQDemuxTests: public DAQDemuxTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// DAQ Demux Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DAQDemuxTests, getDemuxLayout) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto layout = demux::getDemuxLayout(irio.getTerminalsDAQ(), 1);
+	EXPECT_EQ(layout.nCh, 3);
+	EXPECT_EQ(layout.lengthBlock, 48);
+	EXPECT_EQ(layout.headerWords, 2);
+	EXPECT_EQ(layout.sampleSize, 2);
+	EXPECT_EQ(layout.samplesPerChannel(), 64);
+}
+
+TEST_F(DAQDemuxTests, setSimdLevel) {
+	EXPECT_EQ(demux::setSimdLevel(demux::SimdLevel::Scalar),
+			demux::SimdLevel::Scalar);
+	EXPECT_EQ(demux::getSimdLevel(), demux::SimdLevel::Scalar);
+	EXPECT_EQ(demux::setSimdLevel(demux::SimdLevel::AVX512),
+			demux::detectSimdLevel());
+}
+
+TEST_F(DAQDemuxTests, scalarValues) {
+	// Two blocks, FormatB, two channels: ch0 = 1..4 ch1 = -1..-4
+	const std::uint64_t data[] = {
+			0, 0, 0xFFFE0002FFFF0001, 0xFFFC0004FFFD0003,
+			0, 0, 0xFFFE0002FFFF0001, 0xFFFC0004FFFD0003};
+	std::int16_t ch0[8], ch1[8];
+	std::int16_t *channels[] = {ch0, ch1};
+
+	demux::setSimdLevel(demux::SimdLevel::Scalar);
+	EXPECT_EQ(demux::demux(makeLayout(2, 2, 2), data, 2, channels), 8);
+	for (size_t i = 0; i < 8; ++i) {
+		EXPECT_EQ(ch0[i], static_cast<std::int16_t>(i % 4 + 1));
+		EXPECT_EQ(ch1[i], -static_cast<std::int16_t>(i % 4 + 1));
+	}
+}
+
+TEST_F(DAQDemuxTests, bitExactInt16) {
+	for (const auto nCh : channelsToTest) {
+		checkBitExact<std::int16_t>(makeLayout(nCh, 64, 0), 3);
+		checkBitExact<std::int16_t>(makeLayout(nCh, 37, 2), 3);
+	}
+}
+
+TEST_F(DAQDemuxTests, bitExactInt32) {
+	for (const auto nCh : channelsToTest) {
+		checkBitExact<std::int32_t>(makeLayout(nCh, 64, 0), 3);
+		checkBitExact<std::int32_t>(makeLayout(nCh, 37, 2), 3);
+	}
+}
+
+TEST_F(DAQDemuxTests, bitExactFloat) {
+	const ModuleNI5761 module;
+	for (const auto nCh : channelsToTest) {
+		checkBitExact<float>(makeLayout(nCh, 64, 0), 3,
+				static_cast<float>(module.getCVADC()));
+		checkBitExact<float>(makeLayout(nCh, 37, 2), 3, 0.5f);
+	}
+}
+
+TEST_F(DAQDemuxTests, cvadcScaling) {
+	const std::uint64_t data[] = {0x0000000000000002};
+	float ch0[4];
+	float *channels[] = {ch0};
+	const ModuleNI5761 module;
+
+	demux::demux(makeLayout(1, 1, 0), data, 1, channels, module);
+	EXPECT_EQ(ch0[0], 2.0f * static_cast<float>(module.getCVADC()));
+	EXPECT_EQ(ch0[1], 0.0f);
+}
+
+TEST_F(DAQDemuxTests, otherSampleSizes) {
+	// Sample size 4, two channels, one word per sample pair
+	const std::uint64_t data[] = {0xFFFFFFFF00000007, 0x0000000500000006};
+	std::int32_t ch0[2], ch1[2];
+	std::int32_t *channels[] = {ch0, ch1};
+
+	EXPECT_EQ(demux::demux(makeLayout(2, 2, 0, 4), data, 1, channels), 2);
+	EXPECT_EQ(ch0[0], 7);
+	EXPECT_EQ(ch1[0], -1);
+	EXPECT_EQ(ch0[1], 6);
+	EXPECT_EQ(ch1[1], 5);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DAQ Demux Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDAQDemuxTests, sampleSizeDoesNotFit) {
+	const std::uint64_t data[] = {0};
+	std::int16_t ch0[1];
+	std::int16_t *channels[] = {ch0};
+	EXPECT_THROW(demux::demux(makeLayout(1, 1, 0, 4), data, 1, channels);,
+			errors::DAQFormatMismatchError);
+}
+
+TEST_F(ErrorDAQDemuxTests, noChannels) {
+	const std::uint64_t data[] = {0};
+	std::int32_t *channels[] = {nullptr};
+	EXPECT_THROW(demux::demux(makeLayout(0, 1, 0), data, 1, channels);,
+			errors::DAQFormatMismatchError);
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 
 #include "fixtures.h"
 #include "fff_nifpga.h"
@@ -146,7 +147,12 @@ TEST_F(DMACPUCommonTests, startDMA) {
     SET_CUSTOM_FAKE_SEQ(NiFpga_ReadFifoU64, custom_fakes, 2);
 
 	Irio irio(bitfilePath, "0", "V9.9");
-	EXPECT_NO_THROW(irio.getTerminalsDAQ().startDMA(0));
+	size_t discarded = 0;
+	EXPECT_NO_THROW(discarded = irio.getTerminalsDAQ().startDMA(0));
+	EXPECT_EQ(discarded, 100);
+	// Stale data is released in place, never read into a buffer
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 1);
+	EXPECT_EQ(NiFpga_ReleaseFifoElements_fake.arg2_val, 100);
 }
 
 TEST_F(DMACPUCommonTests, startAllDMAs) {
@@ -154,6 +160,31 @@ TEST_F(DMACPUCommonTests, startAllDMAs) {
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().startAllDMAs());
 }
 
+TEST_F(DMACPUCommonTests, hostDepth) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	auto term = irio.getTerminalsDAQ();
+	EXPECT_EQ(term.getEffectiveHostDepth(0), 0);
+	EXPECT_NO_THROW(term.setHostDepth(0, 4096));
+	EXPECT_EQ(term.getHostDepth(0), 4096);
+	EXPECT_NO_THROW(term.startAllDMAs());
+	EXPECT_EQ(term.getEffectiveHostDepth(0), 4096);
+}
+
+TEST_F(DMACPUCommonTests, hostDepthGranted) {
+	NiFpga_ConfigureFifo2_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			size_t requestedDepth, size_t* actualDepth) {
+		*actualDepth = requestedDepth + 100;
+		return NiFpga_Status_Success;
+	};
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	auto term = irio.getTerminalsDAQ();
+	term.setHostDepth(1, 1000);
+	term.startAllDMAs();
+	EXPECT_EQ(term.getHostDepth(1), 1000);
+	EXPECT_EQ(term.getEffectiveHostDepth(1), 1100);
+}
+
 TEST_F(DMACPUCommonTests, stopDMA) {
 	Irio irio(bitfilePath, "0", "V9.9");
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().stopDMA(0));
@@ -169,6 +200,27 @@ TEST_F(DMACPUCommonTests, cleanDMA) {
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().cleanDMA(0));
 }
 
+NiFpga_Status funcAcquireUpTo60(NiFpga_Session, uint32_t,
+		uint64_t **elements, size_t elementsRequested, uint32_t,
+		size_t *elementsAcquired, size_t *elementsRemaining) {
+	static uint64_t hostBuffer[60] = {};
+	*elements = hostBuffer;
+	*elementsAcquired = elementsRequested > 60 ? 60 : elementsRequested;
+	*elementsRemaining = elementsRequested - *elementsAcquired;
+	return NiFpga_Status_Success;
+}
+
+TEST_F(DMACPUCommonTests, cleanDMADiscarded) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReturnElemRem;
+	NiFpga_AcquireFifoReadElementsU64_fake.custom_fake = funcAcquireUpTo60;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().cleanDMA(0), 100);
+	EXPECT_EQ(NiFpga_AcquireFifoReadElementsU64_fake.call_count, 2);
+	EXPECT_EQ(NiFpga_ReleaseFifoElements_fake.arg2_history[0], 60);
+	EXPECT_EQ(NiFpga_ReleaseFifoElements_fake.arg2_history[1], 40);
+}
+
 TEST_F(DMACPUCommonTests, cleanAllDMAs) {
 	Irio irio(bitfilePath, "0", "V9.9");
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().cleanAllDMAs());
@@ -203,6 +255,272 @@ TEST_F(DMACPUCommonTests, readDataNonBlocking) {
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().readDataNonBlocking(0, numElem, data.get()));
 }
 
+TEST_F(DMACPUCommonTests, readDataBlockingWaitPolicy) {
+	// Two probes find nothing, the third finds enough and the data is read
+	auto (*custom_fakes[])(NiFpga_Session, uint32_t, uint64_t*, size_t,
+			uint32_t, size_t*) -> NiFpga_Status = {funcReturnNoElemRem,
+			funcReturnNoElemRem, funcReturnElemRem, funcReturnElemRem};
+	SET_CUSTOM_FAKE_SEQ(NiFpga_ReadFifoU64, custom_fakes, 4);
+
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataBlocking(0, numElem, data, 1000,
+			WaitPolicy::hybrid(0, 0, 10, 100)), numElem);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 4);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_history[2], 0);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_history[3], numElem);
+}
+
+TEST_F(DMACPUCommonTests, setWaitPolicy) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReturnElemRem;
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_TRUE(irio.getTerminalsDAQ().getWaitPolicy().driverWait);
+
+	irio.getTerminalsDAQ().setWaitPolicy(WaitPolicy::busySpin());
+	EXPECT_FALSE(irio.getTerminalsDAQ().getWaitPolicy().driverWait);
+
+	// Probe and read instead of a single blocking read
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataBlocking(0, numElem, data),
+			numElem);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 2);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_history[0], 0);
+
+	// The policy of the call takes precedence
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataBlocking(0, numElem, data, 500,
+			WaitPolicy()), numElem);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 3);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg4_val, 500);
+}
+
+TEST_F(DMACPUCommonTests, acquireData) {
+	const size_t numElem = 10;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMADataView view;
+	EXPECT_NO_THROW(view = irio.getTerminalsDAQ().acquireData(0, numElem, 500));
+	EXPECT_EQ(view.size(), numElem);
+	EXPECT_FALSE(view.wraps());
+	EXPECT_NO_THROW(irio.getTerminalsDAQ().releaseData(0, view.size()));
+	EXPECT_EQ(NiFpga_ReleaseFifoElements_fake.arg2_val, numElem);
+}
+
+NiFpga_Status funcAcquireEndOfBuffer(NiFpga_Session, uint32_t,
+		uint64_t **elements, size_t, uint32_t, size_t *elementsAcquired,
+		size_t *) {
+	static uint64_t endBuffer[4] = {};
+	*elements = endBuffer;
+	*elementsAcquired = 4;
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status funcAcquireStartOfBuffer(NiFpga_Session, uint32_t,
+		uint64_t **elements, size_t elementsRequested, uint32_t,
+		size_t *elementsAcquired, size_t *) {
+	static uint64_t startBuffer[16] = {};
+	*elements = startBuffer;
+	*elementsAcquired = elementsRequested;
+	return NiFpga_Status_Success;
+}
+
+TEST_F(DMACPUCommonTests, acquireDataWrapAround) {
+	auto (*custom_fakes[])(NiFpga_Session, uint32_t, uint64_t**, size_t,
+			uint32_t, size_t*, size_t*) -> NiFpga_Status =
+					{funcAcquireEndOfBuffer, funcAcquireStartOfBuffer};
+	SET_CUSTOM_FAKE_SEQ(NiFpga_AcquireFifoReadElementsU64, custom_fakes, 2);
+
+	const size_t numElem = 10;
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto view = irio.getTerminalsDAQ().acquireData(0, numElem, 500);
+	EXPECT_TRUE(view.wraps());
+	EXPECT_EQ(view.firstSize, 4);
+	EXPECT_EQ(view.secondSize, numElem - 4);
+	EXPECT_EQ(view.size(), numElem);
+	EXPECT_EQ(NiFpga_AcquireFifoReadElementsU64_fake.arg3_history[1],
+			numElem - 4);
+}
+
+NiFpga_Status funcReadRemaining35(NiFpga_Session, uint32_t, uint64_t*,
+		size_t, uint32_t, size_t *elementsRemaining) {
+	*elementsRemaining = 35;
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status funcReadTimeout(NiFpga_Session, uint32_t, uint64_t*,
+		size_t, uint32_t, size_t *elementsRemaining) {
+	*elementsRemaining = 0;
+	return NiFpga_Status_FifoTimeout;
+}
+
+NiFpga_Status funcReadTimeoutRemaining7(NiFpga_Session, uint32_t, uint64_t*,
+		size_t, uint32_t, size_t *elementsRemaining) {
+	*elementsRemaining = 7;
+	return NiFpga_Status_FifoTimeout;
+}
+
+TEST_F(DMACPUCommonTests, readAvailable) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadRemaining35;
+	const size_t maxElem = 100;
+	std::unique_ptr<std::uint64_t[]> data(new std::uint64_t[maxElem]);
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto daq = irio.getTerminalsDAQ();
+	size_t remaining = 0;
+
+	// Nothing known yet, a single block is tried
+	EXPECT_EQ(daq.readAvailable(0, maxElem, data.get(), 10, &remaining), 10);
+	EXPECT_EQ(remaining, 35);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_val, 10);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg4_val, 0);
+
+	// Whole blocks of the remaining elements are read with one call
+	EXPECT_EQ(daq.readAvailable(0, maxElem, data.get(), 10, &remaining), 30);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_val, 30);
+
+	// Capped to max elements
+	EXPECT_EQ(daq.readAvailable(0, 20, data.get(), 10, &remaining), 20);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_val, 20);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 3);
+}
+
+TEST_F(DMACPUCommonTests, readAvailableNoData) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeout;
+	const size_t maxElem = 100;
+	std::unique_ptr<std::uint64_t[]> data(new std::uint64_t[maxElem]);
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	size_t remaining = 1;
+	EXPECT_EQ(irio.getTerminalsDAQ().readAvailable(0, maxElem, data.get(), 10,
+			&remaining), 0);
+	EXPECT_EQ(remaining, 0);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 1);
+}
+
+TEST_F(DMACPUCommonTests, readAvailableFillLevel) {
+	const size_t maxElem = 100;
+	std::unique_ptr<std::uint64_t[]> data(new std::uint64_t[maxElem]);
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto daq = irio.getTerminalsDAQ();
+	size_t remaining = 0;
+
+	// Less than a block, the fill level of the timed out read is reported
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeoutRemaining7;
+	EXPECT_EQ(daq.readAvailable(0, maxElem, data.get(), 10, &remaining), 0);
+	EXPECT_EQ(remaining, 7);
+
+	// No room for a block, the fill level is still read from the driver
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadRemaining35;
+	EXPECT_EQ(daq.readAvailable(0, 5, data.get(), 10, &remaining), 0);
+	EXPECT_EQ(remaining, 35);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_val, 0);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 2);
+}
+
+TEST_F(DMACPUCommonTests, readDataMulti) {
+	std::uint64_t data0[10], data1[20];
+	const std::vector<DMAReadRequest> requests = {{0, 10, data0},
+			{1, 20, data1}};
+	std::vector<DMAReadResult> results;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataMulti(requests, &results), 2);
+	ASSERT_EQ(results.size(), 2);
+	EXPECT_EQ(results[0].status, DMAReadStatus::Success);
+	EXPECT_EQ(results[0].elementsRead, 10);
+	EXPECT_EQ(results[1].status, DMAReadStatus::Success);
+	EXPECT_EQ(results[1].elementsRead, 20);
+
+	// Non-blocking reads are a single driver call each, without waiting
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 2);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg3_history[1], 20);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg4_history[1], 0);
+}
+
+TEST_F(DMACPUCommonTests, readDataMultiNotEnough) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeout;
+	std::uint64_t data[10];
+	std::vector<DMAReadResult> results;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataMulti({{0, 10, data}},
+			&results), 0);
+	EXPECT_EQ(results[0].status, DMAReadStatus::NotEnough);
+	EXPECT_EQ(results[0].elementsRead, 0);
+}
+
+TEST_F(DMACPUCommonTests, readDataMultiBlocking) {
+	std::uint64_t data[10];
+	std::vector<DMAReadResult> results;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataMulti({{0, 10, data}},
+			&results, true), 1);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg4_val, NiFpga_InfiniteTimeout);
+
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataMulti({{0, 10, data}},
+			&results, true, 500), 1);
+	EXPECT_LE(NiFpga_ReadFifoU64_fake.arg4_val, 500);
+}
+
+TEST_F(DMACPUCommonTests, readStats) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReturnElemRem;
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	auto daq = irio.getTerminalsDAQ();
+	EXPECT_FALSE(daq.isReadStatsEnabled());
+	daq.readDataBlocking(0, numElem, data);
+	EXPECT_EQ(daq.getReadStats(0).latencyNs.count, 0);
+
+	daq.setReadStatsEnabled(true);
+	EXPECT_TRUE(daq.isReadStatsEnabled());
+	EXPECT_EQ(daq.readDataBlocking(0, numElem, data), numElem);
+	EXPECT_EQ(daq.readDataNonBlocking(0, numElem, data), numElem);
+
+	const auto stats = daq.getReadStats(0);
+	EXPECT_EQ(stats.latencyNs.count, 2);
+	EXPECT_EQ(stats.elements.count, 2);
+	EXPECT_EQ(stats.elements.max, numElem);
+	// Remaining after the blocking read plus the elements read, and
+	// available before the non-blocking one
+	EXPECT_EQ(stats.fillLevel.max, 100 + numElem);
+	EXPECT_EQ(stats.fillLevel.min, 100);
+	EXPECT_EQ(stats.interArrivalNs.count, 1);
+	EXPECT_EQ(stats.timeouts, 0);
+	EXPECT_EQ(daq.getReadStats(1).latencyNs.count, 0);
+
+	daq.resetAllReadStats();
+	EXPECT_EQ(daq.getReadStats(0).latencyNs.count, 0);
+	daq.readDataBlocking(0, numElem, data);
+	EXPECT_EQ(daq.getReadStats(0).interArrivalNs.count, 0);
+}
+
+TEST_F(DMACPUCommonTests, readStatsWaitPolicy) {
+	// Only the read is recorded, not the probes of the polling
+	auto (*custom_fakes[])(NiFpga_Session, uint32_t, uint64_t*, size_t,
+			uint32_t, size_t*) -> NiFpga_Status = {funcReturnNoElemRem,
+			funcReturnElemRem, funcReturnElemRem};
+	SET_CUSTOM_FAKE_SEQ(NiFpga_ReadFifoU64, custom_fakes, 3);
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	auto daq = irio.getTerminalsDAQ();
+	daq.setReadStatsEnabled(true);
+	EXPECT_EQ(daq.readDataBlocking(0, numElem, data, 1000,
+			WaitPolicy::hybrid(0, 0, 10, 100)), numElem);
+
+	const auto stats = daq.getReadStats(0);
+	EXPECT_EQ(stats.latencyNs.count, 1);
+	EXPECT_EQ(stats.fillLevel.max, 100);
+}
+
 ///////////////////////////////////////////////////////////////
 ///// Error DMACPU Common Terminals Tests
 ///////////////////////////////////////////////////////////////
@@ -225,6 +543,113 @@ TEST_F(ErrorDMACPUCommonTests, DMAReadTimeout) {
 		errors::DMAReadTimeout);
 }
 
+TEST_F(ErrorDMACPUCommonTests, readDataBlockingWaitPolicyTimeout) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReturnNoElemRem;
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().readDataBlocking(0, numElem, data, 5,
+			WaitPolicy::hybrid()), errors::DMAReadTimeout);
+	EXPECT_GT(NiFpga_ReadFifoU64_fake.call_count, 1);
+}
+
+TEST_F(ErrorDMACPUCommonTests, readStatsTimeout) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeout;
+	const size_t numElem = 10;
+	std::uint64_t data[numElem];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	auto daq = irio.getTerminalsDAQ();
+	daq.setReadStatsEnabled(true);
+	EXPECT_THROW(daq.readDataBlocking(0, numElem, data, 5),
+			errors::DMAReadTimeout);
+
+	const auto stats = daq.getReadStats(0);
+	EXPECT_EQ(stats.timeouts, 1);
+	EXPECT_EQ(stats.latencyNs.count, 0);
+}
+
+TEST_F(ErrorDMACPUCommonTests, readStatsInvalidDMAID) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().getReadStats(10);,
+			errors::ResourceNotFoundError);
+	EXPECT_THROW(irio.getTerminalsDAQ().resetReadStats(10);,
+			errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMACPUCommonTests, readAvailableError) {
+	NiFpga_ReadFifoU64_fake.return_val = NiFpga_Status_InternalError;
+	std::uint64_t data[10];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().readAvailable(0, 10, data);,
+			errors::NiFpgaError);
+}
+
+TEST_F(ErrorDMACPUCommonTests, readDataMultiTimeout) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeout;
+	std::uint64_t data[10];
+	std::vector<DMAReadResult> results;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_EQ(irio.getTerminalsDAQ().readDataMulti({{0, 10, data}},
+			&results, true, 500), 0);
+	EXPECT_EQ(results[0].status, DMAReadStatus::Timeout);
+}
+
+TEST_F(ErrorDMACPUCommonTests, readDataMultiPartialFailure) {
+	std::uint64_t data0[10], data1[10];
+	const std::vector<DMAReadRequest> requests = {{10, 10, data0},
+			{1, 10, data1}};
+	std::vector<DMAReadResult> results;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto daq = irio.getTerminalsDAQ();
+	EXPECT_EQ(daq.readDataMulti(requests, &results), 1);
+	EXPECT_EQ(results[0].status, DMAReadStatus::NotFound);
+	EXPECT_EQ(results[1].status, DMAReadStatus::Success);
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.call_count, 1);
+
+	NiFpga_ReadFifoU64_fake.return_val = NiFpga_Status_InternalError;
+	EXPECT_EQ(daq.readDataMulti(requests, &results), 0);
+	EXPECT_EQ(results[1].status, DMAReadStatus::Error);
+	EXPECT_EQ(results[1].fpgaStatus, NiFpga_Status_InternalError);
+	EXPECT_EQ(results[1].elementsRead, 0);
+}
+
+TEST_F(ErrorDMACPUCommonTests, cleanDMAReleaseError) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReturnElemRem;
+	NiFpga_ReleaseFifoElements_fake.return_val = NiFpga_Status_InternalError;
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().cleanDMA(0);, errors::NiFpgaError);
+}
+
+TEST_F(ErrorDMACPUCommonTests, acquireDataTimeout) {
+	NiFpga_AcquireFifoReadElementsU64_fake.custom_fake = [](NiFpga_Session,
+			uint32_t, uint64_t**, size_t, uint32_t, size_t*, size_t*) {
+		return NiFpga_Status_FifoTimeout;
+	};
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().acquireData(0, 10, 500);,
+		errors::DMAReadTimeout);
+}
+
+TEST_F(ErrorDMACPUCommonTests, acquireDataInvalidDMAID) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().acquireData(10, 10, 500);,
+			errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMACPUCommonTests, hostDepthInvalidDMAID) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(irio.getTerminalsDAQ().setHostDepth(10, 1000);,
+			errors::ResourceNotFoundError);
+	EXPECT_THROW(irio.getTerminalsDAQ().getEffectiveHostDepth(10);,
+			errors::ResourceNotFoundError);
+}
+
 TEST_F(ErrorDMACPUCommonTests, startDMAInvalidDMAID) {
 	Irio irio(bitfilePath, "0", "V9.9");
 	EXPECT_THROW(irio.getTerminalsDAQ().startDMA(10);,
@@ -28,9 +28,13 @@ public:
 						bfp.getRegister(TERMINAL_DMATTOHOSTSAMPLINGRATE
 								+std::to_string(0)).getAddress(),
 						samplingRateFake);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTSAMPLESIZE).getAddress(),
+						sampleSizeFake, 2);
 	}
 
 	const std::uint16_t nchFake[2] = {5,2};
+	const std::uint8_t sampleSizeFake[2] = {8,8};
 	const std::uint16_t lengthBlockFake[2] = {42,24};
 	const std::uint16_t samplingRateFake = 12345;
 };
@@ -61,6 +65,15 @@ TEST_F(DMACPUDAQTests, setSamplingRateDecimation){
 	EXPECT_NO_THROW(irio.getTerminalsDAQ().setSamplingRateDecimation(0, 1));
 }
 
+TEST_F(DMACPUDAQTests, setHostDepthAuto){
+	// 1 kHz, 5 channels of 8 bytes -> 5000 words/s, 500 words in 100 ms
+	const std::uint32_t fref = samplingRateFake * 1000;
+	Irio irio(bitfilePath, "0", "V9.9");
+	const auto depth = irio.getTerminalsDAQ().setHostDepthAuto(0, fref, 100);
+	EXPECT_EQ(depth, 12 * lengthBlockFake[0]);
+	EXPECT_EQ(irio.getTerminalsDAQ().getHostDepth(0), depth);
+}
+
 ///////////////////////////////////////////////////////////////
 ///// Error DMACPU DAQ Terminals Tests
 ///////////////////////////////////////////////////////////////
@@ -77,6 +90,13 @@ TEST_F(ErrorDMACPUDAQTests, MistmatchDMALengthBlock) {
 	);
 }
 
+TEST_F(ErrorDMACPUDAQTests, MistmatchDMALengthBlockLazy) {
+	Irio irio("../../../resources/failResources/7854/NiFpga_Rseries_MismatchDMALengthBlock_7854.lvbitx", "0", "V9.9", false, TerminalsConstruction::Lazy);
+	EXPECT_NO_THROW(irio.getTerminalsCommon(););
+	EXPECT_THROW(irio.getTerminalsDAQ();, errors::ResourceNotFoundError);
+	EXPECT_THROW(irio.validateTerminals();, errors::ResourceNotFoundError);
+}
+
 TEST_F(ErrorDMACPUDAQTests, MistmatchDMASamplingRate) {
 	EXPECT_THROW(
 		Irio irio("../../../resources/failResources/7854/NiFpga_Rseries_MistmatchDMASamplingRate_7854.lvbitx", "0", "V9.9");,
@@ -115,6 +115,18 @@ TEST_F(DMACPUIMAQTests, setUARTBaudRate){
     EXPECT_NO_THROW(imaq.setUARTBaudRate(UARTBaudRates::BR1152));
 }
 
+TEST_F(DMACPUIMAQTests, UARTWaitPolicy){
+    Irio irio(bitfilePath, "0", "V9.9");
+    auto imaq = irio.getTerminalsIMAQ();
+    imaq.setWaitPolicy(WaitPolicy::hybrid());
+
+    std::string msg = "test";
+    EXPECT_NO_THROW(
+        imaq.sendUARTMsg(std::vector<std::uint8_t>(msg.begin(), msg.end())));
+    EXPECT_NO_THROW(imaq.setUARTBaudRate(UARTBaudRates::BR1152, 100,
+        WaitPolicy::busySpin()));
+}
+
 TEST_F(DMACPUIMAQTests, getUARTBaudRate){
     Irio irio(bitfilePath, "0", "V9.9");
     auto imaq = irio.getTerminalsIMAQ();
@@ -166,6 +178,23 @@ TEST_F(DMACPUIMAQTests, readImageBlocking){
     EXPECT_NO_THROW(imaq.readImageBlocking(0, numPixels, data.get()));
 }
 
+TEST_F(DMACPUIMAQTests, readImageStats){
+    const size_t numPixels = 1920;
+    std::unique_ptr<std::uint64_t> data(new std::uint64_t[numPixels]);
+
+    Irio irio(bitfilePath, "0", "V9.9");
+    auto imaq = irio.getTerminalsIMAQ();
+    imaq.setReadStatsEnabled(true);
+    imaq.readImageBlocking(0, numPixels, data.get());
+    imaq.readImageBlocking(0, numPixels, data.get());
+
+    const auto stats = imaq.getReadStats(0);
+    EXPECT_EQ(stats.latencyNs.count, 2);
+    EXPECT_EQ(stats.interArrivalNs.count, 1);
+    EXPECT_EQ(stats.elements.max,
+              numPixels * imaq.getSampleSize(0) / 8);
+}
+
 ///////////////////////////////////////////////////////////////
 /// Error IMAQCPU Terminals Tests
 ///////////////////////////////////////////////////////////////
@@ -183,6 +212,20 @@ TEST_F(ErrorDMACPUIMAQTests, sendUARTMsgTimeout){
 		irio::errors::CLUARTTimeout);
 }
 
+TEST_F(ErrorDMACPUIMAQTests, sendUARTMsgTimeoutWaitPolicy){
+	setValueForReg(ReadFunctions::NiFpga_ReadBool,
+				   bfp.getRegister(TERMINAL_UARTTXREADY).getAddress(), 0);
+
+	Irio irio(bitfilePath, "0", "V9.9");
+    auto imaq = irio.getTerminalsIMAQ();
+
+    std::string msg = "test";
+	EXPECT_THROW(
+		imaq.sendUARTMsg(std::vector<std::uint8_t>(msg.begin(), msg.end()), 2,
+			WaitPolicy::hybrid()),
+		irio::errors::CLUARTTimeout);
+}
+
 TEST_F(ErrorDMACPUIMAQTests, recvUARTMsgTimeout){
     setValueForReg(ReadFunctions::NiFpga_ReadBool,
                         bfp.getRegister(TERMINAL_UARTRECEIVE).getAddress(),
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "dmaOverflowMonitor.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+
+
+using namespace irio;
+
+
+class DMAOverflowMonitorTests: public BaseTests {
+public:
+	DMAOverflowMonitorTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadFunctions::NiFpga_ReadBool,
+						bfp.getRegister(TERMINAL_DMATTOHOSTENABLE+std::to_string(0)).getAddress(),
+						1);
+		setOverflows(0);
+	}
+
+	void setOverflows(const std::uint16_t value) {
+		setValueForReg(ReadFunctions::NiFpga_ReadU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTOVERFLOWS).getAddress(),
+						value);
+	}
+
+	const std::uint16_t nchFake[2] = {5,2};
+};
+
+class ErrorDMAOverflowMonitorTests: public DMAOverflowMonitorTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// DMA Overflow Monitor Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DMAOverflowMonitorTests, countOverflows) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitorConfig config;
+	config.period = 0;
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ(), config);
+
+	EXPECT_EQ(monitor.poll(), 0);
+	setOverflows(0b10);
+	EXPECT_EQ(monitor.poll(), 0b10);
+	EXPECT_EQ(monitor.poll(), 0b10);
+	setOverflows(0);
+	monitor.poll();
+	setOverflows(0b10);
+	monitor.poll();
+
+	const auto stats = monitor.getStats(1);
+	EXPECT_EQ(stats.overflows, 2);
+	EXPECT_TRUE(stats.active);
+	EXPECT_LE(stats.firstOverflow, stats.lastOverflow);
+	EXPECT_EQ(monitor.getStats(0).overflows, 0);
+	EXPECT_EQ(monitor.getStats(0).firstOverflow,
+			std::chrono::system_clock::time_point());
+}
+
+TEST_F(DMAOverflowMonitorTests, callbacks) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitorConfig config;
+	config.period = 0;
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ(), config);
+
+	std::vector<std::pair<std::uint32_t, bool>> events;
+	monitor.addCallback([&events](const std::uint32_t n, const bool overflow,
+			const DMAOverflowStats&) {
+		events.emplace_back(n, overflow);
+	});
+
+	setOverflows(0b11);
+	monitor.poll();
+	setOverflows(0b01);
+	monitor.poll();
+
+	const std::vector<std::pair<std::uint32_t, bool>> expected = {
+			{0, true}, {1, true}, {1, false}};
+	EXPECT_EQ(events, expected);
+}
+
+TEST_F(DMAOverflowMonitorTests, monitorThread) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitorConfig config;
+	config.period = 1;
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ(), config);
+
+	std::atomic<int> calls(0);
+	monitor.addCallback([&calls](const std::uint32_t, const bool,
+			const DMAOverflowStats&) {
+		++calls;
+	});
+	setOverflows(0b01);
+	monitor.start();
+	EXPECT_TRUE(monitor.isRunning());
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	monitor.stop();
+	EXPECT_FALSE(monitor.isRunning());
+
+	EXPECT_EQ(calls.load(), 1);
+	EXPECT_EQ(monitor.getStats(0).overflows, 1);
+}
+
+TEST_F(DMAOverflowMonitorTests, restartPolicy) {
+	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			uint64_t*, size_t, uint32_t, size_t *elementsRemaining) {
+		*elementsRemaining = 25;
+		return NiFpga_Status_Success;
+	};
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitorConfig config;
+	config.period = 0;
+	config.policy = OverflowPolicy::Restart;
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ(), config);
+
+	setOverflows(0b01);
+	monitor.poll();
+
+	EXPECT_EQ(NiFpga_StopFifo_fake.call_count, 1);
+	EXPECT_EQ(NiFpga_StartFifo_fake.call_count, 1);
+	const auto stats = monitor.getStats(0);
+	EXPECT_EQ(stats.restarts, 1);
+	EXPECT_EQ(stats.elementsDiscarded, 25);
+
+	EXPECT_EQ(monitor.getGapCount(0), 1);
+	DMAGap gap;
+	EXPECT_TRUE(monitor.popGap(0, &gap));
+	EXPECT_EQ(gap.sequence, 1);
+	EXPECT_EQ(gap.elementsDiscarded, 25);
+	EXPECT_FALSE(monitor.popGap(0, &gap));
+	EXPECT_EQ(monitor.getGapCount(0), 1);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DMA Overflow Monitor Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDMAOverflowMonitorTests, invalidDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ());
+	EXPECT_THROW(monitor.getStats(2);, errors::ResourceNotFoundError);
+	DMAGap gap;
+	EXPECT_THROW(monitor.popGap(2, &gap);, errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMAOverflowMonitorTests, readError) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAOverflowMonitor monitor(irio.getTerminalsDAQ());
+
+	NiFpga_ReadU16_fake.custom_fake = nullptr;
+	NiFpga_ReadU16_fake.return_val = NiFpga_Status_InternalError;
+	EXPECT_THROW(monitor.poll();, errors::NiFpgaError);
+}
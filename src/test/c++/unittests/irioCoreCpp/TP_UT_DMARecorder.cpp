@@ -0,0 +1,211 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "dmaRecorder.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class DMARecorderTests: public BaseTests {
+public:
+	DMARecorderTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+		NiFpga_ReadFifoU64_fake.custom_fake = funcCounter;
+		counter = 0;
+	}
+
+	~DMARecorderTests() {
+		std::remove(recordPath);
+	}
+
+	void recordAndCheck(const DMARecorderConfig &config);
+
+	static NiFpga_Status funcCounter(NiFpga_Session, uint32_t,
+			uint64_t *data, size_t number, uint32_t,
+			size_t *elementsRemaining) {
+		for (size_t i = 0; i < number; ++i) {
+			data[i] = counter++;
+		}
+		if (elementsRemaining) {
+			*elementsRemaining = 0;
+		}
+		return NiFpga_Status_Success;
+	}
+
+	static std::uint64_t counter;
+
+	const std::uint16_t nchFake[2] = {5,2};
+	const std::uint16_t lengthBlockFake[2] = {42,24};
+	const char *recordPath = "dmaRecorderTest.rec";
+};
+
+std::uint64_t DMARecorderTests::counter = 0;
+
+class ErrorDMARecorderTests: public DMARecorderTests { };
+
+void DMARecorderTests::recordAndCheck(const DMARecorderConfig &config) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMARecorder recorder(irio.getTerminalsDAQ(), 0, irio.getSignature(),
+			recordPath, config);
+
+	recorder.start();
+	EXPECT_TRUE(recorder.isRunning());
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	recorder.stop();
+	EXPECT_FALSE(recorder.isRunning());
+
+	const auto stats = recorder.getStats();
+	EXPECT_FALSE(stats.failed) << stats.lastError;
+	EXPECT_GT(stats.chunksWritten, 0);
+	EXPECT_EQ(stats.chunksRead, stats.chunksWritten + stats.chunksDropped);
+	EXPECT_EQ(stats.bytesWritten, stats.chunksWritten * recorder.getChunkSize());
+
+	std::ifstream file(recordPath, std::ios::binary);
+	const std::vector<char> content((std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+	ASSERT_GE(content.size(), sizeof(record::FileHeader));
+
+	record::FileHeader header;
+	std::memcpy(&header, content.data(), sizeof(header));
+	EXPECT_EQ(std::memcmp(header.magic, record::FILE_MAGIC,
+			sizeof(header.magic)), 0);
+	EXPECT_EQ(header.version, record::FORMAT_VERSION);
+	EXPECT_EQ(header.dma, 0);
+	EXPECT_EQ(std::string(header.signature), irio.getSignature());
+	EXPECT_EQ(header.nCh, nchFake[0]);
+	EXPECT_EQ(header.lengthBlock, lengthBlockFake[0]);
+	EXPECT_EQ(header.elementsPerBlock, lengthBlockFake[0]);
+	EXPECT_EQ(header.blocksPerChunk, config.blocksPerChunk);
+	EXPECT_EQ(header.chunkSize, recorder.getChunkSize());
+	EXPECT_EQ(header.chunkCount, stats.chunksWritten);
+	EXPECT_EQ(header.indexEntries, header.chunkCount);
+	EXPECT_EQ(header.indexOffset,
+			record::ALIGNMENT + header.chunkCount * header.chunkSize);
+	EXPECT_EQ(header.blocksDropped,
+			stats.chunksDropped * config.blocksPerChunk);
+	ASSERT_EQ(content.size(), header.indexOffset
+			+ header.indexEntries * sizeof(record::IndexEntry));
+
+	const size_t elements = header.elementsPerBlock * header.blocksPerChunk;
+	for (std::uint64_t i = 0; i < header.indexEntries; ++i) {
+		record::IndexEntry entry;
+		std::memcpy(&entry, content.data() + header.indexOffset
+				+ i * sizeof(entry), sizeof(entry));
+		EXPECT_EQ(entry.offset, record::ALIGNMENT + i * header.chunkSize);
+
+		record::ChunkHeader chunk;
+		std::memcpy(&chunk, content.data() + entry.offset, sizeof(chunk));
+		EXPECT_EQ(chunk.magic, record::CHUNK_MAGIC);
+		EXPECT_EQ(chunk.sequence, i);
+		EXPECT_EQ(chunk.firstBlock, entry.firstBlock);
+		EXPECT_EQ(chunk.timestamp, entry.timestamp);
+
+		// Each chunk holds the words of its blocks in FIFO order
+		std::vector<std::uint64_t> words(elements);
+		std::memcpy(words.data(), content.data() + entry.offset
+				+ record::CHUNK_HEADER_SIZE, elements * sizeof(std::uint64_t));
+		for (size_t w = 0; w < elements; ++w) {
+			ASSERT_EQ(words[w], words[0] + w);
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////////
+///// DMA Recorder Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DMARecorderTests, chunkSize) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMARecorderConfig config;
+	config.blocksPerChunk = 4;
+	DMARecorder recorder(irio.getTerminalsDAQ(), 0, irio.getSignature(),
+			recordPath, config);
+
+	EXPECT_EQ(recorder.getChunkSize(), record::ALIGNMENT);
+	EXPECT_EQ(recorder.getChunkSize(),
+			record::getChunkSize(lengthBlockFake[0], 4));
+}
+
+TEST_F(DMARecorderTests, recordThreads) {
+	DMARecorderConfig config;
+	config.blocksPerChunk = 8;
+	config.buffers = 4;
+	config.useIoUring = false;
+	recordAndCheck(config);
+}
+
+TEST_F(DMARecorderTests, recordIoUring) {
+	// Falls back to the thread pool if the kernel does not support it
+	DMARecorderConfig config;
+	config.blocksPerChunk = 8;
+	config.buffers = 4;
+	recordAndCheck(config);
+}
+
+TEST_F(DMARecorderTests, recordBuffered) {
+	DMARecorderConfig config;
+	config.blocksPerChunk = 3;
+	config.directIO = false;
+	recordAndCheck(config);
+}
+
+TEST_F(DMARecorderTests, restart) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMARecorder recorder(irio.getTerminalsDAQ(), 0, irio.getSignature(),
+			recordPath);
+
+	recorder.start();
+	recorder.stop();
+	recorder.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	recorder.stop();
+	EXPECT_FALSE(recorder.getStats().failed);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DMA Recorder Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDMARecorderTests, invalidDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(DMARecorder(irio.getTerminalsDAQ(), 10, irio.getSignature(),
+			recordPath);, errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMARecorderTests, signatureTooLong) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(DMARecorder(irio.getTerminalsDAQ(), 0,
+			std::string(record::SIGNATURE_LENGTH, 'A'), recordPath);,
+			errors::DMARecorderError);
+}
+
+TEST_F(ErrorDMARecorderTests, invalidPath) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMARecorder recorder(irio.getTerminalsDAQ(), 0, irio.getSignature(),
+			"/nonexistent/dir/record.rec");
+
+	EXPECT_THROW(recorder.start(), errors::DMARecorderError);
+	EXPECT_FALSE(recorder.isRunning());
+}
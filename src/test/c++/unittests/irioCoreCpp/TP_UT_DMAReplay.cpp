@@ -0,0 +1,354 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "dmaRecorder.h"
+#include "dmaReplay.h"
+#include "dmaSelector.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class DMAReplayTests: public BaseTests {
+public:
+	DMAReplayTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+		NiFpga_ReadFifoU64_fake.custom_fake = funcCounter;
+		counter = 0;
+	}
+
+	~DMAReplayTests() {
+		std::remove(recordPath);
+	}
+
+	record::FileHeader record(const size_t blocksPerChunk);
+	void writeCapture(const size_t chunks, const bool withIndex);
+
+	static NiFpga_Status funcCounter(NiFpga_Session, uint32_t,
+			uint64_t *data, size_t number, uint32_t,
+			size_t *elementsRemaining) {
+		for (size_t i = 0; i < number; ++i) {
+			data[i] = counter++;
+		}
+		if (elementsRemaining) {
+			*elementsRemaining = 0;
+		}
+		return NiFpga_Status_Success;
+	}
+
+	static std::uint64_t counter;
+
+	const std::uint16_t nchFake[2] = {5,2};
+	const std::uint16_t lengthBlockFake[2] = {42,24};
+	const char *recordPath = "dmaReplayTest.rec";
+	/// Words per chunk of the captures written by writeCapture
+	const size_t chunkWords = 40;
+};
+
+std::uint64_t DMAReplayTests::counter = 0;
+
+class ErrorDMAReplayTests: public DMAReplayTests { };
+
+record::FileHeader DMAReplayTests::record(const size_t blocksPerChunk) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMARecorderConfig config;
+	config.blocksPerChunk = blocksPerChunk;
+	config.useIoUring = false;
+	DMARecorder recorder(irio.getTerminalsDAQ(), 0, irio.getSignature(),
+			recordPath, config);
+	recorder.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	recorder.stop();
+
+	record::FileHeader header;
+	std::ifstream file(recordPath, std::ios::binary);
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	return header;
+}
+
+/**
+ * Writes a capture of 10-word blocks, 4 blocks per chunk, whose words count
+ * from 0. The blocks of a chunk are dropped before the fourth one and the
+ * chunks are read 1 ms apart
+ */
+void DMAReplayTests::writeCapture(const size_t chunks, const bool withIndex) {
+	record::FileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, record::FILE_MAGIC, sizeof(header.magic));
+	header.version = record::FORMAT_VERSION;
+	std::strcpy(header.signature, "SIGNATURE");
+	header.nCh = 3;
+	header.sampleSize = 2;
+	header.lengthBlock = 10;
+	header.decimation = 9;
+	header.elementsPerBlock = 10;
+	header.blocksPerChunk = 4;
+	header.chunkSize = record::getChunkSize(10, 4);
+
+	std::vector<char> content(record::ALIGNMENT + chunks * header.chunkSize);
+	std::vector<record::IndexEntry> index;
+	std::uint64_t word = 0;
+	std::uint64_t block = 0;
+	for (size_t i = 0; i < chunks; ++i) {
+		if (i == 3) {
+			block += header.blocksPerChunk;
+		}
+		const record::ChunkHeader chunk = {record::CHUNK_MAGIC, i, block,
+				1000000000ull + i * 1000000ull, {0, 0, 0, 0}};
+		char *data = content.data() + record::ALIGNMENT
+				+ i * header.chunkSize;
+		std::memcpy(data, &chunk, sizeof(chunk));
+		for (size_t w = 0; w < chunkWords; ++w, ++word) {
+			std::memcpy(data + record::CHUNK_HEADER_SIZE
+					+ w * sizeof(word), &word, sizeof(word));
+		}
+		index.push_back({record::ALIGNMENT + i * header.chunkSize, block,
+				chunk.timestamp, 0});
+		block += header.blocksPerChunk;
+	}
+	if (withIndex) {
+		header.chunkCount = chunks;
+		header.indexOffset = content.size();
+		header.indexEntries = chunks;
+		content.resize(content.size() + chunks * sizeof(record::IndexEntry));
+		std::memcpy(content.data() + header.indexOffset, index.data(),
+				chunks * sizeof(record::IndexEntry));
+	} else {
+		// Space preallocated by a recording that was not stopped
+		content.resize(content.size() + 2 * header.chunkSize);
+	}
+	std::memcpy(content.data(), &header, sizeof(header));
+	std::ofstream(recordPath, std::ios::binary).write(content.data(),
+			content.size());
+}
+
+
+///////////////////////////////////////////////////////////////
+///// DMA Replay Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DMAReplayTests, metadata) {
+	const auto header = record(2);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+
+	EXPECT_EQ(daq.countDMAs(), 1);
+	EXPECT_EQ(daq.getNCh(0), nchFake[0]);
+	EXPECT_EQ(daq.getLengthBlock(0), lengthBlockFake[0]);
+	EXPECT_EQ(daq.getElementsPerBlock(0), lengthBlockFake[0]);
+	EXPECT_EQ(daq.getSampleSize(0), header.sampleSize);
+	EXPECT_EQ(daq.getSamplingRateDecimation(0), header.decimation);
+	EXPECT_EQ(replay.getSignature(0), std::string(header.signature));
+	EXPECT_EQ(replay.getTotalElements(0), header.chunkCount
+			* header.blocksPerChunk * header.elementsPerBlock);
+}
+
+TEST_F(DMAReplayTests, replayRecording) {
+	record(2);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	const auto total = replay.getTotalElements(0);
+	ASSERT_GT(total, 0);
+
+	daq.startDMA(0);
+	EXPECT_EQ(daq.getElementsAvailable(0), total);
+	std::vector<std::uint64_t> data(total);
+	EXPECT_EQ(daq.readDataBlocking(0, total, data.data()), total);
+	// Consecutive chunks hold consecutive words unless one was dropped
+	for (size_t w = 1; w < lengthBlockFake[0] * 2; ++w) {
+		ASSERT_EQ(data[w], data[0] + w);
+	}
+	EXPECT_TRUE(replay.isFinished(0));
+}
+
+TEST_F(DMAReplayTests, notStarted) {
+	writeCapture(2, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	std::vector<std::uint64_t> data(chunkWords);
+
+	EXPECT_EQ(daq.getElementsAvailable(0), 0);
+	EXPECT_EQ(daq.readDataNonBlocking(0, chunkWords, data.data()), 0);
+	daq.startDMA(0);
+	daq.stopDMA(0);
+	EXPECT_EQ(daq.getElementsAvailable(0), 0);
+}
+
+TEST_F(DMAReplayTests, acquireViews) {
+	writeCapture(10, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(25);
+	ASSERT_EQ(daq.readDataNonBlocking(0, 25, data.data()), 25);
+
+	// Spans two chunks, returned as two views of the mapped file
+	const auto view = daq.acquireData(0, 50);
+	EXPECT_EQ(view.firstSize, chunkWords - 25);
+	EXPECT_EQ(view.secondSize, 50 - (chunkWords - 25));
+	for (size_t i = 0; i < view.size(); ++i) {
+		ASSERT_EQ(view[i], 25 + i);
+	}
+	daq.releaseData(0, view.size());
+
+	// Spans more than two chunks, returned as a copy
+	const auto copy = daq.acquireData(0, 100);
+	EXPECT_FALSE(copy.wraps());
+	for (size_t i = 0; i < copy.size(); ++i) {
+		ASSERT_EQ(copy[i], 75 + i);
+	}
+	daq.releaseData(0, copy.size());
+}
+
+TEST_F(DMAReplayTests, overflowOnDroppedBlocks) {
+	writeCapture(5, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(5 * chunkWords);
+
+	ASSERT_EQ(daq.readDataNonBlocking(0, 3 * chunkWords, data.data()),
+			3 * chunkWords);
+	EXPECT_FALSE(daq.getDMAOverflow(0));
+	ASSERT_EQ(daq.readDataNonBlocking(0, 1, data.data()), 1);
+	EXPECT_TRUE(daq.getDMAOverflow(0));
+	EXPECT_EQ(daq.getAllDMAOverflows(), 1);
+
+	daq.startDMA(0);
+	EXPECT_FALSE(daq.getDMAOverflow(0));
+}
+
+TEST_F(DMAReplayTests, endOfCapture) {
+	writeCapture(2, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(3 * chunkWords);
+
+	size_t remaining = 1;
+	EXPECT_EQ(daq.readAvailable(0, 3 * chunkWords, data.data(),
+			chunkWords, &remaining), 2 * chunkWords);
+	EXPECT_EQ(remaining, 0);
+	EXPECT_TRUE(replay.isFinished(0));
+	EXPECT_THROW(daq.readDataBlocking(0, 1, data.data(), 1000),
+			errors::DMAReadTimeout);
+}
+
+TEST_F(DMAReplayTests, readStats) {
+	writeCapture(2, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	daq.setReadStatsEnabled(true);
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(chunkWords);
+
+	EXPECT_EQ(daq.readDataBlocking(0, chunkWords, data.data()), chunkWords);
+	EXPECT_EQ(daq.readDataNonBlocking(0, chunkWords, data.data()),
+			chunkWords);
+	EXPECT_THROW(daq.readDataBlocking(0, 1, data.data(), 1000),
+			errors::DMAReadTimeout);
+
+	const auto stats = daq.getReadStats(0);
+	EXPECT_EQ(stats.latencyNs.count, 2);
+	EXPECT_EQ(stats.fillLevel.max, 2 * chunkWords);
+	EXPECT_EQ(stats.fillLevel.min, chunkWords);
+	EXPECT_EQ(stats.interArrivalNs.count, 1);
+	EXPECT_EQ(stats.timeouts, 1);
+}
+
+TEST_F(DMAReplayTests, withoutIndex) {
+	writeCapture(3, false);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+
+	EXPECT_EQ(replay.getTotalElements(0), 3 * chunkWords);
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(3 * chunkWords);
+	EXPECT_EQ(daq.readDataBlocking(0, 3 * chunkWords, data.data()),
+			3 * chunkWords);
+	EXPECT_EQ(data.back(), 3 * chunkWords - 1);
+}
+
+TEST_F(DMAReplayTests, recordedPace) {
+	writeCapture(10, true);
+	DMAReplayConfig config;
+	config.speed = 1;
+	DMAReplay replay({recordPath}, config);
+	auto daq = replay.getTerminalsDAQ();
+	daq.startDMA(0);
+	std::vector<std::uint64_t> data(chunkWords);
+
+	EXPECT_EQ(daq.getElementsAvailable(0), chunkWords);
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < 10; ++i) {
+		ASSERT_EQ(daq.readDataBlocking(0, chunkWords, data.data(), 1000),
+				chunkWords);
+	}
+	EXPECT_GE(std::chrono::steady_clock::now() - start,
+			std::chrono::milliseconds(8));
+}
+
+TEST_F(DMAReplayTests, pollingSelector) {
+	writeCapture(2, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+
+	DMASelectorConfig config;
+	config.dataReadyIrqs = {1};
+	EXPECT_THROW(DMASelector(daq, {0}, config);, errors::DMAReplayError);
+
+	daq.startDMA(0);
+	DMASelector selector(daq, {0});
+	std::vector<std::uint32_t> ready;
+	EXPECT_EQ(selector.select(chunkWords, 100, &ready), 1);
+	EXPECT_EQ(ready, std::vector<std::uint32_t>{0});
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DMA Replay Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDMAReplayTests, missingFile) {
+	EXPECT_THROW(DMAReplay({"/nonexistent/capture.rec"});,
+			errors::DMAReplayError);
+}
+
+TEST_F(ErrorDMAReplayTests, notACapture) {
+	std::ofstream(recordPath) << std::string(2 * record::ALIGNMENT, 'x');
+	EXPECT_THROW(DMAReplay({recordPath});, errors::DMAReplayError);
+}
+
+TEST_F(ErrorDMAReplayTests, noCaptures) {
+	EXPECT_THROW(DMAReplay({});, errors::DMAReplayError);
+}
+
+TEST_F(ErrorDMAReplayTests, invalidDMA) {
+	writeCapture(1, true);
+	DMAReplay replay({recordPath});
+	auto daq = replay.getTerminalsDAQ();
+	std::vector<std::uint64_t> data(1);
+
+	EXPECT_THROW(daq.getNCh(1), errors::ResourceNotFoundError);
+	EXPECT_THROW(daq.readDataNonBlocking(1, 1, data.data()),
+			errors::ResourceNotFoundError);
+	EXPECT_THROW(replay.getSignature(1), errors::ResourceNotFoundError);
+}
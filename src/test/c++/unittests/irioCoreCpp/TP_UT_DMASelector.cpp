@@ -0,0 +1,154 @@
+#include <chrono>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "dmaSelector.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+
+
+using namespace irio;
+
+
+class DMASelectorTests: public BaseTests {
+public:
+	DMASelectorTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+	}
+
+	const std::uint16_t nchFake[2] = {5,2};
+};
+
+class ErrorDMASelectorTests: public DMASelectorTests { };
+
+NiFpga_Status funcRemaining100(NiFpga_Session, uint32_t, uint64_t*, size_t,
+		uint32_t, size_t *elementsRemaining) {
+	*elementsRemaining = 100;
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status funcRemaining0(NiFpga_Session, uint32_t, uint64_t*, size_t,
+		uint32_t, size_t *elementsRemaining) {
+	*elementsRemaining = 0;
+	return NiFpga_Status_Success;
+}
+
+///////////////////////////////////////////////////////////////
+///// DMA Selector Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DMASelectorTests, pollingReady) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcRemaining100;
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelector selector(irio.getTerminalsDAQ(), {0, 1});
+	std::vector<std::uint32_t> ready;
+
+	EXPECT_FALSE(selector.usesIrqs());
+	EXPECT_EQ(selector.select(10, 0, &ready), 2);
+	EXPECT_EQ(ready, std::vector<std::uint32_t>({0, 1}));
+	EXPECT_EQ(selector.getElementsAvailable(1), 100);
+	EXPECT_EQ(selector.select(200, 0, &ready), 0);
+	EXPECT_TRUE(ready.empty());
+}
+
+TEST_F(DMASelectorTests, pollingTimeout) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcRemaining0;
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelector selector(irio.getTerminalsDAQ(), {0, 1});
+	std::vector<std::uint32_t> ready;
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(selector.select(1, 5, &ready), 0);
+	EXPECT_GE(std::chrono::steady_clock::now() - start,
+			std::chrono::milliseconds(5));
+	EXPECT_GT(NiFpga_ReadFifoU64_fake.call_count, 2);
+}
+
+TEST_F(DMASelectorTests, pollingBackoffFromZero) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcRemaining0;
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelectorConfig config;
+	config.minPollInterval = 0;
+	DMASelector selector(irio.getTerminalsDAQ(), {0, 1}, config);
+	std::vector<std::uint32_t> ready;
+
+	// Sleeps double up to 1 ms instead of spinning on the fill levels
+	EXPECT_EQ(selector.select(1, 20, &ready), 0);
+	EXPECT_LT(NiFpga_ReadFifoU64_fake.call_count, 200);
+}
+
+TEST_F(DMASelectorTests, irqs) {
+	// Initial scan finds no data, the data arrives with the IRQs
+	auto (*custom_fakes[])(NiFpga_Session, uint32_t, uint64_t*, size_t,
+			uint32_t, size_t*) -> NiFpga_Status =
+					{funcRemaining0, funcRemaining0, funcRemaining100};
+	SET_CUSTOM_FAKE_SEQ(NiFpga_ReadFifoU64, custom_fakes, 3);
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelectorConfig config;
+	config.dataReadyIrqs = {3, 4};
+	std::vector<std::uint32_t> ready;
+	{
+		DMASelector selector(irio.getTerminalsDAQ(), {0, 1}, config);
+		EXPECT_TRUE(selector.usesIrqs());
+		EXPECT_EQ(selector.select(10, 1000, &ready), 2);
+	}
+
+	EXPECT_EQ(NiFpga_ReserveIrqContext_fake.call_count, 1);
+	EXPECT_EQ(NiFpga_WaitOnIrqs_fake.arg2_val, (1u << 3) | (1u << 4));
+	EXPECT_EQ(NiFpga_AcknowledgeIrqs_fake.arg1_val, (1u << 3) | (1u << 4));
+	EXPECT_EQ(NiFpga_UnreserveIrqContext_fake.call_count, 1);
+}
+
+TEST_F(DMASelectorTests, irqsPendingData) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcRemaining100;
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelectorConfig config;
+	config.dataReadyIrqs = {3, 4};
+	DMASelector selector(irio.getTerminalsDAQ(), {0, 1}, config);
+	std::vector<std::uint32_t> ready;
+
+	EXPECT_EQ(selector.select(10, 1000, &ready), 2);
+	EXPECT_EQ(NiFpga_WaitOnIrqs_fake.call_count, 0);
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DMA Selector Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDMASelectorTests, invalidDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	EXPECT_THROW(DMASelector(irio.getTerminalsDAQ(), {0, 10});,
+			errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMASelectorTests, irqsMismatch) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelectorConfig config;
+	config.dataReadyIrqs = {3};
+	EXPECT_THROW(DMASelector(irio.getTerminalsDAQ(), {0, 1}, config);,
+			errors::DMASelectorError);
+}
+
+TEST_F(ErrorDMASelectorTests, irqOutOfRange) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelectorConfig config;
+	config.dataReadyIrqs = {3, 32};
+	EXPECT_THROW(DMASelector(irio.getTerminalsDAQ(), {0, 1}, config);,
+			errors::DMASelectorError);
+}
+
+TEST_F(ErrorDMASelectorTests, notSelectedDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMASelector selector(irio.getTerminalsDAQ(), {0});
+	EXPECT_THROW(selector.getElementsAvailable(1);,
+			errors::ResourceNotFoundError);
+}
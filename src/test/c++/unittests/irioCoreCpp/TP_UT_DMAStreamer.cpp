@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "dmaStreamer.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+#include "terminals/names/namesTerminalsDMADAQCPU.h"
+
+
+using namespace irio;
+
+
+class DMAStreamerTests: public BaseTests {
+public:
+	DMAStreamerTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU8,
+						bfp.getRegister(TERMINAL_DMATTOHOSTFRAMETYPE).getAddress(),
+						frameTypeFake, 2);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTBLOCKNWORDS).getAddress(),
+						lengthBlockFake, 2);
+	}
+
+	const std::uint16_t nchFake[2] = {5,2};
+	const std::uint8_t frameTypeFake[2] = {0, 1};
+	const std::uint16_t lengthBlockFake[2] = {42,24};
+};
+
+class ErrorDMAStreamerTests: public DMAStreamerTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// DMA Streamer Tests
+///////////////////////////////////////////////////////////////
+TEST_F(DMAStreamerTests, chunkElements) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamerConfig config;
+	config.blocksPerChunk = 4;
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0, 1}, config);
+
+	EXPECT_EQ(streamer.getChunkElements(0), 4 * lengthBlockFake[0]);
+	// FormatB adds two timestamp words to each block
+	EXPECT_EQ(streamer.getChunkElements(1), 4 * (lengthBlockFake[1] + 2));
+}
+
+TEST_F(DMAStreamerTests, zeroConfigClamped) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamerConfig config;
+	config.blocksPerChunk = 0;
+	config.readTimeout = 0;
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0}, config);
+	EXPECT_EQ(streamer.getChunkElements(0), lengthBlockFake[0]);
+
+	streamer.start();
+	EXPECT_NE(streamer.front(0, 1000), nullptr);
+	streamer.stop();
+	EXPECT_EQ(NiFpga_ReadFifoU64_fake.arg4_val, 1);
+}
+
+TEST_F(DMAStreamerTests, pull) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0});
+
+	streamer.start();
+	EXPECT_TRUE(streamer.isRunning());
+	const std::uint64_t *chunk = streamer.front(0, 1000);
+	EXPECT_NE(chunk, nullptr);
+	streamer.pop(0);
+	streamer.stop();
+	EXPECT_FALSE(streamer.isRunning());
+
+	const auto stats = streamer.getStats(0);
+	EXPECT_GT(stats.chunksRead, 0);
+	EXPECT_EQ(stats.chunksDelivered, 1);
+	EXPECT_FALSE(stats.failed);
+}
+
+TEST_F(DMAStreamerTests, dropWhenRingFull) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamerConfig config;
+	config.ringChunks = 2;
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0}, config);
+
+	streamer.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	streamer.stop();
+
+	const auto stats = streamer.getStats(0);
+	EXPECT_GT(stats.chunksDropped, 0);
+	EXPECT_EQ(stats.chunksRead - stats.chunksDropped, 2);
+}
+
+TEST_F(DMAStreamerTests, callback) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0});
+
+	std::atomic<size_t> chunks(0);
+	streamer.setCallback([&chunks](const std::uint32_t, const std::uint64_t*,
+			const size_t) {
+		++chunks;
+	});
+	streamer.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	streamer.stop();
+
+	EXPECT_GT(chunks.load(), 0);
+	EXPECT_EQ(streamer.getStats(0).chunksDelivered, chunks.load());
+}
+
+///////////////////////////////////////////////////////////////
+///// Error DMA Streamer Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorDMAStreamerTests, invalidDMA) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0});
+	EXPECT_THROW(streamer.getStats(1);, errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorDMAStreamerTests, pullWithCallback) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0});
+	streamer.setCallback([](const std::uint32_t, const std::uint64_t*,
+			const size_t) {});
+	EXPECT_THROW(streamer.front(0);, errors::DMAStreamerError);
+}
+
+TEST_F(ErrorDMAStreamerTests, readerError) {
+	NiFpga_ReadFifoU64_fake.custom_fake = [](NiFpga_Session, uint32_t,
+			uint64_t*, size_t, uint32_t, size_t*) {
+		return NiFpga_Status_InternalError;
+	};
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	DMAStreamer streamer(irio.getTerminalsDAQ(), {0});
+	streamer.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	streamer.stop();
+
+	const auto stats = streamer.getStats(0);
+	EXPECT_TRUE(stats.failed);
+	EXPECT_FALSE(stats.lastError.empty());
+}
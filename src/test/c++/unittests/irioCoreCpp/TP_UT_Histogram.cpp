@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "histogram.h"
+
+
+using namespace irio;
+
+
+///////////////////////////////////////////////////////////////
+///// Histogram Tests
+///////////////////////////////////////////////////////////////
+TEST(HistogramTests, buckets) {
+	for (std::uint64_t value = 0; value < 16; ++value) {
+		EXPECT_EQ(Histogram::bucketOf(value), value);
+	}
+	EXPECT_EQ(Histogram::bucketOf(16), 16);
+	EXPECT_EQ(Histogram::bucketOf(31), 31);
+	EXPECT_EQ(Histogram::bucketOf(32), 32);
+	EXPECT_EQ(Histogram::bucketOf(33), 32);
+	EXPECT_EQ(Histogram::bucketOf(std::numeric_limits<std::uint64_t>::max()),
+			Histogram::BUCKETS - 1);
+
+	for (size_t bucket = 0; bucket < Histogram::BUCKETS; ++bucket) {
+		const auto lower = Histogram::bucketLowerBound(bucket);
+		const auto upper = Histogram::bucketUpperBound(bucket);
+		EXPECT_LE(lower, upper);
+		EXPECT_EQ(Histogram::bucketOf(lower), bucket);
+		EXPECT_EQ(Histogram::bucketOf(upper), bucket);
+		// Width is at most 1/16 of the value
+		EXPECT_LE(upper - lower, lower / 16);
+	}
+}
+
+TEST(HistogramTests, snapshot) {
+	Histogram histogram;
+	EXPECT_EQ(histogram.snapshot().count, 0);
+	EXPECT_EQ(histogram.snapshot().percentile(50), 0);
+	EXPECT_EQ(histogram.snapshot().mean(), 0);
+
+	for (std::uint64_t value = 1; value <= 1000; ++value) {
+		histogram.record(value);
+	}
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, 1000);
+	EXPECT_EQ(snapshot.sum, 500500);
+	EXPECT_EQ(snapshot.min, 1);
+	EXPECT_EQ(snapshot.max, 1000);
+	EXPECT_DOUBLE_EQ(snapshot.mean(), 500.5);
+	EXPECT_EQ(snapshot.percentile(0), 1);
+	EXPECT_EQ(snapshot.percentile(100), 1000);
+	EXPECT_GE(snapshot.percentile(50), 500);
+	EXPECT_LE(snapshot.percentile(50), 500 + 500 / 16);
+	EXPECT_GE(snapshot.percentile(99), 990);
+	EXPECT_LE(snapshot.percentile(99), 1000);
+}
+
+TEST(HistogramTests, reset) {
+	Histogram histogram;
+	histogram.record(42);
+	histogram.reset();
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, 0);
+	EXPECT_EQ(snapshot.sum, 0);
+	EXPECT_EQ(snapshot.min, 0);
+	EXPECT_EQ(snapshot.max, 0);
+
+	histogram.record(7);
+	EXPECT_EQ(histogram.snapshot().min, 7);
+}
+
+TEST(HistogramTests, concurrentRecord) {
+	const int threads = 4;
+	const std::uint64_t values = 10000;
+	Histogram histogram;
+
+	std::vector<std::thread> writers;
+	for (int t = 0; t < threads; ++t) {
+		writers.emplace_back([&histogram, values]() {
+			for (std::uint64_t value = 1; value <= values; ++value) {
+				histogram.record(value);
+			}
+		});
+	}
+	for (auto &writer : writers) {
+		writer.join();
+	}
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, threads * values);
+	EXPECT_EQ(snapshot.sum, threads * values * (values + 1) / 2);
+	EXPECT_EQ(snapshot.min, 1);
+	EXPECT_EQ(snapshot.max, values);
+}
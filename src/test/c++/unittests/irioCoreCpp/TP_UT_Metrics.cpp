@@ -0,0 +1,328 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "fixtures.h"
+#include "fff_nifpga.h"
+
+#include "irioCoreCpp.h"
+#include "metrics.h"
+#include "metricsExporter.h"
+#include "terminals/names/namesTerminalsCommon.h"
+#include "terminals/names/namesTerminalsDMACPUCommon.h"
+
+
+using namespace irio;
+
+namespace {
+
+const std::string DEVICE = "MockDevice";
+
+NiFpga_Status funcReadAvailable(NiFpga_Session, uint32_t, uint64_t*,
+		size_t, uint32_t, size_t *elementsRemaining) {
+	if (elementsRemaining)
+		*elementsRemaining = 100;
+	return NiFpga_Status_Success;
+}
+
+NiFpga_Status funcReadTimeout(NiFpga_Session, uint32_t, uint64_t*,
+		size_t, uint32_t, size_t *elementsRemaining) {
+	if (elementsRemaining)
+		*elementsRemaining = 0;
+	return NiFpga_Status_FifoTimeout;
+}
+
+std::string readFile(const std::string &path) {
+	std::ifstream file(path);
+	std::stringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+
+/// Unix socket accepting the connection of the exporter
+class ListeningSocket {
+public:
+	explicit ListeningSocket(const std::string &path): m_path(path) {
+		::unlink(m_path.c_str());
+		m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		std::strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+		::bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+		::listen(m_fd, 1);
+	}
+
+	~ListeningSocket() {
+		::close(m_fd);
+		::unlink(m_path.c_str());
+	}
+
+	std::string receive() const {
+		const int client = ::accept(m_fd, nullptr, nullptr);
+		std::string text;
+		char buffer[4096];
+		ssize_t n;
+		while ((n = ::read(client, buffer, sizeof(buffer))) > 0) {
+			text.append(buffer, static_cast<size_t>(n));
+		}
+		::close(client);
+		return text;
+	}
+
+private:
+	const std::string m_path;
+	int m_fd;
+};
+
+}  // namespace
+
+class MetricsTests: public BaseTests {
+public:
+	MetricsTests():
+		BaseTests("../../../resources/7854/NiFpga_Rseries_CPUDAQ_7854.lvbitx")
+	{
+		setValueForReg(ReadFunctions::NiFpga_ReadU8,
+						bfp.getRegister(TERMINAL_PLATFORM).getAddress(),
+						PLATFORM_ID::RSeries);
+		setValueForReg(ReadArrayFunctions::NiFpga_ReadArrayU16,
+						bfp.getRegister(TERMINAL_DMATTOHOSTNCH).getAddress(),
+						nchFake, 2);
+		setValueForReg(ReadFunctions::NiFpga_ReadBool,
+						bfp.getRegister(TERMINAL_DMATTOHOSTENABLE+std::to_string(0)).getAddress(),
+						1);
+	}
+
+	std::uint64_t delta(const MetricsTerminal terminal,
+			const MetricsOperation operation) const {
+		const auto now = MetricsRegistry::instance().snapshot();
+		return now.get(DEVICE, terminal, operation)
+				- before.get(DEVICE, terminal, operation);
+	}
+
+	void mark() {
+		before = MetricsRegistry::instance().snapshot();
+	}
+
+	const std::uint16_t nchFake[2] = {5,2};
+	MetricsSnapshot before;
+};
+
+class ErrorMetricsTests: public MetricsTests { };
+
+
+///////////////////////////////////////////////////////////////
+///// Metrics Tests
+///////////////////////////////////////////////////////////////
+TEST_F(MetricsTests, registerReadsWrites) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	mark();
+	irio.getTerminalsCommon().getDevTemp();
+	irio.getTerminalsCommon().getInitDone();
+	irio.getTerminalsCommon().setDebugMode(true);
+	irio.getTerminalsDAQ().isDMAEnable(0);
+
+	EXPECT_EQ(delta(MetricsTerminal::Common, MetricsOperation::RegisterRead), 2);
+	EXPECT_EQ(delta(MetricsTerminal::Common, MetricsOperation::RegisterWrite), 1);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::RegisterRead), 1);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::RegisterWrite), 0);
+}
+
+TEST_F(MetricsTests, dmaReads) {
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadAvailable;
+	std::uint64_t data[20];
+
+	Irio irio(bitfilePath, "0", "V9.9");
+	mark();
+	const auto daq = irio.getTerminalsDAQ();
+	daq.readDataNonBlocking(0, 20, data);
+	daq.readDataBlocking(0, 10, data, 100);
+
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::DMARead), 2);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::DMAElementsRead),
+			30);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::Timeout), 0);
+}
+
+TEST_F(MetricsTests, threadsKeepCounts) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	mark();
+	const auto common = irio.getTerminalsCommon();
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i) {
+		threads.emplace_back([&common]() {
+			for (int j = 0; j < 100; ++j) {
+				common.getDevTemp();
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(delta(MetricsTerminal::Common, MetricsOperation::RegisterRead),
+			400);
+}
+
+TEST_F(MetricsTests, reopenKeepsCounts) {
+	mark();
+	{
+		Irio irio(bitfilePath, "0", "V9.9");
+		irio.getTerminalsCommon().getDevTemp();
+	}
+	Irio irio(bitfilePath, "0", "V9.9");
+	irio.getTerminalsCommon().getDevTemp();
+
+	EXPECT_GE(delta(MetricsTerminal::Common, MetricsOperation::RegisterRead),
+			2);
+}
+
+TEST_F(MetricsTests, prometheusText) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	irio.getTerminalsCommon().getDevTemp();
+
+	const auto text = MetricsRegistry::instance().snapshot().toPrometheus();
+	EXPECT_NE(text.find("# TYPE irio_register_reads_total counter\n"),
+			std::string::npos);
+	EXPECT_NE(text.find("irio_register_reads_total{device=\"MockDevice\","
+			"terminal=\"common\"} "), std::string::npos);
+	EXPECT_NE(text.find("irio_dma_reads_total{device=\"MockDevice\","
+			"terminal=\"dma\"} "), std::string::npos);
+	EXPECT_NE(text.find("\nirio_nifpga_errors_total "), std::string::npos);
+}
+
+TEST_F(MetricsTests, exportFile) {
+	const std::string path = "/tmp/irio_metrics_test.prom";
+	std::remove(path.c_str());
+	Irio irio(bitfilePath, "0", "V9.9");
+
+	MetricsExporterConfig config;
+	config.path = path;
+	MetricsExporter exporter(config);
+	EXPECT_NO_THROW(exporter.exportNow());
+
+	const auto text = readFile(path);
+	EXPECT_NE(text.find("irio_register_reads_total{device=\"MockDevice\""),
+			std::string::npos);
+	EXPECT_EQ(std::ifstream(path + ".tmp").good(), false);
+	EXPECT_EQ(exporter.getExports(), 1);
+	std::remove(path.c_str());
+}
+
+TEST_F(MetricsTests, exportSocket) {
+	const std::string path = "/tmp/irio_metrics_test.sock";
+	ListeningSocket socket(path);
+	Irio irio(bitfilePath, "0", "V9.9");
+
+	MetricsExporterConfig config;
+	config.path = path;
+	config.target = MetricsTarget::UnixSocket;
+	MetricsExporter exporter(config);
+	EXPECT_NO_THROW(exporter.exportNow());
+
+	const auto text = socket.receive();
+	EXPECT_NE(text.find("# TYPE irio_dma_reads_total counter\n"),
+			std::string::npos);
+	EXPECT_NE(text.find("device=\"MockDevice\""), std::string::npos);
+}
+
+TEST_F(MetricsTests, exportPeriodically) {
+	const std::string path = "/tmp/irio_metrics_periodic.prom";
+	MetricsExporterConfig config;
+	config.path = path;
+	config.period = 5;
+	MetricsExporter exporter(config);
+	exporter.start();
+	EXPECT_TRUE(exporter.isRunning());
+
+	const auto deadline = std::chrono::steady_clock::now()
+			+ std::chrono::seconds(5);
+	while (exporter.getExports() < 2
+			&& std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	exporter.stop();
+	EXPECT_FALSE(exporter.isRunning());
+	EXPECT_GE(exporter.getExports(), 2);
+	std::remove(path.c_str());
+}
+
+///////////////////////////////////////////////////////////////
+///// Error Metrics Tests
+///////////////////////////////////////////////////////////////
+TEST_F(ErrorMetricsTests, dmaErrors) {
+	std::uint64_t data[10];
+	Irio irio(bitfilePath, "0", "V9.9");
+	mark();
+	const auto daq = irio.getTerminalsDAQ();
+
+	NiFpga_ReadFifoU64_fake.custom_fake = funcReadTimeout;
+	EXPECT_THROW(daq.readDataBlocking(0, 10, data, 5), errors::DMAReadTimeout);
+	NiFpga_ReadFifoU64_fake.custom_fake = nullptr;
+	NiFpga_ReadFifoU64_fake.return_val = NiFpga_Status_InternalError;
+	EXPECT_THROW(daq.readAvailable(0, 10, data), errors::NiFpgaError);
+
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::Timeout), 1);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::NiFpgaError), 1);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::DMARead), 2);
+	EXPECT_EQ(delta(MetricsTerminal::DMA, MetricsOperation::DMAElementsRead),
+			0);
+}
+
+TEST_F(ErrorMetricsTests, unattributedErrors) {
+	const auto unattributed = MetricsRegistry::instance().snapshot()
+			.unattributedErrors;
+	NiFpga_Open_fake.return_val = NiFpga_Status_InternalError;
+	EXPECT_THROW(Irio(bitfilePath, "0", "V9.9"),
+			errors::NiFpgaErrorDownloadingBitfile);
+
+	EXPECT_EQ(MetricsRegistry::instance().snapshot().unattributedErrors,
+			unattributed + 1);
+}
+
+TEST_F(ErrorMetricsTests, startErrorsAttributed) {
+	Irio irio(bitfilePath, "0", "V9.9");
+	mark();
+	const auto unattributed = before.unattributedErrors;
+	NiFpga_Run_fake.return_val = NiFpga_Status_InternalError;
+	EXPECT_THROW(irio.startFPGA(), errors::NiFpgaError);
+
+	EXPECT_EQ(delta(MetricsTerminal::Common, MetricsOperation::NiFpgaError), 1);
+	EXPECT_EQ(MetricsRegistry::instance().snapshot().unattributedErrors,
+			unattributed);
+}
+
+TEST_F(ErrorMetricsTests, exportNoPath) {
+	const MetricsExporterConfig config;
+	EXPECT_THROW(MetricsExporter exporter(config), errors::MetricsExportError);
+}
+
+TEST_F(ErrorMetricsTests, exportFileError) {
+	MetricsExporterConfig config;
+	config.path = "/nonexistent/dir/metrics.prom";
+	MetricsExporter exporter(config);
+	EXPECT_THROW(exporter.exportNow(), errors::MetricsExportError);
+	EXPECT_EQ(exporter.getFailures(), 1);
+	EXPECT_EQ(exporter.getExports(), 0);
+}
+
+TEST_F(ErrorMetricsTests, exportSocketError) {
+	MetricsExporterConfig config;
+	config.path = "/tmp/irio_metrics_nobody.sock";
+	config.target = MetricsTarget::UnixSocket;
+	::unlink(config.path.c_str());
+	MetricsExporter exporter(config);
+	EXPECT_THROW(exporter.exportNow(), errors::MetricsExportError);
+
+	config.path = std::string(200, 'a');
+	MetricsExporter exporterLongPath(config);
+	EXPECT_THROW(exporterLongPath.exportNow(), errors::MetricsExportError);
+}
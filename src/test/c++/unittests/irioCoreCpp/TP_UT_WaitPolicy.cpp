@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "waitPolicy.h"
+
+
+using namespace irio;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+
+///////////////////////////////////////////////////////////////
+///// Wait Policy Tests
+///////////////////////////////////////////////////////////////
+TEST(WaitPolicyTests, defaultKeepsDriverWait) {
+	const WaitPolicy policy;
+	EXPECT_TRUE(policy.driverWait);
+	EXPECT_EQ(policy.spinUs, 0);
+	EXPECT_EQ(policy.minSleepUs, 1000);
+	EXPECT_EQ(policy.maxSleepUs, 1000);
+
+	EXPECT_FALSE(WaitPolicy::fixedSleep().driverWait);
+	EXPECT_FALSE(WaitPolicy::busySpin().driverWait);
+	EXPECT_FALSE(WaitPolicy::hybrid().driverWait);
+}
+
+TEST(WaitPolicyTests, timeoutExpires) {
+	for (const auto &policy : {WaitPolicy(), WaitPolicy::busySpin(),
+			WaitPolicy::hybrid(), WaitPolicy::fixedSleep(300)}) {
+		const auto start = steady_clock::now();
+		PollWaiter waiter(policy, 5);
+		while (waiter.wait()) { }
+		const auto elapsed = steady_clock::now() - start;
+		EXPECT_GE(elapsed, milliseconds(5));
+		EXPECT_LT(elapsed, milliseconds(100));
+	}
+}
+
+TEST(WaitPolicyTests, noTimeout) {
+	PollWaiter waiter(WaitPolicy::hybrid(0, 0, 1, 1), 0);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_TRUE(waiter.wait());
+	}
+}
+
+TEST(WaitPolicyTests, spinDoesNotSleep) {
+	PollWaiter waiter(WaitPolicy::busySpin(), 1000);
+	const auto start = steady_clock::now();
+	for (int i = 0; i < 1000; ++i) {
+		waiter.wait();
+	}
+	EXPECT_LT(steady_clock::now() - start, milliseconds(50));
+}
+
+TEST(WaitPolicyTests, sleepBacksOff) {
+	// 100, 200, 400 and then 400 us
+	PollWaiter waiter(WaitPolicy::hybrid(0, 0, 100, 400), 0);
+	const auto start = steady_clock::now();
+	for (int i = 0; i < 4; ++i) {
+		waiter.wait();
+	}
+	EXPECT_GE(steady_clock::now() - start, microseconds(1100));
+}
@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <NiFpga.h>
+
+#include "bfp.h"
+#include "nifpgaSim.h"
+#include "errorsIrio.h"
+
+using namespace irio;
+
+class NifpgaSimTests: public ::testing::Test {
+ public:
+	NifpgaSimTests():
+		bitfilePath("../../../resources/bitfile.lvbitx"),
+		bfp(bitfilePath, false),
+		session(0) { }
+
+	void SetUp() override {
+		sim::resetDeviceConfigs();
+	}
+
+	void TearDown() override {
+		if (session) {
+			NiFpga_Close(session, 0);
+		}
+		sim::resetDeviceConfigs();
+	}
+
+	NiFpga_Status open(const sim::DeviceConfig &config) {
+		sim::setDeviceConfig("0", config);
+		return open();
+	}
+
+	NiFpga_Status open() {
+		return NiFpga_Open(bitfilePath.c_str(), bfp.getSignature().c_str(),
+				sim::getResourceName("0").c_str(), 0, &session);
+	}
+
+	std::uint32_t addr(const std::string &name) const {
+		return bfp.getRegister(name).getAddress();
+	}
+
+	const std::string bitfilePath;
+	const bfp::BFP bfp;
+	NiFpga_Session session;
+};
+
+class ErrorNifpgaSimTests: public NifpgaSimTests { };
+
+/**
+ * FIFO 0 of the test bitfile is DMA3. Words are 8-byte ramp samples, so
+ * word i holds i
+ */
+sim::DeviceConfig rampConfig(const double rate) {
+	sim::DeviceConfig config;
+	config.fifos["DMA3"].rate = rate;
+	config.fifos["DMA3"].producer.sampleSize = 8;
+	return config;
+}
+
+///////////////////////////////////////////////////////////////
+///// Registers Tests
+///////////////////////////////////////////////////////////////
+TEST_F(NifpgaSimTests, writeReadScalar) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+
+	EXPECT_EQ(NiFpga_WriteU8(session, addr("InputU8"), 200),
+			NiFpga_Status_Success);
+	std::uint8_t valueU8 = 0;
+	EXPECT_EQ(NiFpga_ReadU8(session, addr("InputU8"), &valueU8),
+			NiFpga_Status_Success);
+	EXPECT_EQ(valueU8, 200);
+
+	EXPECT_EQ(NiFpga_WriteI16(session, addr("InputI16"), -1234),
+			NiFpga_Status_Success);
+	std::int16_t valueI16 = 0;
+	EXPECT_EQ(NiFpga_ReadI16(session, addr("InputI16"), &valueI16),
+			NiFpga_Status_Success);
+	EXPECT_EQ(valueI16, -1234);
+}
+
+TEST_F(NifpgaSimTests, writeReadArray) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	const auto reg = bfp.getRegister("InputArrayU162");
+	std::vector<std::uint16_t> written(reg.getNumElem());
+	for (size_t i = 0; i < written.size(); ++i) {
+		written[i] = static_cast<std::uint16_t>(1000 + i);
+	}
+
+	EXPECT_EQ(NiFpga_WriteArrayU16(session, reg.getAddress(),
+			written.data(), written.size()), NiFpga_Status_Success);
+	std::vector<std::uint16_t> read(written.size());
+	EXPECT_EQ(NiFpga_ReadArrayU16(session, reg.getAddress(),
+			read.data(), read.size()), NiFpga_Status_Success);
+	EXPECT_EQ(read, written);
+}
+
+TEST_F(NifpgaSimTests, configRegisters) {
+	sim::DeviceConfig config;
+	config.registers["OutputU8"] = {42};
+	ASSERT_EQ(open(config), NiFpga_Status_Success);
+
+	std::uint8_t value = 0;
+	EXPECT_EQ(NiFpga_ReadU8(session, addr("OutputU8"), &value),
+			NiFpga_Status_Success);
+	EXPECT_EQ(value, 42);
+}
+
+TEST_F(NifpgaSimTests, deviceSetRegister) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	const auto device = sim::getDevice(session);
+	ASSERT_NE(device, nullptr);
+
+	device->setRegister("OutputU8", 7);
+	std::uint8_t value = 0;
+	EXPECT_EQ(NiFpga_ReadU8(session, addr("OutputU8"), &value),
+			NiFpga_Status_Success);
+	EXPECT_EQ(value, 7);
+	EXPECT_EQ(device->getRegister("OutputU8"), 7);
+}
+
+TEST_F(ErrorNifpgaSimTests, unknownAddress) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	std::uint8_t value = 0;
+	EXPECT_EQ(NiFpga_ReadU8(session, 0xFFFFFFF0, &value),
+			NiFpga_Status_ResourceNotFound);
+}
+
+TEST_F(ErrorNifpgaSimTests, unknownRegisterName) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	EXPECT_THROW(sim::getDevice(session)->setRegister("NotARegister", 1),
+			errors::ResourceNotFoundError);
+}
+
+TEST_F(ErrorNifpgaSimTests, configUnknownRegister) {
+	sim::DeviceConfig config;
+	config.registers["NotARegister"] = {1};
+	EXPECT_NE(open(config), NiFpga_Status_Success);
+	session = 0;
+}
+
+TEST_F(ErrorNifpgaSimTests, signatureMismatch) {
+	EXPECT_EQ(NiFpga_Open(bitfilePath.c_str(), "0123456789ABCDEF",
+			sim::getResourceName("0").c_str(), 0, &session),
+			NiFpga_Status_SignatureMismatch);
+	session = 0;
+}
+
+TEST_F(ErrorNifpgaSimTests, invalidResourceName) {
+	EXPECT_EQ(NiFpga_Open(bitfilePath.c_str(), bfp.getSignature().c_str(),
+			"RIO0", 0, &session), NiFpga_Status_InvalidResourceName);
+	session = 0;
+}
+
+///////////////////////////////////////////////////////////////
+///// FIFO Tests
+///////////////////////////////////////////////////////////////
+TEST_F(NifpgaSimTests, readRampUnthrottled) {
+	ASSERT_EQ(open(rampConfig(0)), NiFpga_Status_Success);
+
+	std::vector<std::uint64_t> data(10);
+	size_t remaining = 0;
+	EXPECT_EQ(NiFpga_ReadFifoU64(session, 0, data.data(), data.size(), 0,
+			&remaining), NiFpga_Status_Success);
+	for (size_t i = 0; i < data.size(); ++i) {
+		EXPECT_EQ(data[i], i);
+	}
+	EXPECT_EQ(remaining, sim::Device::DEFAULT_DEPTH - data.size());
+}
+
+TEST_F(NifpgaSimTests, rateLimitedFillLevel) {
+	ASSERT_EQ(open(rampConfig(1e3)), NiFpga_Status_Success);
+	ASSERT_EQ(NiFpga_StartFifo(session, 0), NiFpga_Status_Success);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	const auto stats = sim::getDevice(session)->getFifoStats("DMA3");
+	EXPECT_TRUE(stats.started);
+	EXPECT_GT(stats.fillLevel, 0);
+	// 50 words expected, the bound leaves room for a slow host
+	EXPECT_LT(stats.fillLevel, 1000);
+	EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST_F(NifpgaSimTests, acquireDoesNotWrap) {
+	ASSERT_EQ(open(rampConfig(0)), NiFpga_Status_Success);
+	size_t depth = 0;
+	ASSERT_EQ(NiFpga_ConfigureFifo2(session, 0, 10, &depth),
+			NiFpga_Status_Success);
+	ASSERT_EQ(depth, 10);
+
+	std::uint64_t *elements = nullptr;
+	size_t acquired = 0;
+	size_t remaining = 0;
+	EXPECT_EQ(NiFpga_AcquireFifoReadElementsU64(session, 0, &elements, 6, 0,
+			&acquired, &remaining), NiFpga_Status_Success);
+	EXPECT_EQ(acquired, 6);
+	EXPECT_EQ(elements[0], 0);
+	EXPECT_EQ(NiFpga_ReleaseFifoElements(session, 0, acquired),
+			NiFpga_Status_Success);
+
+	EXPECT_EQ(NiFpga_AcquireFifoReadElementsU64(session, 0, &elements, 6, 0,
+			&acquired, &remaining), NiFpga_Status_Success);
+	EXPECT_EQ(acquired, 4);
+	EXPECT_EQ(elements[0], 6);
+	EXPECT_EQ(NiFpga_ReleaseFifoElements(session, 0, acquired),
+			NiFpga_Status_Success);
+}
+
+TEST_F(NifpgaSimTests, overflowDropsWords) {
+	ASSERT_EQ(open(rampConfig(1e9)), NiFpga_Status_Success);
+	ASSERT_EQ(NiFpga_ConfigureFifo(session, 0, 100), NiFpga_Status_Success);
+	ASSERT_EQ(NiFpga_StartFifo(session, 0), NiFpga_Status_Success);
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	const auto stats = sim::getDevice(session)->getFifoStats("DMA3");
+	EXPECT_EQ(stats.produced, 100);
+	EXPECT_GT(stats.dropped, 0);
+
+	std::vector<std::uint64_t> data(100);
+	EXPECT_EQ(NiFpga_ReadFifoU64(session, 0, data.data(), data.size(), 0,
+			nullptr), NiFpga_Status_Success);
+	for (size_t i = 0; i < data.size(); ++i) {
+		EXPECT_EQ(data[i], i);
+	}
+}
+
+TEST_F(ErrorNifpgaSimTests, readTimeout) {
+	ASSERT_EQ(open(rampConfig(10)), NiFpga_Status_Success);
+	std::vector<std::uint64_t> data(1000);
+	EXPECT_EQ(NiFpga_ReadFifoU64(session, 0, data.data(), data.size(), 5,
+			nullptr), NiFpga_Status_FifoTimeout);
+}
+
+TEST_F(ErrorNifpgaSimTests, unknownFifo) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	EXPECT_EQ(NiFpga_StartFifo(session, 99), NiFpga_Status_ResourceNotFound);
+}
+
+TEST_F(ErrorNifpgaSimTests, closedSession) {
+	ASSERT_EQ(open(), NiFpga_Status_Success);
+	ASSERT_EQ(NiFpga_Close(session, 0), NiFpga_Status_Success);
+	EXPECT_EQ(NiFpga_StartFifo(session, 0), NiFpga_Status_InvalidSession);
+	session = 0;
+}
+
+///////////////////////////////////////////////////////////////
+///// Producers Tests
+///////////////////////////////////////////////////////////////
+TEST(NifpgaSimProducersTests, rampPacking) {
+	sim::ProducerConfig config;
+	config.nCh = 2;
+	config.sampleSize = 2;
+	const auto producer = sim::makeProducer(config);
+
+	std::uint64_t word = 0;
+	producer->generate(&word, 1);
+	// Samples ch0[0], ch1[0], ch0[1], ch1[1], lowest first
+	EXPECT_EQ(word, 0x0002000100010000ull);
+}
+
+TEST(NifpgaSimProducersTests, rampSkip) {
+	sim::ProducerConfig config;
+	config.sampleSize = 8;
+	const auto producer = sim::makeProducer(config);
+
+	producer->skip(100);
+	std::uint64_t word = 0;
+	producer->generate(&word, 1);
+	EXPECT_EQ(word, 100);
+}
+
+TEST(NifpgaSimProducersTests, framesLayout) {
+	sim::ProducerConfig config;
+	config.type = sim::ProducerType::Frames;
+	config.sampleSize = 8;
+	config.blockWords = 4;
+	const auto producer = sim::makeProducer(config);
+
+	std::vector<std::uint64_t> words(12);
+	producer->generate(words.data(), words.size());
+	EXPECT_EQ(words[0], sim::FramesProducer::HEADER_MARK);
+	EXPECT_EQ(words[1], 0);
+	EXPECT_EQ(words[2], 0);
+	EXPECT_EQ(words[5], 3);
+	EXPECT_EQ(words[6], sim::FramesProducer::HEADER_MARK | 1);
+	EXPECT_EQ(words[7], 4);
+	EXPECT_EQ(words[8], 4);
+}
+
+TEST(NifpgaSimProducersTests, invalidSampleSize) {
+	sim::ProducerConfig config;
+	config.sampleSize = 3;
+	EXPECT_THROW(sim::makeProducer(config), errors::SimulatorConfigError);
+}
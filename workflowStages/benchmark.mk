@@ -0,0 +1,11 @@
+all: bench
+
+LIB_MAKEFILE_DIR := $(COPY_DIR)/main/c++
+BENCH_MAKEFILE_DIR := $(COPY_DIR)/test/c++/benchmarks
+
+bench:
+	@printf "\n$(BOLD)Building libs with the NiFpga simulator...$(NC)\n"
+	$(MAKE) -C $(LIB_MAKEFILE_DIR) clean
+	$(MAKE) -C $(LIB_MAKEFILE_DIR) NIFPGA_SIM=true
+	$(MAKE) -C $(BENCH_MAKEFILE_DIR) NIFPGA_SIM=true
+	cd $(BENCH_MAKEFILE_DIR); $(MAKE) run NIFPGA_SIM=true